@@ -39,6 +39,8 @@
 #include <cstdint>
 #include <cstring>
 
+#include "encodings/utf8_output.h"
+
 // Supported codepages
 #include "encodings/cp932.h"
 #include "encodings/cp936.h"
@@ -81,6 +83,27 @@ void Codepage::JisDecodeString(const char* src,
 
 uint16_t Codepage::Convert(uint16_t ch) const { return ch; }
 
+std::string Codepage::ConvertToUTF8(const std::string& s) const {
+  const char* begin = s.c_str();
+  const char* end = begin + std::strlen(begin);
+
+  // No supported encoding takes more than three bytes of UTF-8 per input
+  // byte; single byte half-width katakana are the worst case.
+  std::string out((end - begin) * 3, '\0');
+  char* out_begin = &out[0];
+  out.resize(TranscodeToUTF8(begin, end, out_begin) - out_begin);
+  return out;
+}
+
+char* Codepage::TranscodeToUTF8(const char* begin,
+                                const char* end,
+                                char* out) const {
+  std::wstring wide = ConvertString(std::string(begin, end));
+  for (wchar_t ch : wide)
+    out = AppendUTF8(ch, out);
+  return out;
+}
+
 bool Codepage::DbcsDelim(char* str) const { return false; }
 
 bool Codepage::IsItalic(uint16_t ch) const { return false; }
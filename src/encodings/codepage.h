@@ -47,6 +47,17 @@ struct Codepage {
   virtual void JisEncodeString(const char* s, char* buf, size_t buflen) const;
   virtual unsigned short Convert(unsigned short ch) const = 0;
   virtual std::wstring ConvertString(const std::string& s) const = 0;
+
+  // Converts |s|, up to its first NUL, straight to UTF-8 in a single pass
+  // over a preallocated buffer.
+  std::string ConvertToUTF8(const std::string& s) const;
+
+  // Writes the UTF-8 for [begin, end) to |out|, which must have room for three
+  // bytes per input byte, and returns the end of the output. The default goes
+  // through ConvertString(); subclasses transcode directly from their tables.
+  virtual char* TranscodeToUTF8(const char* begin,
+                                const char* end,
+                                char* out) const;
   virtual bool DbcsDelim(char* str) const;
   virtual bool IsItalic(unsigned short ch) const;
 
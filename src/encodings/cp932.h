@@ -44,6 +44,9 @@
 struct Cp932 : public Codepage {
   virtual unsigned short Convert(unsigned short ch) const;
   virtual std::wstring ConvertString(const std::string& s) const;
+  virtual char* TranscodeToUTF8(const char* begin,
+                                const char* end,
+                                char* out) const;
   Cp932();
 };
 
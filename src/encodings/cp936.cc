@@ -41,6 +41,8 @@
 #include <cstring>
 #include <string>
 
+#include "encodings/utf8_output.h"
+
 Cp936::Cp936() {
   //  DesirableCharset = GB2312_CHARSET;
   NoTransforms = false;
@@ -2836,6 +2838,30 @@ std::wstring Cp936::ConvertString(const std::string& in_string) const {
   return rv;
 }
 
+char* Cp936::TranscodeToUTF8(const char* begin,
+                             const char* end,
+                             char* out) const {
+  const size_t table_size = sizeof(gbk_to_uni) / sizeof(gbk_to_uni[0]);
+  const char* s = begin;
+  while (s != end) {
+    uint8_t c = *s;
+    if (c < 0x80) {
+      CopyASCIIRun(s, end, out);
+      continue;
+    }
+
+    // A lead byte cut off by the end of the string has no character.
+    if (end - s < 2)
+      break;
+    uint8_t trail = s[1];
+    size_t index = (c - 0x81) * (0xff - 0x40) + (trail - 0x40);
+    out = AppendUTF8(index < table_size ? gbk_to_uni[index] : 0, out);
+    s += 2;
+  }
+
+  return out;
+}
+
 #else
 uint16_t Cp936::Convert(uint16_t ch) const { return ch; }
 
@@ -2843,4 +2869,10 @@ std::wstring Cp936::ConvertString(const std::string& s) const {
   return std::wstring();
 }
 
+char* Cp936::TranscodeToUTF8(const char* begin,
+                             const char* end,
+                             char* out) const {
+  return out;
+}
+
 #endif
@@ -43,6 +43,8 @@
 #include <cstring>
 #include <string>
 
+#include "encodings/utf8_output.h"
+
 Cp949::Cp949() {
   //  DesirableCharset = HANGUL_CHARSET;
   NoTransforms = false;
@@ -1766,6 +1768,30 @@ std::wstring Cp949::ConvertString(const std::string& in_string) const {
   return rv;
 }
 
+char* Cp949::TranscodeToUTF8(const char* begin,
+                             const char* end,
+                             char* out) const {
+  const size_t table_size = sizeof(ksc_to_uni) / sizeof(ksc_to_uni[0]);
+  const char* s = begin;
+  while (s != end) {
+    uint8_t c = *s;
+    if (c < 0x80) {
+      CopyASCIIRun(s, end, out);
+      continue;
+    }
+
+    // A lead byte cut off by the end of the string has no character.
+    if (end - s < 2)
+      break;
+    uint8_t trail = s[1];
+    size_t index = (c - 0x81) * 190 + (trail - 0x41);
+    out = AppendUTF8(index < table_size ? ksc_to_uni[index] : 0, out);
+    s += 2;
+  }
+
+  return out;
+}
+
 #else
 
 uint16_t Cp949::JisDecode(uint16_t ch) const { return ch; }
@@ -1778,4 +1804,10 @@ uint16_t Cp949::Convert(uint16_t ch) const { return ch; }
 
 std::wstring Cp949::ConvertString(const std::string& s) const { return NULL; }
 
+char* Cp949::TranscodeToUTF8(const char* begin,
+                             const char* end,
+                             char* out) const {
+  return out;
+}
+
 #endif
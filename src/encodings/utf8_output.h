@@ -0,0 +1,94 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#ifndef SRC_ENCODINGS_UTF8_OUTPUT_H_
+#define SRC_ENCODINGS_UTF8_OUTPUT_H_
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Helpers shared by the Codepage::TranscodeToUTF8() implementations. They
+// write into a buffer the caller has already sized for the worst case, so
+// none of them check for space.
+
+// Writes the UTF-8 encoding of |codepoint| to |out| and returns the byte past
+// it. Unmapped characters come out of the tables as 0 and are written as a NUL
+// byte, which is what the old wide string path produced.
+inline char* AppendUTF8(uint16_t codepoint, char* out) {
+  if (codepoint < 0x80) {
+    *out++ = static_cast<char>(codepoint);
+  } else if (codepoint < 0x800) {
+    *out++ = static_cast<char>(0xc0 | (codepoint >> 6));
+    *out++ = static_cast<char>(0x80 | (codepoint & 0x3f));
+  } else {
+    *out++ = static_cast<char>(0xe0 | (codepoint >> 12));
+    *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+    *out++ = static_cast<char>(0x80 | (codepoint & 0x3f));
+  }
+  return out;
+}
+
+// Copies the run of 7-bit ASCII bytes at the front of [|in|, |end|) to |out|
+// and advances both pointers past it. ASCII is the same in every codepage we
+// support and in UTF-8, and it makes up most of the text in a typical scene,
+// so this is checked a block at a time.
+inline void CopyASCIIRun(const char*& in, const char* end, char*& out) {
+#ifdef __SSE2__
+  while (end - in >= 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), block);
+    int high_bits = _mm_movemask_epi8(block);
+    if (high_bits) {
+      int run = __builtin_ctz(high_bits);
+      in += run;
+      out += run;
+      return;
+    }
+    in += 16;
+    out += 16;
+  }
+#else
+  while (end - in >= 8) {
+    uint64_t block;
+    std::memcpy(&block, in, sizeof(block));
+    if (block & 0x8080808080808080ull)
+      break;
+    std::memcpy(out, &block, sizeof(block));
+    in += 8;
+    out += 8;
+  }
+#endif
+
+  while (in != end && static_cast<uint8_t>(*in) < 0x80)
+    *out++ = *in++;
+}
+
+#endif  // SRC_ENCODINGS_UTF8_OUTPUT_H_
@@ -40,6 +40,8 @@
 #include <cstdint>
 #include <string>
 
+#include "encodings/utf8_output.h"
+
 bool Cp1252::IsItalic(uint16_t ch) const {
   return (ch > 0x8300 && ch < 0x8900);
 }
@@ -132,3 +134,20 @@ std::wstring Cp1252::ConvertString(const std::string& in_string) const {
 
   return rv;
 }
+
+char* Cp1252::TranscodeToUTF8(const char* begin,
+                              const char* end,
+                              char* out) const {
+  const char* s = begin;
+  while (s != end) {
+    uint8_t c = *s;
+    if (c < 0x80) {
+      CopyASCIIRun(s, end, out);
+    } else {
+      out = AppendUTF8(Convert(c), out);
+      ++s;
+    }
+  }
+
+  return out;
+}
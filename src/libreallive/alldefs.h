@@ -40,6 +40,36 @@ using std::string;
 
 namespace libreallive {
 
+// A run of bytes inside a scenario's bytecode. Bytecode elements keep these
+// instead of copying their parameters out; the bytes belong to the Scenario
+// (or, for elements built by hand, whatever buffer they were built from) and
+// must outlive the element.
+class ByteSpan {
+ public:
+  ByteSpan() : data_(NULL), size_(0) {}
+  ByteSpan(const char* data, size_t size) : data_(data), size_(size) {}
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const char* begin() const { return data_; }
+  const char* end() const { return data_ + size_; }
+  char operator[](size_t i) const { return data_[i]; }
+
+  // The bytes from |pos| to |pos| + |len|.
+  ByteSpan substr(size_t pos, size_t len) const {
+    return ByteSpan(data_ + pos, len);
+  }
+
+  // Copies the bytes out.
+  string str() const { return string(data_, size_); }
+
+ private:
+  const char* data_;
+  size_t size_;
+};
+
 inline void insert_i16(string& dest, int dpos, const int i16) {
   dest[dpos++] = i16 & 0xff;
   dest[dpos]   = (i16 >> 8) & 0xff;
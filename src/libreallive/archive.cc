@@ -47,7 +47,12 @@ namespace fs = boost::filesystem;
 namespace libreallive {
 
 Archive::Archive(const std::string& filename)
-    : name_(filename), info_(filename, Read), second_level_xor_key_(NULL) {
+    : name_(filename),
+      info_(filename, Read),
+      second_level_xor_key_(NULL),
+      prepare_display_text_(false),
+      parameter_parser_(NULL),
+      parser_thread_count_(1) {
   ReadTOC();
   ReadOverrides();
 }
@@ -56,7 +61,10 @@ Archive::Archive(const std::string& filename, const std::string& regname)
     : name_(filename),
       info_(filename, Read),
       second_level_xor_key_(NULL),
-      regname_(regname) {
+      regname_(regname),
+      prepare_display_text_(false),
+      parameter_parser_(NULL),
+      parser_thread_count_(1) {
   ReadTOC();
   ReadOverrides();
 
@@ -102,12 +110,25 @@ Scenario* Archive::GetScenario(int index) {
   if (st != scenarios_.end()) {
     Scenario* scene =
         new Scenario(st->second, index, regname_, second_level_xor_key_);
+    if (prepare_display_text_)
+      scene->PrepareDisplayText();
+    if (parameter_parser_)
+      scene->PreparseParameters(*parameter_parser_, parser_thread_count_);
     accessed_[index].reset(scene);
     return scene;
   }
   return NULL;
 }
 
+void Archive::SetParameterParser(ParameterParser* parser, int thread_count) {
+  parameter_parser_ = parser;
+  parser_thread_count_ = thread_count;
+  if (parameter_parser_) {
+    for (auto const& scene : accessed_)
+      scene.second->PreparseParameters(*parameter_parser_, thread_count);
+  }
+}
+
 int Archive::GetProbableEncodingType() const {
   // Directly create Header objects instead of Scenarios. We don't want to
   // parse the entire SEEN file here.
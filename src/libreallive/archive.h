@@ -67,6 +67,15 @@ class Archive {
   // Returns a specific scenario by |index| number or NULL if none exist.
   Scenario* GetScenario(int index);
 
+  // Whether scenarios convert their text for display as they are loaded.
+  // Defaults to off.
+  void set_prepare_display_text(bool in) { prepare_display_text_ = in; }
+
+  // Parses the parameters of every command in a scenario with |parser| as the
+  // scenario is loaded, on |thread_count| threads. Scenarios that are already
+  // loaded are parsed immediately. Pass NULL to stop. Does not take ownership.
+  void SetParameterParser(ParameterParser* parser, int thread_count);
+
   // Does a quick pass through all scenarios in the archive, looking for any
   // with non-default encoding. This short circuits when it finds one.
   int GetProbableEncodingType() const;
@@ -94,6 +103,13 @@ class Archive {
   // The #REGNAME key from the Gameexe.ini file. Passed down to Scenario for
   // prettier error messages.
   std::string regname_;
+
+  // Whether GetScenario() calls Scenario::PrepareDisplayText().
+  bool prepare_display_text_;
+
+  // If set, GetScenario() pre-parses command parameters with this.
+  ParameterParser* parameter_parser_;
+  int parser_thread_count_;
 };
 
 }  // namespace libreallive
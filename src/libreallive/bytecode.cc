@@ -33,6 +33,8 @@
 
 #include "libreallive/bytecode.h"
 
+#include <boost/algorithm/string/predicate.hpp>
+
 #include <cassert>
 #include <cstring>
 #include <exception>
@@ -46,6 +48,8 @@
 #include "libreallive/expression.h"
 
 #include "machine/rlmachine.h"
+#include "systems/base/text_system.h"
+#include "utilities/string_utilities.h"
 
 namespace libreallive {
 
@@ -106,14 +110,25 @@ inline BytecodeElement* ReadFunction(const char* stream,
   return BuildFunctionElement(stream);
 }
 
+const char seen_end[] = {130, 114,  // S
+                         130, 133,  // e
+                         130, 133,  // e
+                         130, 142,  // n
+                         130, 100,  // E
+                         130, 142,  // n
+                         130, 132   // d
+};
+
 }  // namespace
 
+const std::string SeenEnd(seen_end, 14);
+
 char BytecodeElement::entrypoint_marker = '@';
 
 CommandElement* BuildFunctionElement(const char* stream) {
   const char* ptr = stream;
   ptr += 8;
-  std::vector<std::string> params;
+  std::vector<ByteSpan> params;
   if (*ptr == '(') {
     const char* end = ptr + 1;
     while (*end != ')') {
@@ -132,24 +147,24 @@ CommandElement* BuildFunctionElement(const char* stream) {
 }
 
 void PrintParameterString(std::ostream& oss,
-                          const std::vector<std::string>& parameters) {
+                          const std::vector<ByteSpan>& parameters) {
   bool first = true;
   oss << "(";
-  for (std::string const& param : parameters) {
+  for (ByteSpan const& param : parameters) {
     if (!first) {
       oss << ", ";
     }
     first = false;
 
     // Take the binary stuff and try to get usefull, printable values.
-    const char* start = param.c_str();
+    const char* start = param.data();
     try {
       ExpressionPiece piece(GetData(start));
       oss << piece.GetDebugString();
     }
     catch (libreallive::Error& e) {
       // Any error throw here is a parse error.
-      oss << "{RAW : " << ParsableToPrintableString(param) << "}";
+      oss << "{RAW : " << ParsableToPrintableString(param.str()) << "}";
     }
   }
   oss << ")";
@@ -208,6 +223,8 @@ string BytecodeElement::GetSerializedCommand(RLMachine& machine) const {
       "FunctionElements");
 }
 
+void BytecodeElement::PrepareDisplayText(int encoding) {}
+
 void BytecodeElement::RunOnMachine(RLMachine& machine) const {
   machine.AdvanceInstructionPointer();
 }
@@ -319,7 +336,7 @@ TextoutElement::TextoutElement(const char* src, const char* file_end) {
     else
       ++end;
   }
-  repr.assign(src, end);
+  repr = ByteSpan(src, end - src);
 }
 
 TextoutElement::~TextoutElement() {}
@@ -327,8 +344,8 @@ TextoutElement::~TextoutElement() {}
 const string TextoutElement::GetText() const {
   string rv;
   bool quoted = false;
-  string::const_iterator it = repr.cbegin();
-  while (it != repr.cend()) {
+  const char* it = repr.begin();
+  while (it != repr.end()) {
     if (*it == '"') {
       ++it;
       quoted = !quoted;
@@ -355,6 +372,16 @@ void TextoutElement::PrintSourceRepresentation(std::ostream& oss) const {
 
 const size_t TextoutElement::GetBytecodeLength() const { return repr.size(); }
 
+void TextoutElement::PrepareDisplayText(int encoding) {
+  // Text with names in it depends on the contents of memory when it is shown,
+  // and the end of the scenario isn't displayed at all.
+  string text = GetText();
+  if (boost::starts_with(text, SeenEnd) || HasNameReferences(text))
+    return;
+
+  display_text_.reset(new DisplayText(cp932toUTF8(text, encoding)));
+}
+
 void TextoutElement::RunOnMachine(RLMachine& machine) const {
   machine.PerformTextout(*this);
   machine.AdvanceInstructionPointer();
@@ -407,9 +434,10 @@ CommandElement::CommandElement(const char* src) { memcpy(command, src, 8); }
 
 CommandElement::~CommandElement() {}
 
-std::vector<std::string> CommandElement::GetUnparsedParameters() const {
-  std::vector<std::string> parameters;
+std::vector<ByteSpan> CommandElement::GetUnparsedParameters() const {
+  std::vector<ByteSpan> parameters;
   size_t param_count = GetParamCount();
+  parameters.reserve(param_count);
   for (size_t i = 0; i < param_count; ++i)
     parameters.push_back(GetParam(i));
   return parameters;
@@ -434,7 +462,7 @@ pointer_t CommandElement::GetPointer(int i) const { return pointer_t(); }
 
 const size_t CommandElement::GetCaseCount() const { return 0; }
 
-const string CommandElement::GetCase(int i) const { return ""; }
+ByteSpan CommandElement::GetCase(int i) const { return ByteSpan(); }
 
 void CommandElement::PrintSourceRepresentation(std::ostream& oss) const {
   oss << "op<" << modtype() << ":" << std::setw(3) << std::setfill('0')
@@ -457,14 +485,11 @@ void CommandElement::RunOnMachine(RLMachine& machine) const {
 
 SelectElement::SelectElement(const char* src)
     : CommandElement(src), uselessjunk(0) {
-  repr.assign(src, 8);
-
+  const char* start = src;
   src += 8;
-  if (*src == '(') {
-    const int elen = NextExpression(src);
-    repr.append(src, elen);
-    src += elen;
-  }
+  if (*src == '(')
+    src += NextExpression(src);
+  repr = ByteSpan(start, src - start);
 
   if (*src++ != '{')
     throw Error("SelectElement(): expected `{'");
@@ -489,7 +514,7 @@ SelectElement::SelectElement(const char* src)
         Condition c;
         if (*src == '(') {
           int len = NextExpression(src);
-          c.condition = string(src, len);
+          c.condition = ByteSpan(src, len);
           src += len;
         }
         bool seekarg = *src != '2' && *src != '3';
@@ -497,7 +522,7 @@ SelectElement::SelectElement(const char* src)
         ++src;
         if (seekarg && *src != ')' && (*src < '0' || *src > '9')) {
           int len = NextExpression(src);
-          c.effect_argument = string(src, len);
+          c.effect_argument = ByteSpan(src, len);
           src += len;
         }
         cond_parsed.push_back(c);
@@ -538,8 +563,8 @@ SelectElement::SelectElement(const char* src)
 SelectElement::~SelectElement() {}
 
 ExpressionPiece SelectElement::GetWindowExpression() const {
-  if (repr[8] == '(') {
-    const char* location = repr.c_str() + 9;
+  if (repr.size() > 8 && repr[8] == '(') {
+    const char* location = repr.data() + 9;
     return GetExpression(location);
   }
   return ExpressionPiece::IntConstant(-1);
@@ -547,10 +572,10 @@ ExpressionPiece SelectElement::GetWindowExpression() const {
 
 const size_t SelectElement::GetParamCount() const { return params.size(); }
 
-string SelectElement::GetParam(int i) const {
-  string rv(params[i].cond_text);
-  rv.append(params[i].text);
-  return rv;
+ByteSpan SelectElement::GetParam(int i) const {
+  // The condition is immediately followed by the text.
+  return ByteSpan(params[i].cond_text.data(),
+                  params[i].cond_text.size() + params[i].text.size());
 }
 
 const size_t SelectElement::GetBytecodeLength() const {
@@ -566,7 +591,7 @@ const size_t SelectElement::GetBytecodeLength() const {
 // -----------------------------------------------------------------------
 
 FunctionElement::FunctionElement(const char* src,
-                                 const std::vector<string>& params)
+                                 const std::vector<ByteSpan>& params)
     : CommandElement(src), params(params) {}
 
 FunctionElement::~FunctionElement() {}
@@ -578,19 +603,19 @@ const size_t FunctionElement::GetParamCount() const {
   // dropping the parameter will put the stream cursor in the wrong place), so
   // hack this here.
   if (!params.empty()) {
-    string final = params.back();
+    const ByteSpan& final = params.back();
     if (final.size() == 3 && final[0] == '\n')
       return params.size() - 1;
   }
   return params.size();
 }
 
-string FunctionElement::GetParam(int i) const { return params[i]; }
+ByteSpan FunctionElement::GetParam(int i) const { return params[i]; }
 
 const size_t FunctionElement::GetBytecodeLength() const {
   if (params.size() > 0) {
     size_t rv(COMMAND_SIZE + 2);
-    for (std::string const& param : params)
+    for (ByteSpan const& param : params)
       rv += param.size();
     return rv;
   } else {
@@ -604,8 +629,8 @@ std::string FunctionElement::GetSerializedCommand(RLMachine& machine) const {
     rv.push_back(command[i]);
   if (params.size() > 0) {
     rv.push_back('(');
-    for (string const& param : params) {
-      const char* data = param.c_str();
+    for (ByteSpan const& param : params) {
+      const char* data = param.data();
       ExpressionPiece expression(GetData(data));
       rv.append(expression.GetSerializedExpression(machine));
     }
@@ -625,7 +650,7 @@ VoidFunctionElement::~VoidFunctionElement() {}
 
 const size_t VoidFunctionElement::GetParamCount() const { return 0; }
 
-string VoidFunctionElement::GetParam(int i) const { return std::string(); }
+ByteSpan VoidFunctionElement::GetParam(int i) const { return ByteSpan(); }
 
 const size_t VoidFunctionElement::GetBytecodeLength() const {
   return COMMAND_SIZE;
@@ -644,15 +669,15 @@ std::string VoidFunctionElement::GetSerializedCommand(RLMachine& machine)
 // -----------------------------------------------------------------------
 
 SingleArgFunctionElement::SingleArgFunctionElement(const char* src,
-                                                   const std::string& arg)
+                                                   const ByteSpan& arg)
     : CommandElement(src), arg_(arg) {}
 
 SingleArgFunctionElement::~SingleArgFunctionElement() {}
 
 const size_t SingleArgFunctionElement::GetParamCount() const { return 1; }
 
-string SingleArgFunctionElement::GetParam(int i) const {
-  return i == 0 ? arg_ : std::string();
+ByteSpan SingleArgFunctionElement::GetParam(int i) const {
+  return i == 0 ? arg_ : ByteSpan();
 }
 
 const size_t SingleArgFunctionElement::GetBytecodeLength() const {
@@ -665,7 +690,7 @@ std::string SingleArgFunctionElement::GetSerializedCommand(RLMachine& machine)
   for (int i = 0; i < COMMAND_SIZE; ++i)
     rv.push_back(command[i]);
   rv.push_back('(');
-  const char* data = arg_.c_str();
+  const char* data = arg_.data();
   ExpressionPiece expression(GetData(data));
   rv.append(expression.GetSerializedExpression(machine));
   rv.push_back(')');
@@ -706,7 +731,7 @@ const size_t GotoElement::GetParamCount() const {
   return 0;
 }
 
-string GotoElement::GetParam(int i) const { return std::string(); }
+ByteSpan GotoElement::GetParam(int i) const { return ByteSpan(); }
 
 const size_t GotoElement::GetPointersCount() const { return 1; }
 
@@ -729,18 +754,15 @@ void GotoElement::SetPointers(ConstructionData& cdata) {
 
 GotoIfElement::GotoIfElement(const char* src, ConstructionData& cdata)
     : CommandElement(src) {
-  repr.assign(src, 8);
+  const char* start = src;
   src += 8;
 
   if (*src++ != '(')
     throw Error("GotoIfElement(): expected `('");
-  int expr = NextExpression(src);
-  repr.push_back('(');
-  repr.append(src, expr);
-  repr.push_back(')');
-  src += expr;
+  src += NextExpression(src);
   if (*src++ != ')')
     throw Error("GotoIfElement(): expected `)'");
+  repr = ByteSpan(start, src - start);
 
   id_ = read_i32(src);
 }
@@ -752,10 +774,10 @@ const size_t GotoIfElement::GetParamCount() const {
   return repr.size() == 8 ? 0 : 1;
 }
 
-string GotoIfElement::GetParam(int i) const {
-  return i == 0
-             ? (repr.size() == 8 ? string() : repr.substr(9, repr.size() - 10))
-             : string();
+ByteSpan GotoIfElement::GetParam(int i) const {
+  return i == 0 ? (repr.size() == 8 ? ByteSpan()
+                                    : repr.substr(9, repr.size() - 10))
+                : ByteSpan();
 }
 
 const size_t GotoIfElement::GetPointersCount() const { return 1; }
@@ -781,12 +803,11 @@ void GotoIfElement::SetPointers(ConstructionData& cdata) {
 
 GotoCaseElement::GotoCaseElement(const char* src, ConstructionData& cdata)
     : PointerElement(src) {
-  repr.assign(src, 8);
+  const char* start = src;
   src += 8;
   // Condition
-  const int expr = NextExpression(src);
-  repr.append(src, expr);
-  src += expr;
+  src += NextExpression(src);
+  repr = ByteSpan(start, src - start);
   // Cases
   if (*src++ != '{')
     throw Error("GotoCaseElement(): expected `{'");
@@ -797,7 +818,7 @@ GotoCaseElement::GotoCaseElement(const char* src, ConstructionData& cdata)
     if (src[0] != '(')
       throw Error("GotoCaseElement(): expected `('");
     if (src[1] == ')') {
-      cases.push_back("()");
+      cases.emplace_back(src, 2);
       src += 2;
     } else {
       int cexpr = NextExpression(src + 1);
@@ -820,13 +841,13 @@ const size_t GotoCaseElement::GetParamCount() const {
   return 1;
 }
 
-string GotoCaseElement::GetParam(int i) const {
-  return i == 0 ? repr.substr(8, repr.size() - 8) : string();
+ByteSpan GotoCaseElement::GetParam(int i) const {
+  return i == 0 ? repr.substr(8, repr.size() - 8) : ByteSpan();
 }
 
 const size_t GotoCaseElement::GetCaseCount() const { return cases.size(); }
 
-const string GotoCaseElement::GetCase(int i) const { return cases[i]; }
+ByteSpan GotoCaseElement::GetCase(int i) const { return cases[i]; }
 
 const size_t GotoCaseElement::GetBytecodeLength() const {
   size_t rv = repr.size() + 2;
@@ -841,12 +862,11 @@ const size_t GotoCaseElement::GetBytecodeLength() const {
 
 GotoOnElement::GotoOnElement(const char* src, ConstructionData& cdata)
     : PointerElement(src) {
-  repr.assign(src, 8);
+  const char* start = src;
   src += 8;
   // Condition
-  const int expr = NextExpression(src);
-  repr.append(src, expr);
-  src += expr;
+  src += NextExpression(src);
+  repr = ByteSpan(start, src - start);
   // Pointers
   if (*src++ != '{')
     throw Error("GotoOnElement(): expected `{'");
@@ -864,8 +884,8 @@ GotoOnElement::~GotoOnElement() {}
 
 const size_t GotoOnElement::GetParamCount() const { return 1; }
 
-string GotoOnElement::GetParam(int i) const {
-  return i == 0 ? repr.substr(8, repr.size() - 8) : string();
+ByteSpan GotoOnElement::GetParam(int i) const {
+  return i == 0 ? repr.substr(8, repr.size() - 8) : ByteSpan();
 }
 
 const size_t GotoOnElement::GetBytecodeLength() const {
@@ -904,7 +924,7 @@ const size_t GosubWithElement::GetParamCount() const {
   return params.size();
 }
 
-string GosubWithElement::GetParam(int i) const { return params[i]; }
+ByteSpan GosubWithElement::GetParam(int i) const { return params[i]; }
 
 const size_t GosubWithElement::GetPointersCount() const { return 1; }
 
@@ -36,6 +36,7 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -44,16 +45,21 @@
 #include "libreallive/expression.h"
 
 class RLMachine;
+struct DisplayText;
 
 namespace libreallive {
 
+// Seen files are terminated with the string "SeenEnd", which isn't NULL
+// terminated and has a bunch of random garbage after it.
+extern const std::string SeenEnd;
+
 class CommandElement;
 
 // Returns a representation of the non-special cased function.
 CommandElement* BuildFunctionElement(const char* stream);
 
 void PrintParameterString(std::ostream& oss,
-                          const std::vector<std::string>& paramseters);
+                          const std::vector<ByteSpan>& paramseters);
 
 struct ConstructionData {
   ConstructionData(size_t kt, pointer_t pt);
@@ -116,6 +122,10 @@ class BytecodeElement {
   // other cases.
   virtual string GetSerializedCommand(RLMachine& machine) const;
 
+  // Fat interface: lets TextoutElement convert its text for display when the
+  // scenario is loaded. Does nothing in all other cases.
+  virtual void PrepareDisplayText(int encoding);
+
   // Execute this bytecode instruction on this virtual machine
   virtual void RunOnMachine(RLMachine& machine) const;
 
@@ -172,13 +182,20 @@ class TextoutElement : public BytecodeElement {
 
   const string GetText() const;
 
+  // The text already converted to UTF-8 by PrepareDisplayText(), or NULL if
+  // it has to be converted when it is displayed.
+  const DisplayText* display_text() const { return display_text_.get(); }
+
   // Overridden from BytecodeElement::
   virtual void PrintSourceRepresentation(std::ostream& oss) const final;
   virtual const size_t GetBytecodeLength() const final;
+  virtual void PrepareDisplayText(int encoding) final;
   virtual void RunOnMachine(RLMachine& machine) const final;
 
  private:
-  string repr;
+  ByteSpan repr;
+
+  std::unique_ptr<DisplayText> display_text_;
 };
 
 // Expression elements.
@@ -222,8 +239,8 @@ class CommandElement : public BytecodeElement {
   const int argc()     const { return command[5] | (command[6] << 8); }
   const int overload() const { return command[7]; }
 
-  // Returns the raw byte strings of this command elements parameters.
-  std::vector<string> GetUnparsedParameters() const;
+  // Returns the raw bytes of this command elements parameters.
+  std::vector<ByteSpan> GetUnparsedParameters() const;
 
   // Whether the RLOperation has cached the parsed versions of the parameters.
   bool AreParametersParsed() const;
@@ -234,7 +251,7 @@ class CommandElement : public BytecodeElement {
 
   // Returns the number of parameters.
   virtual const size_t GetParamCount() const = 0;
-  virtual string GetParam(int index) const = 0;
+  virtual ByteSpan GetParam(int index) const = 0;
 
   // Methods that deal with pointers.
   virtual const size_t GetPointersCount() const;
@@ -242,7 +259,7 @@ class CommandElement : public BytecodeElement {
 
   // Fat interface stuff for GotoCase. Prevents casting, etc.
   virtual const size_t GetCaseCount() const;
-  virtual const string GetCase(int i) const;
+  virtual ByteSpan GetCase(int i) const;
 
   // Overridden from BytecodeElement:
   virtual void PrintSourceRepresentation(std::ostream& oss) const final;
@@ -264,15 +281,15 @@ class SelectElement : public CommandElement {
   static const int OPTION_CURSOR = 0x34;
 
   struct Condition {
-    string condition;
+    ByteSpan condition;
     uint8_t effect;
-    string effect_argument;
+    ByteSpan effect_argument;
   };
 
   struct Param {
     std::vector<Condition> cond_parsed;
-    string cond_text;
-    string text;
+    ByteSpan cond_text;
+    ByteSpan text;
     int line;
     Param() : cond_text(), text(), line(0) {}
     Param(const char* tsrc, const size_t tlen, const int lnum)
@@ -296,13 +313,13 @@ class SelectElement : public CommandElement {
 
   // Overridden from CommandElement:
   virtual const size_t GetParamCount() const final;
-  virtual string GetParam(int i) const final;
+  virtual ByteSpan GetParam(int i) const final;
 
   // Overridden from BytecodeElement:
   virtual const size_t GetBytecodeLength() const final;
 
  private:
-  string repr;
+  ByteSpan repr;
   params_t params;
   int firstline;
   int uselessjunk;
@@ -310,19 +327,19 @@ class SelectElement : public CommandElement {
 
 class FunctionElement : public CommandElement {
  public:
-  FunctionElement(const char* src, const std::vector<string>& params);
+  FunctionElement(const char* src, const std::vector<ByteSpan>& params);
   virtual ~FunctionElement();
 
   // Overridden from CommandElement:
   virtual const size_t GetParamCount() const final;
-  virtual string GetParam(int i) const final;
+  virtual ByteSpan GetParam(int i) const final;
 
   // Overridden from BytecodeElement:
   virtual const size_t GetBytecodeLength() const final;
   virtual string GetSerializedCommand(RLMachine& machine) const final;
 
  private:
-  std::vector<string> params;
+  std::vector<ByteSpan> params;
 };
 
 class VoidFunctionElement : public CommandElement {
@@ -332,7 +349,7 @@ class VoidFunctionElement : public CommandElement {
 
   // Overridden from CommandElement:
   virtual const size_t GetParamCount() const final;
-  virtual string GetParam(int i) const final;
+  virtual ByteSpan GetParam(int i) const final;
 
   // Overridden from BytecodeElement:
   virtual const size_t GetBytecodeLength() const final;
@@ -341,20 +358,19 @@ class VoidFunctionElement : public CommandElement {
 
 class SingleArgFunctionElement : public CommandElement {
  public:
-  SingleArgFunctionElement(const char* src,
-                           const std::string& arg);
+  SingleArgFunctionElement(const char* src, const ByteSpan& arg);
   virtual ~SingleArgFunctionElement();
 
   // Overridden from CommandElement:
   virtual const size_t GetParamCount() const final;
-  virtual string GetParam(int i) const final;
+  virtual ByteSpan GetParam(int i) const final;
 
   // Overridden from BytecodeElement:
   virtual const size_t GetBytecodeLength() const final;
   virtual string GetSerializedCommand(RLMachine& machine) const final;
 
  private:
-  std::string arg_;
+  ByteSpan arg_;
 };
 
 class PointerElement : public CommandElement {
@@ -380,7 +396,7 @@ class GotoElement : public CommandElement {
 
   // Overridden from CommandElement:
   virtual const size_t GetParamCount() const final;
-  virtual string GetParam(int i) const final;
+  virtual ByteSpan GetParam(int i) const final;
   virtual const size_t GetPointersCount() const final;
   virtual pointer_t GetPointer(int i) const final;
 
@@ -400,7 +416,7 @@ class GotoIfElement : public CommandElement {
 
   // Overridden from CommandElement:
   virtual const size_t GetParamCount() const final;
-  virtual string GetParam(int i) const final;
+  virtual ByteSpan GetParam(int i) const final;
   virtual const size_t GetPointersCount() const final;
   virtual pointer_t GetPointer(int i) const final;
 
@@ -411,7 +427,7 @@ class GotoIfElement : public CommandElement {
  private:
   unsigned long id_;
   pointer_t pointer_;
-  string repr;
+  ByteSpan repr;
 };
 
 class GotoCaseElement : public PointerElement {
@@ -421,16 +437,16 @@ class GotoCaseElement : public PointerElement {
 
   // Overridden from CommandElement:
   virtual const size_t GetParamCount() const final;
-  virtual string GetParam(int i) const final;
+  virtual ByteSpan GetParam(int i) const final;
   virtual const size_t GetCaseCount() const final;
-  virtual const string GetCase(int i) const final;
+  virtual ByteSpan GetCase(int i) const final;
 
   // Overridden from BytecodeElement:
   virtual const size_t GetBytecodeLength() const final;
 
  private:
-  string repr;
-  std::vector<string> cases;
+  ByteSpan repr;
+  std::vector<ByteSpan> cases;
 };
 
 class GotoOnElement : public PointerElement {
@@ -440,13 +456,13 @@ class GotoOnElement : public PointerElement {
 
   // Overridden from CommandElement:
   virtual const size_t GetParamCount() const final;
-  virtual string GetParam(int i) const final;
+  virtual ByteSpan GetParam(int i) const final;
 
   // Overridden from BytecodeElement:
   virtual const size_t GetBytecodeLength() const final;
 
  private:
-  string repr;
+  ByteSpan repr;
 };
 
 class GosubWithElement : public CommandElement {
@@ -456,7 +472,7 @@ class GosubWithElement : public CommandElement {
 
   // Overridden from CommandElement:
   virtual const size_t GetParamCount() const final;
-  virtual string GetParam(int i) const final;
+  virtual ByteSpan GetParam(int i) const final;
   virtual const size_t GetPointersCount() const final;
   virtual pointer_t GetPointer(int i) const final;
 
@@ -468,7 +484,7 @@ class GosubWithElement : public CommandElement {
   unsigned long id_;
   pointer_t pointer_;
   int repr_size;
-  std::vector<string> params;
+  std::vector<ByteSpan> params;
 };
 
 }  // namespace libreallive
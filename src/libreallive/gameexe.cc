@@ -34,97 +34,112 @@
 
 #include "libreallive/gameexe.h"
 
-#include <boost/tokenizer.hpp>
 #include <boost/algorithm/string.hpp>
-#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
 #include <iostream>
-#include <fstream>
 #include <iomanip>
 
 #include "libreallive/defs.h"
+#include "libreallive/filemap.h"
 
 namespace fs = boost::filesystem;
 
-#define is_space(c) (c == '\r' || c == '\n' || c == ' ' || c == '\t')
-#define is_num(c) (c == '-' || (c >= '0' && c <= '9'))
-#define is_data(c) (c == '"' || is_num(c))
+namespace {
 
-// A boost::TokenizerFunction used to extract valid pieces of data
-// from the value part of a gameexe key/value pair.
-class gameexe_token_extractor {
- public:
-  void reset() {}
+inline bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' ||
+         c == '\f';
+}
 
-  template <typename InputIterator, typename Token>
-  bool operator()(InputIterator& next, InputIterator end, Token& tok) {
-    tok = Token();
-    // Advance to the next data character
-    for (; next != end && (!is_data(*next)); ++next) {}
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
 
-    if (next == end)
-      return false;
+inline bool IsNum(char c) { return c == '-' || IsDigit(c); }
 
-    if (*next == '"') {
-      tok += '"';
-      next++;
-      for (; next != end && *next != '"'; ++next)
-        tok += *next;
-      tok += '"';
-      next++;
-    } else {
-      char lastChar = '\0';
-
-      // Eat the current character and all
-      while (next != end) {
-        if (*next == '-') {
-          // Dashes are ambiguous. They are both seperators and the negative
-          // sign and we have to tokenize differently based on what it's
-          // doing. If the previous character is a number, we are being used as
-          // a range separator.
-          if (lastChar >= '0' && lastChar <= '9') {
-            // Skip the dash so we don't treat the next number as negative.
-            next++;
-            break;
-          } else {
-            // Consume the dash for the next parts.
-            tok += *next;
-          }
-        } else if (is_num(*next)) {
-          // All other numbers are consumed here.
-          tok += *next;
-        } else {
-          // We only deal with numbers in this branch.
-          break;
-        }
-
-        lastChar = *next;
-        ++next;
-      }
-    }
+// Narrows [*begin, *end) to exclude leading and trailing whitespace.
+void Trim(const char** begin, const char** end) {
+  while (*begin != *end && IsSpace(**begin))
+    ++*begin;
+  while (*end != *begin && IsSpace(*(*end - 1)))
+    --*end;
+}
+
+// Converts a numeric token: a run of dashes followed by a run of digits. A
+// lone dash is a separator and yields nothing. Tokens that aren't a single
+// optional minus sign followed by an int are reported and stored as 0.
+bool ConvertNumber(const char* begin, const char* end, int* out) {
+  const char* digits = begin;
+  while (digits != end && *digits == '-')
+    ++digits;
+  size_t dashes = digits - begin;
+  if (dashes == 1 && digits == end)
+    return false;
+
+  bool valid = dashes <= 1 && digits != end;
+  int64_t limit = static_cast<int64_t>(INT32_MAX) + dashes;
+  int64_t value = 0;
+  for (const char* c = digits; valid && c != end; ++c) {
+    value = value * 10 + (*c - '0');
+    if (value > limit)
+      valid = false;
+  }
 
-    return true;
+  if (!valid) {
+    std::cerr << "Couldn't int-ify '" << std::string(begin, end) << "'"
+              << std::endl;
+    *out = 0;
+  } else {
+    *out = static_cast<int>(dashes ? -value : value);
   }
-};
+  return true;
+}
+
+}  // namespace
 
 // -----------------------------------------------------------------------
 
-Gameexe::Gameexe() {}
+const GameexeKeyId Gameexe::NO_KEY;
+const GameexeKeyId Gameexe::ROOT_KEY;
+const uint64_t Gameexe::INT_PART;
+const uintmax_t Gameexe::MIN_MAPPED_SIZE;
+
+// -----------------------------------------------------------------------
+
+Gameexe::Gameexe() : child_count_(0) {
+  KeyNode root = {NO_KEY, 0, data_.end()};
+  nodes_.push_back(root);
+}
 
 // -----------------------------------------------------------------------
 
-Gameexe::Gameexe(const fs::path& gameexefile) : data_(), cdata_() {
-  fs::ifstream ifs(gameexefile);
-  if (!ifs) {
+Gameexe::Gameexe(const fs::path& gameexefile) : Gameexe() {
+  boost::system::error_code ec;
+  uintmax_t size = fs::file_size(gameexefile, ec);
+  if (ec) {
     std::ostringstream oss;
     oss << "Could not find Gameexe.ini file! (Looking in " << gameexefile
         << ")";
     throw libreallive::Error(oss.str());
   }
 
-  std::string line;
-  while (std::getline(ifs, line)) {
-    parseLine(line);
+  // Setting up a mapping costs more than reading a typical Gameexe.ini, so
+  // only large files are mapped.
+  if (size >= MIN_MAPPED_SIZE) {
+    libreallive::Mapping mapping(gameexefile.string(), libreallive::Read);
+    ParseBuffer(mapping.get(), mapping.get() + mapping.size());
+  } else {
+    std::vector<char> buffer(size);
+    FILE* f = fopen(gameexefile.string().c_str(), "rb");
+    if (f) {
+      buffer.resize(fread(buffer.data(), 1, size, f));
+      fclose(f);
+    }
+    ParseBuffer(buffer.data(), buffer.data() + buffer.size());
   }
 }
 
@@ -133,39 +148,87 @@ Gameexe::~Gameexe() {}
 // -----------------------------------------------------------------------
 
 void Gameexe::parseLine(const std::string& line) {
-  size_t firstHash = line.find_first_of('#');
-  if (firstHash != std::string::npos) {
-    // Extract what's the key and value
-    size_t firstEqual = line.find_first_of('=');
-    std::string key = line.substr(firstHash + 1, firstEqual - firstHash - 1);
-    std::string value = line.substr(firstEqual + 1);
-
-    // Get rid of extra whitespace
-    boost::trim(key);
-    boost::trim(value);
-
-    Gameexe_vec_type vec;
-
-    // Extract all numeric and data values from the value
-    typedef boost::tokenizer<gameexe_token_extractor> ValueTokenizer;
-    ValueTokenizer tokenizer(value);
-    for (const std::string& tok : tokenizer) {
-      if (tok[0] == '"') {
-        std::string unquoted = tok.substr(1, tok.size() - 2);
-        cdata_.push_back(unquoted);
-        vec.push_back(cdata_.size() - 1);
-      } else if (tok != "-") {
-        try {
-          vec.push_back(std::stoi(tok));
-        }
-        catch (...) {
-          std::cerr << "Couldn't int-ify '" << tok << "'" << std::endl;
-          vec.push_back(0);
-        }
-      }
+  ParseLine(line.data(), line.data() + line.size());
+}
+
+// -----------------------------------------------------------------------
+
+void Gameexe::ParseBuffer(const char* begin, const char* end) {
+  // Most lines define a key with two or three parts.
+  size_t lines = std::count(begin, end, '\n') + 1;
+  nodes_.reserve(nodes_.size() + lines * 2);
+
+  while (begin != end) {
+    const char* eol =
+        static_cast<const char*>(memchr(begin, '\n', end - begin));
+    if (!eol)
+      eol = end;
+    ParseLine(begin, eol);
+    begin = eol == end ? end : eol + 1;
+  }
+}
+
+// -----------------------------------------------------------------------
+
+void Gameexe::ParseLine(const char* begin, const char* end) {
+  const char* hash =
+      static_cast<const char*>(memchr(begin, '#', end - begin));
+  if (!hash)
+    return;
+
+  // The key runs from the hash to the first equals sign on the line, and the
+  // value is everything after that sign. Lines without one are treated as
+  // all value.
+  const char* equal =
+      static_cast<const char*>(memchr(begin, '=', end - begin));
+  const char* key_begin = hash + 1;
+  const char* key_end = (equal && equal > hash) ? equal : end;
+  const char* value = equal ? equal + 1 : begin;
+  Trim(&key_begin, &key_end);
+  std::string key(key_begin, key_end);
+
+  // Extract all numeric and data values from the value.
+  Gameexe_vec_type vec;
+  const char* c = value;
+  while (true) {
+    while (c != end && *c != '"' && !IsNum(*c))
+      ++c;
+    if (c == end)
+      break;
+
+    if (*c == '"') {
+      const char* str_begin = ++c;
+      while (c != end && *c != '"')
+        ++c;
+      cdata_.emplace_back(str_begin, c);
+      vec.push_back(cdata_.size() - 1);
+      if (c != end)
+        ++c;
+    } else {
+      // Dashes are ambiguous. They are both separators and the negative sign.
+      // A dash directly after a digit is a range separator; skip it so the
+      // next number isn't read as negative.
+      const char* tok_begin = c;
+      while (c != end && *c == '-')
+        ++c;
+      while (c != end && IsDigit(*c))
+        ++c;
+      const char* tok_end = c;
+      if (c != end && *c == '-' && tok_end != tok_begin &&
+          IsDigit(*(tok_end - 1)))
+        ++c;
+
+      int number;
+      if (ConvertNumber(tok_begin, tok_end, &number))
+        vec.push_back(number);
     }
-    data_.emplace(key, vec);
   }
+
+  GameexeKeyId id = InternKey(key);
+  GameexeData_t::const_iterator it = data_.emplace(std::move(key), vec);
+  KeyNode& node = nodes_[id];
+  if (node.value == data_.end())
+    node.value = it;
 }
 
 // -----------------------------------------------------------------------
@@ -208,8 +271,7 @@ void Gameexe::SetStringAt(const std::string& key, const std::string& value) {
   Gameexe_vec_type toStore;
   cdata_.push_back(value);
   toStore.push_back(cdata_.size() - 1);
-  data_.erase(key);
-  data_.emplace(key, toStore);
+  SetValue(key, toStore);
 }
 
 // -----------------------------------------------------------------------
@@ -217,25 +279,223 @@ void Gameexe::SetStringAt(const std::string& key, const std::string& value) {
 void Gameexe::SetIntAt(const std::string& key, const int value) {
   Gameexe_vec_type toStore;
   toStore.push_back(value);
+  SetValue(key, toStore);
+}
+
+// -----------------------------------------------------------------------
+
+void Gameexe::SetValue(const std::string& key, const Gameexe_vec_type& value) {
   data_.erase(key);
-  data_.emplace(key, toStore);
+  GameexeData_t::const_iterator it = data_.emplace(key, value);
+  nodes_[InternKey(key)].value = it;
 }
 
 // -----------------------------------------------------------------------
 
 GameexeData_t::const_iterator Gameexe::Find(const std::string& key) {
-  return data_.find(key);
+  GameexeKeyId node = ROOT_KEY;
+  if (Descend(&node, key))
+    return nodes_[node].value;
+  return data_.end();
+}
+
+// -----------------------------------------------------------------------
+
+// static
+bool Gameexe::ParseIntPart(const std::string& key,
+                           size_t begin,
+                           size_t end,
+                           int* value) {
+  // AddToStream() pads to three digits, so "001" and "1000" are integers but
+  // "01", "0001" and "1e3" are strings. Nine digits keeps us in range of int;
+  // longer numbers are always treated as strings.
+  size_t length = end - begin;
+  if (length < 3 || length > 9 || (length > 3 && key[begin] == '0'))
+    return false;
+
+  int result = 0;
+  for (size_t i = begin; i < end; ++i) {
+    if (key[i] < '0' || key[i] > '9')
+      return false;
+    result = result * 10 + (key[i] - '0');
+  }
+  *value = result;
+  return true;
+}
+
+// -----------------------------------------------------------------------
+
+bool Gameexe::Descend(GameexeKeyId* node, const std::string& key) const {
+  size_t begin = 0;
+  while (true) {
+    size_t end = key.find('.', begin);
+    if (end == std::string::npos)
+      end = key.size();
+
+    int value;
+    uint64_t part;
+    if (ParseIntPart(key, begin, end, &value)) {
+      part = INT_PART | static_cast<uint32_t>(value);
+    } else {
+      // Most parts are a whole argument, so avoid copying them.
+      auto it = (begin == 0 && end == key.size())
+                    ? part_ids_.find(key)
+                    : part_ids_.find(key.substr(begin, end - begin));
+      if (it == part_ids_.end())
+        return false;
+      part = it->second;
+    }
+
+    if (!DescendPart(node, part))
+      return false;
+    if (end == key.size())
+      return true;
+    begin = end + 1;
+  }
+}
+
+// -----------------------------------------------------------------------
+
+bool Gameexe::Descend(GameexeKeyId* node, int key) const {
+  if (key < 0 || key > 999999999) {
+    // Not written by AddToStream() in a form ParseIntPart() accepts.
+    std::ostringstream ss;
+    AddToStream(key, ss);
+    return Descend(node, ss.str());
+  }
+  return DescendPart(node, INT_PART | static_cast<uint32_t>(key));
+}
+
+// -----------------------------------------------------------------------
+
+bool Gameexe::DescendPart(GameexeKeyId* node, uint64_t part) const {
+  if (children_.empty())
+    return false;
+
+  size_t mask = children_.size() - 1;
+  size_t slot = std::hash<uint64_t>()(part * 31 + *node) & mask;
+  while (children_[slot].child != NO_KEY) {
+    const ChildSlot& child = children_[slot];
+    if (child.parent == *node && child.part == part) {
+      *node = child.child;
+      return true;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------
+
+GameexeKeyId Gameexe::InternKey(const std::string& key) {
+  GameexeKeyId node = ROOT_KEY;
+  size_t begin = 0;
+  while (true) {
+    size_t end = key.find('.', begin);
+    if (end == std::string::npos)
+      end = key.size();
+
+    int value;
+    uint64_t part;
+    if (ParseIntPart(key, begin, end, &value)) {
+      part = INT_PART | static_cast<uint32_t>(value);
+    } else {
+      std::string name = key.substr(begin, end - begin);
+      auto it = part_ids_.find(name);
+      if (it == part_ids_.end()) {
+        it = part_ids_.emplace(name, part_names_.size()).first;
+        part_names_.push_back(name);
+      }
+      part = it->second;
+    }
+
+    node = InternChild(node, part);
+    if (end == key.size())
+      return node;
+    begin = end + 1;
+  }
+}
+
+// -----------------------------------------------------------------------
+
+GameexeKeyId Gameexe::InternChild(GameexeKeyId parent, uint64_t part) {
+  GameexeKeyId node = parent;
+  if (DescendPart(&node, part))
+    return node;
+
+  // Keep the table at most half full.
+  if ((child_count_ + 1) * 2 > children_.size())
+    GrowChildren();
+
+  node = nodes_.size();
+  KeyNode key_node = {parent, part, data_.end()};
+  nodes_.push_back(key_node);
+
+  size_t mask = children_.size() - 1;
+  size_t slot = std::hash<uint64_t>()(part * 31 + parent) & mask;
+  while (children_[slot].child != NO_KEY)
+    slot = (slot + 1) & mask;
+  ChildSlot child = {part, parent, node};
+  children_[slot] = child;
+  child_count_++;
+  return node;
 }
 
 // -----------------------------------------------------------------------
 
-void Gameexe::AddToStream(const std::string& x, std::ostringstream& ss) {
+void Gameexe::GrowChildren() {
+  std::vector<ChildSlot> old;
+  old.swap(children_);
+  ChildSlot empty = {0, NO_KEY, NO_KEY};
+  children_.assign(std::max<size_t>(64, old.size() * 2), empty);
+
+  size_t mask = children_.size() - 1;
+  for (const ChildSlot& child : old) {
+    if (child.child == NO_KEY)
+      continue;
+    size_t slot = std::hash<uint64_t>()(child.part * 31 + child.parent) & mask;
+    while (children_[slot].child != NO_KEY)
+      slot = (slot + 1) & mask;
+    children_[slot] = child;
+  }
+}
+
+// -----------------------------------------------------------------------
+
+std::string Gameexe::KeyString(GameexeKeyId node) const {
+  std::vector<GameexeKeyId> path;
+  for (; node != ROOT_KEY; node = nodes_[node].parent)
+    path.push_back(node);
+
+  std::ostringstream ss;
+  for (auto it = path.rbegin(); it != path.rend(); ++it) {
+    if (it != path.rbegin())
+      ss << ".";
+    uint64_t part = nodes_[*it].part;
+    if (part & INT_PART)
+      AddToStream(static_cast<int>(part & 0xffffffff), ss);
+    else
+      ss << part_names_[part];
+  }
+  return ss.str();
+}
+
+// -----------------------------------------------------------------------
+
+GameexeData_t::const_iterator Gameexe::NodeValue(GameexeKeyId node) const {
+  return node == NO_KEY ? data_.end() : nodes_[node].value;
+}
+
+// -----------------------------------------------------------------------
+
+void Gameexe::AddToStream(const std::string& x,
+                          std::ostringstream& ss) const {
   ss << x;
 }
 
 // -----------------------------------------------------------------------
 
-void Gameexe::AddToStream(const int& x, std::ostringstream& ss) {
+void Gameexe::AddToStream(const int& x, std::ostringstream& ss) const {
   ss << std::setw(3) << std::setfill('0') << x;
 }
 
@@ -265,15 +525,33 @@ GameexeFilteringIterator Gameexe::filtering_end() {
 GameexeInterpretObject::GameexeInterpretObject(const std::string& key,
                                                Gameexe& objectToLookupOn)
     : key_(key),
-      iterator_(objectToLookupOn.Find(key)),
-      object_to_lookup_on_(objectToLookupOn) {}
+      node_(Gameexe::ROOT_KEY),
+      object_to_lookup_on_(objectToLookupOn) {
+  if (!objectToLookupOn.Descend(&node_, key))
+    node_ = Gameexe::NO_KEY;
+  iterator_ = objectToLookupOn.NodeValue(node_);
+}
 
 // -----------------------------------------------------------------------
 
 GameexeInterpretObject::GameexeInterpretObject(const std::string& key,
                                                GameexeData_t::const_iterator it,
                                                Gameexe& objectToLookupOn)
-    : key_(key), iterator_(it), object_to_lookup_on_(objectToLookupOn) {}
+    : key_(key),
+      node_(Gameexe::ROOT_KEY),
+      iterator_(it),
+      object_to_lookup_on_(objectToLookupOn) {
+  if (!objectToLookupOn.Descend(&node_, key))
+    node_ = Gameexe::NO_KEY;
+}
+
+// -----------------------------------------------------------------------
+
+GameexeInterpretObject::GameexeInterpretObject(GameexeKeyId node,
+                                               Gameexe& objectToLookupOn)
+    : node_(node),
+      iterator_(objectToLookupOn.NodeValue(node)),
+      object_to_lookup_on_(objectToLookupOn) {}
 
 // -----------------------------------------------------------------------
 
@@ -281,6 +559,14 @@ GameexeInterpretObject::~GameexeInterpretObject() {}
 
 // -----------------------------------------------------------------------
 
+const std::string& GameexeInterpretObject::key() const {
+  if (key_.empty() && node_ != Gameexe::NO_KEY)
+    key_ = object_to_lookup_on_.KeyString(node_);
+  return key_;
+}
+
+// -----------------------------------------------------------------------
+
 const int GameexeInterpretObject::ToInt(const int defaultValue) const {
   const std::vector<int>& ints = object_to_lookup_on_.GetIntArray(iterator_);
   if (ints.size() == 0)
@@ -294,7 +580,7 @@ const int GameexeInterpretObject::ToInt(const int defaultValue) const {
 const int GameexeInterpretObject::ToInt() const {
   const std::vector<int>& ints = object_to_lookup_on_.GetIntArray(iterator_);
   if (ints.size() == 0)
-    object_to_lookup_on_.ThrowUnknownKey(key_);
+    object_to_lookup_on_.ThrowUnknownKey(key());
 
   return ints[0];
 }
@@ -324,7 +610,7 @@ const std::string GameexeInterpretObject::ToString() const {
     return object_to_lookup_on_.GetStringAt(iterator_, 0);
   }
   catch (...) {
-    object_to_lookup_on_.ThrowUnknownKey(key_);
+    object_to_lookup_on_.ThrowUnknownKey(key());
   }
 
   // Shut the -Wall up
@@ -342,7 +628,7 @@ const std::string GameexeInterpretObject::GetStringAt(int index) const {
 const std::vector<int>& GameexeInterpretObject::ToIntVector() const {
   const std::vector<int>& ints = object_to_lookup_on_.GetIntArray(iterator_);
   if (ints.size() == 0)
-    object_to_lookup_on_.ThrowUnknownKey(key_);
+    object_to_lookup_on_.ThrowUnknownKey(key());
 
   return ints;
 }
@@ -350,14 +636,16 @@ const std::vector<int>& GameexeInterpretObject::ToIntVector() const {
 // -----------------------------------------------------------------------
 
 bool GameexeInterpretObject::Exists() const {
-  return object_to_lookup_on_.Exists(key_);
+  // Not |iterator_|, which is stale if the key has been assigned to since.
+  return object_to_lookup_on_.NodeValue(node_) !=
+         object_to_lookup_on_.data_.end();
 }
 
 // -----------------------------------------------------------------------
 
 const std::vector<std::string> GameexeInterpretObject::GetKeyParts() const {
   std::vector<std::string> keyparts;
-  boost::split(keyparts, key_, boost::is_any_of("."));
+  boost::split(keyparts, key(), boost::is_any_of("."));
   return keyparts;
 }
 
@@ -366,7 +654,9 @@ const std::vector<std::string> GameexeInterpretObject::GetKeyParts() const {
 GameexeInterpretObject& GameexeInterpretObject::operator=(
     const std::string& value) {
   // Set the key to incoming int
-  object_to_lookup_on_.SetStringAt(key_, value);
+  object_to_lookup_on_.SetStringAt(key(), value);
+  node_ = object_to_lookup_on_.InternKey(key());
+  iterator_ = object_to_lookup_on_.NodeValue(node_);
   return *this;
 }
 
@@ -374,10 +664,73 @@ GameexeInterpretObject& GameexeInterpretObject::operator=(
 
 GameexeInterpretObject& GameexeInterpretObject::operator=(const int value) {
   // Set the key to incoming int
-  object_to_lookup_on_.SetIntAt(key_, value);
+  object_to_lookup_on_.SetIntAt(key(), value);
+  node_ = object_to_lookup_on_.InternKey(key());
+  iterator_ = object_to_lookup_on_.NodeValue(node_);
   return *this;
 }
 
+// -----------------------------------------------------------------------
+// GameexeKeyHandle
+// -----------------------------------------------------------------------
+
+GameexeKeyHandle::GameexeKeyHandle()
+    : gameexe_(NULL), node_(Gameexe::NO_KEY) {}
+
+GameexeKeyHandle::GameexeKeyHandle(Gameexe* gameexe, GameexeKeyId node)
+    : gameexe_(gameexe), node_(node) {}
+
+bool GameexeKeyHandle::Exists() const {
+  return gameexe_ && gameexe_->NodeValue(node_) != gameexe_->data_.end();
+}
+
+int GameexeKeyHandle::ToInt(const int defaultValue) const {
+  if (!gameexe_)
+    return defaultValue;
+  const std::vector<int>& ints =
+      gameexe_->GetIntArray(gameexe_->NodeValue(node_));
+  return ints.empty() ? defaultValue : ints[0];
+}
+
+int GameexeKeyHandle::ToInt() const { return ToIntVector()[0]; }
+
+const std::vector<int>& GameexeKeyHandle::ToIntVector() const {
+  if (!Exists() || gameexe_->NodeValue(node_)->second.empty())
+    gameexe_->ThrowUnknownKey(key());
+  return gameexe_->NodeValue(node_)->second;
+}
+
+std::string GameexeKeyHandle::ToString(const std::string& defaultValue) const {
+  try {
+    return ToString();
+  }
+  catch (...) {
+    return defaultValue;
+  }
+}
+
+std::string GameexeKeyHandle::ToString() const {
+  if (!gameexe_)
+    throw libreallive::Error("Unresolved Gameexe key handle");
+  try {
+    return gameexe_->GetStringAt(gameexe_->NodeValue(node_), 0);
+  }
+  catch (...) {
+    gameexe_->ThrowUnknownKey(key());
+  }
+  return "";
+}
+
+int GameexeKeyHandle::GetIntAt(int index) const {
+  if (!gameexe_)
+    throw libreallive::Error("Unresolved Gameexe key handle");
+  return gameexe_->GetIntAt(gameexe_->NodeValue(node_), index);
+}
+
+std::string GameexeKeyHandle::key() const {
+  return gameexe_ ? gameexe_->KeyString(node_) : std::string();
+}
+
 // -----------------------------------------------------------------------
 // GameexeFilteringIterator
 // -----------------------------------------------------------------------
@@ -38,13 +38,16 @@
 #include <boost/iterator/iterator_facade.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include <cstdint>
 #include <map>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class Gameexe;
 class GameexeFilteringIterator;
+class GameexeKeyHandle;
 
 // -----------------------------------------------------------------------
 
@@ -52,6 +55,9 @@ class GameexeFilteringIterator;
 typedef std::vector<int> Gameexe_vec_type;
 typedef std::multimap<std::string, Gameexe_vec_type> GameexeData_t;
 
+// Id of an interned key (or key prefix) in a Gameexe.
+typedef uint32_t GameexeKeyId;
+
 // -----------------------------------------------------------------------
 
 // Encapsulates a line of the Gameexe file that's passed to the
@@ -77,9 +83,7 @@ class GameexeInterpretObject {
 
   // Extend a key by one key piece
   template<typename A>
-  GameexeInterpretObject operator()(const A& nextKey) {
-    return object_to_lookup_on_(key_, nextKey);
-  }
+  GameexeInterpretObject operator()(const A& nextKey);
 
   // Finds an int value, returning a default if non-existant.
   const int ToInt(const int defaultValue) const;
@@ -113,9 +117,7 @@ class GameexeInterpretObject {
   // Checks to see if the key exists.
   bool Exists() const;
 
-  const std::string& key() const {
-    return key_;
-  }
+  const std::string& key() const;
 
   // Returns the key splitted on periods.
   const std::vector<std::string> GetKeyParts() const;
@@ -132,7 +134,13 @@ class GameexeInterpretObject {
   friend class Gameexe;
   friend class GameexeFilteringIterator;
 
-  const std::string key_;
+  // Built on demand from |node_| when the object was looked up by id.
+  mutable std::string key_;
+
+  // The interned key, or Gameexe::NO_KEY if the key was never interned (in
+  // which case it doesn't exist).
+  GameexeKeyId node_;
+
   GameexeData_t::const_iterator iterator_;
   Gameexe& object_to_lookup_on_;
 
@@ -141,6 +149,37 @@ class GameexeInterpretObject {
   GameexeInterpretObject(const std::string& key,
                          GameexeData_t::const_iterator it,
                          Gameexe& objectToLookupOn);
+  GameexeInterpretObject(GameexeKeyId node, Gameexe& objectToLookupOn);
+};
+
+// A key that was looked up once and can be read many times without formatting
+// or hashing the key again. Hot paths hold on to one of these instead of
+// calling Gameexe::operator() each time. Handles stay valid, and see new
+// values, when the key is assigned to later, even if it didn't exist when the
+// handle was made.
+class GameexeKeyHandle {
+ public:
+  GameexeKeyHandle();
+
+  bool Exists() const;
+
+  // Same semantics as the GameexeInterpretObject methods of the same name.
+  int ToInt(const int defaultValue) const;
+  int ToInt() const;
+  const std::vector<int>& ToIntVector() const;
+  std::string ToString(const std::string& defaultValue) const;
+  std::string ToString() const;
+  int GetIntAt(int index) const;
+
+  std::string key() const;
+
+ private:
+  friend class Gameexe;
+
+  GameexeKeyHandle(Gameexe* gameexe, GameexeKeyId node);
+
+  Gameexe* gameexe_;
+  GameexeKeyId node_;
 };
 
 // New interface to Gameexe, replacing the one inherited from Haeleth,
@@ -148,10 +187,18 @@ class GameexeInterpretObject {
 // to make accessing data in the Gameexe as easy as possible.
 class Gameexe {
  public:
+  // Returned by key lookups that don't name an interned key.
+  static const GameexeKeyId NO_KEY = 0xffffffff;
+
   explicit Gameexe(const boost::filesystem::path& filename);
   Gameexe();
   ~Gameexe();
 
+  // Interned keys point into |data_|, so a copy would point into the
+  // original.
+  Gameexe(const Gameexe&) = delete;
+  Gameexe& operator=(const Gameexe&) = delete;
+
   // Parses an individual Gameexe.ini line.
   void parseLine(const std::string& line);
 
@@ -168,6 +215,15 @@ class Gameexe {
   GameexeInterpretObject operator()(const A& firstKey, const B& secondKey,
                                     const C& thirdKey);
 
+  // Returns a handle for the key "firstKey"[."secondKey"[."thirdKey"]].
+  template<typename A>
+  GameexeKeyHandle GetHandle(const A& firstKey);
+  template<typename A, typename B>
+  GameexeKeyHandle GetHandle(const A& firstKey, const B& secondKey);
+  template<typename A, typename B, typename C>
+  GameexeKeyHandle GetHandle(const A& firstKey, const B& secondKey,
+                             const C& thirdKey);
+
   // Returns iterators that filter on a possible value.
   GameexeFilteringIterator filtering_begin(const std::string& filter);
   GameexeFilteringIterator filtering_end();
@@ -185,6 +241,58 @@ class Gameexe {
   void SetIntAt(const std::string& key, const int value);
 
  private:
+  // A key is a path of parts separated by periods. Every distinct path and
+  // prefix that has been seen gets an id; the id of a path is found by
+  // stepping from its parent's id with the next part through |children_|.
+  // Parts are encoded as integers: the value | INT_PART for parts that are
+  // integers written with setw(3), or the id of the interned string.
+  struct KeyNode {
+    GameexeKeyId parent;
+    uint64_t part;
+    // First entry with this key in |data_|, or |data_|.end().
+    GameexeData_t::const_iterator value;
+  };
+
+  // Open addressed (parent, part) -> child table.
+  struct ChildSlot {
+    uint64_t part;
+    GameexeKeyId parent;
+    GameexeKeyId child;
+  };
+
+  // Parses every line in [begin, end), interning keys as they are read.
+  void ParseBuffer(const char* begin, const char* end);
+  void ParseLine(const char* begin, const char* end);
+
+  // Files at least this large are memory mapped instead of read.
+  static const uintmax_t MIN_MAPPED_SIZE = 64 * 1024;
+
+  static const GameexeKeyId ROOT_KEY = 0;
+  static const uint64_t INT_PART = 1ULL << 32;
+
+  // Returns whether key[begin, end) is an integer as AddToStream() writes it.
+  static bool ParseIntPart(const std::string& key, size_t begin, size_t end,
+                           int* value);
+
+  // Step from |*node| through one or more parts without interning anything.
+  // Return false if the resulting key was never interned.
+  bool Descend(GameexeKeyId* node, const std::string& key) const;
+  bool Descend(GameexeKeyId* node, int key) const;
+  bool DescendPart(GameexeKeyId* node, uint64_t part) const;
+
+  // Interns |key| and all its prefixes.
+  GameexeKeyId InternKey(const std::string& key);
+  GameexeKeyId InternChild(GameexeKeyId parent, uint64_t part);
+  void GrowChildren();
+
+  // Rebuilds the key string for |node|.
+  std::string KeyString(GameexeKeyId node) const;
+
+  GameexeData_t::const_iterator NodeValue(GameexeKeyId node) const;
+
+  // Stores a value for |key|, replacing any existing ones.
+  void SetValue(const std::string& key, const Gameexe_vec_type& value);
+
   const std::vector<int>& GetIntArray(GameexeData_t::const_iterator key);
   int GetIntAt(GameexeData_t::const_iterator key, int index);
   std::string GetStringAt(GameexeData_t::const_iterator key, int index);
@@ -196,10 +304,10 @@ class Gameexe {
 
   // Regrettable artifact of hack to get all integers in streams to
   // have setw(3).
-  void AddToStream(const std::string& x, std::ostringstream& ss);
+  void AddToStream(const std::string& x, std::ostringstream& ss) const;
 
   // Hack to get all integers in streams to have setw(3).
-  void AddToStream(const int& x, std::ostringstream& ss);
+  void AddToStream(const int& x, std::ostringstream& ss) const;
 
   void ThrowUnknownKey(const std::string& key);
 
@@ -207,6 +315,7 @@ class Gameexe {
   // Allow access from the helper class
   friend class GameexeInterpretObject;
   friend class GameexeFilteringIterator;
+  friend class GameexeKeyHandle;
 
   // Implementation detail of how parsed Gameexe.ini data is stored in
   // the class. This was stolen directly from Haeleth's parser in
@@ -215,12 +324,33 @@ class Gameexe {
   // that int is an index into a vector of strings on the side.
   GameexeData_t data_;
   std::vector<std::string> cdata_;
+
+  // Compiled key index over |data_|.
+  std::vector<KeyNode> nodes_;
+  std::vector<ChildSlot> children_;
+  size_t child_count_;
+  std::unordered_map<std::string, uint32_t> part_ids_;
+  std::vector<std::string> part_names_;
 };
 
 // -----------------------------------------------------------------------
 
+template<typename A>
+GameexeInterpretObject GameexeInterpretObject::operator()(const A& nextKey) {
+  GameexeKeyId node = node_;
+  if (node != Gameexe::NO_KEY && object_to_lookup_on_.Descend(&node, nextKey))
+    return GameexeInterpretObject(node, object_to_lookup_on_);
+  return object_to_lookup_on_(key(), nextKey);
+}
+
+// -----------------------------------------------------------------------
+
 template<typename A>
 GameexeInterpretObject Gameexe::operator()(const A& firstKey) {
+  GameexeKeyId node = ROOT_KEY;
+  if (Descend(&node, firstKey))
+    return GameexeInterpretObject(node, *this);
+
   std::ostringstream ss;
   AddToStream(firstKey, ss);
   return GameexeInterpretObject(ss.str(), *this);
@@ -230,6 +360,9 @@ GameexeInterpretObject Gameexe::operator()(const A& firstKey) {
 
 template<>
 inline GameexeInterpretObject Gameexe::operator()(const std::string& firstKey) {
+  GameexeKeyId node = ROOT_KEY;
+  if (Descend(&node, firstKey))
+    return GameexeInterpretObject(node, *this);
   return GameexeInterpretObject(firstKey, *this);
 }
 
@@ -238,6 +371,10 @@ inline GameexeInterpretObject Gameexe::operator()(const std::string& firstKey) {
 template<typename A, typename B>
 GameexeInterpretObject Gameexe::operator()(const A& firstKey,
                                            const B& secondKey) {
+  GameexeKeyId node = ROOT_KEY;
+  if (Descend(&node, firstKey) && Descend(&node, secondKey))
+    return GameexeInterpretObject(node, *this);
+
   std::ostringstream ss;
   AddToStream(firstKey, ss);
   ss << ".";
@@ -251,6 +388,12 @@ template<typename A, typename B, typename C>
 GameexeInterpretObject Gameexe::operator()(const A& firstKey,
                                            const B& secondKey,
                                            const C& thirdKey) {
+  GameexeKeyId node = ROOT_KEY;
+  if (Descend(&node, firstKey) && Descend(&node, secondKey) &&
+      Descend(&node, thirdKey)) {
+    return GameexeInterpretObject(node, *this);
+  }
+
   std::ostringstream ss;
   AddToStream(firstKey, ss);
   ss << ".";
@@ -262,6 +405,26 @@ GameexeInterpretObject Gameexe::operator()(const A& firstKey,
 
 // -----------------------------------------------------------------------
 
+template<typename A>
+GameexeKeyHandle Gameexe::GetHandle(const A& firstKey) {
+  return GameexeKeyHandle(this, InternKey((*this)(firstKey).key()));
+}
+
+template<typename A, typename B>
+GameexeKeyHandle Gameexe::GetHandle(const A& firstKey, const B& secondKey) {
+  return GameexeKeyHandle(this,
+                          InternKey((*this)(firstKey, secondKey).key()));
+}
+
+template<typename A, typename B, typename C>
+GameexeKeyHandle Gameexe::GetHandle(const A& firstKey, const B& secondKey,
+                                    const C& thirdKey) {
+  return GameexeKeyHandle(
+      this, InternKey((*this)(firstKey, secondKey, thirdKey).key()));
+}
+
+// -----------------------------------------------------------------------
+
 class GameexeFilteringIterator
   : public boost::iterator_facade<
   GameexeFilteringIterator,
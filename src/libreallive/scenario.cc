@@ -37,6 +37,8 @@
 #include <cassert>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "libreallive/compression.h"
 #include "utilities/exception.h"
@@ -140,7 +142,8 @@ Script::Script(const Header& hdr,
     }
   }
 
-  char* uncompressed = new char[dlen];
+  uncompressed_.reset(new char[dlen]);
+  char* uncompressed = uncompressed_.get();
   compression::Decompress(data + read_i32(data + 0x20),
                           read_i32(data + 0x28),
                           uncompressed,
@@ -173,8 +176,6 @@ Script::Script(const Header& hdr,
   for (auto& element : elts_) {
     element->SetPointers(cdat);
   }
-
-  delete[] uncompressed;
 }
 
 Script::~Script() {}
@@ -193,7 +194,9 @@ Scenario::Scenario(const char* data, const size_t length, int sn,
   : header(data, length),
     script(header, data, length, regname,
            header.use_xor_2_, second_level_xor_key),
-    scenario_number_(sn) {
+    scenario_number_(sn),
+    preparsed_command_count_(0),
+    preparse_time_(0) {
 }
 
 Scenario::Scenario(const FilePos& fp, int sn,
@@ -202,7 +205,9 @@ Scenario::Scenario(const FilePos& fp, int sn,
   : header(fp.data, fp.length),
     script(header, fp.data, fp.length, regname,
            header.use_xor_2_, second_level_xor_key),
-    scenario_number_(sn) {
+    scenario_number_(sn),
+    preparsed_command_count_(0),
+    preparse_time_(0) {
 }
 
 Scenario::~Scenario() {}
@@ -211,4 +216,46 @@ Scenario::const_iterator Scenario::FindEntrypoint(int entrypoint) const {
   return script.GetEntrypoint(entrypoint);
 }
 
+void Scenario::PrepareDisplayText() {
+  for (auto& element : script.elts_)
+    element->PrepareDisplayText(encoding());
+}
+
+void Scenario::PreparseParameters(ParameterParser& parser, int thread_count) {
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<const CommandElement*> commands;
+  for (auto const& element : script.elts_) {
+    const CommandElement* command =
+        dynamic_cast<const CommandElement*>(element.get());
+    if (command)
+      commands.push_back(command);
+  }
+
+  auto parse_range = [&parser, &commands](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      parser.ParseCommand(*commands[i]);
+  };
+
+  // Each thread gets a contiguous range of commands, so neighbouring elements
+  // stay on the same core. The calling thread takes the first range.
+  size_t ranges = std::max(1, thread_count);
+  ranges = std::min(ranges, std::max<size_t>(1, commands.size()));
+  size_t range_size = (commands.size() + ranges - 1) / ranges;
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < ranges; ++i) {
+    size_t begin = std::min(i * range_size, commands.size());
+    size_t end = std::min(begin + range_size, commands.size());
+    workers.emplace_back(parse_range, begin, end);
+  }
+  parse_range(0, std::min(range_size, commands.size()));
+  for (auto& worker : workers)
+    worker.join();
+
+  preparsed_command_count_ = commands.size();
+  preparse_time_ = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  parser.OnScenarioParsed(*this);
+}
+
 }  // namespace libreallive
@@ -34,6 +34,7 @@
 #ifndef SRC_LIBREALLIVE_SCENARIO_H_
 #define SRC_LIBREALLIVE_SCENARIO_H_
 
+#include <chrono>
 #include <string>
 
 #include "libreallive/defs.h"
@@ -47,6 +48,22 @@ struct XorKey;
 
 #include "libreallive/scenario_internals.h"
 
+class Scenario;
+
+// Parses the parameters of commands before they are executed. Implemented by
+// the interpreter, which knows which operation each command maps to.
+class ParameterParser {
+ public:
+  virtual ~ParameterParser() {}
+
+  // Parses and caches the parameters of |command|. Called from several threads
+  // at once for different commands, and must not throw.
+  virtual void ParseCommand(const CommandElement& command) = 0;
+
+  // Called on the loading thread once all commands in |scenario| are parsed.
+  virtual void OnScenarioParsed(const Scenario& scenario) {}
+};
+
 class Scenario {
  public:
   Scenario(const char* data, const size_t length, int scenarioNum,
@@ -79,10 +96,26 @@ class Scenario {
   // Locate the entrypoint
   const_iterator FindEntrypoint(int entrypoint) const;
 
+  // Converts all display text in the script to UTF-8 in one pass, so it isn't
+  // converted again each time it is shown.
+  void PrepareDisplayText();
+
+  // Runs |parser| over every command in the script, splitting the script into
+  // |thread_count| ranges of elements that are parsed concurrently.
+  void PreparseParameters(ParameterParser& parser, int thread_count);
+
+  // How many commands the last PreparseParameters() call went through, and
+  // how long it took.
+  int preparsed_command_count() const { return preparsed_command_count_; }
+  std::chrono::microseconds preparse_time() const { return preparse_time_; }
+
  private:
   Header header;
   Script script;
   int scenario_number_;
+
+  int preparsed_command_count_;
+  std::chrono::microseconds preparse_time_;
 };
 
 }  // namespace libreallive
@@ -30,6 +30,7 @@
 #define SRC_LIBREALLIVE_SCENARIO_INTERNALS_H_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -86,6 +87,11 @@ class Script {
          bool use_xor_2, const compression::XorKey* second_level_xor_key);
   ~Script();
 
+  // The decompressed bytecode. Elements refer into this buffer instead of
+  // copying their parameters out, so it is declared before |elts_| and
+  // outlives them.
+  std::unique_ptr<char[]> uncompressed_;
+
   BytecodeList elts_;
 
   // Entrypoint handeling
@@ -141,6 +141,8 @@ bool ButtonObjectSelectLongOperation::operator()(RLMachine& machine) {
   }
 }
 
+bool ButtonObjectSelectLongOperation::CanSleep() const { return true; }
+
 void ButtonObjectSelectLongOperation::SetButtonOverride(GraphicsObject* object,
                                                         const char* type) {
   int action = object->GetButtonAction();
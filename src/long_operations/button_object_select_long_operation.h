@@ -52,6 +52,7 @@ class ButtonObjectSelectLongOperation : public LongOperation {
 
   // Overridden from LongOperation:
   virtual bool operator()(RLMachine& machine);
+  virtual bool CanSleep() const override;
 
  private:
   // Sets the override data (changes pattern number and offset) based on
@@ -27,6 +27,7 @@
 
 #include "long_operations/pause_long_operation.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "machine/rlmachine.h"
@@ -184,26 +185,53 @@ bool PauseLongOperation::operator()(RLMachine& machine) {
   if (is_done_) {
     // Stop all voices before continuing.
     machine_.system().sound().KoeStop();
+  } else if (machine_.system().text().auto_mode()) {
+    ScheduleAutomodeWakeup();
   }
 
   return is_done_;
 }
 
+bool PauseLongOperation::CanSleep() const { return true; }
+
 bool PauseLongOperation::AutomodeTimerFired() {
-  int current_time = machine_.system().event().GetTicks();
-  int time_since_last_pass = current_time - time_at_last_pass_;
+  EventSystem& event = machine_.system().event();
+  unsigned int current_time = event.GetTicks();
+  unsigned int last_mouse_move = event.TimeOfLastMouseMove();
+
+  // The game loop may have slept through the end of the mouse grace period
+  // below, so only count time from when it ended.
+  unsigned int counted_from =
+      std::min(current_time, std::max(time_at_last_pass_,
+                                      last_mouse_move + 2000));
   time_at_last_pass_ = current_time;
 
-  if (machine_.system().event().TimeOfLastMouseMove() < (current_time - 2000)) {
+  if (last_mouse_move < (current_time - 2000)) {
     // If the mouse has been moved within the last two seconds, don't advance
     // the timer so the user has a chance to click on buttons.
-    total_time_ += time_since_last_pass;
+    total_time_ += current_time - counted_from;
     return total_time_ >= automode_time_;
   }
 
   return false;
 }
 
+void PauseLongOperation::ScheduleAutomodeWakeup() {
+  EventSystem& event = machine_.system().event();
+
+  // We wait for the voice to finish, which isn't scheduled.
+  if (machine_.system().sound().KoePlaying()) {
+    event.ScheduleNextFrame();
+    return;
+  }
+
+  unsigned int remaining =
+      automode_time_ > total_time_ ? automode_time_ - total_time_ : 0;
+  unsigned int mouse_idle_at = event.TimeOfLastMouseMove() + 2001;
+  event.ScheduleWakeup(std::max(time_at_last_pass_, mouse_idle_at) +
+                       remaining);
+}
+
 // -----------------------------------------------------------------------
 // NewPageAfterLongop
 // -----------------------------------------------------------------------
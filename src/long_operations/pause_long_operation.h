@@ -45,11 +45,15 @@ class PauseLongOperation : public LongOperation {
 
   // Overridden from LongOperation:
   virtual bool operator()(RLMachine& machine);
+  virtual bool CanSleep() const override;
 
  private:
   // Has this pause timed out?
   bool AutomodeTimerFired();
 
+  // Asks the game loop to wake us when the auto mode timer could fire.
+  void ScheduleAutomodeWakeup();
+
   RLMachine& machine_;
 
   bool is_done_;
@@ -69,7 +69,7 @@ SelectLongOperation::SelectLongOperation(RLMachine& machine,
     o.use_colour = false;
 
     std::string evaluated_native =
-        libreallive::EvaluatePRINT(machine, param.text);
+        libreallive::EvaluatePRINT(machine, param.text.str());
     o.str = cp932toUTF8(evaluated_native, machine.GetTextEncoding());
 
     for (auto const& condition : param.cond_parsed) {
@@ -78,8 +78,8 @@ SelectLongOperation::SelectLongOperation(RLMachine& machine,
         // for now, I've never seen anything other than hide.
         case SelectElement::OPTION_HIDE: {
           bool value = false;
-          if (condition.condition != "") {
-            const char* location = condition.condition.c_str();
+          if (!condition.condition.empty()) {
+            const char* location = condition.condition.data();
             ExpressionPiece condition(libreallive::GetExpression(location));
             value = !condition.GetIntegerValue(machine);
           }
@@ -89,16 +89,16 @@ SelectLongOperation::SelectLongOperation(RLMachine& machine,
         }
         case SelectElement::OPTION_TITLE: {
           bool enabled = false;
-          if (condition.condition != "") {
-            const char* location = condition.condition.c_str();
+          if (!condition.condition.empty()) {
+            const char* location = condition.condition.data();
             ExpressionPiece condition(libreallive::GetExpression(location));
             enabled = !condition.GetIntegerValue(machine);
           }
 
           bool use_colour = false;
           int colour_index = 0;
-          if (!enabled && condition.effect_argument != "") {
-            const char* location = condition.effect_argument.c_str();
+          if (!enabled && !condition.effect_argument.empty()) {
+            const char* location = condition.effect_argument.data();
             ExpressionPiece effect_argument(
                 libreallive::GetExpression(location));
             colour_index = !effect_argument.GetIntegerValue(machine);
@@ -113,10 +113,10 @@ SelectLongOperation::SelectLongOperation(RLMachine& machine,
         default:
           cerr << "Unsupported option in select statement "
                << "(condition: "
-               << libreallive::ParsableToPrintableString(condition.condition)
+               << libreallive::ParsableToPrintableString(condition.condition.str())
                << ", effect: " << condition.effect << ", effect_argument: "
                << libreallive::ParsableToPrintableString(
-                      condition.effect_argument) << ")" << endl;
+                      condition.effect_argument.str()) << ")" << endl;
           break;
       }
     }
@@ -166,6 +166,8 @@ bool SelectLongOperation::operator()(RLMachine& machine) {
   }
 }
 
+bool SelectLongOperation::CanSleep() const { return true; }
+
 // -----------------------------------------------------------------------
 // NormalSelectLongOperation
 // -----------------------------------------------------------------------
@@ -80,6 +80,7 @@ class SelectLongOperation : public LongOperation {
 
   // Overridden from LongOperation:
   virtual bool operator()(RLMachine& machine) override;
+  virtual bool CanSleep() const override;
 
  protected:
   RLMachine& machine_;
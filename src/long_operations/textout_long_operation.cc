@@ -39,7 +39,7 @@
 #include "systems/base/text_page.h"
 #include "systems/base/text_system.h"
 #include "utilities/exception.h"
-#include "utf8cpp/utf8.h"
+#include "utilities/string_utilities.h"
 
 // Timing information must stay the same between individual
 // TextoutLongOperations. rlBabel compiled games will always display one
@@ -53,18 +53,32 @@ int TextoutLongOperation::next_character_countdown_ = 0;
 
 TextoutLongOperation::TextoutLongOperation(RLMachine& machine,
                                            const std::string& utf8string)
-    : utf8_string_(utf8string),
+    : owned_text_(new DisplayText(utf8string)),
+      text_(owned_text_.get()),
       current_codepoint_(0),
-      current_position_(utf8_string_.begin()),
+      current_index_(0),
+      next_index_(0),
       no_wait_(false) {
+  Init(machine);
+}
+
+TextoutLongOperation::TextoutLongOperation(RLMachine& machine,
+                                           const DisplayText& text)
+    : text_(&text),
+      current_codepoint_(0),
+      current_index_(0),
+      next_index_(0),
+      no_wait_(false) {
+  Init(machine);
+}
+
+TextoutLongOperation::~TextoutLongOperation() {}
+
+void TextoutLongOperation::Init(RLMachine& machine) {
   // Retrieve the first character (prime the loop in operator())
-  string::iterator tmp = current_position_;
-  if (tmp == utf8_string_.end()) {
-    current_char_ = "";
-  } else {
-    current_codepoint_ = utf8::next(tmp, utf8_string_.end());
-    current_char_ = string(current_position_, tmp);
-    current_position_ = tmp;
+  if (text_->size() > 0) {
+    current_codepoint_ = text_->codepoints[0];
+    next_index_ = 1;
   }
 
   // If we are inside a ruby gloss right now, don't delay at
@@ -73,7 +87,11 @@ TextoutLongOperation::TextoutLongOperation(RLMachine& machine,
     no_wait_ = true;
 }
 
-TextoutLongOperation::~TextoutLongOperation() {}
+std::string TextoutLongOperation::CurrentCharacter() const {
+  if (current_index_ < text_->size())
+    return text_->Character(current_index_);
+  return std::string();
+}
 
 bool TextoutLongOperation::MouseButtonStateChanged(MouseButton mouseButton,
                                                    bool pressed) {
@@ -108,41 +126,34 @@ bool TextoutLongOperation::DisplayName(RLMachine& machine) {
   // name, even though character names are one of the places where that's
   // evaluated.
 
-  // Ignore the starting bracket
-  string::iterator it = current_position_;
-  string::iterator curend = it;
-  string::iterator strend = utf8_string_.end();
-  int codepoint = utf8::next(it, strend);
-
   // Eat all characters between the name brackets
-  while (codepoint != 0x3011 && it != strend) {
-    curend = it;
-    codepoint = utf8::next(it, strend);
-  }
+  size_t close = next_index_;
+  while (close < text_->size() && text_->codepoints[close] != 0x3011)
+    ++close;
 
-  if (codepoint != 0x3011 && it == strend) {
+  if (close == text_->size()) {
     throw SystemError(
         "Malformed string code. Opening bracket in \\{name}"
         " construct,  but missing closing bracket.");
   }
 
   // Grab the name
-  string name(current_position_, curend);
+  size_t name_begin = text_->offsets[next_index_];
+  string name =
+      text_->utf8.substr(name_begin, text_->offsets[close] - name_begin);
 
   // Consume the next character
-  current_position_ = it;
-
-  if (it != strend) {
-    current_codepoint_ = utf8::next(it, strend);
-    current_char_ = string(current_position_, it);
-    current_position_ = it;
+  next_index_ = close + 1;
+  if (next_index_ < text_->size()) {
+    current_index_ = next_index_++;
+    current_codepoint_ = text_->codepoints[current_index_];
   }
 
   TextPage& page = machine.system().text().GetCurrentPage();
-  page.Name(name, current_char_);
+  page.Name(name, CurrentCharacter());
 
   // Stop if this was the end of input
-  return it == strend;
+  return next_index_ == text_->size();
 }
 
 bool TextoutLongOperation::DisplayOneMoreCharacter(RLMachine& machine,
@@ -153,27 +164,25 @@ bool TextoutLongOperation::DisplayOneMoreCharacter(RLMachine& machine,
     return DisplayName(machine);
   } else {
     // Isolate the next character
-    string::iterator it = current_position_;
-    string::iterator strend = utf8_string_.end();
-
-    if (it != strend) {
-      int codepoint = utf8::next(it, strend);
+    if (next_index_ < text_->size()) {
+      int codepoint = text_->codepoints[next_index_];
       TextPage& page = machine.system().text().GetCurrentPage();
       if (codepoint) {
-        string rest(current_position_, strend);
-        bool rendered = page.Character(current_char_, rest);
+        // TextWindow only looks far enough past the current character to
+        // decide on a line break, so don't hand it the whole rest of the
+        // string.
+        bool rendered = page.Character(CurrentCharacter(),
+                                       text_->LineBreakLookahead(next_index_));
 
         // Check to see if this character was rendered to the screen. If
         // this is false, then the page is probably full and the check
         // later on will do something about that.
-        if (rendered) {
-          current_char_ = std::string(current_position_, it);
-          current_position_ = it;
-        }
+        if (rendered)
+          current_index_ = next_index_++;
       } else {
         // advance to the next character if we've somehow hit an
         // embedded NULL that isn't the end of the string
-        current_position_ = it;
+        ++next_index_;
       }
 
       // Call the pause operation if we've filled up the current page.
@@ -186,7 +195,8 @@ bool TextoutLongOperation::DisplayOneMoreCharacter(RLMachine& machine,
 
       return false;
     } else {
-      machine.system().text().GetCurrentPage().Character(current_char_, "");
+      machine.system().text().GetCurrentPage().Character(CurrentCharacter(),
+                                                         "");
 
       return true;
     }
@@ -201,7 +211,7 @@ bool TextoutLongOperation::operator()(RLMachine& machine) {
   if (no_wait_) {
     return DisplayAsMuchAsWeCanThenPause(machine);
   } else {
-    int current_time = machine.system().event().GetTicks();
+    int current_time = machine.system().event().frame_ticks();
     int time_since_last_pass = current_time - time_at_last_pass_;
     time_at_last_pass_ = current_time;
 
@@ -28,16 +28,22 @@
 #ifndef SRC_LONG_OPERATIONS_TEXTOUT_LONG_OPERATION_H_
 #define SRC_LONG_OPERATIONS_TEXTOUT_LONG_OPERATION_H_
 
+#include <memory>
 #include <string>
 
 #include "machine/long_operation.h"
 #include "systems/base/event_listener.h"
 
 class RLMachine;
+struct DisplayText;
 
 class TextoutLongOperation : public LongOperation {
  public:
   TextoutLongOperation(RLMachine& machine, const std::string& utf8string);
+
+  // Displays text that was prepared when its scenario was loaded. |text| must
+  // outlive this operation.
+  TextoutLongOperation(RLMachine& machine, const DisplayText& text);
   virtual ~TextoutLongOperation();
 
   void set_no_wait() { no_wait_ = true; }
@@ -57,11 +63,23 @@ class TextoutLongOperation : public LongOperation {
   bool DisplayName(RLMachine& machine);
   bool DisplayOneMoreCharacter(RLMachine& machine, bool& paused);
 
-  std::string utf8_string_;
+  // Shared by the constructors.
+  void Init(RLMachine& machine);
+
+  // The character at |current_index_|, or the empty string if there is none.
+  std::string CurrentCharacter() const;
+
+  // The text being displayed. Either |owned_text_| or text owned by a
+  // TextoutElement.
+  std::unique_ptr<DisplayText> owned_text_;
+  const DisplayText* text_;
 
   int current_codepoint_;
-  std::string current_char_;
-  std::string::iterator current_position_;
+
+  // The character that will be displayed next, and the index of the
+  // character after it.
+  size_t current_index_;
+  size_t next_index_;
 
   // Sets whether we should display as much text as we can immediately.
   bool no_wait_;
@@ -113,7 +113,10 @@ bool WaitLongOperation::operator()(RLMachine& machine) {
   bool done = ctrl_pressed_ || machine.system().ShouldFastForward();
 
   if (!done && wait_until_target_time_) {
-    done = machine.system().event().GetTicks() > target_time_;
+    EventSystem& event = machine.system().event();
+    done = event.GetTicks() > target_time_;
+    if (!done)
+      event.ScheduleWakeup(target_time_ + 1);
   }
 
   if (!done && break_on_event_) {
@@ -142,3 +145,8 @@ bool WaitLongOperation::operator()(RLMachine& machine) {
 
   return done;
 }
+
+bool WaitLongOperation::CanSleep() const {
+  // Arbitrary predicates have to be polled every frame.
+  return !break_on_event_;
+}
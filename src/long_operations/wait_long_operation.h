@@ -64,6 +64,7 @@ class WaitLongOperation : public LongOperation {
 
   // Overridden from LongOperation:
   virtual bool operator()(RLMachine& machine);
+  virtual bool CanSleep() const override;
 
  private:
   RLMachine& machine_;
@@ -85,10 +85,10 @@ MultiDispatch::MultiDispatch(RLOperation* op) : handler_(op) {}
 MultiDispatch::~MultiDispatch() {}
 
 void MultiDispatch::ParseParameters(
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output) {
   for (auto const& parameter : input) {
-    const char* src = parameter.c_str();
+    const char* src = parameter.data();
     output.push_back(libreallive::GetComplexParam(src));
   }
 }
@@ -160,7 +160,7 @@ void UndefinedFunction::DispatchFunction(RLMachine& machine,
 }
 
 void UndefinedFunction::ParseParameters(
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output) {
   throw rlvm::UnimplementedOpcode(name(), modtype_, module_, opcode_, overload_);
 }
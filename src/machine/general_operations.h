@@ -141,7 +141,7 @@ class MultiDispatch : public RLOp_SpecialCase {
   ~MultiDispatch();
 
   virtual void ParseParameters(
-      const std::vector<std::string>& input,
+      const std::vector<libreallive::ByteSpan>& input,
       libreallive::ExpressionPiecesVector& output) override;
 
   virtual void operator()(RLMachine& machine,
@@ -195,7 +195,7 @@ class UndefinedFunction : public RLOp_SpecialCase {
   virtual void DispatchFunction(RLMachine& machine,
                                 const libreallive::CommandElement& f) override;
   virtual void ParseParameters(
-      const std::vector<std::string>& input,
+      const std::vector<libreallive::ByteSpan>& input,
       libreallive::ExpressionPiecesVector& output) override;
   virtual void operator()(RLMachine&,
                           const libreallive::CommandElement&) override;
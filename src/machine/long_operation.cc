@@ -39,6 +39,8 @@ LongOperation::LongOperation() : EventListener() {}
 
 LongOperation::~LongOperation() {}
 
+bool LongOperation::CanSleep() const { return false; }
+
 // -----------------------------------------------------------------------
 // PerformAfterLongOperationDecorator
 // -----------------------------------------------------------------------
@@ -72,3 +74,7 @@ bool PerformAfterLongOperationDecorator::operator()(RLMachine& machine) {
 
   return ret_val;
 }
+
+bool PerformAfterLongOperationDecorator::CanSleep() const {
+  return operation_->CanSleep();
+}
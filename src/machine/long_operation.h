@@ -55,6 +55,12 @@ class LongOperation : public EventListener {
   // Executes the current LongOperation. Returns true if the command has
   // completed, and normal interpretation should be resumed, false otherwise.
   virtual bool operator()(RLMachine& machine) = 0;
+
+  // Returns true if this operation only needs to run in response to input and
+  // at the times it registers with EventSystem::ScheduleWakeup(). While such
+  // an operation is on top of the stack, the game loop sleeps instead of
+  // running every frame. The default is false.
+  virtual bool CanSleep() const;
 };
 
 // LongOperator decorator that simply invokes the included
@@ -74,6 +80,7 @@ class PerformAfterLongOperationDecorator : public LongOperation {
 
   // Overridden from LongOperation:
   virtual bool operator()(RLMachine& machine);
+  virtual bool CanSleep() const override;
 
  private:
   // Payload of decorator implemented by subclasses
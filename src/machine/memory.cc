@@ -30,6 +30,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "libreallive/gameexe.h"
 #include "libreallive/intmemref.h"
@@ -125,10 +126,14 @@ const std::string& Memory::GetStringValue(int type, int location) {
         "Invalid range access in RLMachine::set_string_value");
 
   switch (type) {
-    case libreallive::STRK_LOCATION:
-      if ((location + 1) > machine_.CurrentStrKBank().size())
-        machine_.CurrentStrKBank().resize(location + 1);
+    case libreallive::STRK_LOCATION: {
+      // Reading doesn't grow the bank, so that references returned for other
+      // strK[] locations stay valid.
+      static const std::string empty;
+      if (static_cast<size_t>(location) >= machine_.CurrentStrKBank().size())
+        return empty;
       return machine_.CurrentStrKBank()[location];
+    }
     case libreallive::STRM_LOCATION:
       return global_->strM[location];
     case libreallive::STRS_LOCATION:
@@ -144,11 +149,18 @@ void Memory::SetStringValue(int type, int number, const std::string& value) {
         "Invalid range access in RLMachine::set_string_value");
 
   switch (type) {
-    case libreallive::STRK_LOCATION:
-      if ((number + 1) > machine_.CurrentStrKBank().size())
-        machine_.CurrentStrKBank().resize(number + 1);
-      machine_.CurrentStrKBank()[number] = value;
+    case libreallive::STRK_LOCATION: {
+      std::vector<std::string>& bank = machine_.CurrentStrKBank();
+      if ((number + 1) > bank.size()) {
+        // |value| may be a reference into |bank|, which resize() moves.
+        std::string copy = value;
+        bank.resize(number + 1);
+        bank[number].swap(copy);
+      } else {
+        bank[number] = value;
+      }
       break;
+    }
     case libreallive::STRM_LOCATION:
       global_->strM[number] = value;
       break;
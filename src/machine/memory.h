@@ -33,6 +33,7 @@
 #include <boost/serialization/version.hpp>
 
 #include <algorithm>
+#include <bitset>
 #include <map>
 #include <memory>
 #include <string>
@@ -87,6 +88,31 @@ BOOST_CLASS_VERSION(GlobalMemory, 1)
 
 struct dont_initialize {};
 
+// The values an integer bank held at the last savepoint, for the locations
+// that have been written since. Recording is a bit test, and committing a
+// savepoint clears the bitmap; the shadow values are only read for the
+// locations whose bit is set.
+struct OriginalIntBank {
+  // Remembers bank[location] if this is the first write since the savepoint.
+  void Record(const int* bank, int location) {
+    if (!dirty[location]) {
+      dirty.set(location);
+      values[location] = bank[location];
+    }
+  }
+
+  // Records every location in [begin, end).
+  void RecordRange(const int* bank, int begin, int end) {
+    for (int i = begin; i < end; ++i)
+      Record(bank, i);
+  }
+
+  void clear() { dirty.reset(); }
+
+  std::bitset<SIZE_OF_MEM_BANK> dirty;
+  int values[SIZE_OF_MEM_BANK];
+};
+
 // Struct that represents Local Memory. In any one rlvm process, lots
 // of these things will be created, because there are commands
 struct LocalMemory {
@@ -114,12 +140,12 @@ struct LocalMemory {
   // Savepoint(). Instead of doing some sort of copying entire memory banks
   // whenever we hit a Savepoint() call, only reconstruct the original memory
   // when we save.
-  std::map<int, int> original_intA;
-  std::map<int, int> original_intB;
-  std::map<int, int> original_intC;
-  std::map<int, int> original_intD;
-  std::map<int, int> original_intE;
-  std::map<int, int> original_intF;
+  OriginalIntBank original_intA;
+  OriginalIntBank original_intB;
+  OriginalIntBank original_intC;
+  OriginalIntBank original_intD;
+  OriginalIntBank original_intE;
+  OriginalIntBank original_intF;
   std::map<int, std::string> original_strS;
 
   std::string local_names[SIZE_OF_NAME_BANK];
@@ -138,6 +164,16 @@ struct LocalMemory {
     ar& merged;
   }
 
+  template <class Archive>
+  void saveArrayRevertingChanges(Archive& ar,
+                                 const int (&a)[SIZE_OF_MEM_BANK],
+                                 const OriginalIntBank& original) const {
+    int merged[SIZE_OF_MEM_BANK];
+    for (int i = 0; i < SIZE_OF_MEM_BANK; ++i)
+      merged[i] = original.dirty[i] ? original.values[i] : a[i];
+    ar& merged;
+  }
+
   // boost::serialization support
   template <class Archive>
   void save(Archive& ar, unsigned int version) const {
@@ -212,6 +248,18 @@ class Memory {
   // Sets the value of a certain memory location
   void SetIntValue(const libreallive::IntMemRef& ref, int value);
 
+  // Bulk versions of the above for |count| consecutive locations starting at
+  // |first|. They have the same effect as calling GetIntValue() or
+  // SetIntValue() in a loop, including throwing partway through a range that
+  // runs off the end of a bank, but work directly on the bank when the whole
+  // range is valid.
+  void GetIntValues(const libreallive::IntMemRef& first, int count, int* out);
+  void SetIntValues(const libreallive::IntMemRef& first,
+                    int count,
+                    const int* values);
+  void FillIntValues(const libreallive::IntMemRef& first, int count, int value);
+  int SumIntValues(const libreallive::IntMemRef& first, int count);
+
   // Returns the string value of a string memory bank
   const std::string& GetStringValue(int type, int location);
 
@@ -257,6 +305,12 @@ class Memory {
   // Connects the memory banks in local_ and in global_ into int_var.
   void ConnectIntVarPointers();
 
+  // Returns the bank for the bulk operations if [first, first + count) is
+  // entirely inside it, or NULL if they must go element by element.
+  int* GetBulkBank(const libreallive::IntMemRef& first,
+                   int count,
+                   OriginalIntBank** original);
+
   // Input validating function to the {get,set}(Local)?Name set of functions.
   void CheckNameIndex(int index, const std::string& name) const;
 
@@ -283,7 +337,7 @@ class Memory {
   int* int_var[NUMBER_OF_INT_LOCATIONS];
 
   // Change records for original.
-  std::map<int, int>* original_int_var[NUMBER_OF_INT_LOCATIONS];
+  OriginalIntBank* original_int_var[NUMBER_OF_INT_LOCATIONS];
 };  // end of class Memory
 
 // Implementation of getting an integer out of an array. Global because we need
@@ -41,6 +41,8 @@
 //
 // -----------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstdint>
 #include <sstream>
 #include <string>
 
@@ -60,17 +62,154 @@ void throwIllegalIndex(const IntMemRef& ref, const std::string& function) {
   throw rlvm::Exception(ss.str());
 }
 
-void saveOriginalValue(int* bank,
-                       std::map<int, int>* original_bank,
-                       int location) {
-  if (bank && original_bank) {
-    std::map<int, int>::iterator it = original_bank->find(location);
-    if (it == original_bank->end()) {
-      original_bank->emplace(location, bank[location]);
+// A bank viewed as an array of BITS wide unsigned integers, packed from the
+// least significant end of each word. PackedBank<32> is the plain int view.
+// The element size is a compile time constant so locating an element is a
+// shift and a mask instead of a division.
+template <int BITS>
+struct PackedBank {
+  static const unsigned int PER_WORD = 32 / BITS;
+  static const uint32_t MASK = BITS == 32 ? 0xffffffffu
+                                          : (1u << (BITS % 32)) - 1;
+  static const unsigned int SIZE = SIZE_OF_MEM_BANK * PER_WORD;
+
+  static int Get(const int* bank, unsigned int location) {
+    uint32_t word = bank[location / PER_WORD];
+    return (word >> (location % PER_WORD * BITS)) & MASK;
+  }
+
+  static void Set(int* bank, unsigned int location, int value) {
+    unsigned int shift = location % PER_WORD * BITS;
+    uint32_t word = bank[location / PER_WORD];
+    word = (word & ~(MASK << shift)) |
+           ((static_cast<uint32_t>(value) & MASK) << shift);
+    bank[location / PER_WORD] = word;
+  }
+
+  static void Read(const int* bank, int first, int count, int* out) {
+    for (int i = 0; i < count; ++i)
+      out[i] = Get(bank, first + i);
+  }
+
+  static void Write(int* bank, int first, int count, const int* values) {
+    for (int i = 0; i < count; ++i)
+      Set(bank, first + i, values[i]);
+  }
+
+  // Sets the partial words at either end element by element and the whole
+  // words in between with one fill.
+  static void Fill(int* bank, int first, int count, int value) {
+    unsigned int i = first;
+    unsigned int end = first + count;
+    for (; i < end && i % PER_WORD; ++i)
+      Set(bank, i, value);
+
+    unsigned int words_end = end / PER_WORD;
+    if (i / PER_WORD < words_end) {
+      uint32_t pattern = 0;
+      for (unsigned int j = 0; j < PER_WORD; ++j)
+        pattern |= (static_cast<uint32_t>(value) & MASK) << (j * BITS % 32);
+      std::fill(bank + i / PER_WORD, bank + words_end,
+                static_cast<int>(pattern));
+      i = words_end * PER_WORD;
     }
+
+    for (; i < end; ++i)
+      Set(bank, i, value);
   }
+
+  // Sums in unsigned arithmetic, which wraps the same way the element-wise
+  // int sum does in practice.
+  static int Sum(const int* bank, int first, int count) {
+    uint32_t total = 0;
+    for (int i = first; i < first + count; ++i)
+      total += static_cast<uint32_t>(Get(bank, i));
+    return static_cast<int>(total);
+  }
+};
+
+template <typename Bank>
+int CheckedGet(const IntMemRef& ref, const int* bank) {
+  if (static_cast<unsigned int>(ref.location()) >= Bank::SIZE)
+    throwIllegalIndex(ref, "RLMachine::GetIntValue()");
+  return Bank::Get(bank, ref.location());
+}
+
+template <typename Bank>
+void CheckedSet(const IntMemRef& ref,
+                int* bank,
+                OriginalIntBank* original_bank,
+                int value) {
+  if (static_cast<unsigned int>(ref.location()) >= Bank::SIZE)
+    throwIllegalIndex(ref, "RLMachine::SetIntValue()");
+  if (original_bank)
+    original_bank->Record(bank, ref.location() / Bank::PER_WORD);
+  Bank::Set(bank, ref.location(), value);
 }
 
+// Runs |op| with the PackedBank for access types 0 through 4.
+template <typename Op>
+void WithPackedBank(int type, const Op& op) {
+  switch (type) {
+    case 0: op(PackedBank<32>()); break;
+    case 1: op(PackedBank<1>()); break;
+    case 2: op(PackedBank<2>()); break;
+    case 3: op(PackedBank<4>()); break;
+    case 4: op(PackedBank<8>()); break;
+  }
+}
+
+// Bulk operations, as functors for WithPackedBank(). The ones that write
+// first record the original value of every word they touch.
+struct ReadOp {
+  const int* bank;
+  int first, count;
+  int* out;
+  template <typename Bank>
+  void operator()(Bank) const {
+    Bank::Read(bank, first, count, out);
+  }
+};
+
+struct WriteOp {
+  int* bank;
+  OriginalIntBank* original;
+  int first, count;
+  const int* values;
+  template <typename Bank>
+  void operator()(Bank) const {
+    if (original) {
+      original->RecordRange(bank, first / Bank::PER_WORD,
+                            (first + count - 1) / Bank::PER_WORD + 1);
+    }
+    Bank::Write(bank, first, count, values);
+  }
+};
+
+struct FillOp {
+  int* bank;
+  OriginalIntBank* original;
+  int first, count, value;
+  template <typename Bank>
+  void operator()(Bank) const {
+    if (original) {
+      original->RecordRange(bank, first / Bank::PER_WORD,
+                            (first + count - 1) / Bank::PER_WORD + 1);
+    }
+    Bank::Fill(bank, first, count, value);
+  }
+};
+
+struct SumOp {
+  const int* bank;
+  int first, count;
+  int* total;
+  template <typename Bank>
+  void operator()(Bank) const {
+    *total = Bank::Sum(bank, first, count);
+  }
+};
+
 }  // namespace
 
 int Memory::GetIntValue(const IntMemRef& ref) {
@@ -87,22 +226,23 @@ int Memory::GetIntValue(const IntMemRef& ref) {
     bank = int_var[index];
   }
 
-  if (type == 0) {
+  switch (type) {
     // A[]..G[], Z[] を直に読む
-    if ((unsigned int)(location) >= 2000)
-      throwIllegalIndex(ref, "RLMachine::GetIntValue()");
-
-    return bank[location];
-  } else {
+    case 0: return CheckedGet<PackedBank<32>>(ref, bank);
     // Ab[]..G4b[], Z8b[] などを読む
-    int factor = 1 << (type - 1);
-    int eltsize = 32 / factor;
-    if ((unsigned int)(location) >= (64000u / factor))
-      throwIllegalIndex(ref, "RLMachine::GetIntValue()");
-
-    return (bank[location / eltsize] >> ((location % eltsize) * factor)) &
-           ((1 << factor) - 1);
+    case 1: return CheckedGet<PackedBank<1>>(ref, bank);
+    case 2: return CheckedGet<PackedBank<2>>(ref, bank);
+    case 3: return CheckedGet<PackedBank<4>>(ref, bank);
+    case 4: return CheckedGet<PackedBank<8>>(ref, bank);
   }
+
+  int factor = 1 << (type - 1);
+  int eltsize = 32 / factor;
+  if ((unsigned int)(location) >= (64000u / factor))
+    throwIllegalIndex(ref, "RLMachine::GetIntValue()");
+
+  return (bank[location / eltsize] >> ((location % eltsize) * factor)) &
+         ((1 << factor) - 1);
 }
 
 void Memory::SetIntValue(const IntMemRef& ref, int value) {
@@ -111,7 +251,7 @@ void Memory::SetIntValue(const IntMemRef& ref, int value) {
   int location = ref.location();
 
   int* bank = NULL;
-  std::map<int, int>* original_bank = NULL;
+  OriginalIntBank* original_bank = NULL;
   if (index == 8) {
     bank = machine_.CurrentIntLBank();
   } else if (index < 0 || index > NUMBER_OF_INT_LOCATIONS) {
@@ -121,24 +261,112 @@ void Memory::SetIntValue(const IntMemRef& ref, int value) {
     original_bank = original_int_var[index];
   }
 
-  if (type == 0) {
+  switch (type) {
     // A[]..G[], Z[] を直に書く
-    if ((unsigned int)(location) >= 2000)
-      throwIllegalIndex(ref, "RLMachine::SetIntValue()");
-    saveOriginalValue(bank, original_bank, location);
-    bank[location] = value;
-  } else {
+    case 0: return CheckedSet<PackedBank<32>>(ref, bank, original_bank, value);
     // Ab[]..G4b[], Z8b[] などを書く
-    int factor = 1 << (type - 1);
-    int eltsize = 32 / factor;
-    int eltmask = (1 << factor) - 1;
-    int shift = (location % eltsize) * factor;
-    if ((unsigned int)(location) >= (64000u / factor))
-      throwIllegalIndex(ref, "RLMachine::SetIntValue()");
-
-    saveOriginalValue(bank, original_bank, location / eltsize);
-    bank[location / eltsize] =
-        (bank[location / eltsize] & ~(eltmask << shift)) | (value & eltmask)
-                                                               << shift;
+    case 1: return CheckedSet<PackedBank<1>>(ref, bank, original_bank, value);
+    case 2: return CheckedSet<PackedBank<2>>(ref, bank, original_bank, value);
+    case 3: return CheckedSet<PackedBank<4>>(ref, bank, original_bank, value);
+    case 4: return CheckedSet<PackedBank<8>>(ref, bank, original_bank, value);
+  }
+
+  int factor = 1 << (type - 1);
+  int eltsize = 32 / factor;
+  int eltmask = (1 << factor) - 1;
+  int shift = (location % eltsize) * factor;
+  if ((unsigned int)(location) >= (64000u / factor))
+    throwIllegalIndex(ref, "RLMachine::SetIntValue()");
+
+  if (original_bank)
+    original_bank->Record(bank, location / eltsize);
+  bank[location / eltsize] =
+      (bank[location / eltsize] & ~(eltmask << shift)) | (value & eltmask)
+                                                             << shift;
+}
+
+int* Memory::GetBulkBank(const IntMemRef& first,
+                         int count,
+                         OriginalIntBank** original) {
+  // intL[] lives in the stack frame and is left to the element-wise path.
+  int index = first.bank();
+  int type = first.type();
+  if (index < 0 || index >= NUMBER_OF_INT_LOCATIONS || type < 0 || type > 4)
+    return NULL;
+
+  int size = SIZE_OF_MEM_BANK * (32 >> (type ? type - 1 : 5));
+  if (first.location() < 0 || first.location() > size - count)
+    return NULL;
+
+  *original = original_int_var[index];
+  return int_var[index];
+}
+
+void Memory::GetIntValues(const IntMemRef& first, int count, int* out) {
+  if (count <= 0)
+    return;
+
+  OriginalIntBank* original = NULL;
+  if (const int* bank = GetBulkBank(first, count, &original)) {
+    WithPackedBank(first.type(),
+                   ReadOp{bank, first.location(), count, out});
+  } else {
+    for (int i = 0; i < count; ++i) {
+      out[i] = GetIntValue(
+          IntMemRef(first.bank(), first.type(), first.location() + i));
+    }
+  }
+}
+
+void Memory::SetIntValues(const IntMemRef& first,
+                          int count,
+                          const int* values) {
+  if (count <= 0)
+    return;
+
+  OriginalIntBank* original = NULL;
+  if (int* bank = GetBulkBank(first, count, &original)) {
+    WithPackedBank(first.type(),
+                   WriteOp{bank, original, first.location(), count, values});
+  } else {
+    for (int i = 0; i < count; ++i) {
+      SetIntValue(IntMemRef(first.bank(), first.type(), first.location() + i),
+                  values[i]);
+    }
+  }
+}
+
+void Memory::FillIntValues(const IntMemRef& first, int count, int value) {
+  if (count <= 0)
+    return;
+
+  OriginalIntBank* original = NULL;
+  if (int* bank = GetBulkBank(first, count, &original)) {
+    WithPackedBank(first.type(),
+                   FillOp{bank, original, first.location(), count, value});
+  } else {
+    for (int i = 0; i < count; ++i) {
+      SetIntValue(IntMemRef(first.bank(), first.type(), first.location() + i),
+                  value);
+    }
+  }
+}
+
+int Memory::SumIntValues(const IntMemRef& first, int count) {
+  if (count <= 0)
+    return 0;
+
+  int total = 0;
+  OriginalIntBank* original = NULL;
+  if (const int* bank = GetBulkBank(first, count, &original)) {
+    WithPackedBank(first.type(), SumOp{bank, first.location(), count, &total});
+  } else {
+    uint32_t sum = 0;
+    for (int i = 0; i < count; ++i) {
+      sum += static_cast<uint32_t>(GetIntValue(
+          IntMemRef(first.bank(), first.type(), first.location() + i)));
+    }
+    total = static_cast<int>(sum);
   }
+  return total;
 }
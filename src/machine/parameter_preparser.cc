@@ -0,0 +1,72 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "machine/parameter_preparser.h"
+
+#include <iomanip>
+#include <iostream>
+
+#include "libreallive/archive.h"
+#include "machine/rlmachine.h"
+#include "machine/rloperation.h"
+
+ParameterPreparser::ParameterPreparser(RLMachine& machine,
+                                       libreallive::Archive& archive,
+                                       int thread_count,
+                                       bool report)
+    : machine_(machine), archive_(archive), report_(report) {
+  archive_.SetParameterParser(this, thread_count);
+}
+
+ParameterPreparser::~ParameterPreparser() {
+  archive_.SetParameterParser(NULL, 1);
+}
+
+void ParameterPreparser::ParseCommand(
+    const libreallive::CommandElement& command) {
+  RLOperation* op = machine_.FindOperation(command);
+  if (!op)
+    return;
+
+  try {
+    op->CacheParsedParameters(command);
+  }
+  catch (...) {
+    // Unimplemented opcodes and malformed parameters are reported when the
+    // command is executed, with the machine state to go along with them.
+  }
+}
+
+void ParameterPreparser::OnScenarioParsed(
+    const libreallive::Scenario& scenario) {
+  if (report_) {
+    std::cerr << "(SEEN" << std::setw(4) << std::setfill('0')
+              << scenario.scene_number() << ") Parsed "
+              << scenario.preparsed_command_count() << " commands in "
+              << scenario.preparse_time().count() << "us" << std::endl;
+  }
+}
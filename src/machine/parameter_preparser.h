@@ -0,0 +1,67 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#ifndef SRC_MACHINE_PARAMETER_PREPARSER_H_
+#define SRC_MACHINE_PARAMETER_PREPARSER_H_
+
+#include "libreallive/scenario.h"
+
+namespace libreallive {
+class Archive;
+}  // namespace libreallive
+
+class RLMachine;
+
+// Parses the parameters of every command in a scenario when the scenario is
+// loaded, instead of the first time each command runs. This moves the parsing
+// off the hot path of the interpreter and lets it be split across threads.
+//
+// Registers itself with the archive for its lifetime. Commands that fail to
+// parse are left alone and are parsed, and throw, when they are executed.
+class ParameterPreparser : public libreallive::ParameterParser {
+ public:
+  // Parses on |thread_count| threads. If |report| is set, prints how long each
+  // scenario took to stderr.
+  ParameterPreparser(RLMachine& machine,
+                     libreallive::Archive& archive,
+                     int thread_count,
+                     bool report);
+  virtual ~ParameterPreparser();
+
+  // libreallive::ParameterParser:
+  virtual void ParseCommand(
+      const libreallive::CommandElement& command) override;
+  virtual void OnScenarioParsed(
+      const libreallive::Scenario& scenario) override;
+
+ private:
+  RLMachine& machine_;
+  libreallive::Archive& archive_;
+  bool report_;
+};
+
+#endif  // SRC_MACHINE_PARAMETER_PREPARSER_H_
@@ -27,6 +27,8 @@
 
 #include "machine/reference.h"
 
+#include <algorithm>
+#include <numeric>
 #include <string>
 
 #include "machine/memory.h"
@@ -87,3 +89,38 @@ bool StringAccessor::operator==(const std::string& rhs) {
 StringAccessor& StringAccessor::operator=(const StringAccessor& rhs) {
   return operator=(rhs.operator std::string());
 }
+
+// -----------------------------------------------------------------------
+// Bulk operations
+// -----------------------------------------------------------------------
+
+void ReadIntRange(IntReferenceIterator first, int count, int* out) {
+  if (first.memory())
+    first.memory()->GetIntValues(IntMemRef(first.type(), first.location()),
+                                 count, out);
+  else
+    std::copy_n(first, std::max(count, 0), out);
+}
+
+void WriteIntRange(IntReferenceIterator first, int count, const int* values) {
+  if (first.memory())
+    first.memory()->SetIntValues(IntMemRef(first.type(), first.location()),
+                                 count, values);
+  else
+    std::copy_n(values, std::max(count, 0), first);
+}
+
+void FillIntRange(IntReferenceIterator first, int count, int value) {
+  if (first.memory())
+    first.memory()->FillIntValues(IntMemRef(first.type(), first.location()),
+                                  count, value);
+  else
+    std::fill_n(first, std::max(count, 0), value);
+}
+
+int SumIntRange(IntReferenceIterator first, int count) {
+  if (first.memory())
+    return first.memory()->SumIntValues(
+        IntMemRef(first.type(), first.location()), count);
+  return std::accumulate(first, first + std::max(count, 0), 0);
+}
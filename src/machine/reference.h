@@ -104,6 +104,9 @@ class MemoryReferenceIterator
   int type() const { return type_; }
   int location() const { return location_; }
 
+  // The memory this iterator points into, or NULL for the store register.
+  Memory* memory() const { return memory_; }
+
   // -------------------------------------------------------- Iterated Interface
   ACCESS operator*() { return ACCESS(this); }
 
@@ -204,4 +207,13 @@ typedef MemoryReferenceIterator<IntAccessor> IntReferenceIterator;
 // Defines a MemoryReferenceIterator that operates on the string memory
 typedef MemoryReferenceIterator<StringAccessor> StringReferenceIterator;
 
+// Bulk operations on |count| consecutive integers starting at |first|. These
+// have the same effect as the equivalent std::copy_n(), std::fill_n() and
+// std::accumulate() calls, but go through Memory's bulk accessors instead of
+// one IntAccessor per element.
+void ReadIntRange(IntReferenceIterator first, int count, int* out);
+void WriteIntRange(IntReferenceIterator first, int count, const int* values);
+void FillIntRange(IntReferenceIterator first, int count, int value);
+int SumIntRange(IntReferenceIterator first, int count);
+
 #endif  // SRC_MACHINE_REFERENCE_H_
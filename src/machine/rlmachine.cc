@@ -77,19 +77,6 @@ using std::endl;
 
 namespace {
 
-// Seen files are terminated with the string "SeenEnd", which isn't NULL
-// terminated and has a bunch of random garbage after it.
-const char seen_end[] = {130, 114,  // S
-                         130, 133,  // e
-                         130, 133,  // e
-                         130, 142,  // n
-                         130, 100,  // E
-                         130, 142,  // n
-                         130, 132   // d
-};
-
-const std::string SeenEnd(seen_end, 14);
-
 bool IsNotLongOp(StackFrame& frame) {
   return frame.frame_type != StackFrame::TYPE_LONGOP;
 }
@@ -106,6 +93,10 @@ RLMachine::RLMachine(System& in_system, libreallive::Archive& in_archive)
       system_(in_system) {
   // Search in the Gameexe for #SEEN_START and place us there
   Gameexe& gameexe = in_system.gameexe();
+  savepoint_message_key_ = gameexe.GetHandle("SAVEPOINT_MESSAGE");
+  savepoint_selcom_key_ = gameexe.GetHandle("SAVEPOINT_SELCOM");
+  savepoint_seentop_key_ = gameexe.GetHandle("SAVEPOINT_SEENTOP");
+
   libreallive::Scenario* scenario = NULL;
   if (gameexe.Exists("SEEN_START")) {
     int first_seen = gameexe("SEEN_START").ToInt();
@@ -199,7 +190,7 @@ void RLMachine::MarkSavepoint() {
 }
 
 bool RLMachine::SavepointDecide(AttributeFunction func,
-                                const std::string& gameexe_key) const {
+                                const GameexeKeyHandle& gameexe_key) const {
   if (!mark_savepoints_)
     return false;
 
@@ -211,9 +202,8 @@ bool RLMachine::SavepointDecide(AttributeFunction func,
 
   //
   // check Gameexe key
-  Gameexe& gexe = system_.gameexe();
-  if (gexe.Exists(gameexe_key)) {
-    int value = gexe(gameexe_key);
+  if (gameexe_key.Exists()) {
+    int value = gameexe_key.ToInt();
     if (value == 0)
       return false;
     else if (value == 1)
@@ -228,17 +218,17 @@ void RLMachine::SetMarkSavepoints(const int in) { mark_savepoints_ = in; }
 
 bool RLMachine::ShouldSetMessageSavepoint() const {
   return SavepointDecide(&libreallive::Scenario::savepoint_message,
-                         "SAVEPOINT_MESSAGE");
+                         savepoint_message_key_);
 }
 
 bool RLMachine::ShouldSetSelcomSavepoint() const {
   return SavepointDecide(&libreallive::Scenario::savepoint_selcom,
-                         "SAVEPOINT_SELCOM");
+                         savepoint_selcom_key_);
 }
 
 bool RLMachine::ShouldSetSeentopSavepoint() const {
   return SavepointDecide(&libreallive::Scenario::savepoint_seentop,
-                         "SAVEPOINT_SEENTOP");
+                         savepoint_seentop_key_);
 }
 
 void RLMachine::ExecuteNextInstruction() {
@@ -339,6 +329,13 @@ void RLMachine::ExecuteCommand(const libreallive::CommandElement& f) {
   }
 }
 
+RLOperation* RLMachine::FindOperation(
+    const libreallive::CommandElement& f) const {
+  ModuleMap::const_iterator it =
+      modules_.find(PackModuleNumber(f.modtype(), f.module()));
+  return it != modules_.end() ? it->second->FindOperation(f) : NULL;
+}
+
 void RLMachine::Jump(int scenario_num, int entrypoint) {
   // Check to make sure it's a valid scenario
   libreallive::Scenario* scenario = archive_.GetScenario(scenario_num);
@@ -550,9 +547,15 @@ int RLMachine::GetProbableEncodingType() const {
 }
 
 void RLMachine::PerformTextout(const libreallive::TextoutElement& e) {
+  // Most text was already converted when the scenario was loaded.
+  if (const DisplayText* text = e.display_text()) {
+    RunTextout(new TextoutLongOperation(*this, *text));
+    return;
+  }
+
   std::string unparsed_text = e.GetText();
-  if (boost::starts_with(unparsed_text, SeenEnd)) {
-    unparsed_text = SeenEnd;
+  if (boost::starts_with(unparsed_text, libreallive::SeenEnd)) {
+    unparsed_text = libreallive::SeenEnd;
     Halt();
   }
 
@@ -572,11 +575,14 @@ void RLMachine::PerformTextout(const std::string& cp932str) {
   }
 
   std::string utf8str = cp932toUTF8(name_parsed_text, GetTextEncoding());
-  TextSystem& ts = system().text();
 
   // Display UTF-8 characters
-  std::unique_ptr<TextoutLongOperation> ptr(
-      new TextoutLongOperation(*this, utf8str));
+  RunTextout(new TextoutLongOperation(*this, utf8str));
+}
+
+void RLMachine::RunTextout(TextoutLongOperation* operation) {
+  std::unique_ptr<TextoutLongOperation> ptr(operation);
+  TextSystem& ts = system().text();
 
   if (system().ShouldFastForward() ||
       ts.message_no_wait() ||
@@ -645,7 +651,7 @@ int RLMachine::CallDLL(int slot,
   }
 }
 
-unsigned int RLMachine::PackModuleNumber(int modtype, int module) {
+unsigned int RLMachine::PackModuleNumber(int modtype, int module) const {
   return (modtype << 8) | module;
 }
 
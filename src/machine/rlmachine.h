@@ -39,6 +39,7 @@
 #include <vector>
 
 #include "libreallive/bytecode_fwd.h"
+#include "libreallive/gameexe.h"
 #include "libreallive/scenario.h"
 
 namespace libreallive {
@@ -50,8 +51,10 @@ class LongOperation;
 class Memory;
 class OpcodeLog;
 class RLModule;
+class RLOperation;
 class RealLiveDLL;
 class System;
+class TextoutLongOperation;
 struct StackFrame;
 
 // The RealLive virtual machine implementation. This class is the main user
@@ -137,7 +140,7 @@ class RLMachine {
   //   return. On any other value, we fall through to...
   // - Check a Gameexe key, which has the final say.
   bool SavepointDecide(AttributeFunction func,
-                       const std::string& gameexe_key) const;
+                       const GameexeKeyHandle& gameexe_key) const;
 
   // Whether the DisableAutoSavepoints override is on. This is
   // triggered purely from bytecode.
@@ -236,6 +239,9 @@ class RLMachine {
   int GetProbableEncodingType() const;
 
   void ExecuteCommand(const libreallive::CommandElement& f);
+
+  // Returns the operation that would run |f|, or NULL if no module handles it.
+  RLOperation* FindOperation(const libreallive::CommandElement& f) const;
   void ExecuteExpression(const libreallive::ExpressionElement& e);
   void PerformTextout(const libreallive::TextoutElement& e);
   void PerformTextout(const std::string& cp932str);
@@ -311,7 +317,7 @@ class RLMachine {
   // it will.
   void SetHaltOnException(bool halt_on_exception);
 
-  unsigned int PackModuleNumber(int modtype, int module);
+  unsigned int PackModuleNumber(int modtype, int module) const;
 
   // Pushes a stack frame onto the call stack, alerting possible
   // LongOperations of this change if needed.
@@ -348,6 +354,10 @@ class RLMachine {
   void AddLineAction(const int seen, const int line, std::function<void(void)>);
 
  private:
+  // Runs |operation| once and pushes it onto the stack if it didn't finish.
+  // Takes ownership of |operation|.
+  void RunTextout(TextoutLongOperation* operation);
+
   // The Reallive VM's integer and string memory
   std::unique_ptr<Memory> memory_;
 
@@ -393,6 +403,11 @@ class RLMachine {
   // Override defaults
   bool mark_savepoints_ = true;
 
+  // #SAVEPOINT_* keys, checked on every message, selection and scenario start.
+  GameexeKeyHandle savepoint_message_key_;
+  GameexeKeyHandle savepoint_selcom_key_;
+  GameexeKeyHandle savepoint_seentop_key_;
+
   // Whether the stack was modified during the running of a
   // LongOperation. Used to signal that any stack mutating functions should be
   // be placed in |delay_modifications_| for execution later.
@@ -153,6 +153,13 @@ void RLModule::DispatchFunction(RLMachine& machine,
   }
 }
 
+RLOperation* RLModule::FindOperation(
+    const libreallive::CommandElement& f) const {
+  OpcodeMap::const_iterator it =
+      stored_operations_.find(PackOpcodeNumber(f.opcode(), f.overload()));
+  return it != stored_operations_.end() ? it->second.get() : NULL;
+}
+
 std::ostream& operator<<(std::ostream& os, const RLModule& module) {
   os << "mod<" << module.module_name() << "," << module.module_type() << ":"
      << module.module_number() << ">";
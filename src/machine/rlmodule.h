@@ -130,6 +130,9 @@ class RLModule {
   void DispatchFunction(RLMachine& machine,
                         const libreallive::CommandElement& f);
 
+  // Returns the operation in this module that handles |f|, or NULL.
+  RLOperation* FindOperation(const libreallive::CommandElement& f) const;
+
   OpcodeMap::iterator begin() { return stored_operations_.begin(); }
   OpcodeMap::iterator end() { return stored_operations_.end(); }
 
@@ -90,12 +90,7 @@ bool RLOperation::AdvanceInstructionPointer() { return true; }
 
 void RLOperation::DispatchFunction(RLMachine& machine,
                                    const libreallive::CommandElement& ff) {
-  if (!ff.AreParametersParsed()) {
-    std::vector<std::string> unparsed = ff.GetUnparsedParameters();
-    libreallive::ExpressionPiecesVector output;
-    ParseParameters(unparsed, output);
-    ff.SetParsedParameters(std::move(output));
-  }
+  CacheParsedParameters(ff);
 
   const libreallive::ExpressionPiecesVector& parameter_pieces =
       ff.GetParsedParameters();
@@ -110,6 +105,15 @@ void RLOperation::DispatchFunction(RLMachine& machine,
     machine.AdvanceInstructionPointer();
 }
 
+void RLOperation::CacheParsedParameters(const libreallive::CommandElement& f) {
+  if (!f.AreParametersParsed()) {
+    std::vector<libreallive::ByteSpan> unparsed = f.GetUnparsedParameters();
+    libreallive::ExpressionPiecesVector output;
+    ParseParameters(unparsed, output);
+    f.SetParsedParameters(std::move(output));
+  }
+}
+
 // Implementation for IntConstant_T
 IntConstant_T::type IntConstant_T::getData(
     RLMachine& machine,
@@ -121,9 +125,9 @@ IntConstant_T::type IntConstant_T::getData(
 // Was working to change the verify_type to parse_parameters.
 void IntConstant_T::ParseParameters(
     unsigned int& position,
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output) {
-  const char* data = input.at(position).c_str();
+  const char* data = input.at(position).data();
   libreallive::ExpressionPiece ep(libreallive::GetData(data));
 
   if (ep.GetExpressionValueType() != libreallive::ValueTypeInteger) {
@@ -146,9 +150,9 @@ IntReference_T::type IntReference_T::getData(
 
 void IntReference_T::ParseParameters(
     unsigned int& position,
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output) {
-  const char* data = input.at(position).c_str();
+  const char* data = input.at(position).data();
   libreallive::ExpressionPiece ep(libreallive::GetData(data));
 
   if (ep.GetExpressionValueType() != libreallive::ValueTypeInteger) {
@@ -201,15 +205,25 @@ StrConstant_T::type StrConstant_T::getData(
   // So to fix this, we break the COW semantics here by forcing a copy. I'd
   // prefer to do this in RLMachine or Memory, but I can't because they return
   // references.
+  //
+  // Operations that only read their string should use StrView_T, which skips
+  // the copy entirely.
   string tmp = p[position++].GetStringValue(machine);
   return string(tmp.data(), tmp.size());
 }
 
+StrView_T::type StrView_T::getData(
+    RLMachine& machine,
+    const libreallive::ExpressionPiecesVector& p,
+    unsigned int& position) {
+  return p[position++].GetStringValue(machine);
+}
+
 void StrConstant_T::ParseParameters(
     unsigned int& position,
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output) {
-  const char* data = input.at(position).c_str();
+  const char* data = input.at(position).data();
   libreallive::ExpressionPiece ep(libreallive::GetData(data));
 
   if (ep.GetExpressionValueType() != libreallive::ValueTypeString) {
@@ -232,9 +246,9 @@ StrReference_T::type StrReference_T::getData(
 
 void StrReference_T::ParseParameters(
     unsigned int& position,
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output) {
-  const char* data = input.at(position).c_str();
+  const char* data = input.at(position).data();
   libreallive::ExpressionPiece ep(libreallive::GetData(data));
 
   if (ep.GetExpressionValueType() != libreallive::ValueTypeString) {
@@ -255,10 +269,10 @@ void RLOp_SpecialCase::Dispatch(
 }
 
 void RLOp_SpecialCase::ParseParameters(
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output) {
   for (auto const& parameter : input) {
-    const char* src = parameter.c_str();
+    const char* src = parameter.data();
     output.push_back(libreallive::GetData(src));
   }
 }
@@ -266,12 +280,7 @@ void RLOp_SpecialCase::ParseParameters(
 void RLOp_SpecialCase::DispatchFunction(RLMachine& machine,
                                         const libreallive::CommandElement& ff) {
   // First try to run the default parse_parameters if we can.
-  if (!ff.AreParametersParsed()) {
-    std::vector<std::string> unparsed = ff.GetUnparsedParameters();
-    libreallive::ExpressionPiecesVector output;
-    ParseParameters(unparsed, output);
-    ff.SetParsedParameters(std::move(output));
-  }
+  CacheParsedParameters(ff);
 
   // Pass this on to the implementation of this functor.
   operator()(machine, ff);
@@ -279,7 +288,7 @@ void RLOp_SpecialCase::DispatchFunction(RLMachine& machine,
 
 template <>
 void RLNormalOpcode<>::ParseParameters(
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output) {
 }
 
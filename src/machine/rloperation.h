@@ -33,6 +33,7 @@
 #include <type_traits>
 #include <vector>
 
+#include "libreallive/alldefs.h"
 #include "libreallive/bytecode_fwd.h"
 #include "libreallive/expression.h"
 #include "machine/rloperation/references.h"
@@ -52,8 +53,8 @@ class RLModule;
 // parameters.
 //
 // Valid type parameters are IntConstant_T, IntReference_T,
-// StrConstant_T, StrReference_T, Argc_T< U > (takes another type as a
-// parameter). The type parameters change the arguments to the
+// StrConstant_T, StrView_T, StrReference_T, Argc_T< U > (takes another type
+// as a parameter). The type parameters change the arguments to the
 // implementation function.
 //
 // Let's say we want to implement an operation with the following
@@ -120,13 +121,17 @@ class RLOperation {
 
   // Parses the parameters in the CommandElement passed in into an
   // output vector that contains parsed ExpressionPieces for each
-  virtual void ParseParameters(const std::vector<std::string>& input,
+  virtual void ParseParameters(const std::vector<libreallive::ByteSpan>& input,
                                libreallive::ExpressionPiecesVector& output) = 0;
 
   // The public interface used by the RLModule; how a method is Dispatched.
   virtual void DispatchFunction(RLMachine& machine,
                                 const libreallive::CommandElement& f);
 
+  // Parses |f|'s parameters and caches them on |f|, unless that was already
+  // done. Called on first dispatch, or ahead of time by ParameterPreparser.
+  void CacheParsedParameters(const libreallive::CommandElement& f);
+
  private:
   friend class RLModule;
   friend class MappedRLModule;
@@ -165,7 +170,7 @@ struct IntConstant_T {
 
   // Parse the raw parameter string and put the results in ExpressionPiece
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output);
 
   enum { is_complex = false };
@@ -188,12 +193,42 @@ struct StrConstant_T {
 
   // Parse the raw parameter string and put the results in ExpressionPiece
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output);
 
   enum { is_complex = false };
 };
 
+// Type definition for a constant string value that the operation only reads.
+//
+// StrConstant_T copies its string out of string memory or the scenario's
+// constant pool. StrView_T passes a reference to the original instead. The
+// reference is only valid for the duration of the call, and it may alias
+// string memory: an operation has to finish reading it before it writes to
+// string memory, and must copy it if it keeps it. Operations that modify the
+// parameter in place should use StrConstant_T.
+//
+// This struct is used to define the parameter types of a RLOperation
+// subclass, and should not be used directly.
+struct StrView_T {
+  // The output type of this type struct
+  typedef const std::string& type;
+
+  // Returns a reference to the parameter's string.
+  static type getData(RLMachine& machine,
+                      const libreallive::ExpressionPiecesVector& p,
+                      unsigned int& position);
+
+  // Parse the raw parameter string and put the results in ExpressionPiece
+  static void ParseParameters(unsigned int& position,
+                              const std::vector<libreallive::ByteSpan>& input,
+                              libreallive::ExpressionPiecesVector& output) {
+    StrConstant_T::ParseParameters(position, input, output);
+  }
+
+  enum { is_complex = false };
+};
+
 struct empty_struct {};
 
 // Defines a null type for the Special parameter.
@@ -209,7 +244,7 @@ struct Empty_T {
 
   // Parse the raw parameter string and put the results in ExpressionPiece
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output) {}
 
   enum { is_complex = false };
@@ -240,7 +275,7 @@ class RLOp_SpecialCase : public RLOperation {
   // Default implementation that simply parses everything as data;
   // doesn't work in the case of complex expressions.
   virtual void ParseParameters(
-      const std::vector<std::string>& input,
+      const std::vector<libreallive::ByteSpan>& input,
       libreallive::ExpressionPiecesVector& output) override;
 
   // Method that is overridden by all subclasses to implement the
@@ -256,7 +291,7 @@ struct _sentinel_type {};
 template <typename T>
 void ParseEachParameter(
     unsigned int& position,
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output,
     typename std::enable_if<std::is_same<T, _sentinel_type>::value,
     int>::type* dummy = nullptr) {
@@ -266,7 +301,7 @@ void ParseEachParameter(
 template <typename T, typename... Args>
 void ParseEachParameter(
     unsigned int& position,
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output,
     typename std::enable_if<!std::is_same<T, _sentinel_type>::value,
     int>::type* dummy = nullptr) {
@@ -307,7 +342,7 @@ class RLNormalOpcode : public RLOperation {
   virtual ~RLNormalOpcode();
 
   virtual void ParseParameters(
-      const std::vector<std::string>& input,
+      const std::vector<libreallive::ByteSpan>& input,
       libreallive::ExpressionPiecesVector& output) final;
 };
 
@@ -319,7 +354,7 @@ RLNormalOpcode<Args...>::~RLNormalOpcode() {}
 
 template <typename... Args>
 void RLNormalOpcode<Args...>::ParseParameters(
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output) {
   unsigned int position = 0;
   internal::ParseEachParameter<Args..., internal::_sentinel_type>(
@@ -329,7 +364,7 @@ void RLNormalOpcode<Args...>::ParseParameters(
 // Specialization for empty template list
 template <>
 void RLNormalOpcode<>::ParseParameters(
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output);
 
 template <typename... Args>
@@ -49,7 +49,7 @@ struct Argc_T {
 
   // Parse the raw parameter string and put the results in ExpressionPiece
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output);
 
   enum { is_complex = false };
@@ -69,7 +69,7 @@ typename Argc_T<CON>::type Argc_T<CON>::getData(
 
 template <typename CON>
 void Argc_T<CON>::ParseParameters(unsigned int& position,
-                                  const std::vector<std::string>& input,
+                                  const std::vector<libreallive::ByteSpan>& input,
                                   libreallive::ExpressionPiecesVector& output) {
   for (; position < input.size();) {
     CON::ParseParameters(position, input, output);
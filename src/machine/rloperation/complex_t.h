@@ -47,7 +47,7 @@ struct Complex_T {
                       unsigned int& position);
 
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output);
 
   enum { is_complex = true };
@@ -69,9 +69,9 @@ Complex_T<Args...>::getData(RLMachine& machine,
 template <typename... Args>
 void Complex_T<Args...>::ParseParameters(
     unsigned int& position,
-    const std::vector<std::string>& input,
+    const std::vector<libreallive::ByteSpan>& input,
     libreallive::ExpressionPiecesVector& output) {
-  const char* data = input.at(position).c_str();
+  const char* data = input.at(position).data();
   libreallive::ExpressionPiece ep(libreallive::GetComplexParam(data));
   output.push_back(std::move(ep));
   position++;
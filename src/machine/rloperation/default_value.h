@@ -26,6 +26,7 @@
 #include <string>
 #include <vector>
 
+#include "libreallive/alldefs.h"
 #include "libreallive/expression.h"
 
 template <int DEFAULTVAL>
@@ -45,7 +46,7 @@ struct DefaultIntValue_T {
   }
 
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output) {
     if (position < input.size()) {
       IntConstant_T::ParseParameters(position, input, output);
@@ -76,7 +77,7 @@ struct DefaultStrValue_T {
   }
 
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output) {
     if (position < input.size()) {
       StrConstant_T::ParseParameters(position, input, output);
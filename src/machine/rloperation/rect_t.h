@@ -45,7 +45,7 @@ struct Point_T {
   }
 
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output) {
     IntConstant_T::ParseParameters(position, input, output);
     IntConstant_T::ParseParameters(position, input, output);
@@ -87,7 +87,7 @@ struct Rect_T {
 
   // Parse the raw parameter string and put the results in ExpressionPiece
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output) {
     IntConstant_T::ParseParameters(position, input, output);
     IntConstant_T::ParseParameters(position, input, output);
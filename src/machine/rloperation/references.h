@@ -26,8 +26,9 @@
 #include <string>
 #include <vector>
 
-#include "machine/reference.h"
+#include "libreallive/alldefs.h"
 #include "libreallive/expression.h"
+#include "machine/reference.h"
 
 // Type definition for a reference into the RLMachine's memory,
 // referencing an integer value.
@@ -47,7 +48,7 @@ struct IntReference_T {
 
   // Parse the raw parameter string and put the results in ExpressionPiece
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output);
 
   enum { is_complex = false };
@@ -71,7 +72,7 @@ struct StrReference_T {
 
   // Parse the raw parameter string and put the results in ExpressionPiece
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output);
 
   enum { is_complex = false };
@@ -46,7 +46,7 @@ struct RGBColour_T {
   }
 
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output) {
     IntConstant_T::ParseParameters(position, input, output);
     IntConstant_T::ParseParameters(position, input, output);
@@ -78,7 +78,7 @@ struct RGBMaybeAColour_T {
   }
 
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output) {
     IntConstant_T::ParseParameters(position, input, output);
     IntConstant_T::ParseParameters(position, input, output);
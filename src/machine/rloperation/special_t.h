@@ -152,9 +152,9 @@ struct Special_T {
   }
 
   static void ParseParameters(unsigned int& position,
-                              const std::vector<std::string>& input,
+                              const std::vector<libreallive::ByteSpan>& input,
                               libreallive::ExpressionPiecesVector& output) {
-    const char* data = input.at(position).c_str();
+    const char* data = input.at(position).data();
     output.emplace_back(libreallive::GetData(data));
     position++;
   }
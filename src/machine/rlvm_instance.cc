@@ -26,21 +26,28 @@
 
 #include "machine/rlvm_instance.h"
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 
 #include "libreallive/gameexe.h"
 #include "libreallive/reallive.h"
 #include "machine/dump_scenario.h"
 #include "machine/game_hacks.h"
+#include "machine/long_operation.h"
 #include "machine/memory.h"
+#include "machine/parameter_preparser.h"
 #include "machine/rlmachine.h"
 #include "machine/serialization.h"
 #include "modules/module_sys_save.h"
 #include "modules/modules.h"
 #include "platforms/gcn/gcn_platform.h"
 #include "systems/base/event_system.h"
+#include "systems/base/frame_telemetry.h"
 #include "systems/base/graphics_system.h"
+#include "systems/base/input_trace.h"
 #include "systems/base/system_error.h"
 #include "systems/sdl/sdl_system.h"
 #include "utf8cpp/utf8.h"
@@ -60,6 +67,10 @@ const char* siglus_exes[] = {"siglus.exe",       "siglusengine-ch.exe",
                              "siglusengine.exe", "siglusenginechs.exe",
                              NULL};
 
+// The longest the game loop sleeps while idle, in case something that needs
+// to run doesn't schedule a wakeup.
+const unsigned int kMaxIdleSleepMs = 250;
+
 RLVMInstance::RLVMInstance()
     : seen_start_(-1),
       memory_(false),
@@ -67,7 +78,11 @@ RLVMInstance::RLVMInstance()
       count_undefined_copcodes_(false),
       tracing_(false),
       load_save_(-1),
-      dump_seen_(-1) {
+      dump_seen_(-1),
+      pcm_cache_size_(-1),
+      present_rate_(-1),
+      prepare_display_text_(true),
+      preparse_threads_(0) {
   srand(time(NULL));
 }
 
@@ -92,6 +107,12 @@ void RLVMInstance::Run(const boost::filesystem::path& gamerootPath) {
     if (memory_)
       gameexe("MEMORY") = 1;
 
+    if (pcm_cache_size_ != -1)
+      gameexe("__PCM_CACHE_SIZE") = pcm_cache_size_;
+
+    if (present_rate_ != -1)
+      gameexe("__PRESENT_RATE") = present_rate_;
+
     if (!custom_font_.empty()) {
       if (!fs::exists(custom_font_)) {
         throw rlvm::UserPresentableError(
@@ -104,6 +125,7 @@ void RLVMInstance::Run(const boost::filesystem::path& gamerootPath) {
     }
 
     libreallive::Archive arc(seenPath.string(), gameexe("REGNAME"));
+    arc.set_prepare_display_text(prepare_display_text_);
     if (dump_seen_ != -1) {
       libreallive::Scenario* scenario = arc.GetScenario(dump_seen_);
       DumpScenario(scenario);
@@ -115,6 +137,12 @@ void RLVMInstance::Run(const boost::filesystem::path& gamerootPath) {
     AddAllModules(rlmachine);
     AddGameHacks(rlmachine);
 
+    std::unique_ptr<ParameterPreparser> preparser;
+    if (preparse_threads_ > 0) {
+      preparser.reset(
+          new ParameterPreparser(rlmachine, arc, preparse_threads_, true));
+    }
+
     // Validate our font file
     // TODO(erg): Remove this when we switch to native font selection dialogs.
     fs::path fontFile = FindFontFile(sdlSystem);
@@ -147,6 +175,24 @@ void RLVMInstance::Run(const boost::filesystem::path& gamerootPath) {
     // user data is going to be screwed!
     DoUserNameCheck(rlmachine);
 
+    EventSystem& event = sdlSystem.event();
+    if (!replay_input_path_.empty()) {
+      std::ifstream in(replay_input_path_.string().c_str());
+      if (!in) {
+        throw rlvm::UserPresentableError(
+            _("Could not open input trace."),
+            _("Please make sure the file given with --replay-input exists."));
+      }
+
+      std::unique_ptr<InputTrace> trace = InputTrace::Load(in);
+      srand(trace->seed());
+      event.StartReplayingInput(std::move(trace));
+    } else if (!record_input_path_.empty()) {
+      unsigned int seed = time(NULL);
+      srand(seed);
+      event.StartRecordingInput(seed);
+    }
+
     rlmachine.SetHaltOnException(false);
 
     if (load_save_ != -1)
@@ -157,31 +203,70 @@ void RLVMInstance::Run(const boost::filesystem::path& gamerootPath) {
       // etc.
       sdlSystem.Run(rlmachine);
 
+      if (event.replay_finished()) {
+        sdlSystem.telemetry().WriteSceneTotals(std::cout);
+        break;
+      }
+
       // Run the rlmachine through as many instructions as we can in a 10ms time
-      // slice. Bail out if we switch to long operation mode, or if the screen
-      // is marked as dirty.
-      unsigned int start_ticks = sdlSystem.event().GetTicks();
+      // slice. Bail out if we switch to long operation mode, if the screen
+      // is marked as dirty, or if presentation is paced and a redraw is due.
+      // When replaying, run exactly as many instructions as were recorded.
+      // The slice is measured on the live clock since GetTicks() holds still
+      // within a frame while recording.
+      GraphicsSystem& graphics = sdlSystem.graphics();
+      bool replaying = event.replaying_input();
+      int replay_instructions = event.GetReplayedInstructions();
+      bool paced = graphics.GetPresentInterval() != 0;
+      FrameTelemetry& telemetry = sdlSystem.telemetry();
+      uint64_t burst_start_us = telemetry.GetMicroseconds();
+      int instructions = 0;
+      unsigned int start_ticks = event.GetLiveMicroseconds() / 1000;
       unsigned int end_ticks = start_ticks;
       do {
         rlmachine.ExecuteNextInstruction();
-        end_ticks = sdlSystem.event().GetTicks();
-      } while (!rlmachine.CurrentLongOperation() &&
-               !sdlSystem.force_wait() &&
-               (end_ticks - start_ticks < 10));
+        ++instructions;
+        end_ticks = event.GetLiveMicroseconds() / 1000;
+      } while (replaying
+                   ? instructions < replay_instructions && !rlmachine.halted()
+                   : !rlmachine.CurrentLongOperation() &&
+                         !sdlSystem.force_wait() &&
+                         (end_ticks - start_ticks < 10) &&
+                         !(paced && graphics.IsPresentDue(end_ticks)));
+      telemetry.Lap(FrameTelemetry::PHASE_INTERPRETER, burst_start_us);
+      telemetry.AddInstructions(instructions);
+      telemetry.SetScene(rlmachine.SceneNumber());
+      event.RecordInstructions(instructions);
 
       // Sleep to be nice to the processor and to give the GPU a chance to
-      // catch up.
-      if (!sdlSystem.ShouldFastForward()) {
-        int real_sleep_time = 10 - (end_ticks - start_ticks);
-        if (real_sleep_time < 1)
-          real_sleep_time = 1;
-        sdlSystem.event().Wait(real_sleep_time);
+      // catch up. Input ends the sleep early. If we're only waiting on the
+      // player, sleep until the next time something asked to run instead of
+      // waking every 10ms.
+      if (!sdlSystem.ShouldFastForward() && !replaying) {
+        unsigned int wakeup = std::max(start_ticks + 10, end_ticks + 1);
+
+        std::shared_ptr<LongOperation> op = rlmachine.CurrentLongOperation();
+        if (op && op->CanSleep() && !graphics.screen_needs_refresh()) {
+          unsigned int idle_wakeup =
+              std::min(event.next_wakeup(), end_ticks + kMaxIdleSleepMs);
+          wakeup = std::max(wakeup, idle_wakeup);
+        }
+
+        event.WaitForEvents(wakeup);
       }
 
       sdlSystem.set_force_wait(false);
     }
 
-    Serialization::saveGlobalMemory(rlmachine);
+    if (event.recording_input()) {
+      std::ofstream out(record_input_path_.string().c_str());
+      event.input_trace()->Save(out);
+    }
+
+    // Leave global memory as it was when recording started, so every replay
+    // of the trace begins from the same globals the recording did.
+    if (!event.recording_input() && !event.replaying_input())
+      Serialization::saveGlobalMemory(rlmachine);
   }
   catch (rlvm::UserPresentableError& e) {
     ReportFatalError(e.message_text(), e.informative_text());
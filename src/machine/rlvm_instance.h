@@ -51,6 +51,18 @@ class RLVMInstance {
   void set_tracing() { tracing_ = true; }
   void set_load_save(int in) { load_save_ = in; }
   void set_custom_font(const std::string& font) { custom_font_ = font; }
+  void set_pcm_cache_size(int megabytes) { pcm_cache_size_ = megabytes; }
+  void set_present_rate(int frames_per_second) {
+    present_rate_ = frames_per_second;
+  }
+  void set_prepare_display_text(bool in) { prepare_display_text_ = in; }
+  void set_record_input(const boost::filesystem::path& path) {
+    record_input_path_ = path;
+  }
+  void set_replay_input(const boost::filesystem::path& path) {
+    replay_input_path_ = path;
+  }
+  void set_preparse_threads(int in) { preparse_threads_ = in; }
 
   void set_dump_seen(int in) { dump_seen_ = in; }
 
@@ -110,6 +122,29 @@ class RLVMInstance {
 
   // Dumps pseudo-kepago of the current seen to stdout and exit if not -1.
   int dump_seen_;
+
+  // Size limit in megabytes of the decoded BGM cache; 0 disables it. Uses the
+  // sound system's default if -1.
+  int pcm_cache_size_;
+
+  // Maximum screen redraws per second; 0 redraws whenever the screen is dirty.
+  // Uses the Gameexe's setting if -1.
+  int present_rate_;
+
+  // Whether scenario text is converted to UTF-8 when the scenario is loaded
+  // instead of each time it is displayed.
+  bool prepare_display_text_;
+
+  // If not empty, the player's input is recorded to this file on exit.
+  boost::filesystem::path record_input_path_;
+
+  // If not empty, input is replayed from this file instead of the player and
+  // per scene timings are printed when it runs out.
+  boost::filesystem::path replay_input_path_;
+
+  // If positive, command parameters are parsed on this many threads when a
+  // scenario is loaded instead of when each command first runs.
+  int preparse_threads_;
 };
 
 #endif  // SRC_MACHINE_RLVM_INSTANCE_H_
@@ -96,7 +96,7 @@ void blitDC1toDC0(RLMachine& machine) {
 // Kanon uses the recOpen('?', ...) form for rendering Last Regrets. This isn't
 // documented in the rldev manual, and we must check for that case.
 void loadImageToDC1(RLMachine& machine,
-                    std::string name,
+                    const std::string& name,
                     const Rect& srcRect,
                     const Point& dest,
                     int opacity,
@@ -104,8 +104,8 @@ void loadImageToDC1(RLMachine& machine,
   GraphicsSystem& graphics = machine.system().graphics();
 
   if (name != "?") {
-    if (name == "???")
-      name = graphics.default_grp_name();
+    const std::string& image =
+        name == "???" ? graphics.default_grp_name() : name;
 
     std::shared_ptr<Surface> dc0 = graphics.GetDC(0);
     std::shared_ptr<Surface> dc1 = graphics.GetDC(1);
@@ -117,7 +117,7 @@ void loadImageToDC1(RLMachine& machine,
 
     // Load the section of the image file on top of dc1
     std::shared_ptr<const Surface> surface(
-        graphics.GetSurfaceNamedAndMarkViewed(machine, name));
+        graphics.GetSurfaceNamedAndMarkViewed(machine, image));
     surface->BlitToSurface(*graphics.GetDC(1),
                            Rect(srcRect.origin(), size),
                            Rect(dest, size),
@@ -250,11 +250,14 @@ struct shake : public RLOpcode<IntConstant_T> {
 // to worry about the difference between grp/rec coordinate space), we write
 // one function for both versions.
 struct load_1
-    : public RLOpcode<StrConstant_T, IntConstant_T, DefaultIntValue_T<255>> {
+    : public RLOpcode<StrView_T, IntConstant_T, DefaultIntValue_T<255>> {
   bool use_alpha_;
   explicit load_1(bool in) : use_alpha_(in) {}
 
-  void operator()(RLMachine& machine, string filename, int dc, int opacity) {
+  void operator()(RLMachine& machine,
+                  const std::string& filename,
+                  int dc,
+                  int opacity) {
     GraphicsSystem& graphics = machine.system().graphics();
 
     std::shared_ptr<const Surface> surface(
@@ -278,7 +281,7 @@ struct load_1
 // Loads filename into dc; note that filename may not be '???'. Using this
 // form, the given area of the bitmap is loaded at the given location.
 template <typename SPACE>
-struct load_3 : public RLOpcode<StrConstant_T,
+struct load_3 : public RLOpcode<StrView_T,
                                IntConstant_T,
                                Rect_T<SPACE>,
                                Point_T,
@@ -287,7 +290,7 @@ struct load_3 : public RLOpcode<StrConstant_T,
   explicit load_3(bool in) : use_alpha_(in) {}
 
   void operator()(RLMachine& machine,
-                  string filename,
+                  const std::string& filename,
                   int dc,
                   Rect srcRect,
                   Point dest,
@@ -440,12 +443,12 @@ struct display_4 : public RLOpcode<IntConstant_T,
 //
 // TODO(erg): factor out the common code between grpOpens!
 struct open_1
-    : public RLOpcode<StrConstant_T, IntConstant_T, IntConstant_T> {
+    : public RLOpcode<StrView_T, IntConstant_T, IntConstant_T> {
   bool use_alpha_;
   explicit open_1(bool in) : use_alpha_(in) {}
 
   void operator()(RLMachine& machine,
-                  string filename,
+                  const std::string& filename,
                   int effectNum,
                   int opacity) {
     Rect src;
@@ -469,18 +472,20 @@ struct open_1
 // Load and display a bitmap. |filename| is loaded into DC1, and then is passed
 // off to whatever transition effect, which will perform some intermediary
 // steps and then render DC1 to DC0.
-struct open_0 : public RLOpcode<StrConstant_T, IntConstant_T> {
+struct open_0 : public RLOpcode<StrView_T, IntConstant_T> {
   open_1 delegate_;
   explicit open_0(bool in) : delegate_(in) {}
 
-  void operator()(RLMachine& machine, string filename, int effectNum) {
+  void operator()(RLMachine& machine,
+                  const std::string& filename,
+                  int effectNum) {
     std::vector<int> selEffect = GetSELEffect(machine, effectNum);
     delegate_(machine, filename, effectNum, selEffect[14]);
   }
 };
 
 template <typename SPACE>
-struct open_3 : public RLOpcode<StrConstant_T,
+struct open_3 : public RLOpcode<StrView_T,
                                IntConstant_T,
                                Rect_T<SPACE>,
                                Point_T,
@@ -489,7 +494,7 @@ struct open_3 : public RLOpcode<StrConstant_T,
   explicit open_3(bool in) : use_alpha_(in) {}
 
   void operator()(RLMachine& machine,
-                  string filename,
+                  const std::string& filename,
                   int effectNum,
                   Rect srcRect,
                   Point dest,
@@ -517,12 +522,12 @@ struct open_3 : public RLOpcode<StrConstant_T,
 // perform some intermediary steps and then render DC1 to DC0.
 template <typename SPACE>
 struct open_2
-    : public RLOpcode<StrConstant_T, IntConstant_T, Rect_T<SPACE>, Point_T> {
+    : public RLOpcode<StrView_T, IntConstant_T, Rect_T<SPACE>, Point_T> {
   open_3<SPACE> delegate_;
   explicit open_2(bool in) : delegate_(in) {}
 
   void operator()(RLMachine& machine,
-                  string filename,
+                  const std::string& filename,
                   int effectNum,
                   Rect src,
                   Point dest) {
@@ -532,7 +537,7 @@ struct open_2
 };
 
 template <typename SPACE>
-struct open_4 : public RLOpcode<StrConstant_T,
+struct open_4 : public RLOpcode<StrView_T,
                                     Rect_T<SPACE>,
                                     Point_T,
                                     IntConstant_T,
@@ -549,7 +554,7 @@ struct open_4 : public RLOpcode<StrConstant_T,
   explicit open_4(bool in) : use_alpha_(in) {}
 
   void operator()(RLMachine& machine,
-                  string fileName,
+                  const std::string& fileName,
                   Rect srcRect,
                   Point dest,
                   int time,
@@ -589,9 +594,9 @@ struct open_4 : public RLOpcode<StrConstant_T,
 };
 
 struct openBg_1
-    : public RLOpcode<StrConstant_T, IntConstant_T, IntConstant_T> {
+    : public RLOpcode<StrView_T, IntConstant_T, IntConstant_T> {
   void operator()(RLMachine& machine,
-                  string fileName,
+                  const std::string& fileName,
                   int effectNum,
                   int opacity) {
     GraphicsSystem& graphics = machine.system().graphics();
@@ -612,17 +617,19 @@ struct openBg_1
   }
 };
 
-struct openBg_0 : public RLOpcode<StrConstant_T, IntConstant_T> {
+struct openBg_0 : public RLOpcode<StrView_T, IntConstant_T> {
   openBg_1 delegate_;
 
-  void operator()(RLMachine& machine, string filename, int effectNum) {
+  void operator()(RLMachine& machine,
+                  const std::string& filename,
+                  int effectNum) {
     std::vector<int> selEffect = GetSELEffect(machine, effectNum);
     delegate_(machine, filename, effectNum, selEffect[14]);
   }
 };
 
 template <typename SPACE>
-struct openBg_3 : public RLOpcode<StrConstant_T,
+struct openBg_3 : public RLOpcode<StrView_T,
                                  IntConstant_T,
                                  Rect_T<SPACE>,
                                  Point_T,
@@ -631,7 +638,7 @@ struct openBg_3 : public RLOpcode<StrConstant_T,
   explicit openBg_3(bool in) : use_alpha_(in) {}
 
   void operator()(RLMachine& machine,
-                  string fileName,
+                  const std::string& fileName,
                   int effectNum,
                   Rect srcRect,
                   Point destPt,
@@ -653,12 +660,12 @@ struct openBg_3 : public RLOpcode<StrConstant_T,
 
 template <typename SPACE>
 struct openBg_2
-    : public RLOpcode<StrConstant_T, IntConstant_T, Rect_T<SPACE>, Point_T> {
+    : public RLOpcode<StrView_T, IntConstant_T, Rect_T<SPACE>, Point_T> {
   openBg_3<SPACE> delegate_;
   explicit openBg_2(bool in) : delegate_(in) {}
 
   void operator()(RLMachine& machine,
-                  string fileName,
+                  const std::string& fileName,
                   int effectNum,
                   Rect srcRect,
                   Point destPt) {
@@ -668,7 +675,7 @@ struct openBg_2
 };
 
 template <typename SPACE>
-struct openBg_4 : public RLOpcode<StrConstant_T,
+struct openBg_4 : public RLOpcode<StrView_T,
                                       Rect_T<SPACE>,
                                       Point_T,
                                       IntConstant_T,
@@ -685,7 +692,7 @@ struct openBg_4 : public RLOpcode<StrConstant_T,
   explicit openBg_4(bool in) : use_alpha_(in) {}
 
   void operator()(RLMachine& machine,
-                  string fileName,
+                  const std::string& fileName,
                   Rect srcRect,
                   Point destPt,
                   int time,
@@ -1108,13 +1115,13 @@ void multi_command<SPACE>::handleMultiCommands(
 
 // fun grpMulti <1:Grp:00075, 4> (<strC 'filename', <'effect', MultiCommand)
 template <typename SPACE>
-struct multi_str_1 : public RLOpcode<StrConstant_T,
+struct multi_str_1 : public RLOpcode<StrView_T,
                                     IntConstant_T,
                                     IntConstant_T,
                                     MultiCommand>,
                      public multi_command<SPACE> {
   void operator()(RLMachine& machine,
-                  string filename,
+                  const std::string& filename,
                   int effect,
                   int alpha,
                   MultiCommand::type commands) {
@@ -1126,11 +1133,11 @@ struct multi_str_1 : public RLOpcode<StrConstant_T,
 
 template <typename SPACE>
 struct multi_str_0
-    : public RLOpcode<StrConstant_T, IntConstant_T, MultiCommand> {
+    : public RLOpcode<StrView_T, IntConstant_T, MultiCommand> {
   multi_str_1<SPACE> delegate_;
 
   void operator()(RLMachine& machine,
-                  string filename,
+                  const std::string& filename,
                   int effect,
                   MultiCommand::type commands) {
     delegate_(machine, filename, effect, 255, commands);
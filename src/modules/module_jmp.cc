@@ -64,24 +64,23 @@ int EvaluateCase(RLMachine& machine, const CommandElement& goto_element) {
   // match against value.
   int cases = goto_element.GetCaseCount();
   for (int i = 0; i < cases; ++i) {
-    std::string caseUnparsed = goto_element.GetCase(i);
+    libreallive::ByteSpan caseUnparsed = goto_element.GetCase(i);
 
     // Check for bytecode wellformedness. All cases should be
     // surrounded by parens
-    if (caseUnparsed[0] != '(' || caseUnparsed[caseUnparsed.size() - 1] != ')')
+    if (caseUnparsed.size() < 2 || caseUnparsed[0] != '(' ||
+        caseUnparsed[caseUnparsed.size() - 1] != ')')
       throw rlvm::Exception("Malformed bytecode in goto_case statment");
 
     // In the case of an empty set of parens, always accept. It is
     // the bytecode representation for the default case.
-    if (caseUnparsed == "()")
+    if (caseUnparsed.size() == 2)
       return i;
 
-    // Strip the parens for parsing
-    caseUnparsed = caseUnparsed.substr(1, caseUnparsed.size() - 2);
-
+    // Skip the opening paren; the expression parser stops at the closing one.
     // Parse this expression, and goto the corresponding label if
     // it's equal to the value we're searching for
-    const char* e = (const char*)caseUnparsed.c_str();
+    const char* e = caseUnparsed.data() + 1;
     libreallive::ExpressionPiece output(libreallive::GetExpression(e));
     if (output.GetIntegerValue(machine) == value)
       return i;
@@ -151,10 +150,10 @@ struct Jmp_goto : public RLOp_SpecialCase {
 // default, special cases treat this as data instead of expressions.
 struct ParseGotoParametersAsExpressions : public RLOp_SpecialCase {
   virtual void ParseParameters(
-      const std::vector<std::string>& input,
+      const std::vector<libreallive::ByteSpan>& input,
       libreallive::ExpressionPiecesVector& output) override {
     for (auto const& parameter : input) {
-      const char* src = parameter.c_str();
+      const char* src = parameter.data();
       output.push_back(libreallive::GetExpression(src));
     }
   }
@@ -42,6 +42,18 @@
 
 namespace {
 
+// Returns the number of locations in the inclusive range [first, last], or -1
+// if |last| isn't at or after |first| in the same view of the same bank. Those
+// ranges are left to the element-wise algorithms, which walk off the end of
+// the bank and throw.
+int InclusiveCount(const IntReferenceIterator& first,
+                   const IntReferenceIterator& last) {
+  if (first.memory() != last.memory() || first.type() != last.type() ||
+      last.location() < first.location())
+    return -1;
+  return last.location() - first.location() + 1;
+}
+
 // Implement op<1:Mem:00000, 0>, fun setarray(int, intC+).
 //
 // Sets a block of integers, starting with origin, to the given values. values
@@ -51,7 +63,7 @@ struct setarray : public RLOpcode<IntReference_T, Argc_T<IntConstant_T>> {
   void operator()(RLMachine& machine,
                   IntReferenceIterator origin,
                   std::vector<int> values) {
-    copy(values.begin(), values.end(), origin);
+    WriteIntRange(origin, values.size(), values.data());
   }
 };
 
@@ -62,8 +74,13 @@ struct setrng_0 : public RLOpcode<IntReference_T, IntReference_T> {
   void operator()(RLMachine& machine,
                   IntReferenceIterator first,
                   IntReferenceIterator last) {
-    ++last;  // RealLive ranges are inclusive
-    fill(first, last, 0);
+    int count = InclusiveCount(first, last);
+    if (count >= 0) {
+      FillIntRange(first, count, 0);
+    } else {
+      ++last;  // RealLive ranges are inclusive
+      fill(first, last, 0);
+    }
   }
 };
 
@@ -76,8 +93,13 @@ struct setrng_1
                   IntReferenceIterator first,
                   IntReferenceIterator last,
                   int value) {
-    ++last;  // RealLive ranges are inclusive
-    fill(first, last, value);
+    int count = InclusiveCount(first, last);
+    if (count >= 0) {
+      FillIntRange(first, count, value);
+    } else {
+      ++last;  // RealLive ranges are inclusive
+      fill(first, last, value);
+    }
   }
 };
 
@@ -91,9 +113,11 @@ struct cpyrng
                   IntReferenceIterator source,
                   IntReferenceIterator dest,
                   int count) {
-    std::vector<int> tmpCopy;
-    std::copy_n(source, count, std::back_inserter(tmpCopy));
-    std::copy(tmpCopy.begin(), tmpCopy.end(), dest);
+    if (count <= 0)
+      return;
+    std::vector<int> tmpCopy(count);
+    ReadIntRange(source, count, tmpCopy.data());
+    WriteIntRange(dest, count, tmpCopy.data());
   }
 };
 
@@ -181,6 +205,9 @@ struct sum : public RLStoreOpcode<IntReference_T, IntReference_T> {
   int operator()(RLMachine& machine,
                  IntReferenceIterator first,
                  IntReferenceIterator last) {
+    int count = InclusiveCount(first, last);
+    if (count >= 0)
+      return SumIntRange(first, count);
     last++;
     return accumulate(first, last, 0);
   }
@@ -197,9 +224,15 @@ struct sums
       IntReferenceIterator>> ranges) {
     int total = 0;
     for (auto it = ranges.cbegin(); it != ranges.cend(); ++it) {
+      IntReferenceIterator first = std::get<0>(*it);
       IntReferenceIterator last = std::get<1>(*it);
-      ++last;
-      total += accumulate(std::get<0>(*it), last, 0);
+      int count = InclusiveCount(first, last);
+      if (count >= 0) {
+        total += SumIntRange(first, count);
+      } else {
+        ++last;
+        total += accumulate(first, last, 0);
+      }
     }
     return total;
   }
@@ -85,11 +85,10 @@ struct FontColour
 
 struct SetFontColour : public RLOpcode<DefaultIntValue_T<0>> {
   void operator()(RLMachine& machine, int textColorNum) {
-    Gameexe& gexe = machine.system().gameexe();
-    if (gexe("COLOR_TABLE", textColorNum).Exists()) {
-      machine.system().text().GetCurrentWindow()->SetDefaultTextColor(
-          gexe("COLOR_TABLE", textColorNum));
-    }
+    TextSystem& text = machine.system().text();
+    GameexeKeyHandle colour = text.GetColourTableKey(textColorNum);
+    if (colour.Exists())
+      text.GetCurrentWindow()->SetDefaultTextColor(colour.ToIntVector());
   }
 };
 
@@ -57,6 +57,7 @@
 #include "systems/base/graphics_system.h"
 #include "systems/base/graphics_text_object.h"
 #include "systems/base/object_mutator.h"
+#include "systems/base/object_tween_table.h"
 #include "systems/base/system.h"
 #include "utilities/exception.h"
 #include "utilities/graphics.h"
@@ -322,6 +323,8 @@ class objEveAdjust : public RLOpcode<IntConstant_T,
                                         IntConstant_T,
                                         IntConstant_T> {
  public:
+  objEveAdjust() : name_id_(InternMutatorName("objEveAdjust")) {}
+
   virtual void operator()(RLMachine& machine,
                           int obj,
                           int repno,
@@ -330,77 +333,25 @@ class objEveAdjust : public RLOpcode<IntConstant_T,
                           int duration_time,
                           int delay,
                           int type) {
-    unsigned int creation_time = machine.system().event().GetTicks();
+    unsigned int creation_time = machine.system().event().frame_ticks();
 
     GraphicsObject& object = GetGraphicsObject(machine, this, obj);
+    if (object.IsMutatorRunningMatching(repno, name_id_))
+      return;
+
     int start_x = object.x_adjustment(repno);
     int start_y = object.y_adjustment(repno);
 
-    object.AddObjectMutator(std::unique_ptr<ObjectMutator>(
-        new AdjustMutator(machine,
-                          repno,
-                          creation_time,
-                          duration_time,
-                          delay,
-                          type,
-                          start_x,
-                          x,
-                          start_y,
-                          y)));
+    // Both halves share a name so they're checked and ended together.
+    ObjectTweenTable& tweens = machine.system().graphics().tweens();
+    tweens.Add(object, name_id_, repno, creation_time, duration_time, delay,
+               type, start_x, x, &GraphicsObject::SetXAdjustment);
+    tweens.Add(object, name_id_, repno, creation_time, duration_time, delay,
+               type, start_y, y, &GraphicsObject::SetYAdjustment);
   }
 
  private:
-  // We need a custom mutator here. One of the parameters isn't varying.
-  class AdjustMutator : public ObjectMutator {
-   public:
-    AdjustMutator(RLMachine& machine,
-                  int repno,
-                  int creation_time,
-                  int duration_time,
-                  int delay,
-                  int type,
-                  int start_x,
-                  int target_x,
-                  int start_y,
-                  int target_y)
-        : ObjectMutator(repno,
-                        "objEveAdjust",
-                        creation_time,
-                        duration_time,
-                        delay,
-                        type),
-          repno_(repno),
-          start_x_(start_x),
-          end_x_(target_x),
-          start_y_(start_y),
-          end_y_(target_y) {}
-
-   private:
-    virtual void SetToEnd(RLMachine& machine,
-                          GraphicsObject& object) override {
-      object.SetXAdjustment(repno_, end_x_);
-      object.SetYAdjustment(repno_, end_y_);
-    }
-
-    virtual ObjectMutator* Clone() const override {
-      return new AdjustMutator(*this);
-    }
-
-    virtual void PerformSetting(RLMachine& machine,
-                                GraphicsObject& object) override {
-      int x = GetValueForTime(machine, start_x_, end_x_);
-      object.SetXAdjustment(repno_, x);
-
-      int y = GetValueForTime(machine, start_y_, end_y_);
-      object.SetYAdjustment(repno_, y);
-    }
-
-    int repno_;
-    int start_x_;
-    int end_x_;
-    int start_y_;
-    int end_y_;
-  };
+  const int name_id_;
 };
 
 class DisplayMutator : public ObjectMutator {
@@ -569,7 +520,7 @@ struct objEveDisplay_1 : public RLOpcode<IntConstant_T,
     const std::vector<int>& disp = gameexe("OBJDISP", param).ToIntVector();
 
     GraphicsObject& object = GetGraphicsObject(machine, this, obj);
-    unsigned int creation_time = machine.system().event().GetTicks();
+    unsigned int creation_time = machine.system().event().frame_ticks();
     object.AddObjectMutator(std::unique_ptr<ObjectMutator>(
         new DisplayMutator(machine,
                            object,
@@ -614,7 +565,7 @@ struct objEveDisplay_2 : public RLOpcode<IntConstant_T,
                   int move_len_x,
                   int move_len_y) {
     GraphicsObject& object = GetGraphicsObject(machine, this, obj);
-    unsigned int creation_time = machine.system().event().GetTicks();
+    unsigned int creation_time = machine.system().event().frame_ticks();
     object.AddObjectMutator(std::unique_ptr<ObjectMutator>(
         new DisplayMutator(machine,
                            object,
@@ -677,7 +628,7 @@ struct objEveDisplay_3 : public RLOpcode<IntConstant_T,
                   int sin_len,
                   int sin_count) {
     GraphicsObject& object = GetGraphicsObject(machine, this, obj);
-    unsigned int creation_time = machine.system().event().GetTicks();
+    unsigned int creation_time = machine.system().event().frame_ticks();
     object.AddObjectMutator(std::unique_ptr<ObjectMutator>(
         new DisplayMutator(machine,
                            object,
@@ -53,7 +53,7 @@ struct Sel_select : public RLOp_SpecialCase {
   // Prevent us from trying to parse the parameters to the CommandElement as
   // RealLive expressions (because they are not).
   virtual void ParseParameters(
-      const std::vector<std::string>& input,
+      const std::vector<libreallive::ByteSpan>& input,
       libreallive::ExpressionPiecesVector& output) override {}
 
   void operator()(RLMachine& machine, const CommandElement& ce) {
@@ -70,7 +70,7 @@ struct Sel_select_s : public RLOp_SpecialCase {
   // Prevent us from trying to parse the parameters to the CommandElement as
   // RealLive expressions (because they are not).
   virtual void ParseParameters(
-      const std::vector<std::string>& input,
+      const std::vector<libreallive::ByteSpan>& input,
       libreallive::ExpressionPiecesVector& output) override {}
 
   void operator()(RLMachine& machine, const CommandElement& ce) {
@@ -99,7 +99,7 @@ struct Sel_select_w : public RLOp_SpecialCase {
   // Prevent us from trying to parse the parameters to the CommandElement as
   // RealLive expressions (because they are not).
   virtual void ParseParameters(
-      const std::vector<std::string>& input,
+      const std::vector<libreallive::ByteSpan>& input,
       libreallive::ExpressionPiecesVector& output) override {}
 
   void operator()(RLMachine& machine, const CommandElement& ce) {
@@ -82,10 +82,10 @@ std::string rl_itoa_implementation(int number, int length, char fill) {
 // Implement op<1:Str:00000, 0>, fun strcpy(str, strC).
 //
 // Assigns the string value val to the string variable dest.
-struct strcpy_0 : public RLOpcode<StrReference_T, StrConstant_T> {
+struct strcpy_0 : public RLOpcode<StrReference_T, StrView_T> {
   void operator()(RLMachine& machine,
                   StringReferenceIterator dest,
-                  std::string val) {
+                  const std::string& val) {
     *dest = val;
   }
 };
@@ -94,10 +94,10 @@ struct strcpy_0 : public RLOpcode<StrReference_T, StrConstant_T> {
 //
 // Assigns the first count characters of val to the string variable dest.
 struct strcpy_1
-    : public RLOpcode<StrReference_T, StrConstant_T, IntConstant_T> {
+    : public RLOpcode<StrReference_T, StrView_T, IntConstant_T> {
   void operator()(RLMachine& machine,
                   StringReferenceIterator dest,
-                  std::string val,
+                  const std::string& val,
                   int count) {
     *dest = val.substr(0, count);
   }
@@ -126,10 +126,10 @@ struct strclear_1 : public RLOpcode<StrReference_T, StrReference_T> {
 
 // Implement op<1:Str:00002, 0>, fun strcat(str, strC). Concatenates
 // the string into the memory location of the first.
-struct Str_strcat : public RLOpcode<StrReference_T, StrConstant_T> {
+struct Str_strcat : public RLOpcode<StrReference_T, StrView_T> {
   void operator()(RLMachine& machine,
                   StringReferenceIterator it,
-                  std::string append) {
+                  const std::string& append) {
     std::string s = *it;
     s += append;
     *it = s;
@@ -138,8 +138,8 @@ struct Str_strcat : public RLOpcode<StrReference_T, StrConstant_T> {
 
 // Implement op<1:Str:00003, 0>, fun strlen(strC). Returns the length
 // of value; Double-byte characters are counted as two bytes.
-struct Str_strlen : public RLStoreOpcode<StrConstant_T> {
-  int operator()(RLMachine& machine, std::string value) {
+struct Str_strlen : public RLStoreOpcode<StrView_T> {
+  int operator()(RLMachine& machine, const std::string& value) {
     return value.size();
   }
 };
@@ -150,8 +150,10 @@ struct Str_strlen : public RLStoreOpcode<StrConstant_T> {
 // strings in JIS X 0208.
 //
 // TODO(erg): THIS NEEDS TO HANDLE JSX ORDERING, NOT JUST ASCII!
-struct Str_strcmp : public RLStoreOpcode<StrConstant_T, StrConstant_T> {
-  int operator()(RLMachine& machine, std::string lhs, std::string rhs) {
+struct Str_strcmp : public RLStoreOpcode<StrView_T, StrView_T> {
+  int operator()(RLMachine& machine,
+                 const std::string& lhs,
+                 const std::string& rhs) {
     return strcmp(lhs.c_str(), rhs.c_str());
   }
 };
@@ -160,10 +162,10 @@ struct Str_strcmp : public RLStoreOpcode<StrConstant_T, StrConstant_T> {
 //
 // Returns the substring, starting at offset.
 struct strsub_0
-    : public RLOpcode<StrReference_T, StrConstant_T, IntConstant_T> {
+    : public RLOpcode<StrReference_T, StrView_T, IntConstant_T> {
   void operator()(RLMachine& machine,
                   StringReferenceIterator dest,
-                  std::string source,
+                  const std::string& source,
                   int offset) {
     const char* str = source.c_str();
     std::string output;
@@ -195,12 +197,12 @@ struct strsub_0
 //
 // Returns the substring of length length, starting at offset.
 struct strsub_1 : public RLOpcode<StrReference_T,
-                                     StrConstant_T,
+                                     StrView_T,
                                      IntConstant_T,
                                      IntConstant_T> {
   void operator()(RLMachine& machine,
                   StringReferenceIterator dest,
-                  std::string source,
+                  const std::string& source,
                   int offset,
                   int length) {
     const char* str = source.c_str();
@@ -230,7 +232,7 @@ struct strsub_1 : public RLOpcode<StrReference_T,
 struct strrsub_0 : public strsub_0 {
   void operator()(RLMachine& machine,
                   StringReferenceIterator dest,
-                  std::string source,
+                  const std::string& source,
                   int offsetFromBack) {
     int offset = strcharlen(source.c_str()) - offsetFromBack;
     return strsub_0::operator()(machine, dest, source, offset);
@@ -241,7 +243,7 @@ struct strrsub_0 : public strsub_0 {
 struct strrsub_1 : public strsub_1 {
   void operator()(RLMachine& machine,
                   StringReferenceIterator dest,
-                  std::string source,
+                  const std::string& source,
                   int offsetFromBack,
                   int length) {
     if (length > offsetFromBack) {
@@ -257,8 +259,8 @@ struct strrsub_1 : public strsub_1 {
 // Implements op<1:Str:00007, 0>, fun strcharlen(strC). Returns the
 // number of characters (as opposed to bytes) in a string. This
 // function deals with Shift_JIS characters properly.
-struct Str_strcharlen : public RLStoreOpcode<StrConstant_T> {
-  int operator()(RLMachine& machine, std::string val) {
+struct Str_strcharlen : public RLStoreOpcode<StrView_T> {
+  int operator()(RLMachine& machine, const std::string& val) {
     return strcharlen(val.c_str());
   }
 };
@@ -293,9 +295,9 @@ struct hantozen_0 : public RLOpcode<StrReference_T> {
 // Implements op<1:Str:00010, 1>, fun hantozen(strC, >str).
 //
 // Changes half width characters to their full width equivalents.
-struct hantozen_1 : public RLOpcode<StrConstant_T, StrReference_T> {
+struct hantozen_1 : public RLOpcode<StrView_T, StrReference_T> {
   void operator()(RLMachine& machine,
-                  std::string input,
+                  const std::string& input,
                   StringReferenceIterator dest) {
     *dest = hantozen_cp932(input, machine.GetTextEncoding());
   }
@@ -313,9 +315,9 @@ struct zentohan_0 : public RLOpcode<StrReference_T> {
 // Implements op<1:Str:00011, 1>, fun zentohan(strC, >str).
 //
 // Changes full width characters to their half width equivalents.
-struct zentohan_1 : public RLOpcode<StrConstant_T, StrReference_T> {
+struct zentohan_1 : public RLOpcode<StrView_T, StrReference_T> {
   void operator()(RLMachine& machine,
-                  std::string input,
+                  const std::string& input,
                   StringReferenceIterator dest) {
     *dest = zentohan_cp932(input, machine.GetTextEncoding());
   }
@@ -480,8 +482,8 @@ struct itoa_1
 // Returns the value of the integer represented by string, or 0 if string does
 // not represent an integer. Leading whitespace is ignored, as is anything
 // following the last decimal digit.
-struct Str_atoi : public RLStoreOpcode<StrConstant_T> {
-  int operator()(RLMachine& machine, std::string word) {
+struct Str_atoi : public RLStoreOpcode<StrView_T> {
+  int operator()(RLMachine& machine, const std::string& word) {
     std::stringstream ss(word);
     int out;
     ss >> out;
@@ -532,8 +534,10 @@ struct Str_digit
 //
 // Returns the offset of the first instance of substring in str, or -1 if
 // substring is not found.
-struct Str_strpos : public RLStoreOpcode<StrConstant_T, StrConstant_T> {
-  int operator()(RLMachine& machine, std::string str, std::string substring) {
+struct Str_strpos : public RLStoreOpcode<StrView_T, StrView_T> {
+  int operator()(RLMachine& machine,
+                 const std::string& str,
+                 const std::string& substring) {
     size_t pos = str.find(substring);
     if (pos == std::string::npos)
       return -1;
@@ -547,8 +551,10 @@ struct Str_strpos : public RLStoreOpcode<StrConstant_T, StrConstant_T> {
 // As strpos, but returns the offset of the last instance of substring. If
 // substring appears only once, or not at all, in string, the behaviour is
 // identical with that of strpos.
-struct Str_strlpos : public RLStoreOpcode<StrConstant_T, StrConstant_T> {
-  int operator()(RLMachine& machine, std::string str, std::string substring) {
+struct Str_strlpos : public RLStoreOpcode<StrView_T, StrView_T> {
+  int operator()(RLMachine& machine,
+                 const std::string& str,
+                 const std::string& substring) {
     size_t pos = str.rfind(substring);
     if (pos == std::string::npos)
       return -1;
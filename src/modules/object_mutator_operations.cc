@@ -34,6 +34,7 @@
 #include "systems/base/graphics_object.h"
 #include "systems/base/graphics_system.h"
 #include "systems/base/object_mutator.h"
+#include "systems/base/object_tween_table.h"
 #include "systems/base/system.h"
 
 namespace {
@@ -42,18 +43,18 @@ bool MutatorIsDone(RLMachine& machine,
                    RLOperation* op,
                    int obj,
                    int repno,
-                   const std::string& name) {
+                   int name_id) {
   return GetGraphicsObject(machine, op, obj)
-             .IsMutatorRunningMatching(repno, name) == false;
+             .IsMutatorRunningMatching(repno, name_id) == false;
 }
 
 bool ObjectMutatorIsWorking(RLMachine& machine,
                             RLOperation* op,
                             int obj,
                             int repno,
-                            const std::string& name) {
+                            int name_id) {
   return GetGraphicsObject(machine, op, obj)
-             .IsMutatorRunningMatching(repno, name) == false;
+             .IsMutatorRunningMatching(repno, name_id) == false;
 }
 
 }  // namespace
@@ -63,7 +64,7 @@ bool ObjectMutatorIsWorking(RLMachine& machine,
 Op_ObjectMutatorInt::Op_ObjectMutatorInt(Getter getter,
                                          Setter setter,
                                          const std::string& name)
-    : getter_(getter), setter_(setter), name_(name) {}
+    : getter_(getter), setter_(setter), name_id_(InternMutatorName(name)) {}
 
 Op_ObjectMutatorInt::~Op_ObjectMutatorInt() {}
 
@@ -73,19 +74,25 @@ void Op_ObjectMutatorInt::operator()(RLMachine& machine,
                                      int duration_time,
                                      int delay,
                                      int type) {
-  unsigned int creation_time = machine.system().event().GetTicks();
+  unsigned int creation_time = machine.system().event().frame_ticks();
   GraphicsObject& obj = GetGraphicsObject(machine, this, object);
 
+  // If there's a currently running mutator that matches the incoming one, we
+  // ignore the incoming one. Kud Wafter's ED relies on this behavior.
+  if (obj.IsMutatorRunningMatching(-1, name_id_))
+    return;
+
   int startval = (obj.*getter_)();
-  obj.AddObjectMutator(std::unique_ptr<ObjectMutator>(
-      new OneIntObjectMutator(name_,
-                              creation_time,
-                              duration_time,
-                              delay,
-                              type,
-                              startval,
-                              endval,
-                              setter_)));
+  machine.system().graphics().tweens().Add(obj,
+                                           name_id_,
+                                           -1,
+                                           creation_time,
+                                           duration_time,
+                                           delay,
+                                           type,
+                                           startval,
+                                           endval,
+                                           setter_);
 }
 
 // -----------------------------------------------------------------------
@@ -93,7 +100,7 @@ void Op_ObjectMutatorInt::operator()(RLMachine& machine,
 Op_ObjectMutatorRepnoInt::Op_ObjectMutatorRepnoInt(Getter getter,
                                                    Setter setter,
                                                    const std::string& name)
-    : getter_(getter), setter_(setter), name_(name) {}
+    : getter_(getter), setter_(setter), name_id_(InternMutatorName(name)) {}
 
 Op_ObjectMutatorRepnoInt::~Op_ObjectMutatorRepnoInt() {}
 
@@ -104,20 +111,23 @@ void Op_ObjectMutatorRepnoInt::operator()(RLMachine& machine,
                                           int duration_time,
                                           int delay,
                                           int type) {
-  unsigned int creation_time = machine.system().event().GetTicks();
+  unsigned int creation_time = machine.system().event().frame_ticks();
   GraphicsObject& obj = GetGraphicsObject(machine, this, object);
 
+  if (obj.IsMutatorRunningMatching(repno, name_id_))
+    return;
+
   int startval = (obj.*getter_)(repno);
-  obj.AddObjectMutator(std::unique_ptr<ObjectMutator>(
-      new RepnoIntObjectMutator(name_,
-                                creation_time,
-                                duration_time,
-                                delay,
-                                type,
-                                repno,
-                                startval,
-                                endval,
-                                setter_)));
+  machine.system().graphics().tweens().Add(obj,
+                                           name_id_,
+                                           repno,
+                                           creation_time,
+                                           duration_time,
+                                           delay,
+                                           type,
+                                           startval,
+                                           endval,
+                                           setter_);
 }
 
 // -----------------------------------------------------------------------
@@ -131,7 +141,7 @@ Op_ObjectMutatorIntInt::Op_ObjectMutatorIntInt(Getter getter_one,
       setter_one_(setter_one),
       getter_two_(getter_two),
       setter_two_(setter_two),
-      name_(name) {}
+      name_id_(InternMutatorName(name)) {}
 
 Op_ObjectMutatorIntInt::~Op_ObjectMutatorIntInt() {}
 
@@ -142,30 +152,26 @@ void Op_ObjectMutatorIntInt::operator()(RLMachine& machine,
                                         int duration_time,
                                         int delay,
                                         int type) {
-  unsigned int creation_time = machine.system().event().GetTicks();
+  unsigned int creation_time = machine.system().event().frame_ticks();
   GraphicsObject& obj = GetGraphicsObject(machine, this, object);
+  if (obj.IsMutatorRunningMatching(-1, name_id_))
+    return;
+
   int startval_one = (obj.*getter_one_)();
   int startval_two = (obj.*getter_two_)();
 
-  obj.AddObjectMutator(std::unique_ptr<ObjectMutator>(
-      new TwoIntObjectMutator(name_,
-                              creation_time,
-                              duration_time,
-                              delay,
-                              type,
-                              startval_one,
-                              endval_one,
-                              setter_one_,
-                              startval_two,
-                              endval_two,
-                              setter_two_)));
+  ObjectTweenTable& tweens = machine.system().graphics().tweens();
+  tweens.Add(obj, name_id_, -1, creation_time, duration_time, delay, type,
+             startval_one, endval_one, setter_one_);
+  tweens.Add(obj, name_id_, -1, creation_time, duration_time, delay, type,
+             startval_two, endval_two, setter_two_);
 }
 
 // -----------------------------------------------------------------------
 
 Op_EndObjectMutation_Normal::Op_EndObjectMutation_Normal(
     const std::string& name)
-    : name_(name) {}
+    : name_id_(InternMutatorName(name)) {}
 
 Op_EndObjectMutation_Normal::~Op_EndObjectMutation_Normal() {}
 
@@ -173,13 +179,13 @@ void Op_EndObjectMutation_Normal::operator()(RLMachine& machine,
                                              int object,
                                              int speedup) {
   GetGraphicsObject(machine, this, object)
-      .EndObjectMutatorMatching(machine, -1, name_, speedup);
+      .EndObjectMutatorMatching(machine, -1, name_id_, speedup);
 }
 
 // -----------------------------------------------------------------------
 
 Op_EndObjectMutation_RepNo::Op_EndObjectMutation_RepNo(const std::string& name)
-    : name_(name) {}
+    : name_id_(InternMutatorName(name)) {}
 
 Op_EndObjectMutation_RepNo::~Op_EndObjectMutation_RepNo() {}
 
@@ -188,53 +194,53 @@ void Op_EndObjectMutation_RepNo::operator()(RLMachine& machine,
                                             int repno,
                                             int speedup) {
   GetGraphicsObject(machine, this, object)
-      .EndObjectMutatorMatching(machine, repno, name_, speedup);
+      .EndObjectMutatorMatching(machine, repno, name_id_, speedup);
 }
 
 // -----------------------------------------------------------------------
 
 Op_MutatorCheck::Op_MutatorCheck(const std::string& name)
-    : name_(name) {}
+    : name_id_(InternMutatorName(name)) {}
 
 Op_MutatorCheck::~Op_MutatorCheck() {}
 
 int Op_MutatorCheck::operator()(RLMachine& machine, int object) {
   GraphicsObject& obj = GetGraphicsObject(machine, this, object);
-  return obj.IsMutatorRunningMatching(object, name_) ? 1 : 0;
+  return obj.IsMutatorRunningMatching(object, name_id_) ? 1 : 0;
 }
 
 // -----------------------------------------------------------------------
 
 Op_MutatorWaitNormal::Op_MutatorWaitNormal(const std::string& name)
-    : name_(name) {}
+    : name_id_(InternMutatorName(name)) {}
 
 Op_MutatorWaitNormal::~Op_MutatorWaitNormal() {}
 
 void Op_MutatorWaitNormal::operator()(RLMachine& machine, int obj) {
   WaitLongOperation* wait_op = new WaitLongOperation(machine);
   wait_op->BreakOnEvent(
-      std::bind(MutatorIsDone, std::ref(machine), this, obj, -1, name_));
+      std::bind(MutatorIsDone, std::ref(machine), this, obj, -1, name_id_));
   machine.PushLongOperation(wait_op);
 }
 
 // -----------------------------------------------------------------------
 
 Op_MutatorWaitRepNo::Op_MutatorWaitRepNo(const std::string& name)
-    : name_(name) {}
+    : name_id_(InternMutatorName(name)) {}
 
 Op_MutatorWaitRepNo::~Op_MutatorWaitRepNo() {}
 
 void Op_MutatorWaitRepNo::operator()(RLMachine& machine, int obj, int repno) {
   WaitLongOperation* wait_op = new WaitLongOperation(machine);
   wait_op->BreakOnEvent(
-      std::bind(MutatorIsDone, std::ref(machine), this, obj, repno, name_));
+      std::bind(MutatorIsDone, std::ref(machine), this, obj, repno, name_id_));
   machine.PushLongOperation(wait_op);
 }
 
 // -----------------------------------------------------------------------
 
 Op_MutatorWaitCNormal::Op_MutatorWaitCNormal(const std::string& name)
-    : name_(name) {}
+    : name_id_(InternMutatorName(name)) {}
 
 Op_MutatorWaitCNormal::~Op_MutatorWaitCNormal() {}
 
@@ -242,14 +248,14 @@ void Op_MutatorWaitCNormal::operator()(RLMachine& machine, int obj) {
   WaitLongOperation* wait_op = new WaitLongOperation(machine);
   wait_op->BreakOnClicks();
   wait_op->BreakOnEvent(std::bind(
-      ObjectMutatorIsWorking, std::ref(machine), this, obj, -1, name_));
+      ObjectMutatorIsWorking, std::ref(machine), this, obj, -1, name_id_));
   machine.PushLongOperation(wait_op);
 }
 
 // -----------------------------------------------------------------------
 
 Op_MutatorWaitCRepNo::Op_MutatorWaitCRepNo(const std::string& name)
-    : name_(name) {}
+    : name_id_(InternMutatorName(name)) {}
 
 Op_MutatorWaitCRepNo::~Op_MutatorWaitCRepNo() {}
 
@@ -257,6 +263,6 @@ void Op_MutatorWaitCRepNo::operator()(RLMachine& machine, int obj, int repno) {
   WaitLongOperation* wait_op = new WaitLongOperation(machine);
   wait_op->BreakOnClicks();
   wait_op->BreakOnEvent(std::bind(
-      ObjectMutatorIsWorking, std::ref(machine), this, obj, repno, name_));
+      ObjectMutatorIsWorking, std::ref(machine), this, obj, repno, name_id_));
   machine.PushLongOperation(wait_op);
 }
@@ -54,7 +54,8 @@ class Op_ObjectMutatorInt : public RLOpcode<IntConstant_T,
  private:
   Getter getter_;
   Setter setter_;
-  const std::string name_;
+  // Interned with InternMutatorName().
+  const int name_id_;
 };
 
 class Op_ObjectMutatorRepnoInt : public RLOpcode<IntConstant_T,
@@ -81,7 +82,8 @@ class Op_ObjectMutatorRepnoInt : public RLOpcode<IntConstant_T,
  private:
   Getter getter_;
   Setter setter_;
-  const std::string name_;
+  // Interned with InternMutatorName().
+  const int name_id_;
 };
 
 class Op_ObjectMutatorIntInt : public RLOpcode<IntConstant_T,
@@ -114,7 +116,8 @@ class Op_ObjectMutatorIntInt : public RLOpcode<IntConstant_T,
   Setter setter_one_;
   Getter getter_two_;
   Setter setter_two_;
-  const std::string name_;
+  // Interned with InternMutatorName().
+  const int name_id_;
 };
 
 // -----------------------------------------------------------------------
@@ -128,7 +131,8 @@ class Op_EndObjectMutation_Normal
   virtual void operator()(RLMachine& machine, int object, int speedup);
 
  private:
-  const std::string name_;
+  // Interned with InternMutatorName().
+  const int name_id_;
 };
 
 // -----------------------------------------------------------------------
@@ -145,7 +149,8 @@ class Op_EndObjectMutation_RepNo
                           int speedup);
 
  private:
-  const std::string name_;
+  // Interned with InternMutatorName().
+  const int name_id_;
 };
 
 // -----------------------------------------------------------------------
@@ -158,7 +163,8 @@ class Op_MutatorCheck : public RLStoreOpcode<IntConstant_T> {
   virtual int operator()(RLMachine& machine, int object) override;
 
  private:
-  const std::string name_;
+  // Interned with InternMutatorName().
+  const int name_id_;
 };
 
 // -----------------------------------------------------------------------
@@ -171,7 +177,8 @@ class Op_MutatorWaitNormal : public RLOpcode<IntConstant_T> {
   virtual void operator()(RLMachine& machine, int obj) override;
 
  private:
-  const std::string name_;
+  // Interned with InternMutatorName().
+  const int name_id_;
 };
 
 // -----------------------------------------------------------------------
@@ -184,7 +191,8 @@ class Op_MutatorWaitRepNo : public RLOpcode<IntConstant_T, IntConstant_T> {
   virtual void operator()(RLMachine& machine, int obj, int repno) override;
 
  private:
-  const std::string name_;
+  // Interned with InternMutatorName().
+  const int name_id_;
 };
 
 // -----------------------------------------------------------------------
@@ -197,7 +205,8 @@ class Op_MutatorWaitCNormal : public RLOpcode<IntConstant_T> {
   virtual void operator()(RLMachine& machine, int obj) override;
 
  private:
-  const std::string name_;
+  // Interned with InternMutatorName().
+  const int name_id_;
 };
 
 // -----------------------------------------------------------------------
@@ -210,7 +219,8 @@ class Op_MutatorWaitCRepNo : public RLOpcode<IntConstant_T, IntConstant_T> {
   virtual void operator()(RLMachine& machine, int obj, int repno) override;
 
  private:
-  const std::string name_;
+  // Interned with InternMutatorName().
+  const int name_id_;
 };
 
 #endif  // SRC_MODULES_OBJECT_MUTATOR_OPERATIONS_H_
@@ -30,6 +30,7 @@
 #include <SDL/SDL.h>
 
 #include <boost/program_options.hpp>
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -87,7 +88,10 @@ int main(int argc, char* argv[]) {
   opts.add_options()("help", "Produce help message")(
       "help-debug", "Print help message for people working on rlvm")(
       "version", "Display version and license information")(
-      "font", po::value<string>(), "Specifies TrueType font to use.");
+      "font", po::value<string>(), "Specifies TrueType font to use.")(
+      "pcm-cache-size", po::value<int>(),
+      "Megabytes of disk to use for caching decoded music (default 512)")(
+      "no-pcm-cache", "Always decode music while it plays");
 
   po::options_description debugOpts("Debugging Options");
   debugOpts.add_options()(
@@ -98,7 +102,21 @@ int main(int argc, char* argv[]) {
       "undefined-opcodes", "Display a message on undefined opcodes")(
       "count-undefined",
       "On exit, present a summary table about how many times each undefined "
-      "opcode was called")("trace", "Prints opcodes as they are run)");
+      "opcode was called")("trace", "Prints opcodes as they are run)")(
+      "no-prepared-text",
+      "Convert scenario text as it is displayed instead of on load")(
+      "preparse-threads", po::value<int>(),
+      "Parse all command parameters on N threads when a scenario loads, "
+      "and print how long it took")(
+      "present-rate", po::value<int>(),
+      "Redraw the screen at most N times a second, letting the interpreter "
+      "run in between (0 redraws whenever something changes)")(
+      "record-input", po::value<string>(),
+      "Record all input to a file on exit, for --replay-input. Global "
+      "memory is left unsaved so replays start from the same state")(
+      "replay-input", po::value<string>(),
+      "Replay input recorded with --record-input as fast as possible, then "
+      "print how long each scene took");
 
   // Declare the final option to be game-root
   po::options_description hidden("Hidden");
@@ -216,6 +234,27 @@ int main(int argc, char* argv[]) {
   if (vm.count("font"))
     instance.set_custom_font(vm["font"].as<string>());
 
+  if (vm.count("pcm-cache-size"))
+    instance.set_pcm_cache_size(std::max(vm["pcm-cache-size"].as<int>(), 0));
+
+  if (vm.count("no-pcm-cache"))
+    instance.set_pcm_cache_size(0);
+
+  if (vm.count("no-prepared-text"))
+    instance.set_prepare_display_text(false);
+
+  if (vm.count("preparse-threads"))
+    instance.set_preparse_threads(vm["preparse-threads"].as<int>());
+
+  if (vm.count("present-rate"))
+    instance.set_present_rate(std::max(vm["present-rate"].as<int>(), 0));
+
+  if (vm.count("record-input"))
+    instance.set_record_input(vm["record-input"].as<string>());
+
+  if (vm.count("replay-input"))
+    instance.set_replay_input(vm["replay-input"].as<string>());
+
   instance.Run(gamerootPath);
 
   return 0;
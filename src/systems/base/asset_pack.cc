@@ -0,0 +1,331 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "systems/base/asset_pack.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+#include "libreallive/alldefs.h"
+#include "libreallive/filemap.h"
+#include "utilities/exception.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+const char PACK_MAGIC[8] = {'R', 'L', 'V', 'M', 'P', 'A', 'K', '1'};
+const uint32_t PACK_VERSION = 1;
+const size_t HEADER_SIZE = 24;
+const size_t ENTRY_SIZE = 32;
+const uint64_t DATA_ALIGNMENT = 16;
+
+// Every pack that is currently open, for FindPath().
+std::mutex s_open_packs_lock;
+std::set<const AssetPack*> s_open_packs;
+
+uint64_t HashName(const std::string& name) {
+  // FNV-1a.
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : name) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+uint32_t ReadU32(const unsigned char* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) |
+         (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t ReadU64(const unsigned char* p) {
+  return ReadU32(p) | (static_cast<uint64_t>(ReadU32(p + 4)) << 32);
+}
+
+void AppendU32(std::string* out, uint32_t value) {
+  for (int i = 0; i < 4; ++i)
+    out->push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+}
+
+void AppendU64(std::string* out, uint64_t value) {
+  AppendU32(out, static_cast<uint32_t>(value));
+  AppendU32(out, static_cast<uint32_t>(value >> 32));
+}
+
+uint64_t AlignUp(uint64_t value) {
+  return (value + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+}
+
+void ThrowBadPack(const fs::path& file, const std::string& why) {
+  std::ostringstream oss;
+  oss << "Invalid asset pack " << file << ": " << why;
+  throw rlvm::Exception(oss.str());
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------
+// AssetPack
+// -----------------------------------------------------------------------
+
+AssetPack::AssetPack(const fs::path& file)
+    : path_(file),
+      buckets_(NULL),
+      entries_(NULL),
+      names_(NULL),
+      bucket_count_(0),
+      entry_count_(0) {
+  try {
+    mapping_.reset(new libreallive::Mapping(file.string(), libreallive::Read));
+  } catch (libreallive::Error& e) {
+    ThrowBadPack(file, e.what());
+  }
+
+  const unsigned char* data =
+      reinterpret_cast<const unsigned char*>(mapping_->get());
+  size_t size = mapping_->size();
+  if (size < HEADER_SIZE || memcmp(data, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0)
+    ThrowBadPack(file, "bad magic");
+  if (ReadU32(data + 8) != PACK_VERSION)
+    ThrowBadPack(file, "unsupported version");
+
+  bucket_count_ = ReadU32(data + 12);
+  entry_count_ = ReadU32(data + 16);
+  uint32_t names_size = ReadU32(data + 20);
+  uint64_t index_size = HEADER_SIZE + uint64_t(bucket_count_) * 4 +
+                        uint64_t(entry_count_) * ENTRY_SIZE + names_size;
+  if (bucket_count_ == 0 || (bucket_count_ & (bucket_count_ - 1)) != 0 ||
+      entry_count_ > bucket_count_ || index_size > size) {
+    ThrowBadPack(file, "truncated index");
+  }
+
+  buckets_ = data + HEADER_SIZE;
+  entries_ = buckets_ + bucket_count_ * 4;
+  names_ = reinterpret_cast<const char*>(entries_ + entry_count_ * ENTRY_SIZE);
+
+  // Validate every entry once so Find() can trust them.
+  for (uint32_t i = 0; i < entry_count_; ++i) {
+    const unsigned char* entry = entries_ + i * ENTRY_SIZE;
+    uint64_t offset = ReadU64(entry + 8);
+    uint64_t length = ReadU64(entry + 16);
+    uint64_t name_end = uint64_t(ReadU32(entry + 24)) + ReadU32(entry + 28);
+    if (offset > size || length > size - offset || name_end > names_size)
+      ThrowBadPack(file, "entry out of bounds");
+  }
+
+  std::lock_guard<std::mutex> lock(s_open_packs_lock);
+  s_open_packs.insert(this);
+}
+
+AssetPack::~AssetPack() {
+  std::lock_guard<std::mutex> lock(s_open_packs_lock);
+  s_open_packs.erase(this);
+}
+
+bool AssetPack::Find(const std::string& name, Asset* out) const {
+  uint64_t hash = HashName(name);
+  uint32_t mask = bucket_count_ - 1;
+  for (uint32_t probe = 0; probe < bucket_count_; ++probe) {
+    uint32_t index = ReadU32(buckets_ + ((hash + probe) & mask) * 4);
+    if (index == 0 || index > entry_count_)
+      return false;
+
+    const unsigned char* entry = entries_ + (index - 1) * ENTRY_SIZE;
+    if (ReadU64(entry) != hash)
+      continue;
+    uint32_t name_size = ReadU32(entry + 28);
+    if (name_size != name.size() ||
+        memcmp(names_ + ReadU32(entry + 24), name.data(), name_size) != 0) {
+      continue;
+    }
+
+    out->data = mapping_->get() + ReadU64(entry + 8);
+    out->size = ReadU64(entry + 16);
+    return true;
+  }
+  return false;
+}
+
+fs::path AssetPack::FindFile(const std::string& lower_stem,
+                             const std::vector<std::string>& extensions) const {
+  Asset asset;
+  for (const std::string& extension : extensions) {
+    std::string name = lower_stem + "." + extension;
+    if (Find(name, &asset))
+      return path_ / name;
+  }
+  return fs::path();
+}
+
+// static
+bool AssetPack::FindPath(const fs::path& path, Asset* out) {
+  std::lock_guard<std::mutex> lock(s_open_packs_lock);
+  if (s_open_packs.empty())
+    return false;
+
+  fs::path parent = path.parent_path();
+  for (const AssetPack* pack : s_open_packs) {
+    if (pack->path_ == parent)
+      return pack->Find(path.filename().string(), out);
+  }
+  return false;
+}
+
+// static
+FILE* AssetPack::OpenStream(const fs::path& path) {
+  Asset asset;
+  if (!FindPath(path, &asset))
+    return fopen(path.string().c_str(), "rb");
+
+#ifdef WIN32
+  // No fmemopen(); fall back to a copy.
+  FILE* f = tmpfile();
+  if (f) {
+    fwrite(asset.data, 1, asset.size, f);
+    rewind(f);
+  }
+  return f;
+#else
+  if (asset.size == 0)
+    return NULL;
+  return fmemopen(const_cast<char*>(asset.data), asset.size, "rb");
+#endif
+}
+
+// static
+void AssetPack::Write(
+    const fs::path& output,
+    const std::vector<std::pair<std::string, fs::path>>& files) {
+  struct PendingEntry {
+    std::string name;
+    fs::path source;
+    uint64_t hash;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t name_offset;
+  };
+
+  std::vector<PendingEntry> entries;
+  std::set<std::string> seen;
+  std::string names;
+  for (const auto& file : files) {
+    std::string name = boost::to_lower_copy(file.first);
+    if (!seen.insert(name).second)
+      continue;
+
+    boost::system::error_code ec;
+    uint64_t size = fs::file_size(file.second, ec);
+    if (ec) {
+      std::ostringstream oss;
+      oss << "Could not read " << file.second << ": " << ec.message();
+      throw rlvm::Exception(oss.str());
+    }
+
+    PendingEntry entry = {name, file.second, HashName(name), 0, size,
+                          static_cast<uint32_t>(names.size())};
+    names += name;
+    entries.push_back(entry);
+  }
+
+  // Keep the table at most half full so probes stay short.
+  uint32_t bucket_count = 1;
+  while (bucket_count < entries.size() * 2)
+    bucket_count <<= 1;
+
+  std::vector<uint32_t> buckets(bucket_count, 0);
+  for (size_t i = 0; i < entries.size(); ++i) {
+    uint32_t slot = entries[i].hash & (bucket_count - 1);
+    while (buckets[slot] != 0)
+      slot = (slot + 1) & (bucket_count - 1);
+    buckets[slot] = i + 1;
+  }
+
+  uint64_t offset = AlignUp(HEADER_SIZE + uint64_t(bucket_count) * 4 +
+                            entries.size() * ENTRY_SIZE + names.size());
+  for (PendingEntry& entry : entries) {
+    entry.offset = offset;
+    offset = AlignUp(offset + entry.size);
+  }
+
+  std::string index(PACK_MAGIC, sizeof(PACK_MAGIC));
+  AppendU32(&index, PACK_VERSION);
+  AppendU32(&index, bucket_count);
+  AppendU32(&index, entries.size());
+  AppendU32(&index, names.size());
+  for (uint32_t bucket : buckets)
+    AppendU32(&index, bucket);
+  for (const PendingEntry& entry : entries) {
+    AppendU64(&index, entry.hash);
+    AppendU64(&index, entry.offset);
+    AppendU64(&index, entry.size);
+    AppendU32(&index, entry.name_offset);
+    AppendU32(&index, entry.name.size());
+  }
+  index += names;
+
+  fs::ofstream out(output, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    std::ostringstream oss;
+    oss << "Could not open " << output << " for writing.";
+    throw rlvm::Exception(oss.str());
+  }
+  out.write(index.data(), index.size());
+
+  std::vector<char> buffer(64 * 1024);
+  for (const PendingEntry& entry : entries) {
+    std::string padding(entry.offset - out.tellp(), '\0');
+    out.write(padding.data(), padding.size());
+
+    fs::ifstream in(entry.source, std::ios::binary);
+    uint64_t remaining = entry.size;
+    while (in && remaining > 0) {
+      size_t chunk = std::min<uint64_t>(remaining, buffer.size());
+      in.read(&buffer[0], chunk);
+      out.write(&buffer[0], in.gcount());
+      remaining -= in.gcount();
+    }
+    if (remaining != 0) {
+      std::ostringstream oss;
+      oss << "Could not read " << entry.source << ".";
+      throw rlvm::Exception(oss.str());
+    }
+  }
+
+  if (!out) {
+    std::ostringstream oss;
+    oss << "Error writing " << output << ".";
+    throw rlvm::Exception(oss.str());
+  }
+}
@@ -0,0 +1,115 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#ifndef SRC_SYSTEMS_BASE_ASSET_PACK_H_
+#define SRC_SYSTEMS_BASE_ASSET_PACK_H_
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace libreallive {
+class Mapping;
+}  // namespace libreallive
+
+// A single memory mapped archive of a game's loose assets, built by the
+// rlvm-pack tool.
+//
+// Games with thousands of loose G00, OGG and NWA files pay an open() and a
+// read() per asset, which is slow on optical drives and network storage. A
+// pack is mapped once, and its contents are looked up through a hash table
+// of lowercased "stem.ext" names without touching the filesystem.
+//
+// System::FindFile() returns paths inside an open pack as |path()| / name.
+// These paths don't exist on disk; loaders pass them to Find() or
+// OpenStream() instead of opening them directly.
+//
+// On disk, all integers are little endian:
+//
+//   header:  "RLVMPAK1", uint32 version, uint32 bucket_count,
+//            uint32 entry_count, uint32 names_size
+//   buckets: uint32[bucket_count], entry index + 1 or 0 if empty
+//   entries: {uint64 hash, uint64 offset, uint64 size,
+//             uint32 name_offset, uint32 name_size}[entry_count]
+//   names:   names_size bytes of lowercased names
+//   data:    file contents, each aligned to DATA_ALIGNMENT
+class AssetPack {
+ public:
+  // A file's contents inside the mapped pack.
+  struct Asset {
+    const char* data;
+    size_t size;
+  };
+
+  // Maps |file|. Throws rlvm::Exception if it isn't a valid pack.
+  explicit AssetPack(const boost::filesystem::path& file);
+  ~AssetPack();
+
+  const boost::filesystem::path& path() const { return path_; }
+  size_t size() const { return entry_count_; }
+
+  // Looks up the lowercased "stem.ext" |name|.
+  bool Find(const std::string& name, Asset* out) const;
+
+  // Returns the path of |lower_stem| with the first of |extensions| in the
+  // pack, or an empty path.
+  boost::filesystem::path FindFile(
+      const std::string& lower_stem,
+      const std::vector<std::string>& extensions) const;
+
+  // Looks up a path returned by FindFile() in any open pack.
+  static bool FindPath(const boost::filesystem::path& path, Asset* out);
+
+  // fopen()s |path| for binary reading. If |path| is inside an open pack,
+  // returns a stream over the mapped contents instead, which doesn't copy.
+  static FILE* OpenStream(const boost::filesystem::path& path);
+
+  // Writes a pack of |files|, which are pairs of (name, source path). Names
+  // are lowercased; later duplicates of a name are skipped. Throws
+  // rlvm::Exception on error.
+  static void Write(
+      const boost::filesystem::path& output,
+      const std::vector<std::pair<std::string, boost::filesystem::path>>&
+          files);
+
+ private:
+  boost::filesystem::path path_;
+  std::unique_ptr<libreallive::Mapping> mapping_;
+
+  const unsigned char* buckets_;
+  const unsigned char* entries_;
+  const char* names_;
+  uint32_t bucket_count_;
+  uint32_t entry_count_;
+};
+
+#endif  // SRC_SYSTEMS_BASE_ASSET_PACK_H_
@@ -0,0 +1,102 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "systems/base/dirty_region.h"
+
+#include <limits>
+
+namespace {
+
+int Area(const Rect& rect) { return rect.width() * rect.height(); }
+
+bool HasArea(const Rect& rect) { return rect.width() > 0 && rect.height() > 0; }
+
+// Pixels that would be uploaded needlessly if |a| and |b| were merged.
+int MergeCost(const Rect& a, const Rect& b) {
+  return Area(a.RectUnion(b)) - Area(a) - Area(b);
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------
+// DirtyRegion
+// -----------------------------------------------------------------------
+
+const int DirtyRegion::kMaxRects;
+
+DirtyRegion::DirtyRegion() {}
+
+DirtyRegion::~DirtyRegion() {}
+
+void DirtyRegion::Add(const Rect& rect) {
+  if (!HasArea(rect))
+    return;
+
+  // Fold |merged| into every rectangle it can be merged into for free. Each
+  // merge grows |merged|, so start over until nothing else fits.
+  Rect merged = rect;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (auto it = rects_.begin(); it != rects_.end(); ++it) {
+      if (MergeCost(merged, *it) <= 0) {
+        merged = merged.RectUnion(*it);
+        rects_.erase(it);
+        changed = true;
+        break;
+      }
+    }
+  }
+  rects_.push_back(merged);
+
+  while (rects_.size() > static_cast<size_t>(kMaxRects)) {
+    size_t best_i = 0, best_j = 1;
+    int best_cost = std::numeric_limits<int>::max();
+    for (size_t i = 0; i < rects_.size(); ++i) {
+      for (size_t j = i + 1; j < rects_.size(); ++j) {
+        int cost = MergeCost(rects_[i], rects_[j]);
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_i = i;
+          best_j = j;
+        }
+      }
+    }
+
+    Rect combined = rects_[best_i].RectUnion(rects_[best_j]);
+    rects_.erase(rects_.begin() + best_j);
+    rects_.erase(rects_.begin() + best_i);
+    Add(combined);
+  }
+}
+
+int DirtyRegion::GetArea() const {
+  int area = 0;
+  for (const Rect& rect : rects_)
+    area += Area(rect);
+  return area;
+}
@@ -0,0 +1,67 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#ifndef SRC_SYSTEMS_BASE_DIRTY_REGION_H_
+#define SRC_SYSTEMS_BASE_DIRTY_REGION_H_
+
+#include <vector>
+
+#include "systems/base/rect.h"
+
+// A small set of rectangles that have changed since the last upload.
+//
+// Keeping a single union rectangle means that two small writes at opposite
+// corners of a surface dirty the whole thing. Instead, we merge a new
+// rectangle into an existing one only when the merged rectangle is no larger
+// than the two apart; glyphs written one at a time along a line collapse into
+// one rectangle per line, while unrelated writes stay separate. Once there are
+// more than kMaxRects rectangles, the pair that wastes the least area when
+// merged is combined.
+class DirtyRegion {
+ public:
+  static const int kMaxRects = 8;
+
+  DirtyRegion();
+  ~DirtyRegion();
+
+  // Adds |rect|. Rectangles without area are ignored.
+  void Add(const Rect& rect);
+
+  void Clear() { rects_.clear(); }
+
+  bool empty() const { return rects_.empty(); }
+  const std::vector<Rect>& rects() const { return rects_; }
+
+  // The total area of the rectangles. Pixels in two overlapping rectangles
+  // count twice, since they're uploaded twice.
+  int GetArea() const;
+
+ private:
+  std::vector<Rect> rects_;
+};
+
+#endif  // SRC_SYSTEMS_BASE_DIRTY_REGION_H_
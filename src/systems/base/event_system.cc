@@ -27,6 +27,10 @@
 
 #include "systems/base/event_system.h"
 
+#include <limits>
+#include <utility>
+#include <vector>
+
 #include "libreallive/gameexe.h"
 #include "machine/long_operation.h"
 #include "machine/rlmachine.h"
@@ -34,6 +38,13 @@
 #include "systems/base/frame_counter.h"
 #include "utilities/exception.h"
 
+namespace {
+
+// How far the frame clock moves per frame once a replay runs out of frames.
+const uint64_t kReplayFrameUs = 16667;
+
+}  // namespace
+
 // -----------------------------------------------------------------------
 // EventSystemGlobals
 // -----------------------------------------------------------------------
@@ -48,10 +59,103 @@ EventSystemGlobals::EventSystemGlobals(Gameexe& gexe)
 // -----------------------------------------------------------------------
 // EventSystem
 // -----------------------------------------------------------------------
-EventSystem::EventSystem(Gameexe& gexe) : globals_(gexe) {}
+const unsigned int EventSystem::kNoWakeup =
+    std::numeric_limits<unsigned int>::max();
+
+EventSystem::EventSystem(Gameexe& gexe)
+    : globals_(gexe),
+      frame_started_(false),
+      frame_time_us_(0),
+      next_wakeup_(kNoWakeup),
+      input_mode_(INPUT_LIVE),
+      replay_position_(-1) {}
 
 EventSystem::~EventSystem() {}
 
+uint64_t EventSystem::GetMicroseconds() const {
+  return static_cast<uint64_t>(GetTicks()) * 1000;
+}
+
+uint64_t EventSystem::GetLiveMicroseconds() const {
+  return GetMicroseconds();
+}
+
+void EventSystem::BeginFrame() {
+  if (input_mode_ == INPUT_REPLAYING) {
+    // Past the end of the trace, keep time moving so nothing waits forever.
+    if (replay_position_ + 1 < input_trace_->size()) {
+      ++replay_position_;
+      frame_time_us_ = input_trace_->GetFrame(replay_position_).time_us;
+    } else {
+      replay_position_ = input_trace_->size();
+      frame_time_us_ += kReplayFrameUs;
+    }
+  } else {
+    frame_time_us_ = clock_source_ ? clock_source_() : GetLiveMicroseconds();
+    if (input_mode_ == INPUT_RECORDING)
+      input_trace_->BeginFrame(frame_time_us_);
+  }
+
+  frame_started_ = true;
+  next_wakeup_ = kNoWakeup;
+}
+
+void EventSystem::SetFrameClockSource(const ClockSource& source) {
+  clock_source_ = source;
+}
+
+void EventSystem::StartRecordingInput(unsigned int seed) {
+  input_mode_ = INPUT_RECORDING;
+  input_trace_.reset(new InputTrace(seed));
+}
+
+void EventSystem::StartReplayingInput(std::unique_ptr<InputTrace> trace) {
+  input_mode_ = INPUT_REPLAYING;
+  input_trace_ = std::move(trace);
+  replay_position_ = -1;
+
+  // The clock stands still at the start of the trace until the first frame.
+  frame_started_ = true;
+  frame_time_us_ =
+      input_trace_->size() ? input_trace_->GetFrame(0).time_us : 0;
+}
+
+bool EventSystem::replay_finished() const {
+  return input_mode_ == INPUT_REPLAYING &&
+         replay_position_ >= input_trace_->size();
+}
+
+void EventSystem::RecordInput(const InputEvent& event) {
+  if (input_mode_ == INPUT_RECORDING)
+    input_trace_->AddEvent(event);
+}
+
+void EventSystem::RecordInstructions(int count) {
+  if (input_mode_ == INPUT_RECORDING)
+    input_trace_->AddInstructions(count);
+}
+
+const std::vector<InputEvent>& EventSystem::GetReplayedInput() const {
+  static const std::vector<InputEvent> kNoInput;
+  if (input_mode_ != INPUT_REPLAYING || replay_position_ < 0 ||
+      replay_position_ >= input_trace_->size())
+    return kNoInput;
+  return input_trace_->GetFrame(replay_position_).events;
+}
+
+int EventSystem::GetReplayedInstructions() const {
+  if (input_mode_ != INPUT_REPLAYING || replay_position_ < 0 ||
+      replay_position_ >= input_trace_->size())
+    return 0;
+  return input_trace_->GetFrame(replay_position_).instructions;
+}
+
+void EventSystem::WaitForEvents(unsigned int ticks) {
+  unsigned int now = GetLiveMicroseconds() / 1000;
+  if (ticks > now)
+    Wait(ticks - now);
+}
+
 RLTimer& EventSystem::GetTimer(int layer, int counter) {
   if (layer >= 2)
     throw rlvm::Exception("Invalid layer in EventSystem::GetTimer.");
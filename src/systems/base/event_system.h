@@ -28,11 +28,14 @@
 #ifndef SRC_SYSTEMS_BASE_EVENT_SYSTEM_H_
 #define SRC_SYSTEMS_BASE_EVENT_SYSTEM_H_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <queue>
 #include <set>
+#include <vector>
 
+#include "systems/base/input_trace.h"
 #include "systems/base/rltimer.h"
 #include "systems/base/rect.h"
 
@@ -126,9 +129,65 @@ class EventSystem {
   // started. Used for timing things.
   virtual unsigned int GetTicks() const = 0;
 
+  // The same clock as GetTicks(), in microseconds. The default implementation
+  // only has millisecond resolution.
+  virtual uint64_t GetMicroseconds() const;
+
+  // The wall clock, even while GetMicroseconds() is held to the frame clock
+  // for recording or replaying input. Only for pacing the game loop itself;
+  // nothing the game sees may depend on it. Defaults to GetMicroseconds().
+  virtual uint64_t GetLiveMicroseconds() const;
+
+  // Frame clock
+  //
+  // Animations, effects, text display and other code that draws according to
+  // the time should read the time from here instead of from GetTicks(). The
+  // clock is sampled once per pass through the game loop by BeginFrame(), so
+  // every object drawn in a frame sees the same time and reading it is cheap.
+  //
+  // Until the first BeginFrame() (as in unit tests, which drive the machine
+  // directly), these return the live clock.
+  void BeginFrame();
+  unsigned int frame_ticks() const {
+    return frame_started_ ? static_cast<unsigned int>(frame_time_us_ / 1000)
+                          : GetTicks();
+  }
+  uint64_t frame_time_us() const {
+    return frame_started_ ? frame_time_us_ : GetLiveMicroseconds();
+  }
+
+  // Replaces the clock that BeginFrame() samples, such as with one that
+  // advances a fixed amount per frame for deterministic tests or rendering
+  // faster than real time. Its values are in microseconds and it must never
+  // run backwards. Pass an empty function to go back to
+  // GetLiveMicroseconds().
+  typedef std::function<uint64_t()> ClockSource;
+  void SetFrameClockSource(const ClockSource& source);
+
   // Idles the program for a certain amount of time in milliseconds.
   virtual void Wait(unsigned int milliseconds) const = 0;
 
+  // Idle scheduling
+  //
+  // While the game waits on the player, the game loop doesn't need to run
+  // every frame. During a pass through the loop, anything that must run again
+  // at a known time calls ScheduleWakeup() with that time in ticks, and
+  // anything that animates continuously calls ScheduleNextFrame(). The loop
+  // then sleeps in WaitForEvents() until the earliest of these or the next
+  // input event. BeginFrame() clears the schedule.
+  static const unsigned int kNoWakeup;
+  void ScheduleWakeup(unsigned int ticks) {
+    if (ticks < next_wakeup_)
+      next_wakeup_ = ticks;
+  }
+  void ScheduleNextFrame() { ScheduleWakeup(frame_ticks()); }
+  unsigned int next_wakeup() const { return next_wakeup_; }
+
+  // Blocks until the live clock reaches |ticks| or until there's input to
+  // handle, whichever comes first. The default implementation can't see
+  // pending input and simply sleeps.
+  virtual void WaitForEvents(unsigned int ticks);
+
   // Keyboard and Mouse Input (Reallive style)
   //
   // RealLive applications poll for input, with all the problems that sort of
@@ -161,6 +220,33 @@ class EventSystem {
   // Returns the time in ticks of the last mouse movement.
   virtual unsigned int TimeOfLastMouseMove() = 0;
 
+  // Input recording and replay
+  //
+  // While recording, every BeginFrame() starts a new frame in the trace, and
+  // the platform event system adds the input it handles with RecordInput().
+  // The game loop adds the number of instructions it ran.
+  //
+  // While replaying, BeginFrame() takes the frame clock from the trace
+  // instead of the system clock, and the platform event system handles
+  // GetReplayedInput() instead of live input. The game loop runs exactly
+  // GetReplayedInstructions() each frame and doesn't sleep, so a recorded
+  // session plays out the same way as fast as the machine allows.
+  void StartRecordingInput(unsigned int seed);
+  void StartReplayingInput(std::unique_ptr<InputTrace> trace);
+  bool recording_input() const { return input_mode_ == INPUT_RECORDING; }
+  bool replaying_input() const { return input_mode_ == INPUT_REPLAYING; }
+  InputTrace* input_trace() { return input_trace_.get(); }
+
+  // Whether every frame of the trace has been replayed.
+  bool replay_finished() const;
+
+  void RecordInput(const InputEvent& event);
+  void RecordInstructions(int count);
+
+  // The input and instruction count of the frame being replayed.
+  const std::vector<InputEvent>& GetReplayedInput() const;
+  int GetReplayedInstructions() const;
+
   // Testing
   //
   // Allows test systems like lua_rlvm to inject mouse movement and clicks.
@@ -193,6 +279,21 @@ class EventSystem {
   EventListeners event_listeners_;
 
   EventSystemGlobals globals_;
+
+  // The frame clock. See BeginFrame().
+  bool frame_started_;
+  uint64_t frame_time_us_;
+  ClockSource clock_source_;
+
+  // The earliest time anything asked to run again this frame, or kNoWakeup.
+  unsigned int next_wakeup_;
+
+  enum InputMode { INPUT_LIVE, INPUT_RECORDING, INPUT_REPLAYING };
+  InputMode input_mode_;
+  std::unique_ptr<InputTrace> input_trace_;
+
+  // The index of the frame being replayed.
+  int replay_position_;
 };
 
 #endif  // SRC_SYSTEMS_BASE_EVENT_SYSTEM_H_
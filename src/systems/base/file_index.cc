@@ -0,0 +1,340 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "systems/base/file_index.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+using boost::to_lower;
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+const char INDEX_FILE_MAGIC[] = "rlvm-file-index 2";
+
+// Orders entries by stem, for both sorting and searching on a bare stem.
+struct StemLess {
+  template <typename Entry>
+  bool operator()(const Entry& a, const Entry& b) const {
+    return a.stem < b.stem;
+  }
+  template <typename Entry>
+  bool operator()(const Entry& a, const std::string& b) const {
+    return a.stem < b;
+  }
+  template <typename Entry>
+  bool operator()(const std::string& a, const Entry& b) const {
+    return a < b.stem;
+  }
+};
+
+bool ContainsNewline(const std::string& name) {
+  return name.find('\n') != std::string::npos;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------
+// FileIndex
+// -----------------------------------------------------------------------
+
+FileIndex::FileIndex(const fs::path& gamepath,
+                     const std::vector<std::string>& folders,
+                     const std::vector<std::string>& extensions,
+                     const fs::path& index_file)
+    : gamepath_(gamepath),
+      folders_(folders),
+      extensions_(extensions),
+      index_file_(index_file),
+      directories_scanned_(0),
+      built_(false) {}
+
+FileIndex::~FileIndex() {
+  // Don't let an exception from an unwaited build escape the destructor.
+  if (building_.valid())
+    building_.wait();
+}
+
+void FileIndex::Build() {
+  DirectoryMap previous;
+  std::time_t previous_listed_at = 0;
+  if (!index_file_.empty() && !LoadIndexFile(&previous, &previous_listed_at))
+    previous.clear();
+
+  // Taken before anything is listed, so a directory modified during the walk
+  // has an mtime no older than this.
+  std::time_t listed_at = std::time(NULL);
+
+  directories_scanned_ = 0;
+  DirectoryMap directories;
+  fs::directory_iterator dir_end;
+  for (fs::directory_iterator dir(gamepath_); dir != dir_end; ++dir) {
+    if (fs::is_directory(dir->status())) {
+      std::string lowername = dir->path().filename().string();
+      to_lower(lowername);
+      if (find(folders_.begin(), folders_.end(), lowername) != folders_.end())
+        WalkDirectory(dir->path().filename().string(), previous,
+                      previous_listed_at, &directories);
+    }
+  }
+
+  BuildTable(directories);
+
+  if (!index_file_.empty() &&
+      (directories_scanned_ > 0 || directories.size() != previous.size())) {
+    SaveIndexFile(directories, listed_at);
+  }
+
+  built_ = true;
+}
+
+void FileIndex::BuildInBackground() {
+  building_ = std::async(std::launch::async, [this] { Build(); });
+}
+
+fs::path FileIndex::Find(const std::string& lower_stem,
+                         const std::vector<std::string>& extensions) {
+  WaitUntilBuilt();
+
+  auto range =
+      std::equal_range(entries_.begin(), entries_.end(), lower_stem, StemLess());
+  if (range.first == range.second)
+    return fs::path();
+
+  for (const std::string& extension : extensions) {
+    int id = InternExtension(extension);
+    if (id < 0)
+      continue;
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->extension == id)
+        return paths_[it->path];
+    }
+  }
+
+  return fs::path();
+}
+
+size_t FileIndex::size() {
+  WaitUntilBuilt();
+  return entries_.size();
+}
+
+void FileIndex::WaitUntilBuilt() {
+  // get() invalidates the future, so later calls don't wait, and rethrows
+  // anything Build() threw.
+  if (building_.valid()) {
+    try {
+      building_.get();
+    } catch (const std::exception& e) {
+      std::cerr << "Building the file index failed, retrying: " << e.what()
+                << std::endl;
+    }
+  }
+
+  if (!built_)
+    Build();
+}
+
+bool FileIndex::LoadIndexFile(DirectoryMap* directories,
+                              std::time_t* listed_at) const {
+  fs::ifstream in(index_file_);
+  if (!in)
+    return false;
+
+  std::string line;
+  if (!getline(in, line) || line != INDEX_FILE_MAGIC)
+    return false;
+  if (!getline(in, line) || line != gamepath_.string())
+    return false;
+  if (!getline(in, line) || line != boost::join(extensions_, ","))
+    return false;
+  if (!getline(in, line))
+    return false;
+  std::istringstream listed_at_stream(line);
+  if (!(listed_at_stream >> *listed_at))
+    return false;
+
+  Directory* current = NULL;
+  while (getline(in, line)) {
+    if (line.size() < 2 || line[1] != ' ')
+      return false;
+
+    std::string value = line.substr(2);
+    switch (line[0]) {
+      case 'D': {
+        std::istringstream iss(value);
+        std::time_t mtime;
+        std::string relative;
+        if (!(iss >> mtime) || iss.get() != ' ' || !getline(iss, relative))
+          return false;
+        current = &(*directories)[relative];
+        current->mtime = mtime;
+        break;
+      }
+      case 'f':
+        if (!current)
+          return false;
+        current->files.push_back(value);
+        break;
+      case 'd':
+        if (!current)
+          return false;
+        current->subdirectories.push_back(value);
+        break;
+      default:
+        return false;
+    }
+  }
+
+  return true;
+}
+
+void FileIndex::SaveIndexFile(const DirectoryMap& directories,
+                              std::time_t listed_at) const {
+  boost::system::error_code ec;
+  fs::create_directories(index_file_.parent_path(), ec);
+
+  fs::path tmp = index_file_;
+  tmp += ".tmp";
+  {
+    fs::ofstream out(tmp, std::ios::trunc);
+    out << INDEX_FILE_MAGIC << '\n' << gamepath_.string() << '\n'
+        << boost::join(extensions_, ",") << '\n' << listed_at << '\n';
+
+    for (const auto& directory : directories) {
+      // Names with newlines can't be stored; leaving the directory out makes
+      // the next build list it again.
+      const Directory& d = directory.second;
+      if (ContainsNewline(directory.first) ||
+          std::any_of(d.files.begin(), d.files.end(), ContainsNewline) ||
+          std::any_of(d.subdirectories.begin(), d.subdirectories.end(),
+                      ContainsNewline)) {
+        continue;
+      }
+
+      out << "D " << d.mtime << ' ' << directory.first << '\n';
+      for (const std::string& file : d.files)
+        out << "f " << file << '\n';
+      for (const std::string& subdirectory : d.subdirectories)
+        out << "d " << subdirectory << '\n';
+    }
+
+    if (!out) {
+      fs::remove(tmp, ec);
+      return;
+    }
+  }
+
+  fs::rename(tmp, index_file_, ec);
+  if (ec) {
+    std::cerr << "Could not write file index " << index_file_ << ": "
+              << ec.message() << std::endl;
+    fs::remove(tmp, ec);
+  }
+}
+
+void FileIndex::WalkDirectory(const std::string& relative,
+                              const DirectoryMap& previous,
+                              std::time_t listed_at,
+                              DirectoryMap* out) {
+  fs::path full_path = gamepath_ / relative;
+  std::time_t mtime = fs::last_write_time(full_path);
+
+  // A file added later in the second the directory was listed doesn't change
+  // its mtime, so only listings taken after the last change can be trusted.
+  DirectoryMap::const_iterator it = previous.find(relative);
+  Directory& directory = (*out)[relative];
+  if (it != previous.end() && it->second.mtime == mtime &&
+      mtime < listed_at) {
+    directory = it->second;
+  } else {
+    directories_scanned_++;
+    directory.mtime = mtime;
+    fs::directory_iterator dir_end;
+    for (fs::directory_iterator dir(full_path); dir != dir_end; ++dir) {
+      std::string name = dir->path().filename().string();
+      if (fs::is_directory(dir->status())) {
+        directory.subdirectories.push_back(name);
+      } else {
+        std::string extension = dir->path().extension().string();
+        if (extension.size() > 1 && extension[0] == '.')
+          extension = extension.substr(1);
+        to_lower(extension);
+        if (InternExtension(extension) >= 0)
+          directory.files.push_back(name);
+      }
+    }
+  }
+
+  for (const std::string& subdirectory : directory.subdirectories)
+    WalkDirectory(relative + "/" + subdirectory, previous, listed_at, out);
+}
+
+int FileIndex::InternExtension(const std::string& lower_extension) const {
+  for (size_t i = 0; i < extensions_.size(); ++i) {
+    if (extensions_[i] == lower_extension)
+      return i;
+  }
+  return -1;
+}
+
+void FileIndex::BuildTable(const DirectoryMap& directories) {
+  entries_.clear();
+  paths_.clear();
+
+  for (const auto& directory : directories) {
+    fs::path base = gamepath_ / directory.first;
+    for (const std::string& file : directory.second.files) {
+      fs::path path = base / file;
+      std::string extension = path.extension().string();
+      if (extension.size() > 1 && extension[0] == '.')
+        extension = extension.substr(1);
+      to_lower(extension);
+      int id = InternExtension(extension);
+      if (id < 0)
+        continue;
+
+      std::string stem = path.stem().string();
+      to_lower(stem);
+      Entry entry = {stem, static_cast<uint8_t>(id),
+                     static_cast<uint32_t>(paths_.size())};
+      entries_.push_back(entry);
+      paths_.push_back(path);
+    }
+  }
+
+  std::stable_sort(entries_.begin(), entries_.end(), StemLess());
+}
@@ -0,0 +1,143 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#ifndef SRC_SYSTEMS_BASE_FILE_INDEX_H_
+#define SRC_SYSTEMS_BASE_FILE_INDEX_H_
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstdint>
+#include <ctime>
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+// An index of every loadable file in the game's #FOLDNAME directories, keyed
+// on the lowercased stem.
+//
+// Walking the game directory is slow on games with tens of thousands of loose
+// voice files, so the directory listings are persisted to |index_file| along
+// with each directory's modification time. On the next start only directories
+// whose mtime changed are listed again; adding, removing or renaming a file
+// always touches its parent directory. Since mtimes only have one second
+// resolution, a directory modified in the same second it was listed is listed
+// again too. The walk can run on a background thread; Find() waits for it to
+// finish.
+//
+// Lookups binary search a flat, sorted table. Extensions are interned as
+// their position in |extensions|, so matching a file type is an integer
+// compare.
+class FileIndex {
+ public:
+  // |folders| are the lowercased #FOLDNAME directories in |gamepath|. Only
+  // files whose lowercased extension is in |extensions| are indexed. An empty
+  // |index_file| disables persistence.
+  FileIndex(const boost::filesystem::path& gamepath,
+            const std::vector<std::string>& folders,
+            const std::vector<std::string>& extensions,
+            const boost::filesystem::path& index_file);
+  ~FileIndex();
+
+  // Builds the index on the calling thread.
+  void Build();
+
+  // Builds the index on a background thread.
+  void BuildInBackground();
+
+  // Returns the path of the file named |lower_stem| with the first of
+  // |extensions| that exists, or an empty path. Blocks until the index is
+  // built. If the background build failed, or the index was never built, the
+  // index is built on the calling thread, and any error from that is thrown.
+  // Later calls try again until a build succeeds.
+  boost::filesystem::path Find(const std::string& lower_stem,
+                               const std::vector<std::string>& extensions);
+
+  // Number of indexed files. Blocks like Find().
+  size_t size();
+
+  // Number of directories that were listed from disk rather than reused from
+  // |index_file| by the last build.
+  int directories_scanned() const { return directories_scanned_; }
+
+ private:
+  // A directory as last seen on disk. |path| is relative to |gamepath_|.
+  struct Directory {
+    std::time_t mtime;
+    std::vector<std::string> files;
+    std::vector<std::string> subdirectories;
+  };
+  typedef std::map<std::string, Directory> DirectoryMap;
+
+  struct Entry {
+    std::string stem;
+    uint8_t extension;
+    uint32_t path;
+  };
+
+  void WaitUntilBuilt();
+
+  // Reads |index_file_| into |directories|, along with the time the listings
+  // in it were taken. Returns false if it is missing or was written for a
+  // different game or extension list.
+  bool LoadIndexFile(DirectoryMap* directories, std::time_t* listed_at) const;
+  void SaveIndexFile(const DirectoryMap& directories,
+                     std::time_t listed_at) const;
+
+  // Adds |relative| and everything under it to |out|, reusing entries from
+  // |previous| whose mtime still matches and is older than |listed_at|, the
+  // time |previous| was listed.
+  void WalkDirectory(const std::string& relative,
+                     const DirectoryMap& previous,
+                     std::time_t listed_at,
+                     DirectoryMap* out);
+
+  // Returns the interned id of |extension| or -1.
+  int InternExtension(const std::string& lower_extension) const;
+
+  void BuildTable(const DirectoryMap& directories);
+
+  boost::filesystem::path gamepath_;
+  std::vector<std::string> folders_;
+  std::vector<std::string> extensions_;
+  boost::filesystem::path index_file_;
+
+  // Sorted by stem. Files with the same stem are ordered by the relative path
+  // of their directory, then by the order that directory was listed in.
+  std::vector<Entry> entries_;
+  std::vector<boost::filesystem::path> paths_;
+
+  int directories_scanned_;
+
+  // Whether a Build() has finished successfully.
+  bool built_;
+
+  // Valid while a build started by BuildInBackground() hasn't been waited on.
+  std::future<void> building_;
+};
+
+#endif  // SRC_SYSTEMS_BASE_FILE_INDEX_H_
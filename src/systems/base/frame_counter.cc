@@ -45,7 +45,7 @@ FrameCounter::FrameCounter(EventSystem& event_system,
       min_value_(frame_min),
       max_value_(frame_max),
       is_active_(true),
-      time_at_start_(event_system.GetTicks()),
+      time_at_start_(event_system.frame_ticks()),
       total_time_(milliseconds) {
   BeginTimer();
 
@@ -91,7 +91,7 @@ void FrameCounter::UpdateTimeValue(float num_ticks) {
 int FrameCounter::ReadNormalFrameWithChangeInterval(float change_interval,
                                                     float& time_at_last_check) {
   if (is_active_) {
-    unsigned int current_time = event_system_.GetTicks();
+    unsigned int current_time = event_system_.frame_ticks();
     float ms_elapsed = current_time - time_at_last_check;
     float num_ticks = ms_elapsed / change_interval;
 
@@ -124,7 +124,7 @@ SimpleFrameCounter::SimpleFrameCounter(EventSystem& es,
                                        int frame_max,
                                        int milliseconds)
     : FrameCounter(es, frame_min, frame_max, milliseconds),
-      time_at_last_check_(es.GetTicks()) {
+      time_at_last_check_(es.frame_ticks()) {
   change_interval_ = float(milliseconds) / abs(frame_max - frame_min);
 }
 
@@ -144,7 +144,7 @@ LoopFrameCounter::LoopFrameCounter(EventSystem& es,
                                    int frame_max,
                                    int milliseconds)
     : FrameCounter(es, frame_min, frame_max, milliseconds),
-      time_at_last_check_(es.GetTicks()) {
+      time_at_last_check_(es.frame_ticks()) {
   change_interval_ = float(milliseconds) / abs(frame_max - frame_min);
 }
 
@@ -168,7 +168,7 @@ TurnFrameCounter::TurnFrameCounter(EventSystem& es,
                                    int frame_max,
                                    int milliseconds)
     : FrameCounter(es, frame_min, frame_max, milliseconds),
-      time_at_last_check_(es.GetTicks()) {
+      time_at_last_check_(es.frame_ticks()) {
   change_interval_ = int(float(milliseconds) / abs(frame_max - frame_min));
   going_forward_ = frame_max >= frame_min;
 }
@@ -181,7 +181,7 @@ int TurnFrameCounter::ReadFrame() {
             << " THING LIKE ALL OTHER FRAME COUNTERS. FIXME." << std::endl;
 
   if (is_active_) {
-    unsigned int current_time = event_system_.GetTicks();
+    unsigned int current_time = event_system_.frame_ticks();
     unsigned int ms_elapsed = current_time - time_at_last_check_;
     unsigned int time_remainder = ms_elapsed % change_interval_;
     unsigned int num_ticks = ms_elapsed / change_interval_;
@@ -219,7 +219,7 @@ AcceleratingFrameCounter::AcceleratingFrameCounter(EventSystem& es,
                                                    int frame_max,
                                                    int milliseconds)
     : FrameCounter(es, frame_min, frame_max, milliseconds),
-      start_time_(es.GetTicks()),
+      start_time_(es.frame_ticks()),
       time_at_last_check_(start_time_) {}
 
 AcceleratingFrameCounter::~AcceleratingFrameCounter() {}
@@ -228,7 +228,7 @@ int AcceleratingFrameCounter::ReadFrame() {
   if (is_active_) {
     float base_interval = float(total_time_) / abs(max_value_ - min_value_);
     float cur_time =
-        (event_system_.GetTicks() - start_time_) / float(total_time_);
+        (event_system_.frame_ticks() - start_time_) / float(total_time_);
     float interval = (1.1f - cur_time * 0.2f) * base_interval;
 
     return ReadNormalFrameWithChangeInterval(interval, time_at_last_check_);
@@ -245,7 +245,7 @@ DeceleratingFrameCounter::DeceleratingFrameCounter(EventSystem& es,
                                                    int frame_max,
                                                    int milliseconds)
     : FrameCounter(es, frame_min, frame_max, milliseconds),
-      start_time_(es.GetTicks()),
+      start_time_(es.frame_ticks()),
       time_at_last_check_(start_time_) {}
 
 DeceleratingFrameCounter::~DeceleratingFrameCounter() {}
@@ -254,7 +254,7 @@ int DeceleratingFrameCounter::ReadFrame() {
   if (is_active_) {
     float base_interval = float(total_time_) / abs(max_value_ - min_value_);
     float cur_time =
-        (event_system_.GetTicks() - start_time_) / float(total_time_);
+        (event_system_.frame_ticks() - start_time_) / float(total_time_);
     float interval = (0.9f + cur_time * 0.2f) * base_interval;
 
     return ReadNormalFrameWithChangeInterval(interval, time_at_last_check_);
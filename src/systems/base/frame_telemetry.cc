@@ -0,0 +1,250 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "systems/base/frame_telemetry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+
+#include "systems/base/colour.h"
+#include "systems/base/graphics_system.h"
+#include "systems/base/rect.h"
+#include "systems/base/surface.h"
+
+namespace {
+
+const char* kPhaseNames[FrameTelemetry::NUM_PHASES] = {
+    "events_us",       "text_us",         "sound_us",
+    "graphics_us",     "interpreter_us",  "draw_background_us",
+    "draw_objects_us", "draw_text_us",    "swap_us"};
+
+// Overlay geometry: one column per frame, two pixels per millisecond.
+const int kOverlayWidth = 240;
+const int kOverlayHeight = 100;
+const int kOverlayUsPerPixel = 500;
+
+// The phases drawn by the overlay, bottom to top. PHASE_GRAPHICS is left out
+// because it contains the drawing phases.
+const struct {
+  FrameTelemetry::Phase phase;
+  RGBAColour colour;
+} kOverlayBars[] = {
+    {FrameTelemetry::PHASE_EVENTS, RGBAColour(128, 128, 128)},
+    {FrameTelemetry::PHASE_TEXT, RGBAColour(255, 255, 0)},
+    {FrameTelemetry::PHASE_SOUND, RGBAColour(0, 255, 255)},
+    {FrameTelemetry::PHASE_INTERPRETER, RGBAColour(255, 0, 255)},
+    {FrameTelemetry::PHASE_DRAW_BACKGROUND, RGBAColour(0, 0, 255)},
+    {FrameTelemetry::PHASE_DRAW_OBJECTS, RGBAColour(0, 255, 0)},
+    {FrameTelemetry::PHASE_DRAW_TEXT, RGBAColour(255, 128, 0)},
+    {FrameTelemetry::PHASE_SWAP, RGBAColour(255, 0, 0)}};
+
+}  // namespace
+
+// -----------------------------------------------------------------------
+// FrameTelemetry::ScopedPhase
+// -----------------------------------------------------------------------
+FrameTelemetry::ScopedPhase::ScopedPhase(FrameTelemetry& telemetry,
+                                         Phase phase)
+    : telemetry_(telemetry),
+      phase_(phase),
+      start_us_(telemetry.GetMicroseconds()) {}
+
+FrameTelemetry::ScopedPhase::~ScopedPhase() {
+  telemetry_.AddPhaseTime(phase_, telemetry_.GetMicroseconds() - start_us_);
+}
+
+// -----------------------------------------------------------------------
+// FrameTelemetry
+// -----------------------------------------------------------------------
+FrameTelemetry::FrameTelemetry(int capacity)
+    : frames_(capacity + 1),
+      current_(0),
+      finished_(0),
+      started_(false),
+      frame_start_us_(0) {}
+
+FrameTelemetry::~FrameTelemetry() {}
+
+// static
+const char* FrameTelemetry::GetPhaseName(Phase phase) {
+  return kPhaseNames[phase];
+}
+
+void FrameTelemetry::SetClockSource(const ClockSource& source) {
+  clock_source_ = source;
+}
+
+uint64_t FrameTelemetry::GetMicroseconds() const {
+  if (clock_source_)
+    return clock_source_();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void FrameTelemetry::BeginFrame(unsigned int ticks) {
+  uint64_t now = GetMicroseconds();
+
+  // Frames stay in the same scene until told otherwise.
+  int scene = 0;
+  if (started_) {
+    Frame& frame = current();
+    scene = frame.scene;
+    frame.frame_us = now - frame_start_us_;
+
+    SceneTotals& totals = scene_totals_[frame.scene];
+    totals.frames++;
+    totals.instructions += frame.instructions;
+    totals.total_us += frame.frame_us;
+    totals.worst_us = std::max(totals.worst_us, frame.frame_us);
+
+    current_ = (current_ + 1) % frames_.size();
+    finished_ = std::min(finished_ + 1, static_cast<int>(frames_.size()) - 1);
+  }
+
+  started_ = true;
+  frame_start_us_ = now;
+  current() = Frame();
+  current().ticks = ticks;
+  current().scene = scene;
+}
+
+void FrameTelemetry::AddPhaseTime(Phase phase, uint64_t microseconds) {
+  if (started_)
+    current().phase_us[phase] += microseconds;
+}
+
+uint64_t FrameTelemetry::Lap(Phase phase, uint64_t since_us) {
+  uint64_t now = GetMicroseconds();
+  AddPhaseTime(phase, now - since_us);
+  return now;
+}
+
+void FrameTelemetry::AddInstructions(int count) {
+  if (started_)
+    current().instructions += count;
+}
+
+void FrameTelemetry::AddUploadBytes(uint64_t bytes) {
+  if (started_)
+    current().upload_bytes += bytes;
+}
+
+void FrameTelemetry::SetScene(int scene) {
+  if (started_)
+    current().scene = scene;
+}
+
+const FrameTelemetry::Frame& FrameTelemetry::GetFrame(int i) const {
+  int size = frames_.size();
+  return frames_[(current_ - finished_ + i + size) % size];
+}
+
+void FrameTelemetry::WriteCSV(std::ostream& out) const {
+  out << "ticks,scene,frame_us";
+  for (int p = 0; p < NUM_PHASES; ++p)
+    out << ',' << kPhaseNames[p];
+  out << ",instructions,upload_bytes\n";
+
+  for (int i = 0; i < size(); ++i) {
+    const Frame& frame = GetFrame(i);
+    out << frame.ticks << ',' << frame.scene << ',' << frame.frame_us;
+    for (int p = 0; p < NUM_PHASES; ++p)
+      out << ',' << frame.phase_us[p];
+    out << ',' << frame.instructions << ',' << frame.upload_bytes << '\n';
+  }
+}
+
+void FrameTelemetry::WriteJSON(std::ostream& out) const {
+  out << "[";
+  for (int i = 0; i < size(); ++i) {
+    const Frame& frame = GetFrame(i);
+    out << (i ? ",\n " : "\n ") << "{\"ticks\": " << frame.ticks
+        << ", \"scene\": " << frame.scene
+        << ", \"frame_us\": " << frame.frame_us;
+    for (int p = 0; p < NUM_PHASES; ++p)
+      out << ", \"" << kPhaseNames[p] << "\": " << frame.phase_us[p];
+    out << ", \"instructions\": " << frame.instructions
+        << ", \"upload_bytes\": " << frame.upload_bytes << "}";
+  }
+  out << "\n]\n";
+}
+
+void FrameTelemetry::WriteSceneTotals(std::ostream& out) const {
+  out << "scene,frames,instructions,total_us,mean_frame_us,worst_frame_us\n";
+  for (const auto& entry : scene_totals_) {
+    const SceneTotals& totals = entry.second;
+    out << entry.first << ',' << totals.frames << ',' << totals.instructions
+        << ',' << totals.total_us << ',' << totals.total_us / totals.frames
+        << ',' << totals.worst_us << '\n';
+  }
+}
+
+// -----------------------------------------------------------------------
+// FrameTelemetryOverlay
+// -----------------------------------------------------------------------
+FrameTelemetryOverlay::FrameTelemetryOverlay(GraphicsSystem& graphics,
+                                             const FrameTelemetry& telemetry)
+    : graphics_(graphics), telemetry_(telemetry) {}
+
+FrameTelemetryOverlay::~FrameTelemetryOverlay() {}
+
+void FrameTelemetryOverlay::Render(std::ostream* tree) {
+  Size size(kOverlayWidth, kOverlayHeight);
+  if (!surface_)
+    surface_ = graphics_.BuildSurface(size);
+
+  surface_->Fill(RGBAColour(0, 0, 0, 160));
+
+  int frames = std::min(telemetry_.size(), kOverlayWidth);
+  int first = telemetry_.size() - frames;
+  for (int i = 0; i < frames; ++i) {
+    const FrameTelemetry::Frame& frame = telemetry_.GetFrame(first + i);
+    int x = kOverlayWidth - frames + i;
+    int y = kOverlayHeight;
+    for (const auto& bar : kOverlayBars) {
+      int height = frame.phase_us[bar.phase] / kOverlayUsPerPixel;
+      height = std::min(height, y);
+      if (height > 0) {
+        y -= height;
+        surface_->Fill(bar.colour, Rect(x, y, Size(1, height)));
+      }
+    }
+  }
+
+  // Mark the budget for a 60fps frame.
+  int budget_y = kOverlayHeight - 16667 / kOverlayUsPerPixel;
+  surface_->Fill(RGBAColour::White(),
+                 Rect(0, budget_y, Size(kOverlayWidth, 1)));
+
+  surface_->RenderToScreen(surface_->GetRect(), Rect(Point(0, 0), size), 255);
+
+  if (tree) {
+    *tree << "  Frame telemetry overlay" << std::endl;
+  }
+}
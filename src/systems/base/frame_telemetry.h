@@ -0,0 +1,179 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#ifndef SRC_SYSTEMS_BASE_FRAME_TELEMETRY_H_
+#define SRC_SYSTEMS_BASE_FRAME_TELEMETRY_H_
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "systems/base/renderable.h"
+
+class GraphicsSystem;
+class Surface;
+
+// Per frame timing of the game loop, for diagnosing stutter without a
+// profiler.
+//
+// Every pass through the game loop is one frame. The systems record how long
+// each phase of the frame took, how many bytecode instructions were executed
+// and how many bytes of texture data were uploaded. The last kDefaultCapacity
+// frames are kept in a ring buffer, which can be written out as CSV or JSON
+// (F10 in the SDL frontend) or drawn over the game (F11).
+class FrameTelemetry {
+ public:
+  // The parts of a frame that are timed. The PHASE_DRAW_* and PHASE_SWAP
+  // phases happen inside PHASE_GRAPHICS whenever the screen is redrawn.
+  enum Phase {
+    PHASE_EVENTS,
+    PHASE_TEXT,
+    PHASE_SOUND,
+    PHASE_GRAPHICS,
+    PHASE_INTERPRETER,
+    PHASE_DRAW_BACKGROUND,
+    PHASE_DRAW_OBJECTS,
+    PHASE_DRAW_TEXT,
+    PHASE_SWAP,
+    NUM_PHASES
+  };
+
+  struct Frame {
+    // The frame clock at the start of the frame.
+    unsigned int ticks;
+
+    // The SEEN the interpreter was in at the end of the frame.
+    int scene;
+
+    // Wall time from the start of this frame to the start of the next.
+    uint64_t frame_us;
+
+    uint64_t phase_us[NUM_PHASES];
+    int instructions;
+    uint64_t upload_bytes;
+  };
+
+  // Times a phase for the lifetime of the object.
+  class ScopedPhase {
+   public:
+    ScopedPhase(FrameTelemetry& telemetry, Phase phase);
+    ~ScopedPhase();
+
+   private:
+    FrameTelemetry& telemetry_;
+    Phase phase_;
+    uint64_t start_us_;
+  };
+
+  static const int kDefaultCapacity = 1024;
+
+  explicit FrameTelemetry(int capacity = kDefaultCapacity);
+  ~FrameTelemetry();
+
+  // Returns the column name used for |phase| in exported data.
+  static const char* GetPhaseName(Phase phase);
+
+  // Replaces the microsecond clock used for timing, for tests. Pass an empty
+  // function to go back to the system's monotonic clock.
+  typedef std::function<uint64_t()> ClockSource;
+  void SetClockSource(const ClockSource& source);
+  uint64_t GetMicroseconds() const;
+
+  // Finishes the current frame and starts recording a new one.
+  void BeginFrame(unsigned int ticks);
+
+  // Add to the current frame. Ignored before the first BeginFrame().
+  void AddPhaseTime(Phase phase, uint64_t microseconds);
+
+  // Adds the time since |since_us| to |phase| and returns the current time,
+  // for timing consecutive phases.
+  uint64_t Lap(Phase phase, uint64_t since_us);
+  void AddInstructions(int count);
+  void AddUploadBytes(uint64_t bytes);
+  void SetScene(int scene);
+
+  // The number of finished frames that are recorded, and the |i|th of them,
+  // oldest first.
+  int size() const { return finished_; }
+  const Frame& GetFrame(int i) const;
+
+  // Writes all finished frames, oldest first.
+  void WriteCSV(std::ostream& out) const;
+  void WriteJSON(std::ostream& out) const;
+
+  // Writes a CSV summary of every frame finished since construction, one row
+  // per scene, for comparing benchmark runs.
+  void WriteSceneTotals(std::ostream& out) const;
+
+ private:
+  Frame& current() { return frames_[current_]; }
+
+  struct SceneTotals {
+    SceneTotals() : frames(0), instructions(0), total_us(0), worst_us(0) {}
+
+    int frames;
+    uint64_t instructions;
+    uint64_t total_us;
+    uint64_t worst_us;
+  };
+
+  ClockSource clock_source_;
+
+  // Ring buffer of |finished_| frames followed by the current one at
+  // |current_|.
+  std::vector<Frame> frames_;
+  int current_;
+  int finished_;
+  bool started_;
+  uint64_t frame_start_us_;
+
+  std::map<int, SceneTotals> scene_totals_;
+};
+
+// Draws the time spent in each phase of recent frames as stacked bars in the
+// top left of the screen. Added to the GraphicsSystem's final renderers.
+class FrameTelemetryOverlay : public Renderable {
+ public:
+  FrameTelemetryOverlay(GraphicsSystem& graphics,
+                        const FrameTelemetry& telemetry);
+  virtual ~FrameTelemetryOverlay();
+
+  // Overridden from Renderable:
+  virtual void Render(std::ostream* tree) override;
+
+ private:
+  GraphicsSystem& graphics_;
+  const FrameTelemetry& telemetry_;
+
+  // Redrawn every frame. Built on first use.
+  std::shared_ptr<Surface> surface_;
+};
+
+#endif  // SRC_SYSTEMS_BASE_FRAME_TELEMETRY_H_
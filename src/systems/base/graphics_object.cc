@@ -40,10 +40,15 @@
 #include <numeric>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "machine/rlmachine.h"
+#include "systems/base/event_system.h"
 #include "systems/base/graphics_object_data.h"
 #include "systems/base/object_mutator.h"
+#include "systems/base/object_tween_table.h"
+#include "systems/base/system.h"
 #include "utilities/exception.h"
 
 const int DEFAULT_TEXT_SIZE = 14;
@@ -137,9 +142,11 @@ GraphicsObject::Impl::ButtonProperties::ButtonProperties()
 // -----------------------------------------------------------------------
 // GraphicsObject
 // -----------------------------------------------------------------------
-GraphicsObject::GraphicsObject() : impl_(s_empty_impl) {}
+GraphicsObject::GraphicsObject()
+    : impl_(s_empty_impl), tween_table_(nullptr) {}
 
-GraphicsObject::GraphicsObject(const GraphicsObject& rhs) : impl_(rhs.impl_) {
+GraphicsObject::GraphicsObject(const GraphicsObject& rhs)
+    : impl_(rhs.impl_), tween_table_(nullptr) {
   if (rhs.object_data_) {
     object_data_.reset(rhs.object_data_->Clone());
     object_data_->set_owned_by(*this);
@@ -149,6 +156,8 @@ GraphicsObject::GraphicsObject(const GraphicsObject& rhs) : impl_(rhs.impl_) {
 
   for (auto const& mutator : rhs.object_mutators_)
     object_mutators_.emplace_back(mutator->Clone());
+  if (rhs.tween_table_)
+    rhs.tween_table_->CopyTweens(rhs, *this);
 }
 
 GraphicsObject::~GraphicsObject() { DeleteObjectMutators(); }
@@ -166,6 +175,8 @@ GraphicsObject& GraphicsObject::operator=(const GraphicsObject& obj) {
 
   for (auto const& mutator : obj.object_mutators_)
     object_mutators_.emplace_back(mutator->Clone());
+  if (obj.tween_table_)
+    obj.tween_table_->CopyTweens(obj, *this);
 
   return *this;
 }
@@ -795,40 +806,39 @@ void GraphicsObject::AddObjectMutator(std::unique_ptr<ObjectMutator> mutator) {
 
   // If there's a currently running mutator that matches the incoming mutator,
   // we ignore the incoming mutator. Kud Wafter's ED relies on this behavior.
-  for (std::unique_ptr<ObjectMutator>& mutator_ptr : object_mutators_) {
-    if (mutator_ptr->OperationMatches(mutator->repr(), mutator->name())) {
-      return;
-    }
-  }
+  if (IsMutatorRunningMatching(mutator->repr(), mutator->name_id()))
+    return;
 
   object_mutators_.push_back(std::move(mutator));
 }
 
-bool GraphicsObject::IsMutatorRunningMatching(int repno,
-                                              const std::string& name) {
+bool GraphicsObject::IsMutatorRunningMatching(int repno, int name_id) const {
   for (auto const& mutator : object_mutators_) {
-    if (mutator->OperationMatches(repno, name))
+    if (mutator->OperationMatches(repno, name_id))
       return true;
   }
 
-  return false;
+  return tween_table_ && tween_table_->IsRunning(*this, repno, name_id);
 }
 
 void GraphicsObject::EndObjectMutatorMatching(RLMachine& machine,
                                               int repno,
-                                              const std::string& name,
+                                              int name_id,
                                               int speedup) {
   if (speedup == 0) {
     std::vector<std::unique_ptr<ObjectMutator>>::iterator it =
         object_mutators_.begin();
     while (it != object_mutators_.end()) {
-      if ((*it)->OperationMatches(repno, name)) {
+      if ((*it)->OperationMatches(repno, name_id)) {
         (*it)->SetToEnd(machine, *this);
         it = object_mutators_.erase(it);
       } else {
         ++it;
       }
     }
+
+    if (tween_table_)
+      tween_table_->SetToEnd(*this, repno, name_id);
   } else if (speedup == 1) {
     // This is explicitly a noop.
   } else {
@@ -839,13 +849,18 @@ void GraphicsObject::EndObjectMutatorMatching(RLMachine& machine,
 }
 
 std::vector<std::string> GraphicsObject::GetMutatorNames() const {
-  std::vector<std::string> names;
+  std::vector<std::pair<int, int>> running;
+  for (auto& mutator : object_mutators_)
+    running.emplace_back(mutator->name_id(), mutator->repr());
+  if (tween_table_)
+    tween_table_->GetRunning(*this, &running);
 
-  for (auto& mutator : object_mutators_) {
+  std::vector<std::string> names;
+  for (auto& name_and_repno : running) {
     std::ostringstream oss;
-    oss << mutator->name();
-    if (mutator->repr() != -1)
-      oss << "/" << mutator->repr();
+    oss << GetMutatorName(name_and_repno.first);
+    if (name_and_repno.second != -1)
+      oss << "/" << name_and_repno.second;
     names.push_back(oss.str());
   }
 
@@ -860,6 +875,10 @@ void GraphicsObject::MakeImplUnique() {
 
 void GraphicsObject::DeleteObjectMutators() {
   object_mutators_.clear();
+  if (tween_table_) {
+    tween_table_->Remove(*this);
+    tween_table_ = nullptr;
+  }
 }
 
 void GraphicsObject::Render(int objNum,
@@ -895,6 +914,10 @@ void GraphicsObject::Execute(RLMachine& machine) {
     object_data_->Execute(machine);
   }
 
+  // Mutators animate every frame.
+  if (!object_mutators_.empty())
+    machine.system().event().ScheduleNextFrame();
+
   // Run each mutator. If it returns true, remove it.
   std::vector<std::unique_ptr<ObjectMutator>>::iterator it =
       object_mutators_.begin();
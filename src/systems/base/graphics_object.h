@@ -44,6 +44,7 @@ class GraphicsObject;
 class GraphicsObjectSlot;
 class GraphicsObjectData;
 class ObjectMutator;
+class ObjectTweenTable;
 
 // Describes an independent, movable graphical object on the
 // screen. GraphicsObject, internally, references a copy-on-write
@@ -295,14 +296,14 @@ class GraphicsObject {
   // ownership of the passed in object.
   void AddObjectMutator(std::unique_ptr<ObjectMutator> mutator);
 
-  // Returns true if a mutator matching the following parameters is currently
-  // running.
-  bool IsMutatorRunningMatching(int repno, const std::string& name);
+  // Returns true if a mutator or tween matching the following parameters is
+  // currently running. |name_id| comes from InternMutatorName().
+  bool IsMutatorRunningMatching(int repno, int name_id) const;
 
-  // Ends all mutators that match the given parameters.
+  // Ends all mutators and tweens that match the given parameters.
   void EndObjectMutatorMatching(RLMachine& machine,
                                 int repno,
-                                const std::string& name,
+                                int name_id,
                                 int speedup);
 
   // Returns a string for each mutator.
@@ -321,7 +322,8 @@ class GraphicsObject {
   // doesn't, a local copy is made.
   void MakeImplUnique();
 
-  // Immediately delete all mutators; doesn't run their SetToEnd() method.
+  // Immediately delete all mutators and tweens; doesn't run their SetToEnd()
+  // method.
   void DeleteObjectMutators();
 
   // Implementation data structure. GraphicsObject::Impl is the internal data
@@ -525,6 +527,11 @@ class GraphicsObject {
   // RLMAX SDK.
   std::vector<std::unique_ptr<ObjectMutator>> object_mutators_;
 
+  // The table holding this object's integer tweens, or NULL if none were ever
+  // added. Set by ObjectTweenTable.
+  ObjectTweenTable* tween_table_;
+
+  friend class ObjectTweenTable;
   friend class boost::serialization::access;
 
   // boost::serialization support
@@ -55,6 +55,7 @@
 #include "systems/base/anm_graphics_object_data.h"
 #include "systems/base/cgm_table.h"
 #include "systems/base/event_system.h"
+#include "systems/base/frame_telemetry.h"
 #include "systems/base/graphics_object.h"
 #include "systems/base/graphics_object_data.h"
 #include "systems/base/graphics_object_of_file.h"
@@ -64,10 +65,13 @@
 #include "systems/base/mouse_cursor.h"
 #include "systems/base/object_mutator.h"
 #include "systems/base/object_settings.h"
+#include "systems/base/object_tween_table.h"
+#include "systems/base/parent_graphics_object_data.h"
 #include "systems/base/surface.h"
 #include "systems/base/system.h"
 #include "systems/base/system_error.h"
 #include "systems/base/text_system.h"
+#include "systems/base/texture_budget.h"
 #include "utilities/exception.h"
 #include "utilities/lazy_array.h"
 
@@ -83,6 +87,29 @@ using std::vector;
 
 namespace fs = boost::filesystem;
 
+namespace {
+
+// Whether |obj|, or any object under it if it's a parent object, is an
+// animation that is currently playing.
+bool IsPlayingAnimation(GraphicsObject& obj) {
+  if (!obj.has_object_data())
+    return false;
+
+  GraphicsObjectData& data = obj.GetObjectData();
+  if (data.IsParentLayer()) {
+    for (GraphicsObject& child :
+         static_cast<ParentGraphicsObjectData&>(data).objects()) {
+      if (IsPlayingAnimation(child))
+        return true;
+    }
+    return false;
+  }
+
+  return data.IsAnimation() && data.is_currently_playing();
+}
+
+}  // namespace
+
 // -----------------------------------------------------------------------
 // GraphicsSystem::GraphicsObjectSettings
 // -----------------------------------------------------------------------
@@ -224,11 +251,15 @@ GraphicsSystem::GraphicsSystem(System& system, Gameexe& gameexe)
       background_type_(BACKGROUND_DC0),
       screen_needs_refresh_(false),
       object_state_dirty_(false),
+      present_interval_(0),
+      skip_present_interval_(0),
+      last_present_time_(0),
       is_responsible_for_update_(true),
       display_subtitle_(gameexe("SUBTITLE").ToInt(0)),
       interface_hidden_(false),
       globals_(gameexe),
       time_at_last_queue_change_(0),
+      tweens_(new ObjectTweenTable),
       graphics_object_settings_(new GraphicsObjectSettings(gameexe)),
       graphics_object_impl_(new GraphicsObjectImpl(
           graphics_object_settings_->objects_in_a_layer)),
@@ -236,9 +267,16 @@ GraphicsSystem::GraphicsSystem(System& system, Gameexe& gameexe)
       show_cursor_from_bytecode_(true),
       cursor_(gameexe("MOUSE_CURSOR").ToInt(0)),
       system_(system),
+      texture_budget_(new TextureBudget(
+          static_cast<uint64_t>(
+              std::max(0, gameexe("__TEXTURE_BUDGET").ToInt(256))) *
+          1024 * 1024)),
       preloaded_hik_scripts_(32),
       preloaded_g00_(256),
-      image_cache_(10) {}
+      image_cache_(10) {
+  SetPresentRate(gameexe("__PRESENT_RATE").ToInt(0));
+  SetSkipPresentRate(gameexe("__SKIP_PRESENT_RATE").ToInt(15));
+}
 
 // -----------------------------------------------------------------------
 
@@ -246,6 +284,12 @@ GraphicsSystem::~GraphicsSystem() {}
 
 // -----------------------------------------------------------------------
 
+void GraphicsSystem::WriteMemoryReport(std::ostream& os) const {
+  texture_budget_->WriteReport(os);
+}
+
+// -----------------------------------------------------------------------
+
 void GraphicsSystem::MarkScreenAsDirty(GraphicsUpdateType type) {
   switch (screen_update_mode()) {
     case SCREENUPDATEMODE_AUTOMATIC:
@@ -281,6 +325,28 @@ void GraphicsSystem::ForceRefresh() {
 void GraphicsSystem::OnScreenRefreshed() {
   screen_needs_refresh_ = false;
   object_state_dirty_ = false;
+  last_present_time_ = system().event().frame_ticks();
+}
+
+void GraphicsSystem::SetPresentRate(int frames_per_second) {
+  present_interval_ = frames_per_second > 0 ? 1000 / frames_per_second : 0;
+}
+
+void GraphicsSystem::SetSkipPresentRate(int frames_per_second) {
+  skip_present_interval_ =
+      frames_per_second > 0 ? 1000 / frames_per_second : 0;
+}
+
+unsigned int GraphicsSystem::GetPresentInterval() const {
+  if (skip_present_interval_ > present_interval_ &&
+      system_.ShouldFastForward())
+    return skip_present_interval_;
+  return present_interval_;
+}
+
+bool GraphicsSystem::IsPresentDue(unsigned int ticks) const {
+  return screen_needs_refresh_ &&
+         ticks - last_present_time_ >= GetPresentInterval();
 }
 
 // -----------------------------------------------------------------------
@@ -311,7 +377,7 @@ void GraphicsSystem::QueueShakeSpec(int spec) {
     }
 
     ForceRefresh();
-    time_at_last_queue_change_ = system().event().GetTicks();
+    time_at_last_queue_change_ = system().event().frame_ticks();
   }
 }
 
@@ -433,6 +499,21 @@ void GraphicsSystem::RemoveRenderable(Renderable* renderable) {
 
 // -----------------------------------------------------------------------
 
+void GraphicsSystem::ToggleTelemetryOverlay() {
+  if (telemetry_overlay_) {
+    RemoveRenderable(telemetry_overlay_.get());
+    telemetry_overlay_.reset();
+  } else {
+    telemetry_overlay_.reset(
+        new FrameTelemetryOverlay(*this, system().telemetry()));
+    AddRenderable(telemetry_overlay_.get());
+  }
+
+  ForceRefresh();
+}
+
+// -----------------------------------------------------------------------
+
 void GraphicsSystem::SetWindowSubtitle(const std::string& cp932str,
                                        int text_encoding) {
   subtitle_ = cp932str;
@@ -484,6 +565,9 @@ std::shared_ptr<Surface> GraphicsSystem::RenderToSurface() {
 }
 
 void GraphicsSystem::DrawFrame(std::ostream* tree) {
+  FrameTelemetry& telemetry = system().telemetry();
+  uint64_t lap = telemetry.GetMicroseconds();
+
   switch (background_type_) {
     case BACKGROUND_DC0: {
       // Display DC0
@@ -506,30 +590,50 @@ void GraphicsSystem::DrawFrame(std::ostream* tree) {
     }
   }
 
+  lap = telemetry.Lap(FrameTelemetry::PHASE_DRAW_BACKGROUND, lap);
   RenderObjects(tree);
+  lap = telemetry.Lap(FrameTelemetry::PHASE_DRAW_OBJECTS, lap);
 
   // Render text
   if (!is_interface_hidden())
     system().text().Render(tree);
+  telemetry.Lap(FrameTelemetry::PHASE_DRAW_TEXT, lap);
 }
 
 // -----------------------------------------------------------------------
 
 void GraphicsSystem::ExecuteGraphicsSystem(RLMachine& machine) {
+  EventSystem& event = system().event();
+
   // Check to see if any of the graphics objects are reporting that
   // they want to force a redraw
-  for (GraphicsObject& obj : GetForegroundObjects())
+  bool animating = false;
+  for (GraphicsObject& obj : GetForegroundObjects()) {
     obj.Execute(machine);
+    animating = animating || IsPlayingAnimation(obj);
+  }
+
+  if (tweens_->Execute(event.frame_ticks()))
+    mark_object_state_as_dirty();
 
   if (mouse_cursor_)
     mouse_cursor_->Execute(system());
 
-  if (hik_renderer_ && background_type_ == BACKGROUND_HIK)
+  if (hik_renderer_ && background_type_ == BACKGROUND_HIK) {
     hik_renderer_->Execute(machine);
+    animating = true;
+  }
+
+  if (animating || tweens_->size())
+    event.ScheduleNextFrame();
+
+  unsigned int present_interval = GetPresentInterval();
+  if (screen_needs_refresh_ && present_interval)
+    event.ScheduleWakeup(last_present_time_ + present_interval);
 
   // Possibly update the screen shaking state
   if (!screen_shake_queue_.empty()) {
-    unsigned int now = system().event().GetTicks();
+    unsigned int now = system().event().frame_ticks();
     unsigned int accumulated_ticks = now - time_at_last_queue_change_;
     while (!screen_shake_queue_.empty() &&
            accumulated_ticks > screen_shake_queue_.front().second) {
@@ -539,6 +643,11 @@ void GraphicsSystem::ExecuteGraphicsSystem(RLMachine& machine) {
       screen_shake_queue_.pop();
       ForceRefresh();
     }
+
+    if (!screen_shake_queue_.empty()) {
+      event.ScheduleWakeup(time_at_last_queue_change_ +
+                           screen_shake_queue_.front().second + 1);
+    }
   }
 }
 
@@ -791,6 +900,9 @@ bool GraphicsSystem::AnimationsPlaying() const {
 // -----------------------------------------------------------------------
 
 void GraphicsSystem::TakeSavepointSnapshot() {
+  // The snapshot records the objects as they are now; it must not be tweened
+  // along with the live objects.
+  ObjectTweenTable::ScopedNoCopy no_tweens(*tweens_);
   GetForegroundObjects().CopyTo(graphics_object_impl_->saved_foreground_objects);
   GetBackgroundObjects().CopyTo(graphics_object_impl_->saved_background_objects);
   graphics_object_impl_->saved_graphics_stack =
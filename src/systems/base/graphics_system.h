@@ -51,6 +51,7 @@
 #include "lru_cache.hpp"
 
 class ColourFilter;
+class FrameTelemetryOverlay;
 class Gameexe;
 class GraphicsObject;
 class GraphicsObjectData;
@@ -58,12 +59,14 @@ class GraphicsStackFrame;
 class HIKRenderer;
 class HIKScript;
 class MouseCursor;
+class ObjectTweenTable;
 class Renderable;
 class RGBAColour;
 class RLMachine;
 class Size;
 class Surface;
 class System;
+class TextureBudget;
 struct ObjectSettings;
 
 template <typename T>
@@ -257,6 +260,9 @@ class GraphicsSystem : public EventListener {
   void AddRenderable(Renderable* renderable);
   void RemoveRenderable(Renderable* renderable);
 
+  // Shows or hides a graph of System::telemetry() over the game.
+  void ToggleTelemetryOverlay();
+
   // Subtitle management
 
   // Sets the current value of the subtitle, as set with title(). This
@@ -324,6 +330,29 @@ class GraphicsSystem : public EventListener {
   bool screen_needs_refresh() const { return screen_needs_refresh_; }
   void OnScreenRefreshed();
 
+  // Presentation pacing
+  //
+  // By default a dirty screen is redrawn on the next pass through the game
+  // loop. With a present interval (set from \#__PRESENT_RATE, in frames per
+  // second), it's redrawn at most once per interval. Changes made in between
+  // are drawn together, and the game loop ends an interpreter burst when a
+  // redraw is due, so neither long bursts nor slow frames set the pace of the
+  // other.
+  //
+  // While skipping, redraws are further capped to \#__SKIP_PRESENT_RATE
+  // (default 15) so that skipping through read text is limited by the
+  // interpreter and not by drawing every page.
+  unsigned int present_interval() const { return present_interval_; }
+  void SetPresentRate(int frames_per_second);
+  void SetSkipPresentRate(int frames_per_second);
+
+  // The minimum ticks between redraws right now, taking skip mode into
+  // account. Zero when redraws aren't paced.
+  unsigned int GetPresentInterval() const;
+
+  // Returns true if the screen is dirty and may be redrawn at |ticks|.
+  bool IsPresentDue(unsigned int ticks) const;
+
   // We keep a separate state about whether object state has been modified. We
   // do this so that background object mutation in automatic mode plays nicely
   // with LongOperations.
@@ -367,6 +396,17 @@ class GraphicsSystem : public EventListener {
   std::shared_ptr<const Surface> GetSurfaceNamed(
       const std::string& short_filename);
 
+  // Keeps the video memory used by uploaded surfaces under
+  // \#__TEXTURE_BUDGET megabytes (default 256; zero for no limit). Shared so
+  // that surfaces which outlive the graphics system can still unregister.
+  const std::shared_ptr<TextureBudget>& texture_budget() const {
+    return texture_budget_;
+  }
+
+  // Writes a summary of texture memory use, and of the DCs where the
+  // platform keeps track.
+  virtual void WriteMemoryReport(std::ostream& os) const;
+
   virtual std::shared_ptr<Surface> GetHaikei() = 0;
 
   virtual std::shared_ptr<Surface> GetDC(int dc) = 0;
@@ -407,6 +447,10 @@ class GraphicsSystem : public EventListener {
   LazyArray<GraphicsObject>& GetBackgroundObjects();
   LazyArray<GraphicsObject>& GetForegroundObjects();
 
+  // The running objEve* tweens of every object in every layer. Advanced once
+  // per ExecuteGraphicsSystem().
+  ObjectTweenTable& tweens() { return *tweens_; }
+
   // Returns true if there's a currently playing animation.
   bool AnimationsPlaying() const;
 
@@ -495,6 +539,12 @@ class GraphicsSystem : public EventListener {
   // Whether object state has been mutated since the last screen refresh.
   bool object_state_dirty_;
 
+  // Minimum ticks between screen refreshes normally and while skipping, and
+  // the frame time of the last one. See IsPresentDue().
+  unsigned int present_interval_;
+  unsigned int skip_present_interval_;
+  unsigned int last_present_time_;
+
   // Whether it is the Graphics system's responsibility to redraw the
   // screen. Some LongOperations temporarily take this responsibility
   // to implement pretty fades and wipes
@@ -527,6 +577,10 @@ class GraphicsSystem : public EventListener {
   // The last time |screen_shake_queue_| was modified.
   unsigned int time_at_last_queue_change_;
 
+  // Declared before the object layers so it outlives every object that has
+  // rows in it.
+  std::unique_ptr<ObjectTweenTable> tweens_;
+
   // Immutable
   struct GraphicsObjectSettings;
   // Immutable global data that's constructed from the Gameexe.ini file.
@@ -563,6 +617,8 @@ class GraphicsSystem : public EventListener {
   // Our parent system object.
   System& system_;
 
+  std::shared_ptr<TextureBudget> texture_budget_;
+
   // Preloaded HIKScripts.
   typedef std::pair<std::string, std::shared_ptr<HIKScript>> HIKArrayItem;
   typedef LazyArray<HIKArrayItem> HIKScriptList;
@@ -581,6 +637,9 @@ class GraphicsSystem : public EventListener {
   // Possible background script which drives graphics to the screen.
   std::unique_ptr<HIKRenderer> hik_renderer_;
 
+  // Non-NULL while the telemetry overlay is shown.
+  std::unique_ptr<FrameTelemetryOverlay> telemetry_overlay_;
+
   // Tuple used in RenderObjects(). Causes about a half megabyte of allocator
   // churn per minute if we try to allocate it every time.
   //
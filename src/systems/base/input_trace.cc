@@ -0,0 +1,131 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "systems/base/input_trace.h"
+
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include "utilities/exception.h"
+
+namespace {
+
+// The first line of a trace is the magic, version and random seed. Then
+// each frame is an "f" line with its clock and instruction count, followed
+// by one "e" line per input event.
+const char kTraceMagic[] = "rlvm-input-trace";
+const int kTraceVersion = 1;
+
+const char* kEventNames[] = {"keydown", "keyup", "motion", "mousedown",
+                             "mouseup", "focus", "blur"};
+const int kNumEventNames = sizeof(kEventNames) / sizeof(kEventNames[0]);
+
+}  // namespace
+
+InputTrace::InputTrace(unsigned int seed) : seed_(seed) {}
+
+InputTrace::~InputTrace() {}
+
+// static
+std::unique_ptr<InputTrace> InputTrace::Load(std::istream& in) {
+  std::string magic;
+  int version = 0;
+  unsigned int seed = 0;
+  if (!(in >> magic >> version >> seed) || magic != kTraceMagic ||
+      version != kTraceVersion) {
+    throw rlvm::Exception("Not an rlvm input trace");
+  }
+
+  std::unique_ptr<InputTrace> trace(new InputTrace(seed));
+  std::string line;
+  int line_number = 1;
+  while (std::getline(in, line)) {
+    ++line_number;
+    std::istringstream iss(line);
+    std::string kind;
+    if (!(iss >> kind))
+      continue;
+
+    bool ok = false;
+    if (kind == "f") {
+      Frame frame;
+      ok = static_cast<bool>(iss >> frame.time_us >> frame.instructions);
+      trace->frames_.push_back(frame);
+    } else if (kind == "e" && !trace->frames_.empty()) {
+      std::string name;
+      int code, x, y, modifiers;
+      if (iss >> name >> code >> x >> y >> modifiers) {
+        for (int i = 0; i < kNumEventNames; ++i) {
+          if (name == kEventNames[i]) {
+            trace->AddEvent(InputEvent(static_cast<InputEvent::Type>(i),
+                                       code,
+                                       Point(x, y),
+                                       modifiers));
+            ok = true;
+          }
+        }
+      }
+    }
+
+    if (!ok) {
+      std::ostringstream oss;
+      oss << "Malformed input trace on line " << line_number;
+      throw rlvm::Exception(oss.str());
+    }
+  }
+
+  return trace;
+}
+
+void InputTrace::Save(std::ostream& out) const {
+  out << kTraceMagic << ' ' << kTraceVersion << ' ' << seed_ << '\n';
+  for (const Frame& frame : frames_) {
+    out << "f " << frame.time_us << ' ' << frame.instructions << '\n';
+    for (const InputEvent& event : frame.events) {
+      out << "e " << kEventNames[event.type] << ' ' << event.code << ' '
+          << event.position.x() << ' ' << event.position.y() << ' '
+          << event.modifiers << '\n';
+    }
+  }
+}
+
+void InputTrace::BeginFrame(uint64_t time_us) {
+  frames_.push_back(Frame());
+  frames_.back().time_us = time_us;
+}
+
+void InputTrace::AddEvent(const InputEvent& event) {
+  if (!frames_.empty())
+    frames_.back().events.push_back(event);
+}
+
+void InputTrace::AddInstructions(int count) {
+  if (!frames_.empty())
+    frames_.back().instructions += count;
+}
@@ -0,0 +1,114 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#ifndef SRC_SYSTEMS_BASE_INPUT_TRACE_H_
+#define SRC_SYSTEMS_BASE_INPUT_TRACE_H_
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include "systems/base/rect.h"
+
+// One piece of player input, in the platform's own key and button codes.
+// (KeyCode mirrors SDL's key codes.)
+struct InputEvent {
+  enum Type {
+    KEY_DOWN,
+    KEY_UP,
+    MOUSE_MOTION,
+    MOUSE_DOWN,
+    MOUSE_UP,
+    FOCUS_GAINED,
+    FOCUS_LOST
+  };
+
+  InputEvent() : type(KEY_DOWN), code(0), modifiers(0) {}
+  InputEvent(Type type, int code, const Point& position, int modifiers)
+      : type(type), code(code), position(position), modifiers(modifiers) {}
+
+  bool operator==(const InputEvent& rhs) const {
+    return type == rhs.type && code == rhs.code &&
+           position == rhs.position && modifiers == rhs.modifiers;
+  }
+
+  Type type;
+
+  // The key for key events, the button for mouse button events and the
+  // platform's focus flags for focus events.
+  int code;
+
+  // The cursor position for mouse events.
+  Point position;
+
+  // The platform's modifier key flags for key events.
+  int modifiers;
+};
+
+// A recording of a play session that can be replayed exactly.
+//
+// The trace has an entry for every pass through the game loop. Each entry
+// holds the frame clock at the start of the pass, the input handled in it
+// and the number of bytecode instructions run. Replaying the same clock,
+// input and instruction counts from the same random seed repeats the
+// session. See EventSystem::StartReplayingInput().
+class InputTrace {
+ public:
+  struct Frame {
+    Frame() : time_us(0), instructions(0) {}
+
+    uint64_t time_us;
+    int instructions;
+    std::vector<InputEvent> events;
+  };
+
+  explicit InputTrace(unsigned int seed);
+  ~InputTrace();
+
+  // Reads a trace written by Save(). Throws rlvm::Exception if |in| isn't a
+  // valid trace.
+  static std::unique_ptr<InputTrace> Load(std::istream& in);
+  void Save(std::ostream& out) const;
+
+  // The seed for the C library's random number generator.
+  unsigned int seed() const { return seed_; }
+
+  int size() const { return frames_.size(); }
+  const Frame& GetFrame(int i) const { return frames_[i]; }
+
+  // Recording. AddEvent() and AddInstructions() add to the last frame.
+  void BeginFrame(uint64_t time_us);
+  void AddEvent(const InputEvent& event);
+  void AddInstructions(int count);
+
+ private:
+  unsigned int seed_;
+  std::vector<Frame> frames_;
+};
+
+#endif  // SRC_SYSTEMS_BASE_INPUT_TRACE_H_
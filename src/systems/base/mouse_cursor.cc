@@ -49,7 +49,7 @@ MouseCursor::MouseCursor(System& system,
       count_(count),
       frame_speed_(speed / count_),
       current_frame_(0),
-      last_time_frame_incremented_(system.event().GetTicks()) {
+      last_time_frame_incremented_(system.event().frame_ticks()) {
   // TODO(erg): Technically, each frame might have a hotspot. In practice, the
   // hotspot is in the same place every frame.
   FindHotspot();
@@ -67,7 +67,7 @@ MouseCursor::MouseCursor(System& system,
 MouseCursor::~MouseCursor() {}
 
 void MouseCursor::Execute(System& system) {
-  unsigned int cur_time = system.event().GetTicks();
+  unsigned int cur_time = system.event().frame_ticks();
 
   if (last_time_frame_incremented_ + frame_speed_ < cur_time) {
     last_time_frame_incremented_ = cur_time;
@@ -78,6 +78,8 @@ void MouseCursor::Execute(System& system) {
     if (current_frame_ >= count_)
       current_frame_ = 0;
   }
+
+  system.event().ScheduleWakeup(last_time_frame_incremented_ + frame_speed_ + 1);
 }
 
 void MouseCursor::RenderHotspotAt(const Point& mouse_location) {
@@ -26,6 +26,10 @@
 
 #include "systems/base/object_mutator.h"
 
+#include <deque>
+#include <string>
+#include <unordered_map>
+
 #include "machine/rlmachine.h"
 #include "systems/base/event_system.h"
 #include "systems/base/graphics_object.h"
@@ -35,6 +39,39 @@
 #include "systems/base/system.h"
 #include "utilities/math_util.h"
 
+namespace {
+
+struct MutatorNameTable {
+  std::unordered_map<std::string, int> ids;
+  // A deque so references handed out by GetMutatorName() stay valid.
+  std::deque<std::string> names;
+};
+
+MutatorNameTable& GetMutatorNameTable() {
+  static MutatorNameTable table;
+  return table;
+}
+
+}  // namespace
+
+int InternMutatorName(const std::string& name) {
+  MutatorNameTable& table = GetMutatorNameTable();
+  auto it = table.ids.find(name);
+  if (it != table.ids.end())
+    return it->second;
+
+  int id = table.names.size();
+  table.names.push_back(name);
+  table.ids.emplace(name, id);
+  return id;
+}
+
+const std::string& GetMutatorName(int name_id) {
+  return GetMutatorNameTable().names.at(name_id);
+}
+
+// -----------------------------------------------------------------------
+
 ObjectMutator::ObjectMutator(int repr,
                              const std::string& name,
                              int creation_time,
@@ -42,7 +79,7 @@ ObjectMutator::ObjectMutator(int repr,
                              int delay,
                              int type)
     : repr_(repr),
-      name_(name),
+      name_id_(InternMutatorName(name)),
       creation_time_(creation_time),
       duration_time_(duration_time),
       delay_(delay),
@@ -54,7 +91,7 @@ ObjectMutator::ObjectMutator(const ObjectMutator& mutator) = default;
 ObjectMutator::~ObjectMutator() {}
 
 bool ObjectMutator::operator()(RLMachine& machine, GraphicsObject& object) {
-  unsigned int ticks = machine.system().event().GetTicks();
+  unsigned int ticks = machine.system().event().frame_ticks();
   if (ticks > (creation_time_ + delay_)) {
     PerformSetting(machine, object);
     machine.system().graphics().mark_object_state_as_dirty();
@@ -62,12 +99,8 @@ bool ObjectMutator::operator()(RLMachine& machine, GraphicsObject& object) {
   return ticks > (creation_time_ + delay_ + duration_time_);
 }
 
-bool ObjectMutator::OperationMatches(int repr, const std::string& name) const {
-  return repr_ == repr && name_ == name;
-}
-
 int ObjectMutator::GetValueForTime(RLMachine& machine, int start, int end) {
-  unsigned int ticks = machine.system().event().GetTicks();
+  unsigned int ticks = machine.system().event().frame_ticks();
   if (ticks < (creation_time_ + delay_)) {
     return start;
   } else if (ticks < (creation_time_ + delay_ + duration_time_)) {
@@ -81,118 +114,3 @@ int ObjectMutator::GetValueForTime(RLMachine& machine, int start, int end) {
     return end;
   }
 }
-
-// -----------------------------------------------------------------------
-
-OneIntObjectMutator::OneIntObjectMutator(const std::string& name,
-                                         int creation_time,
-                                         int duration_time,
-                                         int delay,
-                                         int type,
-                                         int start_value,
-                                         int target_value,
-                                         Setter setter)
-    : ObjectMutator(-1, name, creation_time, duration_time, delay, type),
-      startval_(start_value),
-      endval_(target_value),
-      setter_(setter) {}
-
-OneIntObjectMutator::~OneIntObjectMutator() {}
-
-OneIntObjectMutator::OneIntObjectMutator(const OneIntObjectMutator& rhs) =
-  default;
-
-void OneIntObjectMutator::SetToEnd(RLMachine& machine, GraphicsObject& object) {
-  (object.*setter_)(endval_);
-}
-
-ObjectMutator* OneIntObjectMutator::Clone() const {
-  return new OneIntObjectMutator(*this);
-}
-
-void OneIntObjectMutator::PerformSetting(RLMachine& machine,
-                                         GraphicsObject& object) {
-  int value = GetValueForTime(machine, startval_, endval_);
-  (object.*setter_)(value);
-}
-
-// -----------------------------------------------------------------------
-
-RepnoIntObjectMutator::RepnoIntObjectMutator(const std::string& name,
-                                             int creation_time,
-                                             int duration_time,
-                                             int delay,
-                                             int type,
-                                             int repno,
-                                             int start_value,
-                                             int target_value,
-                                             Setter setter)
-    : ObjectMutator(repno, name, creation_time, duration_time, delay, type),
-      repno_(repno),
-      startval_(start_value),
-      endval_(target_value),
-      setter_(setter) {}
-
-RepnoIntObjectMutator::~RepnoIntObjectMutator() {}
-
-RepnoIntObjectMutator::RepnoIntObjectMutator(const RepnoIntObjectMutator& rhs) =
-  default;
-
-void RepnoIntObjectMutator::SetToEnd(RLMachine& machine,
-                                     GraphicsObject& object) {
-  (object.*setter_)(repno_, endval_);
-}
-
-ObjectMutator* RepnoIntObjectMutator::Clone() const {
-  return new RepnoIntObjectMutator(*this);
-}
-
-void RepnoIntObjectMutator::PerformSetting(RLMachine& machine,
-                                           GraphicsObject& object) {
-  int value = GetValueForTime(machine, startval_, endval_);
-  (object.*setter_)(repno_, value);
-}
-
-// -----------------------------------------------------------------------
-
-TwoIntObjectMutator::TwoIntObjectMutator(const std::string& name,
-                                         int creation_time,
-                                         int duration_time,
-                                         int delay,
-                                         int type,
-                                         int start_one,
-                                         int target_one,
-                                         Setter setter_one,
-                                         int start_two,
-                                         int target_two,
-                                         Setter setter_two)
-    : ObjectMutator(-1, name, creation_time, duration_time, delay, type),
-      startval_one_(start_one),
-      endval_one_(target_one),
-      setter_one_(setter_one),
-      startval_two_(start_two),
-      endval_two_(target_two),
-      setter_two_(setter_two) {}
-
-TwoIntObjectMutator::~TwoIntObjectMutator() {}
-
-TwoIntObjectMutator::TwoIntObjectMutator(const TwoIntObjectMutator& rhs) =
-  default;
-
-void TwoIntObjectMutator::SetToEnd(RLMachine& machine, GraphicsObject& object) {
-  (object.*setter_one_)(endval_one_);
-  (object.*setter_two_)(endval_two_);
-}
-
-ObjectMutator* TwoIntObjectMutator::Clone() const {
-  return new TwoIntObjectMutator(*this);
-}
-
-void TwoIntObjectMutator::PerformSetting(RLMachine& machine,
-                                         GraphicsObject& object) {
-  int value = GetValueForTime(machine, startval_one_, endval_one_);
-  (object.*setter_one_)(value);
-
-  value = GetValueForTime(machine, startval_two_, endval_two_);
-  (object.*setter_two_)(value);
-}
@@ -32,6 +32,13 @@
 class GraphicsObject;
 class RLMachine;
 
+// Mutator names are compared on every objEve*Check and objEve*Wait poll, so
+// they're interned once into small integer ids.
+int InternMutatorName(const std::string& name);
+
+// Returns the name interned as |name_id|.
+const std::string& GetMutatorName(int name_id);
+
 // An object that changes the value of an object parameter over time.
 class ObjectMutator {
  public:
@@ -44,14 +51,17 @@ class ObjectMutator {
   virtual ~ObjectMutator();
 
   int repr() const { return repr_; }
-  const std::string& name() const { return name_; }
+  int name_id() const { return name_id_; }
+  const std::string& name() const { return GetMutatorName(name_id_); }
 
   // Called every tick. Returns true if the command has completed. Virtual for
   // testing.
   virtual bool operator()(RLMachine& machine, GraphicsObject& object);
 
-  // Returns true if this ObjectMutator is operating on |name|/|repr|.
-  bool OperationMatches(int repr, const std::string& name) const;
+  // Returns true if this ObjectMutator is operating on |name_id|/|repr|.
+  bool OperationMatches(int repr, int name_id) const {
+    return repr_ == repr && name_id_ == name_id;
+  }
 
   // Called to end the mutation prematurely.
   virtual void SetToEnd(RLMachine& machine, GraphicsObject& object) = 0;
@@ -73,8 +83,8 @@ class ObjectMutator {
   // arguments.
   int repr_;
 
-  // The name of our operation.
-  const std::string name_;
+  // The interned name of our operation.
+  int name_id_;
 
   // Clock value at time of creation
   int creation_time_;
@@ -89,103 +99,4 @@ class ObjectMutator {
   int type_;
 };
 
-// -----------------------------------------------------------------------
-
-// An object mutator that takes a single integer.
-class OneIntObjectMutator : public ObjectMutator {
- public:
-  typedef void (GraphicsObject::*Setter)(const int);
-
-  OneIntObjectMutator(const std::string& name,
-                      int creation_time,
-                      int duration_time,
-                      int delay,
-                      int type,
-                      int start_value,
-                      int target_value,
-                      Setter setter);
-  virtual ~OneIntObjectMutator();
-
- private:
-  OneIntObjectMutator(const OneIntObjectMutator& rhs);
-
-  virtual void SetToEnd(RLMachine& machine, GraphicsObject& object) override;
-  virtual ObjectMutator* Clone() const override;
-  virtual void PerformSetting(RLMachine& machine,
-                              GraphicsObject& object) override;
-
-  int startval_;
-  int endval_;
-  Setter setter_;
-};
-
-// -----------------------------------------------------------------------
-
-// An object mutator that takes a repno and an integer.
-class RepnoIntObjectMutator : public ObjectMutator {
- public:
-  typedef void (GraphicsObject::*Setter)(const int, const int);
-
-  RepnoIntObjectMutator(const std::string& name,
-                        int creation_time,
-                        int duration_time,
-                        int delay,
-                        int type,
-                        int repno,
-                        int start_value,
-                        int target_value,
-                        Setter setter);
-  virtual ~RepnoIntObjectMutator();
-
- private:
-  RepnoIntObjectMutator(const RepnoIntObjectMutator& rhs);
-
-  virtual void SetToEnd(RLMachine& machine, GraphicsObject& object) override;
-  virtual ObjectMutator* Clone() const override;
-  virtual void PerformSetting(RLMachine& machine,
-                              GraphicsObject& object) override;
-
-  int repno_;
-  int startval_;
-  int endval_;
-  Setter setter_;
-};
-
-// -----------------------------------------------------------------------
-
-// An object mutator that varies two integers.
-class TwoIntObjectMutator : public ObjectMutator {
- public:
-  typedef void (GraphicsObject::*Setter)(const int);
-
-  TwoIntObjectMutator(const std::string& name,
-                      int creation_time,
-                      int duration_time,
-                      int delay,
-                      int type,
-                      int start_one,
-                      int target_one,
-                      Setter setter_one,
-                      int start_two,
-                      int target_two,
-                      Setter setter_two);
-  virtual ~TwoIntObjectMutator();
-
- private:
-  TwoIntObjectMutator(const TwoIntObjectMutator& rhs);
-
-  virtual void SetToEnd(RLMachine& machine, GraphicsObject& object) override;
-  virtual ObjectMutator* Clone() const override;
-  virtual void PerformSetting(RLMachine& machine,
-                              GraphicsObject& object) override;
-
-  int startval_one_;
-  int endval_one_;
-  Setter setter_one_;
-
-  int startval_two_;
-  int endval_two_;
-  Setter setter_two_;
-};
-
 #endif  // SRC_SYSTEMS_BASE_OBJECT_MUTATOR_H_
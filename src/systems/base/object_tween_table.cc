@@ -0,0 +1,276 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "systems/base/object_tween_table.h"
+
+#include "systems/base/graphics_object.h"
+#include "utilities/math_util.h"
+
+namespace {
+
+// Per-row results of the evaluation pass in Execute().
+enum TweenState : uint8_t {
+  // Still inside its delay; nothing is written.
+  TWEEN_WAITING = 0,
+  // Written this frame.
+  TWEEN_APPLYING = 1,
+  // Written this frame for the last time.
+  TWEEN_FINISHED = 2
+};
+
+}  // namespace
+
+ObjectTweenTable::ObjectTweenTable() : copying_(true) {}
+
+ObjectTweenTable::~ObjectTweenTable() {}
+
+void ObjectTweenTable::Add(GraphicsObject& object,
+                           int name_id,
+                           int repno,
+                           unsigned int creation_time,
+                           int duration_time,
+                           int delay,
+                           int type,
+                           int start_value,
+                           int end_value,
+                           Setter setter) {
+  AddRow(object, name_id, repno, creation_time, duration_time, delay, type,
+         start_value, end_value, setter, nullptr);
+}
+
+void ObjectTweenTable::Add(GraphicsObject& object,
+                           int name_id,
+                           int repno,
+                           unsigned int creation_time,
+                           int duration_time,
+                           int delay,
+                           int type,
+                           int start_value,
+                           int end_value,
+                           RepnoSetter setter) {
+  AddRow(object, name_id, repno, creation_time, duration_time, delay, type,
+         start_value, end_value, nullptr, setter);
+}
+
+bool ObjectTweenTable::Execute(unsigned int ticks) {
+  const size_t count = objects_.size();
+  if (count == 0)
+    return false;
+
+  values_.resize(count);
+  states_.resize(count);
+
+  // Evaluation pass. Touches only the plain integer columns.
+  for (size_t i = 0; i < count; ++i) {
+    unsigned int begin = begin_times_[i];
+    unsigned int end = begin + durations_[i];
+
+    if (ticks < begin) {
+      values_[i] = start_values_[i];
+    } else if (ticks < end) {
+      values_[i] = InterpolateBetween(begin, ticks, end, start_values_[i],
+                                      end_values_[i], types_[i]);
+    } else {
+      values_[i] = end_values_[i];
+    }
+
+    states_[i] = ticks > end ? TWEEN_FINISHED
+                             : (ticks > begin ? TWEEN_APPLYING : TWEEN_WAITING);
+  }
+
+  // Write back pass, in row order.
+  bool wrote = false;
+  bool any_finished = false;
+  for (size_t i = 0; i < count; ++i) {
+    if (states_[i] != TWEEN_WAITING) {
+      Apply(i, values_[i]);
+      wrote = true;
+      any_finished |= states_[i] == TWEEN_FINISHED;
+    }
+  }
+
+  if (any_finished) {
+    for (uint8_t& state : states_)
+      state = state == TWEEN_FINISHED;
+    EraseRows(states_);
+  }
+
+  return wrote;
+}
+
+bool ObjectTweenTable::IsRunning(const GraphicsObject& object,
+                                 int repno,
+                                 int name_id) const {
+  for (size_t i = 0; i < objects_.size(); ++i) {
+    if (objects_[i] == &object && name_ids_[i] == name_id &&
+        repnos_[i] == repno) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ObjectTweenTable::SetToEnd(GraphicsObject& object,
+                                int repno,
+                                int name_id) {
+  std::vector<uint8_t> erase(objects_.size(), 0);
+  bool any = false;
+  for (size_t i = 0; i < objects_.size(); ++i) {
+    if (objects_[i] == &object && name_ids_[i] == name_id &&
+        repnos_[i] == repno) {
+      Apply(i, end_values_[i]);
+      erase[i] = 1;
+      any = true;
+    }
+  }
+
+  if (any)
+    EraseRows(erase);
+}
+
+void ObjectTweenTable::GetRunning(
+    const GraphicsObject& object,
+    std::vector<std::pair<int, int>>* running) const {
+  size_t first = running->size();
+  for (size_t i = 0; i < objects_.size(); ++i) {
+    if (objects_[i] != &object)
+      continue;
+
+    // Tweens that drive two properties have one row per property.
+    std::pair<int, int> key(name_ids_[i], repnos_[i]);
+    bool seen = false;
+    for (size_t j = first; j < running->size() && !seen; ++j)
+      seen = (*running)[j] == key;
+    if (!seen)
+      running->push_back(key);
+  }
+}
+
+void ObjectTweenTable::CopyTweens(const GraphicsObject& from,
+                                  GraphicsObject& to) {
+  if (!copying_)
+    return;
+
+  // Rows appended below are past |count| and aren't revisited.
+  const size_t count = objects_.size();
+  for (size_t i = 0; i < count; ++i) {
+    if (objects_[i] != &from)
+      continue;
+
+    objects_.push_back(&to);
+    name_ids_.push_back(name_ids_[i]);
+    repnos_.push_back(repnos_[i]);
+    begin_times_.push_back(begin_times_[i]);
+    durations_.push_back(durations_[i]);
+    types_.push_back(types_[i]);
+    start_values_.push_back(start_values_[i]);
+    end_values_.push_back(end_values_[i]);
+    setters_.push_back(setters_[i]);
+    repno_setters_.push_back(repno_setters_[i]);
+    to.tween_table_ = this;
+  }
+}
+
+void ObjectTweenTable::Remove(const GraphicsObject& object) {
+  std::vector<uint8_t> erase(objects_.size(), 0);
+  bool any = false;
+  for (size_t i = 0; i < objects_.size(); ++i) {
+    if (objects_[i] == &object) {
+      erase[i] = 1;
+      any = true;
+    }
+  }
+
+  if (any)
+    EraseRows(erase);
+}
+
+void ObjectTweenTable::AddRow(GraphicsObject& object,
+                              int name_id,
+                              int repno,
+                              unsigned int creation_time,
+                              int duration_time,
+                              int delay,
+                              int type,
+                              int start_value,
+                              int end_value,
+                              Setter setter,
+                              RepnoSetter repno_setter) {
+  objects_.push_back(&object);
+  name_ids_.push_back(name_id);
+  repnos_.push_back(repno);
+  begin_times_.push_back(creation_time + delay);
+  durations_.push_back(duration_time);
+  types_.push_back(type);
+  start_values_.push_back(start_value);
+  end_values_.push_back(end_value);
+  setters_.push_back(setter);
+  repno_setters_.push_back(repno_setter);
+  object.tween_table_ = this;
+}
+
+void ObjectTweenTable::Apply(std::size_t i, int value) {
+  GraphicsObject& object = *objects_[i];
+  if (setters_[i])
+    (object.*setters_[i])(value);
+  else
+    (object.*repno_setters_[i])(repnos_[i], value);
+}
+
+void ObjectTweenTable::EraseRows(const std::vector<uint8_t>& erase) {
+  size_t out = 0;
+  for (size_t i = 0; i < objects_.size(); ++i) {
+    if (erase[i])
+      continue;
+
+    if (out != i) {
+      objects_[out] = objects_[i];
+      name_ids_[out] = name_ids_[i];
+      repnos_[out] = repnos_[i];
+      begin_times_[out] = begin_times_[i];
+      durations_[out] = durations_[i];
+      types_[out] = types_[i];
+      start_values_[out] = start_values_[i];
+      end_values_[out] = end_values_[i];
+      setters_[out] = setters_[i];
+      repno_setters_[out] = repno_setters_[i];
+    }
+    ++out;
+  }
+
+  objects_.resize(out);
+  name_ids_.resize(out);
+  repnos_.resize(out);
+  begin_times_.resize(out);
+  durations_.resize(out);
+  types_.resize(out);
+  start_values_.resize(out);
+  end_values_.resize(out);
+  setters_.resize(out);
+  repno_setters_.resize(out);
+}
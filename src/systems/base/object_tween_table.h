@@ -0,0 +1,172 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#ifndef SRC_SYSTEMS_BASE_OBJECT_TWEEN_TABLE_H_
+#define SRC_SYSTEMS_BASE_OBJECT_TWEEN_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class GraphicsObject;
+
+// Every running integer tween (the objEve* family of commands) on every
+// GraphicsObject, stored as parallel arrays.
+//
+// Scenes routinely tween hundreds of objects at once. Instead of a virtual
+// ObjectMutator per tween, each tween is a row here, and the whole table is
+// evaluated in one pass per frame: interpolated values are computed for every
+// row first, then written back to the objects in row order, then finished
+// rows are compacted away. Rows for an object keep the order they were added
+// in, so when two tweens drive the same property the later one wins, just as
+// it did with per-object mutator lists.
+//
+// A GraphicsObject with rows here points back at this table, removes its
+// rows when it is cleared or destroyed, and copies them when it is copied
+// (object promotion relies on this). Copies that aren't live layer objects,
+// like the savepoint snapshot, are made under a ScopedNoCopy so that they
+// keep the values they were copied with.
+class ObjectTweenTable {
+ public:
+  typedef void (GraphicsObject::*Setter)(const int);
+  typedef void (GraphicsObject::*RepnoSetter)(const int, const int);
+
+  // While one of these exists, CopyTweens() doesn't copy anything.
+  class ScopedNoCopy {
+   public:
+    explicit ScopedNoCopy(ObjectTweenTable& table)
+        : table_(table), was_copying_(table.copying_) {
+      table_.copying_ = false;
+    }
+    ~ScopedNoCopy() { table_.copying_ = was_copying_; }
+
+   private:
+    ObjectTweenTable& table_;
+    bool was_copying_;
+
+    ScopedNoCopy(const ScopedNoCopy&) = delete;
+    ScopedNoCopy& operator=(const ScopedNoCopy&) = delete;
+  };
+
+  ObjectTweenTable();
+  ~ObjectTweenTable();
+
+  // Adds a tween of |setter| on |object| from |start_value| to |end_value|.
+  // |name_id| is an interned mutator name and |repno| is -1 for commands
+  // that don't take one; together they identify the tween for the objEve*Check,
+  // Wait and End commands.
+  void Add(GraphicsObject& object,
+           int name_id,
+           int repno,
+           unsigned int creation_time,
+           int duration_time,
+           int delay,
+           int type,
+           int start_value,
+           int end_value,
+           Setter setter);
+
+  // As above, but calls |setter| with |repno| as its first argument.
+  void Add(GraphicsObject& object,
+           int name_id,
+           int repno,
+           unsigned int creation_time,
+           int duration_time,
+           int delay,
+           int type,
+           int start_value,
+           int end_value,
+           RepnoSetter setter);
+
+  // Advances every tween to |ticks|. Returns true if any object was written
+  // to.
+  bool Execute(unsigned int ticks);
+
+  // Returns true if |object| has a tween matching |repno|/|name_id|.
+  bool IsRunning(const GraphicsObject& object, int repno, int name_id) const;
+
+  // Writes the end value of every tween on |object| matching |repno|/|name_id|
+  // and removes them.
+  void SetToEnd(GraphicsObject& object, int repno, int name_id);
+
+  // Appends the (name_id, repno) pair of each distinct tween on |object|.
+  void GetRunning(const GraphicsObject& object,
+                  std::vector<std::pair<int, int>>* running) const;
+
+  // Duplicates all of |from|'s rows onto |to|.
+  void CopyTweens(const GraphicsObject& from, GraphicsObject& to);
+
+  // Removes all of |object|'s rows without writing anything to it.
+  void Remove(const GraphicsObject& object);
+
+  std::size_t size() const { return objects_.size(); }
+
+ private:
+  void AddRow(GraphicsObject& object,
+              int name_id,
+              int repno,
+              unsigned int creation_time,
+              int duration_time,
+              int delay,
+              int type,
+              int start_value,
+              int end_value,
+              Setter setter,
+              RepnoSetter repno_setter);
+
+  // Writes |value| through row |i|'s setter.
+  void Apply(std::size_t i, int value);
+
+  // Removes every row whose entry in |erase| is nonzero, preserving the order
+  // of the remaining rows.
+  void EraseRows(const std::vector<uint8_t>& erase);
+
+  // One entry per row in each of these.
+  std::vector<GraphicsObject*> objects_;
+  std::vector<int> name_ids_;
+  std::vector<int> repnos_;
+  std::vector<unsigned int> begin_times_;
+  std::vector<unsigned int> durations_;
+  std::vector<int> types_;
+  std::vector<int> start_values_;
+  std::vector<int> end_values_;
+  std::vector<Setter> setters_;
+  std::vector<RepnoSetter> repno_setters_;
+
+  // Scratch space for Execute(), kept to avoid reallocating every frame.
+  std::vector<int> values_;
+  std::vector<uint8_t> states_;
+
+  // Cleared by ScopedNoCopy.
+  bool copying_;
+
+  ObjectTweenTable(const ObjectTweenTable&) = delete;
+  ObjectTweenTable& operator=(const ObjectTweenTable&) = delete;
+};
+
+#endif  // SRC_SYSTEMS_BASE_OBJECT_TWEEN_TABLE_H_
@@ -64,6 +64,7 @@
 #include <string>
 #include <sstream>
 
+#include "systems/base/asset_pack.h"
 #include "utilities/exception.h"
 #include "xclannad/endian.hpp"
 
@@ -114,7 +115,7 @@ std::string oggErrorCodeToString(int code) {
 }  // namespace
 
 OVKVoiceSample::OVKVoiceSample(fs::path file)
-    : stream_(std::fopen(file.native().c_str(), "rb")), offset_(0), length_(0) {
+    : stream_(AssetPack::OpenStream(file)), offset_(0), length_(0) {
   std::fseek(stream_, 0, SEEK_END);
   length_ = ftell(stream_);
   std::fseek(stream_, 0, SEEK_SET);
@@ -0,0 +1,390 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "systems/base/pcm_cache.h"
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "libreallive/alldefs.h"
+#include "libreallive/filemap.h"
+#include "xclannad/wavfile.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+const char PCM_CACHE_MAGIC[8] = {'R', 'L', 'V', 'M', 'P', 'C', 'M', '1'};
+const uint32_t PCM_CACHE_VERSION = 1;
+
+// Bytes requested from the decoder per Read() while populating an entry.
+const int DECODE_BUFFER_SIZE = 16 * 1024;
+
+// Written in native byte order; the cache is never shared between machines.
+// The source path follows the header so that hash collisions are detected.
+struct PCMCacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  int32_t freq;
+  int32_t format;
+  int32_t channels;
+  int32_t source_freq;
+  int32_t frame_bytes;
+  uint32_t path_size;
+  int64_t source_mtime;
+  uint64_t source_size;
+  uint64_t data_size;
+};
+
+uint64_t HashPath(const std::string& path) {
+  // FNV-1a.
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : path) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Streams PCM straight out of a mapped cache entry.
+class PCMCacheFILE : public WAVFILE {
+ public:
+  PCMCacheFILE(std::unique_ptr<libreallive::Mapping> mapping,
+               const PCMCacheHeader& header)
+      : mapping_(std::move(mapping)),
+        data_(mapping_->get() + header.header_size + header.path_size),
+        data_size_(header.data_size),
+        position_(0),
+        freq_(header.freq),
+        source_freq_(header.source_freq),
+        frame_bytes_(header.frame_bytes) {
+    wavinfo.SamplingRate = header.freq;
+    wavinfo.Channels = header.channels;
+    wavinfo.DataBits = header.format & 0xff;
+  }
+
+  virtual int Read(char* buf, int blksize, int blklen) {
+    if (blksize <= 0 || blklen <= 0)
+      return 0;
+    uint64_t available = (data_size_ - position_) / blksize;
+    int blocks = static_cast<int>(
+        std::min(available, static_cast<uint64_t>(blklen)));
+    memcpy(buf, data_ + position_, static_cast<size_t>(blocks) * blksize);
+    position_ += static_cast<uint64_t>(blocks) * blksize;
+    return blocks;
+  }
+
+  // |count| is in frames of the source file, like every other WAVFILE.
+  virtual void Seek(int count) {
+    uint64_t frame = static_cast<uint64_t>(std::max(count, 0)) * freq_ /
+                     std::max(source_freq_, 1);
+    position_ = std::min(frame * frame_bytes_, data_size_);
+  }
+
+ private:
+  std::unique_ptr<libreallive::Mapping> mapping_;
+  const char* data_;
+  uint64_t data_size_;
+  uint64_t position_;
+  int freq_;
+  int source_freq_;
+  int frame_bytes_;
+};
+
+// The sampling rate of the file the decoder reads, before any conversion to
+// the output format.
+int SourceFrequency(WAVFILE* decoder) {
+  WAVFILE_Converter* converter = dynamic_cast<WAVFILE_Converter*>(decoder);
+  if (converter)
+    return converter->original->wavinfo.SamplingRate;
+  return decoder->wavinfo.SamplingRate;
+}
+
+// Bytes per frame of the decoder's output. WAVFILE::MakeConverter() always
+// converts to stereo.
+int OutputFrameBytes(WAVFILE* decoder) {
+  int channels = dynamic_cast<WAVFILE_Converter*>(decoder)
+                     ? 2
+                     : decoder->wavinfo.Channels;
+  return channels * ((WAVFILE::format & 0xff) / 8);
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------
+// PCMCache
+// -----------------------------------------------------------------------
+
+PCMCache::PCMCache(const fs::path& directory, uint64_t max_bytes)
+    : directory_(directory), max_bytes_(max_bytes), shutting_down_(false) {}
+
+PCMCache::~PCMCache() {
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    shutting_down_ = true;
+    queue_.clear();
+  }
+  cv_.notify_all();
+  if (worker_.joinable())
+    worker_.join();
+}
+
+WAVFILE* PCMCache::Open(const fs::path& source) {
+  if (!enabled())
+    return NULL;
+
+  fs::path entry = GetEntryPath(source);
+  boost::system::error_code ec;
+  if (!fs::exists(entry, ec))
+    return NULL;
+
+  std::unique_ptr<libreallive::Mapping> mapping;
+  try {
+    mapping.reset(new libreallive::Mapping(entry.string(), libreallive::Read));
+  } catch (libreallive::Error& e) {
+    return NULL;
+  }
+
+  PCMCacheHeader header;
+  const std::string& source_string = source.string();
+  bool valid = mapping->size() >= sizeof(header);
+  if (valid) {
+    memcpy(&header, mapping->get(), sizeof(header));
+    valid =
+        memcmp(header.magic, PCM_CACHE_MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == PCM_CACHE_VERSION &&
+        header.header_size == sizeof(header) &&
+        header.freq == WAVFILE::freq && header.format == WAVFILE::format &&
+        header.channels == WAVFILE::channels && header.frame_bytes > 0 &&
+        header.path_size == source_string.size() &&
+        static_cast<uint64_t>(mapping->size()) ==
+            header.header_size + header.path_size + header.data_size &&
+        memcmp(mapping->get() + header.header_size, source_string.data(),
+               header.path_size) == 0;
+  }
+  if (valid) {
+    time_t mtime = fs::last_write_time(source, ec);
+    uintmax_t size = ec ? 0 : fs::file_size(source, ec);
+    valid = !ec && header.source_mtime == static_cast<int64_t>(mtime) &&
+            header.source_size == size;
+  }
+
+  if (!valid) {
+    // A stale or corrupt entry; drop it so the next play rebuilds it.
+    mapping.reset();
+    fs::remove(entry, ec);
+    return NULL;
+  }
+
+  // The entry's modification time is its last use, for eviction.
+  fs::last_write_time(entry, std::time(NULL), ec);
+  return new PCMCacheFILE(std::move(mapping), header);
+}
+
+void PCMCache::Populate(const fs::path& source, const DecoderFactory& factory) {
+  if (!enabled())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    if (shutting_down_ || !in_progress_.insert(source.string()).second)
+      return;
+    queue_.push_back(Job(source, factory));
+    if (!worker_.joinable())
+      worker_ = std::thread(&PCMCache::WorkerLoop, this);
+  }
+  cv_.notify_all();
+}
+
+uint64_t PCMCache::GetTotalBytes() const {
+  uint64_t total = 0;
+  boost::system::error_code ec;
+  for (fs::directory_iterator it(directory_, ec), end; !ec && it != end;
+       it.increment(ec)) {
+    if (it->path().extension() == ".pcm")
+      total += fs::file_size(it->path(), ec);
+  }
+  return total;
+}
+
+void PCMCache::WaitForPendingWrites() {
+  std::unique_lock<std::mutex> lock(lock_);
+  cv_.wait(lock, [this] { return in_progress_.empty(); });
+}
+
+fs::path PCMCache::GetEntryPath(const fs::path& source) const {
+  std::ostringstream oss;
+  oss << std::hex << HashPath(source.string()) << ".pcm";
+  return directory_ / oss.str();
+}
+
+void PCMCache::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(lock_);
+  while (true) {
+    cv_.wait(lock, [this] { return shutting_down_ || !queue_.empty(); });
+    if (shutting_down_)
+      return;
+
+    Job job = queue_.front();
+    queue_.pop_front();
+
+    lock.unlock();
+    DecodeAndStore(job.first, job.second);
+    lock.lock();
+
+    in_progress_.erase(job.first.string());
+    cv_.notify_all();
+  }
+}
+
+void PCMCache::DecodeAndStore(const fs::path& source,
+                              const DecoderFactory& factory) {
+  boost::system::error_code ec;
+  time_t mtime = fs::last_write_time(source, ec);
+  uintmax_t source_size = ec ? 0 : fs::file_size(source, ec);
+  if (ec)
+    return;
+
+  std::unique_ptr<WAVFILE> decoder(factory());
+  if (!decoder)
+    return;
+
+  fs::create_directories(directory_, ec);
+  fs::path entry = GetEntryPath(source);
+  fs::path tmp = entry;
+  tmp.replace_extension(".tmp");
+
+  const std::string& source_string = source.string();
+  PCMCacheHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, PCM_CACHE_MAGIC, sizeof(header.magic));
+  header.version = PCM_CACHE_VERSION;
+  header.header_size = sizeof(header);
+  header.freq = WAVFILE::freq;
+  header.format = WAVFILE::format;
+  header.channels = WAVFILE::channels;
+  header.source_freq = SourceFrequency(decoder.get());
+  header.frame_bytes = OutputFrameBytes(decoder.get());
+  header.path_size = source_string.size();
+  header.source_mtime = mtime;
+  header.source_size = source_size;
+  if (header.frame_bytes <= 0)
+    return;
+
+  bool ok = true;
+  {
+    fs::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(source_string.data(), source_string.size());
+
+    std::vector<char> buffer(DECODE_BUFFER_SIZE);
+    int blocks = DECODE_BUFFER_SIZE / header.frame_bytes;
+    while (out && !shutting_down_) {
+      int count = decoder->Read(&buffer[0], header.frame_bytes, blocks);
+      if (count <= 0)
+        break;
+      out.write(&buffer[0], static_cast<size_t>(count) * header.frame_bytes);
+      header.data_size += static_cast<uint64_t>(count) * header.frame_bytes;
+      if (header.data_size > max_bytes_) {
+        // Never going to fit; don't evict everything else for it.
+        ok = false;
+        break;
+      }
+    }
+
+    ok = ok && out && !shutting_down_;
+    if (ok) {
+      out.seekp(0);
+      out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      out.flush();
+      ok = static_cast<bool>(out);
+    }
+  }
+
+  if (!ok) {
+    fs::remove(tmp, ec);
+    return;
+  }
+
+  fs::rename(tmp, entry, ec);
+  if (ec) {
+    std::cerr << "Could not write PCM cache entry " << entry << ": "
+              << ec.message() << std::endl;
+    fs::remove(tmp, ec);
+    return;
+  }
+
+  Evict(entry);
+}
+
+void PCMCache::Evict(const fs::path& keep) {
+  struct Entry {
+    time_t mtime;
+    uintmax_t size;
+    fs::path path;
+  };
+  std::vector<Entry> entries;
+  uint64_t total = 0;
+
+  boost::system::error_code ec;
+  for (fs::directory_iterator it(directory_, ec), end; !ec && it != end;
+       it.increment(ec)) {
+    if (it->path().extension() != ".pcm")
+      continue;
+    boost::system::error_code entry_ec;
+    Entry entry = {fs::last_write_time(it->path(), entry_ec),
+                   fs::file_size(it->path(), entry_ec), it->path()};
+    if (entry_ec)
+      continue;
+    total += entry.size;
+    entries.push_back(entry);
+  }
+
+  if (total <= max_bytes_)
+    return;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+  for (const Entry& entry : entries) {
+    if (total <= max_bytes_)
+      break;
+    if (entry.path == keep)
+      continue;
+    fs::remove(entry.path, ec);
+    if (!ec)
+      total -= entry.size;
+  }
+}
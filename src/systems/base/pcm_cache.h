@@ -0,0 +1,123 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#ifndef SRC_SYSTEMS_BASE_PCM_CACHE_H_
+#define SRC_SYSTEMS_BASE_PCM_CACHE_H_
+
+#include <boost/filesystem/path.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+
+struct WAVFILE;
+
+// An on-disk cache of fully decoded background music.
+//
+// NWA and Ogg tracks are decoded on every play, and looped tracks keep
+// decoding for as long as they play, with an expensive seek back to the loop
+// point each time. The first time a track is played, PCMCache decodes it a
+// second time on a background thread. It writes the raw PCM, already
+// converted to the output format of the audio device, to a file in the game's
+// save directory. Later plays memory map that file and do no decoding at
+// all.
+//
+// Entries are keyed on the source path and validated against the source's
+// modification time and size. Once the cache is larger than its byte limit,
+// the least recently played entries are deleted.
+class PCMCache {
+ public:
+  // Builds a WAVFILE decoder for a source file. Called on the background
+  // thread.
+  typedef std::function<WAVFILE*()> DecoderFactory;
+
+  // |max_bytes| of zero disables the cache.
+  PCMCache(const boost::filesystem::path& directory, uint64_t max_bytes);
+  ~PCMCache();
+
+  bool enabled() const { return max_bytes_ > 0; }
+
+  // Returns a WAVFILE that streams the cached PCM for |source|, or NULL if
+  // there is no valid entry. Marks the entry as recently used.
+  WAVFILE* Open(const boost::filesystem::path& source);
+
+  // Decodes |source| on a background thread with a decoder from |factory| and
+  // stores the result. Does nothing if the cache is disabled or |source| is
+  // already queued.
+  void Populate(const boost::filesystem::path& source,
+                const DecoderFactory& factory);
+
+  // Total bytes of all entries currently in the cache directory.
+  uint64_t GetTotalBytes() const;
+
+  // Blocks until all pending background decodes have finished. Used by tests.
+  void WaitForPendingWrites();
+
+ private:
+  typedef std::pair<boost::filesystem::path, DecoderFactory> Job;
+
+  // The file in |directory_| that holds the entry for |source|.
+  boost::filesystem::path GetEntryPath(
+      const boost::filesystem::path& source) const;
+
+  // Body of |worker_|. Runs queued jobs until shutdown.
+  void WorkerLoop();
+
+  // Decodes one source and atomically moves the result into the cache.
+  void DecodeAndStore(const boost::filesystem::path& source,
+                      const DecoderFactory& factory);
+
+  // Deletes least recently used entries until the cache fits in |max_bytes_|.
+  // Never deletes |keep|.
+  void Evict(const boost::filesystem::path& keep);
+
+  boost::filesystem::path directory_;
+  uint64_t max_bytes_;
+
+  // Guards everything below.
+  std::mutex lock_;
+  std::condition_variable cv_;
+
+  // Pending decodes, and the set of sources that are queued or running.
+  std::deque<Job> queue_;
+  std::set<std::string> in_progress_;
+
+  // Started on the first Populate().
+  std::thread worker_;
+
+  // Set on destruction to abandon the running decode.
+  std::atomic<bool> shutting_down_;
+};
+
+#endif  // SRC_SYSTEMS_BASE_PCM_CACHE_H_
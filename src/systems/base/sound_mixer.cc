@@ -0,0 +1,269 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "systems/base/sound_mixer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+template <typename SampleT>
+inline int SaturateAndStore(SampleT* out, float value) {
+  long v = std::lrint(value);
+  if (v > std::numeric_limits<SampleT>::max())
+    v = std::numeric_limits<SampleT>::max();
+  else if (v < std::numeric_limits<SampleT>::min())
+    v = std::numeric_limits<SampleT>::min();
+  *out = static_cast<SampleT>(v);
+  return std::abs(static_cast<int>(v));
+}
+
+// Processes frames [|first_frame|, |frames|) one sample at a time. The gain
+// for frame f is start + step * f; the SSE2 path computes it the same way so
+// that both paths round identically.
+template <typename SampleT>
+int ScalarGainRamp(SampleT* samples, int first_frame, int frames,
+                   int channels, float start, float step) {
+  int peak = 0;
+  for (int f = first_frame; f < frames; ++f) {
+    float gain = start + step * static_cast<float>(f);
+    SampleT* frame = samples + f * channels;
+    for (int c = 0; c < channels; ++c)
+      peak = std::max(peak, SaturateAndStore(frame + c, frame[c] * gain));
+  }
+  return peak;
+}
+
+template <typename SampleT>
+int ScalarPeakLevel(const SampleT* samples, int first, int count) {
+  int peak = 0;
+  for (int i = first; i < count; ++i)
+    peak = std::max(peak, std::abs(static_cast<int>(samples[i])));
+  return peak;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------
+
+int ApplyGainRamp(int16_t* samples, int frames, int channels,
+                  float start_gain, float end_gain) {
+  if (frames <= 0 || channels <= 0)
+    return 0;
+
+  float step = (end_gain - start_gain) / frames;
+  int first_scalar_frame = 0;
+  int peak = 0;
+
+#if defined(__SSE2__)
+  if (8 % channels == 0) {
+    const int frames_per_block = 8 / channels;
+    const int blocks = (frames * channels) / 8;
+
+    const __m128 start_v = _mm_set1_ps(start_gain);
+    const __m128 step_v = _mm_set1_ps(step);
+    const __m128 block_step_v = _mm_set1_ps(static_cast<float>(frames_per_block));
+    const __m128 offset_lo = _mm_set_ps(3 / channels, 2 / channels,
+                                        1 / channels, 0);
+    const __m128 offset_hi = _mm_set_ps(7 / channels, 6 / channels,
+                                        5 / channels, 4 / channels);
+    __m128 frame_v = _mm_setzero_ps();
+    __m128i max_v = _mm_setzero_si128();
+    __m128i min_v = _mm_setzero_si128();
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128i* p = reinterpret_cast<__m128i*>(samples);
+    for (int i = 0; i < blocks; ++i) {
+      __m128i in = _mm_loadu_si128(p + i);
+
+      // Sign extend the eight int16 samples into two int32x4 vectors.
+      __m128i sign = _mm_cmpgt_epi16(zero, in);
+      __m128 lo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(in, sign));
+      __m128 hi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(in, sign));
+
+      __m128 gain_lo =
+          _mm_add_ps(start_v, _mm_mul_ps(step_v, _mm_add_ps(frame_v, offset_lo)));
+      __m128 gain_hi =
+          _mm_add_ps(start_v, _mm_mul_ps(step_v, _mm_add_ps(frame_v, offset_hi)));
+
+      __m128i out = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(lo, gain_lo)),
+                                    _mm_cvtps_epi32(_mm_mul_ps(hi, gain_hi)));
+      _mm_storeu_si128(p + i, out);
+
+      max_v = _mm_max_epi16(max_v, out);
+      min_v = _mm_min_epi16(min_v, out);
+      frame_v = _mm_add_ps(frame_v, block_step_v);
+    }
+
+    int16_t maxes[8], mins[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maxes), max_v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), min_v);
+    for (int i = 0; i < 8; ++i) {
+      peak = std::max(peak, static_cast<int>(maxes[i]));
+      peak = std::max(peak, -static_cast<int>(mins[i]));
+    }
+
+    first_scalar_frame = blocks * frames_per_block;
+  }
+#endif
+
+  return std::max(peak, ScalarGainRamp(samples, first_scalar_frame, frames,
+                                       channels, start_gain, step));
+}
+
+int ApplyGainRamp(int8_t* samples, int frames, int channels,
+                  float start_gain, float end_gain) {
+  if (frames <= 0 || channels <= 0)
+    return 0;
+
+  float step = (end_gain - start_gain) / frames;
+  return ScalarGainRamp(samples, 0, frames, channels, start_gain, step);
+}
+
+int PeakLevel(const int16_t* samples, int count) {
+  int peak = 0;
+  int first_scalar = 0;
+
+#if defined(__SSE2__)
+  const __m128i* p = reinterpret_cast<const __m128i*>(samples);
+  __m128i max_v = _mm_setzero_si128();
+  __m128i min_v = _mm_setzero_si128();
+  int blocks = count / 8;
+  for (int i = 0; i < blocks; ++i) {
+    __m128i in = _mm_loadu_si128(p + i);
+    max_v = _mm_max_epi16(max_v, in);
+    min_v = _mm_min_epi16(min_v, in);
+  }
+
+  int16_t maxes[8], mins[8];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(maxes), max_v);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), min_v);
+  for (int i = 0; i < 8; ++i) {
+    peak = std::max(peak, static_cast<int>(maxes[i]));
+    peak = std::max(peak, -static_cast<int>(mins[i]));
+  }
+
+  first_scalar = blocks * 8;
+#endif
+
+  return std::max(peak, ScalarPeakLevel(samples, first_scalar, count));
+}
+
+int PeakLevel(const int8_t* samples, int count) {
+  return ScalarPeakLevel(samples, 0, count);
+}
+
+// -----------------------------------------------------------------------
+// MixerChannel
+// -----------------------------------------------------------------------
+
+MixerChannel::MixerChannel(float initial_gain)
+    : current_gain_(initial_gain),
+      target_gain_(initial_gain),
+      gain_step_(0.0f),
+      ramp_frames_left_(0),
+      peak_level_(0) {}
+
+void MixerChannel::SetGain(float gain) {
+  current_gain_ = gain;
+  target_gain_ = gain;
+  gain_step_ = 0.0f;
+  ramp_frames_left_ = 0;
+}
+
+void MixerChannel::RampTo(float gain, int frames) {
+  if (frames <= 0) {
+    SetGain(gain);
+    return;
+  }
+
+  target_gain_ = gain;
+  gain_step_ = (gain - current_gain_) / frames;
+  ramp_frames_left_ = frames;
+}
+
+void MixerChannel::Process(void* stream,
+                           int len,
+                           MixerSampleFormat format,
+                           int channels) {
+  int peak;
+  if (format == MIXER_SAMPLE_S16) {
+    peak = ProcessImpl(static_cast<int16_t*>(stream), len / (2 * channels),
+                       channels);
+  } else {
+    peak = ProcessImpl(static_cast<int8_t*>(stream), len / channels,
+                       channels) << 8;
+  }
+
+  // Only the audio thread writes a non-zero value here, so a lost update can
+  // only drop a concurrent reset.
+  peak = std::min(peak, 32767);
+  if (peak > peak_level_.load(std::memory_order_relaxed))
+    peak_level_.store(peak, std::memory_order_relaxed);
+}
+
+int MixerChannel::TakePeakLevel() {
+  return peak_level_.exchange(0, std::memory_order_relaxed);
+}
+
+template <typename SampleT>
+int MixerChannel::ProcessImpl(SampleT* samples, int frames, int channels) {
+  int peak = 0;
+
+  if (ramp_frames_left_ > 0) {
+    int ramp_frames = std::min(frames, ramp_frames_left_);
+    float end_gain = current_gain_ + gain_step_ * ramp_frames;
+    peak = ApplyGainRamp(samples, ramp_frames, channels, current_gain_,
+                         end_gain);
+
+    ramp_frames_left_ -= ramp_frames;
+    current_gain_ = ramp_frames_left_ ? end_gain : target_gain_;
+    samples += ramp_frames * channels;
+    frames -= ramp_frames;
+  }
+
+  if (frames > 0) {
+    if (current_gain_ == 1.0f) {
+      peak = std::max(peak, PeakLevel(samples, frames * channels));
+    } else if (current_gain_ == 0.0f) {
+      memset(samples, 0, frames * channels * sizeof(SampleT));
+    } else {
+      peak = std::max(peak, ApplyGainRamp(samples, frames, channels,
+                                          current_gain_, current_gain_));
+    }
+  }
+
+  return peak;
+}
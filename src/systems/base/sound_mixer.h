@@ -0,0 +1,103 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#ifndef SRC_SYSTEMS_BASE_SOUND_MIXER_H_
+#define SRC_SYSTEMS_BASE_SOUND_MIXER_H_
+
+#include <atomic>
+#include <cstdint>
+
+// Sample formats that the mixer stage knows how to process. These are the
+// only two formats that SoundSystem::sound_quality() can request.
+enum MixerSampleFormat {
+  MIXER_SAMPLE_S8,
+  MIXER_SAMPLE_S16
+};
+
+// Multiplies the |frames| interleaved frames in |samples| by a gain that
+// moves linearly from |start_gain| at the first frame towards |end_gain|,
+// saturating the result. Every sample in a frame gets the same gain. Returns
+// the peak absolute value of the processed samples.
+//
+// The int16 version has an SSE2 path for 1, 2, 4 and 8 channel data; it
+// produces the same output as the scalar loop.
+int ApplyGainRamp(int16_t* samples, int frames, int channels,
+                  float start_gain, float end_gain);
+int ApplyGainRamp(int8_t* samples, int frames, int channels,
+                  float start_gain, float end_gain);
+
+// Returns the peak absolute value in |samples| without modifying them.
+int PeakLevel(const int16_t* samples, int count);
+int PeakLevel(const int8_t* samples, int count);
+
+// A single gain stage in the mixer. Each sound channel (and the BGM stream)
+// owns one. The gain is changed by ramping over a number of sample frames so
+// that fades and volume changes are applied per sample instead of once per
+// audio callback buffer, which is what caused audible zipper noise.
+//
+// Ramps are set up from the main thread (under an SDLAudioLocker) and
+// consumed by Process() from the audio thread. Process() never allocates.
+class MixerChannel {
+ public:
+  explicit MixerChannel(float initial_gain = 1.0f);
+
+  // The gain that will be applied to the next processed frame.
+  float gain() const { return current_gain_; }
+
+  // The gain at the end of the current ramp.
+  float target_gain() const { return target_gain_; }
+
+  bool IsRamping() const { return ramp_frames_left_ > 0; }
+
+  // Sets the gain immediately, cancelling any ramp.
+  void SetGain(float gain);
+
+  // Ramps linearly from the current gain to |gain| over |frames| sample
+  // frames. A |frames| of zero is the same as SetGain().
+  void RampTo(float gain, int frames);
+
+  // Applies the gain stage in place to |len| bytes of interleaved audio.
+  void Process(void* stream, int len, MixerSampleFormat format, int channels);
+
+  // Returns the peak level (in the range [0, 32767]) seen by Process() since
+  // the last call and resets it. Safe to call from any thread.
+  int TakePeakLevel();
+
+ private:
+  template <typename SampleT>
+  int ProcessImpl(SampleT* samples, int frames, int channels);
+
+  float current_gain_;
+  float target_gain_;
+  float gain_step_;
+  int ramp_frames_left_;
+
+  // Highest level seen since the last TakePeakLevel(), normalized to 16 bits.
+  std::atomic<int> peak_level_;
+};
+
+#endif  // SRC_SYSTEMS_BASE_SOUND_MIXER_H_
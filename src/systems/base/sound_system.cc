@@ -225,6 +225,10 @@ void SoundSystem::ExecuteSoundSystem() {
       SetBgmVolumeScript(volume, 0);
     }
   }
+
+  // Fades run every frame.
+  if (!pcm_adjustment_tasks_.empty() || bgm_adjustment_task_)
+    system().event().ScheduleNextFrame();
 }
 
 void SoundSystem::SetSoundQuality(const int quality) {
@@ -46,7 +46,10 @@
 #include "machine/rlmachine.h"
 #include "machine/serialization.h"
 #include "modules/module_sys.h"
+#include "systems/base/asset_pack.h"
 #include "systems/base/event_system.h"
+#include "systems/base/file_index.h"
+#include "systems/base/frame_telemetry.h"
 #include "systems/base/graphics_system.h"
 #include "systems/base/platform.h"
 #include "systems/base/rlvm_info.h"
@@ -124,7 +127,8 @@ System::System()
     : in_menu_(false),
       force_fast_forward_(false),
       force_wait_(false),
-      use_western_font_(false) {
+      use_western_font_(false),
+      telemetry_(new FrameTelemetry) {
   std::fill(syscom_status_,
             syscom_status_ + NUM_SYSCOM_ENTRIES,
             SYSCOM_VISIBLE);
@@ -327,11 +331,18 @@ void System::ShowSystemInfo(RLMachine& machine) {
   }
 }
 
+void System::BuildFileSystemCacheInBackground() {
+  filesystem_cache_ = CreateFileIndex(true);
+  filesystem_cache_->BuildInBackground();
+}
+
 boost::filesystem::path System::FindFile(
     const std::string& file_name,
     const std::vector<std::string>& extensions) {
-  if (filesystem_cache_.empty())
-    BuildFileSystemCache();
+  if (!filesystem_cache_) {
+    filesystem_cache_ = CreateFileIndex(false);
+    filesystem_cache_->Build();
+  }
 
   // Hack to get around fileNames like "REALNAME?010", where we only
   // want REALNAME.
@@ -339,19 +350,10 @@ boost::filesystem::path System::FindFile(
       string(file_name.begin(), find(file_name.begin(), file_name.end(), '?'));
   to_lower(lower_name);
 
-  std::pair<FileSystemCache::const_iterator, FileSystemCache::const_iterator>
-      ret = filesystem_cache_.equal_range(lower_name);
-  for (const std::string& extension : extensions) {
-    for (FileSystemCache::const_iterator it = ret.first; it != ret.second;
-         ++it) {
-      if (extension == it->second.first) {
-        return it->second.second;
-      }
-    }
-  }
-
-  // Error.
-  return fs::path();
+  fs::path path = filesystem_cache_->Find(lower_name, extensions);
+  if (path.empty() && asset_pack_)
+    path = asset_pack_->FindFile(lower_name, extensions);
+  return path;
 }
 
 void System::Reset() {
@@ -396,6 +398,21 @@ void System::DumpRenderTree(RLMachine& machine) {
   graphics().Refresh(&tree);
 }
 
+void System::DumpFrameTelemetry(RLMachine& machine) {
+  std::ostringstream oss;
+  oss << "Telemetry_SEEN" << std::setw(4) << std::setfill('0')
+      << machine.SceneNumber() << "_Line" << machine.line_number();
+
+  std::ofstream csv((oss.str() + ".csv").c_str());
+  telemetry_->WriteCSV(csv);
+
+  std::ofstream json((oss.str() + ".json").c_str());
+  telemetry_->WriteJSON(json);
+
+  std::ofstream memory((oss.str() + "_Memory.txt").c_str());
+  graphics().WriteMemoryReport(memory);
+}
+
 boost::filesystem::path System::GetHomeDirectory() {
   std::string drive, home;
   char* homeptr = getenv("HOME");
@@ -445,7 +462,7 @@ void System::CheckSyscomIndex(int index, const char* function) {
   }
 }
 
-void System::BuildFileSystemCache() {
+std::unique_ptr<FileIndex> System::CreateFileIndex(bool persistent) {
   // First retrieve all the directories defined in the #FOLDNAME section.
   std::vector<std::string> valid_directories;
   Gameexe& gexe = gameexe();
@@ -460,39 +477,21 @@ void System::BuildFileSystemCache() {
   }
 
   fs::path gamepath(gexe("__GAMEPATH").ToString());
-  fs::directory_iterator dir_end;
-  for (fs::directory_iterator dir(gamepath); dir != dir_end; ++dir) {
-    if (fs::is_directory(dir->status())) {
-      std::string lowername = dir->path().filename().string();
-      to_lower(lowername);
-      if (find(valid_directories.begin(), valid_directories.end(), lowername) !=
-          valid_directories.end()) {
-        AddDirectoryToCache(dir->path());
-      }
+  fs::path pack_file = gamepath / "rlvm.pack";
+  if (!asset_pack_ && fs::exists(pack_file)) {
+    try {
+      asset_pack_.reset(new AssetPack(pack_file));
+    } catch (rlvm::Exception& e) {
+      std::cerr << e.what() << std::endl;
     }
   }
-}
 
-void System::AddDirectoryToCache(const fs::path& directory) {
-  fs::directory_iterator dir_end;
-  for (fs::directory_iterator dir(directory); dir != dir_end; ++dir) {
-    if (fs::is_directory(dir->status())) {
-      AddDirectoryToCache(dir->path());
-    } else {
-      std::string extension = dir->path().extension().string();
-      if (extension.size() > 1 && extension[0] == '.')
-        extension = extension.substr(1);
-      to_lower(extension);
-
-      if (find(ALL_FILETYPES.begin(), ALL_FILETYPES.end(), extension) !=
-          ALL_FILETYPES.end()) {
-        std::string stem = dir->path().stem().string();
-        to_lower(stem);
-
-        filesystem_cache_.emplace(stem, make_pair(extension, dir->path()));
-      }
-    }
-  }
+  fs::path index_file;
+  if (persistent)
+    index_file = GameSaveDirectory() / "file_index";
+
+  return std::unique_ptr<FileIndex>(
+      new FileIndex(gamepath, valid_directories, ALL_FILETYPES, index_file));
 }
 
 std::string GetRlvmVersionString() { return "Version 0.14"; }
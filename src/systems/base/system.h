@@ -33,13 +33,17 @@
 #include <boost/filesystem/path.hpp>
 
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 class GraphicsSystem;
+class AssetPack;
 class EventSystem;
+class FileIndex;
+class FrameTelemetry;
 class TextSystem;
 class SoundSystem;
 class RLMachine;
@@ -224,8 +228,15 @@ class System {
   // interpreter.
   void ShowSystemInfo(RLMachine& machine);
 
+  // Starts indexing the game's files on a background thread, so the first
+  // FindFile() doesn't have to walk the game directory. Call once the
+  // Gameexe is available.
+  void BuildFileSystemCacheInBackground();
+
   // Finds a file on disk based on its basename with a list of possible
-  // extensions, or empty() if file not found.
+  // extensions, or empty() if file not found. Loose files take priority over
+  // the game's rlvm.pack; paths inside the pack must be opened through
+  // AssetPack.
   boost::filesystem::path FindFile(const std::string& fileName,
                                    const std::vector<std::string>& extensions);
 
@@ -263,6 +274,13 @@ class System {
   // Renders the screen and dumps a textual representation of the screen.
   void DumpRenderTree(RLMachine& machine);
 
+  // Per frame timing of the game loop, recorded by the subsystems.
+  FrameTelemetry& telemetry() { return *telemetry_; }
+
+  // Writes the recorded frame timings as CSV and JSON files, along with a
+  // summary of texture and DC memory use.
+  void DumpFrameTelemetry(RLMachine& machine);
+
   // Called once per gameloop.
   virtual void Run(RLMachine& machine) = 0;
 
@@ -279,10 +297,6 @@ class System {
   std::shared_ptr<Platform> platform_;
 
  private:
-  typedef std::multimap<std::string,
-                        std::pair<std::string, boost::filesystem::path>>
-      FileSystemCache;
-
   boost::filesystem::path GetHomeDirectory();
 
   // Invokes a custom dialog or the standard one if none present.
@@ -294,13 +308,10 @@ class System {
   // Verify that |index| is valid and throw if it isn't.
   void CheckSyscomIndex(int index, const char* function);
 
-  // Builds a list of all files that are in a directory specified in the
-  // #FOLDNAME part of the Gameexe.ini file.
-  void BuildFileSystemCache();
-
-  // Recurses on |directory| and adds all filetypes that we can read to our
-  // FileSystemCache.
-  void AddDirectoryToCache(const boost::filesystem::path& directory);
+  // Creates an index of all files that are in a directory specified in the
+  // #FOLDNAME part of the Gameexe.ini file. The index is persisted in the
+  // save directory if |persistent|. Also opens the game's asset pack.
+  std::unique_ptr<FileIndex> CreateFileIndex(bool persistent);
 
   // The visibility status for all syscom entries
   int syscom_status_[NUM_SYSCOM_ENTRIES];
@@ -321,7 +332,12 @@ class System {
 
   // Cached view of the filesystem, mapping a lowercase filename to an
   // extension and the local file path for that file.
-  FileSystemCache filesystem_cache_;
+  std::unique_ptr<FileIndex> filesystem_cache_;
+
+  // The game's rlvm.pack, if it has one.
+  std::unique_ptr<AssetPack> asset_pack_;
+
+  std::unique_ptr<FrameTelemetry> telemetry_;
 
   SystemGlobals globals_;
 
@@ -47,7 +47,7 @@ using std::vector;
 TextKeyCursor::TextKeyCursor(System& system, int in_curosr_number)
     : cursor_number_(in_curosr_number),
       current_frame_(0),
-      last_time_frame_incremented_(system.event().GetTicks()),
+      last_time_frame_incremented_(system.event().frame_ticks()),
       system_(system) {
   Gameexe& gexe = system.gameexe();
   GameexeInterpretObject cursor = gexe("CURSOR", in_curosr_number);
@@ -67,7 +67,7 @@ TextKeyCursor::~TextKeyCursor() {}
 // -----------------------------------------------------------------------
 
 void TextKeyCursor::Execute() {
-  unsigned int cur_time = system_.event().GetTicks();
+  unsigned int cur_time = system_.event().frame_ticks();
 
   if (cursor_image_ && last_time_frame_incremented_ + frame_speed_ < cur_time) {
     last_time_frame_incremented_ = cur_time;
@@ -78,6 +78,11 @@ void TextKeyCursor::Execute() {
     if (current_frame_ >= frame_count_)
       current_frame_ = 0;
   }
+
+  if (cursor_image_) {
+    system_.event().ScheduleWakeup(last_time_frame_incremented_ +
+                                   frame_speed_ + 1);
+  }
 }
 
 // -----------------------------------------------------------------------
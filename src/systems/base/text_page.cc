@@ -28,22 +28,18 @@
 #include "systems/base/text_page.h"
 
 #include <algorithm>
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "libreallive/gameexe.h"
 #include "machine/rlmachine.h"
 #include "systems/base/system.h"
 #include "systems/base/text_system.h"
 #include "systems/base/text_window.h"
-#include "utf8cpp/utf8.h"
 #include "utilities/exception.h"
 #include "utilities/string_utilities.h"
 
-using std::bind;
-using std::ref;
-using std::placeholders::_1;
-using std::placeholders::_2;
-
 // Represents the various commands.
 enum CommandType {
   TYPE_CHARACTERS,
@@ -66,235 +62,52 @@ enum CommandType {
   TYPE_NEXT_CHAR_IS_ITALIC,
 };
 
-// Storage for each command.
-struct TextPage::Command {
-  explicit Command(CommandType type);
-  Command(CommandType type, int one);
-  Command(CommandType type, const std::string& one);
-  Command(CommandType type, const std::string& one, const std::string& two);
-  Command(CommandType type, const std::string& one, int two);
-  Command(const Command& rhs);
-  ~Command();
-
-  enum CommandType command;
-  union {
-    // TYPE_CHARACTERS
-    std::string characters;
-
-    // TYPE_NAME
-    struct {
-      std::string name;
-      std::string next_char;
-    } name;
-
-    // TYPE_KOE_MARKER
-    int koe_id;
-
-    // TYPE_FONT_COLOUR
-    int font_colour;
-
-    // TYPE_FONT_SIZE
-    int font_size;
-
-    // TYPE_RUBY_END
-    std::string ruby_text;
-
-    // TYPE_SET_INSERTION_X
-    int set_insertion_x;
-
-    // TYPE_SET_INSERTION_Y
-    int set_insertion_y;
-
-    // TYPE_OFFSET_INSERTION_X
-    int offset_insertion_x;
-
-    // TYPE_OFFSET_INSERTION_Y
-    int offset_insertion_y;
-
-    // TYPE_FACE_OPEN
-    struct {
-      std::string filename;
-      int index;
-    } face_open;
-
-    // TYPE_FACE_CLOSE
-    int face_close;
-
-    // For the empty types:
-    // TYPE_HARD_BREAK
-    // TYPE_SET_INDENTATION
-    // TYPE_RESET_INDENTATION
-    // TYPE_DEFAULT_FONT_SIZE
-    // TYPE_RUBY_BEGIN
-    int empty;
-  };
-};
+// Commands are packed one after another into TextPage::commands_. Each starts
+// with its CommandType in one byte, followed by its arguments:
+//
+//   TYPE_CHARACTERS          string (the run of UTF-8 characters)
+//   TYPE_NAME                interned name, string (next character)
+//   TYPE_RUBY_END            string
+//   TYPE_FACE_OPEN           interned filename, int
+//   TYPE_KOE_MARKER,
+//   TYPE_FONT_COLOUR,
+//   TYPE_FONT_SIZE,
+//   TYPE_*_INSERTION_*,
+//   TYPE_FACE_CLOSE          int
+//   everything else          nothing
+//
+// An int is four bytes in host order. A string is an int length followed by
+// its bytes. An interned string is the int id from TextSystem::InternString().
 
-TextPage::Command::Command(CommandType type)
-    : command(type) {
-  switch (type) {
-    case TYPE_HARD_BREAK:
-    case TYPE_SET_INDENTATION:
-    case TYPE_RESET_INDENTATION:
-    case TYPE_DEFAULT_FONT_SIZE:
-    case TYPE_RUBY_BEGIN:
-    case TYPE_NEXT_CHAR_IS_ITALIC:
-      empty = 0;
-      break;
-    case TYPE_CHARACTERS:
-      new (&characters) std::string;
-      break;
-    default:
-      throw rlvm::Exception("Incorrect arity");
-  }
-}
+namespace {
 
-TextPage::Command::Command(CommandType type, int one)
-    : command(type) {
-  switch (type) {
-    case TYPE_KOE_MARKER:
-      koe_id = one;
-      break;
-    case TYPE_FONT_COLOUR:
-      font_colour = one;
-      break;
-    case TYPE_FONT_SIZE:
-      font_size = one;
-      break;
-    case TYPE_SET_INSERTION_X:
-      set_insertion_x = one;
-      break;
-    case TYPE_SET_INSERTION_Y:
-      set_insertion_y = one;
-      break;
-    case TYPE_OFFSET_INSERTION_X:
-      offset_insertion_x = one;
-      break;
-    case TYPE_OFFSET_INSERTION_Y:
-      offset_insertion_y = one;
-      break;
-    case TYPE_FACE_CLOSE:
-      face_close = one;
-      break;
-    default:
-      throw rlvm::Exception("Incorrect arity");
-  }
-}
+const size_t kNoCharacters = static_cast<size_t>(-1);
 
-TextPage::Command::Command(CommandType type, const std::string& one)
-    : command(type) {
-  switch (type) {
-    case TYPE_RUBY_END:
-      new (&ruby_text) std::string(one);
-      break;
-    default:
-      throw rlvm::Exception("Incorrect arity");
-  }
+void PutInt(std::vector<char>& out, int32_t value) {
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(value));
 }
 
-TextPage::Command::Command(CommandType type,
-                           const std::string& one,
-                           const std::string& two)
-    : command(type) {
-  switch (type) {
-    case TYPE_NAME:
-      new (&name.name) std::string(one);
-      new (&name.next_char) std::string(two);
-      break;
-    default:
-      throw rlvm::Exception("Incorrect arity");
-  }
+void PutString(std::vector<char>& out, const std::string& str) {
+  PutInt(out, str.size());
+  out.insert(out.end(), str.begin(), str.end());
 }
 
-TextPage::Command::Command(CommandType type,
-                           const std::string& one,
-                           int two)
-    : command(type) {
-  switch (type) {
-    case TYPE_FACE_OPEN:
-      new (&face_open.filename) std::string(one);
-      face_open.index = two;
-      break;
-    default:
-      throw rlvm::Exception("Incorrect arity");
-  }
+int32_t ReadInt(const char*& in) {
+  int32_t value;
+  memcpy(&value, in, sizeof(value));
+  in += sizeof(value);
+  return value;
 }
 
-TextPage::Command::Command(const Command& rhs)
-    : command(rhs.command) {
-  switch (rhs.command) {
-    case TYPE_HARD_BREAK:
-    case TYPE_SET_INDENTATION:
-    case TYPE_RESET_INDENTATION:
-    case TYPE_DEFAULT_FONT_SIZE:
-    case TYPE_RUBY_BEGIN:
-    case TYPE_NEXT_CHAR_IS_ITALIC:
-      empty = 0;
-      break;
-    case TYPE_KOE_MARKER:
-      koe_id = rhs.koe_id;
-      break;
-    case TYPE_FONT_COLOUR:
-      font_colour = rhs.font_colour;
-      break;
-    case TYPE_FONT_SIZE:
-      font_size = rhs.font_size;
-      break;
-    case TYPE_SET_INSERTION_X:
-      set_insertion_x = rhs.set_insertion_x;
-      break;
-    case TYPE_SET_INSERTION_Y:
-      set_insertion_y = rhs.set_insertion_y;
-      break;
-    case TYPE_OFFSET_INSERTION_X:
-      offset_insertion_x = rhs.offset_insertion_x;
-      break;
-    case TYPE_OFFSET_INSERTION_Y:
-      offset_insertion_y = rhs.offset_insertion_y;
-      break;
-    case TYPE_FACE_CLOSE:
-      face_close = rhs.face_close;
-      break;
-    case TYPE_CHARACTERS:
-      new (&characters) std::string(rhs.characters);
-      break;
-    case TYPE_RUBY_END:
-      new (&ruby_text) std::string(rhs.ruby_text);
-      break;
-    case TYPE_NAME:
-      new (&name.name) std::string(rhs.name.name);
-      new (&name.next_char) std::string(rhs.name.next_char);
-      break;
-    case TYPE_FACE_OPEN:
-      command = TYPE_FACE_OPEN;
-      new (&face_open.filename) std::string(rhs.face_open.filename);
-      face_open.index = rhs.face_open.index;
-      break;
-  }
+std::string ReadString(const char*& in) {
+  int32_t size = ReadInt(in);
+  std::string str(in, size);
+  in += size;
+  return str;
 }
 
-TextPage::Command::~Command() {
-  // Needed to get around a quirk of the language
-  using string_type = std::string;
-
-  switch (command) {
-    case TYPE_CHARACTERS:
-      characters.~string_type();
-      break;
-    case TYPE_RUBY_END:
-      ruby_text.~string_type();
-      break;
-    case TYPE_NAME:
-      name.name.~string_type();
-      name.next_char.~string_type();
-      break;
-    case TYPE_FACE_OPEN:
-      face_open.filename.~string_type();
-      break;
-    default:
-      break;
-  }
-}
+}  // namespace
 
 // -----------------------------------------------------------------------
 // TextPage
@@ -304,7 +117,8 @@ TextPage::TextPage(System& system, int window_num)
     : system_(&system),
       window_num_(window_num),
       number_of_chars_on_page_(0),
-      in_ruby_gloss_(false) {
+      in_ruby_gloss_(false),
+      characters_offset_(kNoCharacters) {
 }
 
 TextPage::TextPage(const TextPage& rhs) = default;
@@ -313,19 +127,23 @@ TextPage::TextPage(TextPage&& rhs) = default;
 
 TextPage::~TextPage() {}
 
+size_t TextPage::GetMemoryUsage() const {
+  return sizeof(*this) + commands_.capacity();
+}
+
 void TextPage::Replay(bool is_active_page) {
   // Reset the font color.
   if (!is_active_page) {
-    Gameexe& gexe = system_->gameexe();
-    GameexeInterpretObject colour(gexe("COLOR_TABLE", 254));
+    GameexeKeyHandle colour = system_->text().GetColourTableKey(254);
     if (colour.Exists()) {
-      system_->text().GetTextWindow(window_num_)->SetFontColor(colour);
+      system_->text().GetTextWindow(window_num_)->SetFontColor(
+          colour.ToIntVector());
     }
   }
 
-  for_each(elements_to_replay_.begin(),
-           elements_to_replay_.end(),
-           [&](Command& c) { RunTextPageCommand(c, is_active_page); });
+  size_t offset = 0;
+  while (offset < commands_.size())
+    offset = RunTextPageCommand(offset, is_active_page);
 }
 
 // ------------------------------------------------- [ Public operations ]
@@ -334,12 +152,17 @@ bool TextPage::Character(const string& current, const string& rest) {
   bool rendered = CharacterImpl(current, rest);
 
   if (rendered) {
-    if (elements_to_replay_.size() == 0 ||
-        elements_to_replay_.back().command != TYPE_CHARACTERS) {
-      elements_to_replay_.emplace_back(TYPE_CHARACTERS);
+    // Extend the run of characters at the end of the page, if there is one.
+    if (characters_offset_ == kNoCharacters) {
+      characters_offset_ = commands_.size();
+      commands_.push_back(TYPE_CHARACTERS);
+      PutInt(commands_, 0);
     }
 
-    elements_to_replay_.back().characters.append(current);
+    commands_.insert(commands_.end(), current.begin(), current.end());
+    const char* length_ptr = &commands_[characters_offset_ + 1];
+    int32_t length = ReadInt(length_ptr) + current.size();
+    memcpy(&commands_[characters_offset_ + 1], &length, sizeof(length));
 
     number_of_chars_on_page_++;
   }
@@ -348,108 +171,132 @@ bool TextPage::Character(const string& current, const string& rest) {
 }
 
 void TextPage::Name(const string& name, const string& next_char) {
-  AddAction(Command(TYPE_NAME, name, next_char));
+  size_t offset = BeginCommand(TYPE_NAME);
+  PutInt(commands_, system_->text().InternString(name));
+  PutString(commands_, next_char);
+  RunTextPageCommand(offset, true);
   number_of_chars_on_page_++;
 }
 
 void TextPage::KoeMarker(int id) {
-  AddAction(Command(TYPE_KOE_MARKER, id));
+  AddAction(TYPE_KOE_MARKER, id);
 }
 
 void TextPage::HardBrake() {
-  AddAction(Command(TYPE_HARD_BREAK));
+  AddAction(TYPE_HARD_BREAK);
 }
 
 void TextPage::SetIndentation() {
-  AddAction(Command(TYPE_SET_INDENTATION));
+  AddAction(TYPE_SET_INDENTATION);
 }
 
 void TextPage::ResetIndentation() {
-  AddAction(Command(TYPE_RESET_INDENTATION));
+  AddAction(TYPE_RESET_INDENTATION);
 }
 
 void TextPage::FontColour(int colour) {
-  AddAction(Command(TYPE_FONT_COLOUR, colour));
+  AddAction(TYPE_FONT_COLOUR, colour);
 }
 
 void TextPage::DefaultFontSize() {
-  AddAction(Command(TYPE_DEFAULT_FONT_SIZE));
+  AddAction(TYPE_DEFAULT_FONT_SIZE);
 }
 
 void TextPage::FontSize(const int size) {
-  AddAction(Command(TYPE_FONT_SIZE, size));
+  AddAction(TYPE_FONT_SIZE, size);
 }
 
 void TextPage::MarkRubyBegin() {
-  AddAction(Command(TYPE_RUBY_BEGIN));
+  AddAction(TYPE_RUBY_BEGIN);
 }
 
 void TextPage::DisplayRubyText(const std::string& utf8str) {
-  AddAction(Command(TYPE_RUBY_END, utf8str));
+  size_t offset = BeginCommand(TYPE_RUBY_END);
+  PutString(commands_, utf8str);
+  RunTextPageCommand(offset, true);
 }
 
 void TextPage::SetInsertionPointX(int x) {
-  AddAction(Command(TYPE_SET_INSERTION_X, x));
+  AddAction(TYPE_SET_INSERTION_X, x);
 }
 
 void TextPage::SetInsertionPointY(int y) {
-  AddAction(Command(TYPE_SET_INSERTION_Y, y));
+  AddAction(TYPE_SET_INSERTION_Y, y);
 }
 
 void TextPage::Offset_insertion_point_x(int offset) {
-  AddAction(Command(TYPE_OFFSET_INSERTION_X, offset));
+  AddAction(TYPE_OFFSET_INSERTION_X, offset);
 }
 
 void TextPage::Offset_insertion_point_y(int offset) {
-  AddAction(Command(TYPE_OFFSET_INSERTION_Y, offset));
+  AddAction(TYPE_OFFSET_INSERTION_Y, offset);
 }
 
 void TextPage::FaceOpen(const std::string& filename, int index) {
-  AddAction(Command(TYPE_FACE_OPEN, filename, index));
+  size_t offset = BeginCommand(TYPE_FACE_OPEN);
+  PutInt(commands_, system_->text().InternString(filename));
+  PutInt(commands_, index);
+  RunTextPageCommand(offset, true);
 }
 
 void TextPage::FaceClose(int index) {
-  AddAction(Command(TYPE_FACE_CLOSE, index));
+  AddAction(TYPE_FACE_CLOSE, index);
 }
 
 void TextPage::NextCharIsItalic() {
-  AddAction(Command(TYPE_NEXT_CHAR_IS_ITALIC));
+  AddAction(TYPE_NEXT_CHAR_IS_ITALIC);
 }
 
 bool TextPage::IsFull() const {
   return system_->text().GetTextWindow(window_num_)->IsFull();
 }
 
-void TextPage::AddAction(const Command& command) {
-  RunTextPageCommand(command, true);
-  elements_to_replay_.push_back(command);
+size_t TextPage::BeginCommand(int type) {
+  characters_offset_ = kNoCharacters;
+  size_t offset = commands_.size();
+  commands_.push_back(type);
+  return offset;
+}
+
+void TextPage::AddAction(int type) {
+  RunTextPageCommand(BeginCommand(type), true);
+}
+
+void TextPage::AddAction(int type, int argument) {
+  size_t offset = BeginCommand(type);
+  PutInt(commands_, argument);
+  RunTextPageCommand(offset, true);
 }
 
 bool TextPage::CharacterImpl(const string& c, const string& rest) {
   return system_->text().GetTextWindow(window_num_)->DisplayCharacter(c, rest);
 }
 
-void TextPage::RunTextPageCommand(const Command& command,
-                                  bool is_active_page) {
+size_t TextPage::RunTextPageCommand(size_t offset, bool is_active_page) {
   std::shared_ptr<TextWindow> window =
       system_->text().GetTextWindow(window_num_);
 
-  switch (command.command) {
-    case TYPE_CHARACTERS:
-      if (command.characters.size()) {
-        PrintTextToFunction(
-            bind(&TextPage::CharacterImpl, ref(*this), _1, _2),
-            command.characters,
-            "");
-      }
+  const char* in = commands_.data() + offset;
+  switch (static_cast<unsigned char>(*in++)) {
+    case TYPE_CHARACTERS: {
+      // Only the characters that decide the next line break are passed along
+      // with each character, so replaying a page is linear in its length.
+      DisplayText text(ReadString(in));
+      for (size_t i = 0; i < text.size(); ++i)
+        CharacterImpl(text.Character(i), text.LineBreakLookahead(i + 1));
       break;
-    case TYPE_NAME:
-      window->SetName(command.name.name, command.name.next_char);
+    }
+    case TYPE_NAME: {
+      const std::string& name = system_->text().GetInternedString(ReadInt(in));
+      window->SetName(name, ReadString(in));
       break;
-    case TYPE_KOE_MARKER:
+    }
+    case TYPE_KOE_MARKER: {
+      int koe_id = ReadInt(in);
       if (!is_active_page)
-        window->KoeMarker(command.koe_id);
+        window->KoeMarker(koe_id);
       break;
+    }
     case TYPE_HARD_BREAK:
       window->HardBrake();
       break;
@@ -459,45 +306,55 @@ void TextPage::RunTextPageCommand(const Command& command,
     case TYPE_RESET_INDENTATION:
       window->ResetIndentation();
       break;
-    case TYPE_FONT_COLOUR:
+    case TYPE_FONT_COLOUR: {
+      int font_colour = ReadInt(in);
       if (is_active_page) {
         window->SetFontColor(
-            system_->gameexe()("COLOR_TABLE", command.font_colour));
+            system_->text().GetColourTableKey(font_colour).ToIntVector());
       }
       break;
+    }
     case TYPE_DEFAULT_FONT_SIZE:
       window->set_font_size_to_default();
       break;
     case TYPE_FONT_SIZE:
-      window->set_font_size_in_pixels(command.font_size);
+      window->set_font_size_in_pixels(ReadInt(in));
       break;
     case TYPE_RUBY_BEGIN:
       window->MarkRubyBegin();
       in_ruby_gloss_ = true;
       break;
     case TYPE_RUBY_END:
-      window->DisplayRubyText(command.ruby_text);
+      window->DisplayRubyText(ReadString(in));
       in_ruby_gloss_ = false;
       break;
     case TYPE_SET_INSERTION_X:
-      window->set_insertion_point_x(command.set_insertion_x);
+      window->set_insertion_point_x(ReadInt(in));
       break;
     case TYPE_SET_INSERTION_Y:
-      window->set_insertion_point_y(command.set_insertion_y);
+      window->set_insertion_point_y(ReadInt(in));
       break;
     case TYPE_OFFSET_INSERTION_X:
-      window->offset_insertion_point_x(command.offset_insertion_x);
+      window->offset_insertion_point_x(ReadInt(in));
       break;
     case TYPE_OFFSET_INSERTION_Y:
-      window->offset_insertion_point_y(command.offset_insertion_y);
+      window->offset_insertion_point_y(ReadInt(in));
       break;
-    case TYPE_FACE_OPEN:
-      window->FaceOpen(command.face_open.filename, command.face_open.index);
+    case TYPE_FACE_OPEN: {
+      const std::string& filename =
+          system_->text().GetInternedString(ReadInt(in));
+      window->FaceOpen(filename, ReadInt(in));
       break;
+    }
     case TYPE_FACE_CLOSE:
-      window->FaceClose(command.face_close);
+      window->FaceClose(ReadInt(in));
       break;
     case TYPE_NEXT_CHAR_IS_ITALIC:
       window->NextCharIsItalic();
+      break;
+    default:
+      throw rlvm::Exception("Corrupt text page");
   }
+
+  return in - commands_.data();
 }
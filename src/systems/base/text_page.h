@@ -33,17 +33,15 @@
 #include <string>
 #include <vector>
 
-class TextPageElement;
-class SetWindowTextPageElement;
 class System;
-class TextTextPageElement;
 
 // A sequence of replayable commands that write to or modify a window, such as
 // displaying characters and changing font information.
 //
-// The majority of public methods in TextPage simply call the private versions
-// of these methods, and add the appropriate TextPageElement to this page's
-// back log for replay.
+// The majority of public methods in TextPage append a command to this page's
+// back log and then run it. Commands are packed into a single byte buffer
+// instead of being stored as individual objects, since a backlog holds
+// hundreds of pages; see text_page.cc for the encoding.
 class TextPage {
  public:
   TextPage(System& system, int window_num);
@@ -58,7 +56,10 @@ class TextPage {
   // MarkRubyBegin(), but not the closing DisplayRubyText().
   bool in_ruby_gloss() const { return in_ruby_gloss_; }
 
-  bool empty() const { return elements_to_replay_.empty(); }
+  bool empty() const { return commands_.empty(); }
+
+  // Bytes of memory used by this page, including its command buffer.
+  size_t GetMemoryUsage() const;
 
   // Replays every recordable action called on this TextPage.
   void Replay(bool is_active_page);
@@ -121,18 +122,20 @@ class TextPage {
   bool IsFull() const;
 
  private:
-  // Storage for an individual command.
-  struct Command;
+  // Starts a new command of |type| at the end of |commands_| and returns its
+  // offset.
+  size_t BeginCommand(int type);
 
-  // Executes |command| and then adds it to |elements_to_replay_|.
-  void AddAction(const Command& command);
+  // Appends a command with no arguments or one int argument and runs it.
+  void AddAction(int type);
+  void AddAction(int type, int argument);
 
   // Performs textout.
   bool CharacterImpl(const std::string& c, const std::string& rest);
 
-  // Actually performs the command in most cases.
-  void RunTextPageCommand(const Command& command,
-                          bool is_active_page);
+  // Runs the command starting at |offset| in |commands_| and returns the
+  // offset of the next one.
+  size_t RunTextPageCommand(size_t offset, bool is_active_page);
 
   System* system_;
 
@@ -146,8 +149,12 @@ class TextPage {
   // called.
   bool in_ruby_gloss_;
 
-  // A list of the text elements to replay on this page.
-  std::vector<Command> elements_to_replay_;
+  // The packed commands to replay on this page.
+  std::vector<char> commands_;
+
+  // Offset in |commands_| of the TYPE_CHARACTERS command that Character()
+  // appends to, or -1 if the last command is something else.
+  size_t characters_offset_;
 };
 
 #endif  // SRC_SYSTEMS_BASE_TEXT_PAGE_H_
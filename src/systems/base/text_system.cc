@@ -59,7 +59,10 @@ using std::ostringstream;
 using std::string;
 using std::vector;
 
-const unsigned int MAX_PAGE_HISTORY = 100;
+const size_t MAX_PAGE_HISTORY = 100;
+
+// Default cap on the memory used by the backlog.
+const size_t MAX_BACKLOG_BYTES = 4 * 1024 * 1024;
 
 const int FULLWIDTH_NUMBER_SIGN = 0xFF03;
 const int FULLWIDTH_A = 0xFF21;
@@ -102,6 +105,9 @@ TextSystem::TextSystem(System& system, Gameexe& gexe)
       active_window_(0),
       is_reading_backlog_(false),
       current_pageset_(),
+      max_backlog_pages_(MAX_PAGE_HISTORY),
+      max_backlog_bytes_(MAX_BACKLOG_BYTES),
+      backlog_bytes_(0),
       in_pause_state_(false),
       // #WINDOW_*_USE
       move_use_(false),
@@ -131,6 +137,16 @@ TextSystem::TextSystem(System& system, Gameexe& gexe)
   CheckAndSetBool(gexe, "WINDOW_MSGBKRIGHT_USE", msgbkright_use_);
   CheckAndSetBool(gexe, "WINDOW_EXBTN_USE", exbtn_use_);
 
+  GameexeInterpretObject backlog_pages(gexe("__BACKLOG_PAGES"));
+  if (backlog_pages.Exists())
+    max_backlog_pages_ = std::max(backlog_pages.ToInt(), 1);
+  GameexeInterpretObject backlog_bytes(gexe("__BACKLOG_BYTES"));
+  if (backlog_bytes.Exists())
+    max_backlog_bytes_ = std::max(backlog_bytes.ToInt(), 0);
+
+  for (int i = 0; i < COLOUR_TABLE_SIZE; ++i)
+    colour_table_keys_[i] = gexe.GetHandle("COLOR_TABLE", i);
+
   previous_page_it_ = previous_page_sets_.end();
 }
 
@@ -255,8 +271,57 @@ void TextSystem::CheckAndSetBool(Gameexe& gexe,
 }
 
 void TextSystem::ExpireOldPages() {
-  while (previous_page_sets_.size() > MAX_PAGE_HISTORY)
+  while (!previous_page_sets_.empty() &&
+         (previous_page_sets_.size() > max_backlog_pages_ ||
+          backlog_bytes_ > max_backlog_bytes_)) {
+    // Don't leave the backlog reader pointing at a freed page.
+    if (previous_page_it_ == previous_page_sets_.begin())
+      ++previous_page_it_;
+
+    backlog_bytes_ -= GetPageSetMemoryUsage(previous_page_sets_.front());
     previous_page_sets_.pop_front();
+  }
+}
+
+size_t TextSystem::GetPageSetMemoryUsage(const PageSet& set) {
+  size_t bytes = 0;
+  for (auto const& page : set)
+    bytes += page.second.GetMemoryUsage();
+  return bytes;
+}
+
+void TextSystem::SetBacklogLimits(size_t max_pages, size_t max_bytes) {
+  max_backlog_pages_ = std::max<size_t>(max_pages, 1);
+  max_backlog_bytes_ = max_bytes;
+  ExpireOldPages();
+}
+
+std::vector<size_t> TextSystem::GetBacklogMemoryUsage() const {
+  std::vector<size_t> usage;
+  for (auto const& set : previous_page_sets_)
+    usage.push_back(GetPageSetMemoryUsage(set));
+  return usage;
+}
+
+int TextSystem::InternString(const std::string& str) {
+  auto it = interned_ids_.find(str);
+  if (it != interned_ids_.end())
+    return it->second;
+
+  int id = interned_strings_.size();
+  interned_strings_.push_back(str);
+  interned_ids_.emplace(str, id);
+  return id;
+}
+
+const std::string& TextSystem::GetInternedString(int id) const {
+  return interned_strings_.at(id);
+}
+
+GameexeKeyHandle TextSystem::GetColourTableKey(int index) {
+  if (index < 0 || index >= COLOUR_TABLE_SIZE)
+    return system_.gameexe().GetHandle("COLOR_TABLE", index);
+  return colour_table_keys_[index];
 }
 
 bool TextSystem::MouseButtonStateChanged(MouseButton mouse_button,
@@ -296,6 +361,7 @@ void TextSystem::Snapshot() {
 
   if (!all_empty) {
     previous_page_sets_.push_back(current_pageset_);
+    backlog_bytes_ += GetPageSetMemoryUsage(previous_page_sets_.back());
     ExpireOldPages();
   }
 }
@@ -667,8 +733,8 @@ std::shared_ptr<Surface> TextSystem::RenderText(const std::string& utf8str,
           // Consume an integer. Or don't.
           int val;
           if (parseInteger(cur_end, strend, val)) {
-            Gameexe& gexe = system().gameexe();
-            current_colour = RGBColour(gexe("COLOR_TABLE", val));
+            current_colour =
+                RGBColour(GetColourTableKey(val).ToIntVector());
           } else {
             current_colour = colour;
           }
@@ -771,6 +837,7 @@ void TextSystem::Reset() {
   current_pageset_.clear();
   previous_page_sets_.clear();
   previous_page_it_ = previous_page_sets_.end();
+  backlog_bytes_ = 0;
 
   window_visual_override_.clear();
   text_window_.clear();
@@ -838,14 +905,18 @@ template void TextSystem::load<boost::archive::text_iarchive>(
 
 // -----------------------------------------------------------------------
 
+namespace {
+
+const char LOWER_BYTE_FULLWIDTH_ASTERISK = 0x96;
+const char LOWER_BYTE_FULLWIDTH_PERCENT = 0x93;
+
+}  // namespace
+
 void parseNames(const Memory& memory,
                 const std::string& input,
                 std::string& output) {
   const char* cur = input.c_str();
 
-  const char LOWER_BYTE_FULLWIDTH_ASTERISK = 0x96;
-  const char LOWER_BYTE_FULLWIDTH_PERCENT = 0x93;
-
   while (*cur) {
     if (cur[0] == 0x81 && (cur[1] == LOWER_BYTE_FULLWIDTH_ASTERISK ||
                            cur[1] == LOWER_BYTE_FULLWIDTH_PERCENT)) {
@@ -871,6 +942,23 @@ void parseNames(const Memory& memory,
   }
 }
 
+bool HasNameReferences(const std::string& input) {
+  const char* cur = input.c_str();
+  while (*cur) {
+    if (cur[0] == 0x81 && (cur[1] == LOWER_BYTE_FULLWIDTH_ASTERISK ||
+                           cur[1] == LOWER_BYTE_FULLWIDTH_PERCENT)) {
+      return true;
+    }
+
+    if (shiftjis_lead_byte(cur[0]) && cur[1] != '\0')
+      cur += 2;
+    else
+      ++cur;
+  }
+
+  return false;
+}
+
 bool TextSystem::CurrentlySkipping() const {
   return kidoku_read_ && skip_mode();
 }
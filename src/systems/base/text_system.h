@@ -35,9 +35,11 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <map>
 
+#include "libreallive/gameexe.h"
 #include "machine/long_operation.h"
 #include "systems/base/event_listener.h"
 
@@ -142,6 +144,25 @@ class TextSystem : public EventListener {
   bool IsReadingBacklog() const;
   void StopReadingBacklog();
 
+  // Caps the backlog at |max_pages| page sets and |max_bytes| of page memory.
+  // The oldest pages are dropped first. Can also be set with the
+  // __BACKLOG_PAGES and __BACKLOG_BYTES Gameexe keys.
+  void SetBacklogLimits(size_t max_pages, size_t max_bytes);
+
+  // Debugging information: the memory used by each page set in the backlog,
+  // oldest first, and the total.
+  std::vector<size_t> GetBacklogMemoryUsage() const;
+  size_t backlog_bytes() const { return backlog_bytes_; }
+
+  // TextPages store names and face filenames, which repeat on nearly every
+  // page, as ids into a table kept here.
+  int InternString(const std::string& str);
+  const std::string& GetInternedString(int id) const;
+
+  // Returns the #COLOR_TABLE entry for |index|. Text colours are looked up for
+  // every message and every replayed page, so the keys are resolved once.
+  GameexeKeyHandle GetColourTableKey(int index);
+
   // A temporary version of |message_no_wait_| controllable by the script.
   void set_script_message_nowait(const int in) { script_message_no_wait_ = in; }
   int script_message_nowait() const { return script_message_no_wait_; }
@@ -271,10 +292,12 @@ class TextSystem : public EventListener {
 
   void CheckAndSetBool(Gameexe& gexe, const std::string& key, bool& out);
 
-  // Reduces the number of page snapshots in previous_page_sets_ down to a
-  // manageable constant number.
+  // Drops the oldest page snapshots in previous_page_sets_ until the backlog
+  // fits in |max_backlog_pages_| and |max_backlog_bytes_|.
   void ExpireOldPages();
 
+  static size_t GetPageSetMemoryUsage(const PageSet& set);
+
   // TextPage will call our internals since it actually does most of
   // the work while we hold state.
   friend class TextPage;
@@ -319,6 +342,20 @@ class TextSystem : public EventListener {
   // being rendered.
   std::list<PageSet>::iterator previous_page_it_;
 
+  // Limits on |previous_page_sets_|, and the memory its pages currently use.
+  size_t max_backlog_pages_;
+  size_t max_backlog_bytes_;
+  size_t backlog_bytes_;
+
+  // Strings interned by InternString(). Never shrinks; it only holds names
+  // and filenames, of which a game has a bounded number.
+  std::vector<std::string> interned_strings_;
+  std::unordered_map<std::string, int> interned_ids_;
+
+  // Handles for #COLOR_TABLE.000 through #COLOR_TABLE.255.
+  static const int COLOUR_TABLE_SIZE = 256;
+  GameexeKeyHandle colour_table_keys_[COLOUR_TABLE_SIZE];
+
   // Whether we are in a state where the interpreter is pause()d.
   bool in_pause_state_;
 
@@ -371,6 +408,10 @@ void parseNames(const Memory& memory,
                 const std::string& input,
                 std::string& output);
 
+// Returns whether |input| has any name variable placeholders that parseNames()
+// would replace.
+bool HasNameReferences(const std::string& input);
+
 // LongOperation which just calls text().set_system_visible(true) and removes
 // itself from the callstack.
 struct RestoreTextSystemVisibility : public LongOperation {
@@ -420,6 +420,8 @@ void TextWindow::Render(std::ostream* tree) {
   std::shared_ptr<Surface> text_surface = GetTextSurface();
 
   if (text_surface && is_visible()) {
+    FlushPendingGlyphs();
+
     Size surface_size = text_surface->GetSize();
 
     // POINT
@@ -518,6 +520,7 @@ void TextWindow::ClearWin() {
   ruby_begin_point_ = -1;
   font_colour_ = default_colour_;
   koe_replay_button_.clear();
+  pending_glyphs_.clear();
 }
 
 bool TextWindow::DisplayCharacter(const std::string& current,
@@ -555,15 +558,13 @@ bool TextWindow::DisplayCharacter(const std::string& current,
         return false;
     }
 
-    RGBColour shadow = RGBAColour::Black().rgb();
-    text_system_.RenderGlyphOnto(current,
-                                 font_size_in_pixels(),
-                                 next_char_italic_,
-                                 font_colour_,
-                                 &shadow,
-                                 text_insertion_point_x_,
-                                 text_insertion_point_y_,
-                                 GetTextSurface());
+    PendingGlyph glyph = {current, font_size_in_pixels(), next_char_italic_,
+                          font_colour_,
+                          Point(text_insertion_point_x_,
+                                text_insertion_point_y_)};
+    pending_glyphs_.push_back(glyph);
+    if (!system_.ShouldFastForward())
+      FlushPendingGlyphs();
     next_char_italic_ = false;
     text_wrapping_point_x_ += GetWrappingWidthFor(cur_codepoint);
 
@@ -605,6 +606,25 @@ bool TextWindow::DisplayCharacter(const std::string& current,
   return true;
 }
 
+void TextWindow::FlushPendingGlyphs() {
+  if (pending_glyphs_.empty())
+    return;
+
+  std::shared_ptr<Surface> text_surface = GetTextSurface();
+  RGBColour shadow = RGBAColour::Black().rgb();
+  for (const PendingGlyph& glyph : pending_glyphs_) {
+    text_system_.RenderGlyphOnto(glyph.character,
+                                 glyph.font_size,
+                                 glyph.italic,
+                                 glyph.colour,
+                                 &shadow,
+                                 glyph.insertion_point.x(),
+                                 glyph.insertion_point.y(),
+                                 text_surface);
+  }
+  pending_glyphs_.clear();
+}
+
 // Lines we still get wrong in CLANNAD Prologue:
 //
 // <rlmax> = Official RealLive's breaking
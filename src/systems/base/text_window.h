@@ -210,6 +210,12 @@ class TextWindow {
   virtual bool DisplayCharacter(const std::string& current,
                                 const std::string& rest);
 
+  // While skipping, DisplayCharacter() only lays out glyphs and queues them;
+  // they are drawn onto the text surface here, which Render() calls before
+  // the page is shown. Pages cleared before they're ever shown are never
+  // rasterized.
+  void FlushPendingGlyphs();
+
   // Checks to make sure that not only will |cur_codepoint| fit on the line,
   // but also that we'll perform kinsoku rules correctly.
   bool MustLineBreak(int cur_codepoint, const std::string& rest);
@@ -419,6 +425,17 @@ class TextWindow {
   };
   std::unique_ptr<KoeReplayInfo> koe_replay_info_;
 
+  // A glyph that has been laid out but not yet drawn onto the text surface.
+  // See FlushPendingGlyphs().
+  struct PendingGlyph {
+    std::string character;
+    int font_size;
+    bool italic;
+    RGBColour colour;
+    Point insertion_point;
+  };
+  std::vector<PendingGlyph> pending_glyphs_;
+
   System& system_;
   TextSystem& text_system_;
 };
@@ -0,0 +1,155 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "systems/base/texture_budget.h"
+
+#include <algorithm>
+#include <ostream>
+
+namespace {
+
+const double kBytesPerMegabyte = 1024.0 * 1024.0;
+
+}  // namespace
+
+// -----------------------------------------------------------------------
+// TextureBudget::Client
+// -----------------------------------------------------------------------
+
+TextureBudget::Client::~Client() {}
+
+// -----------------------------------------------------------------------
+// TextureBudget::Stats
+// -----------------------------------------------------------------------
+
+TextureBudget::Stats::Stats()
+    : resident_bytes(0),
+      peak_bytes(0),
+      resident_clients(0),
+      evictions(0),
+      evicted_bytes(0),
+      uploads(0),
+      reuploads(0) {}
+
+// -----------------------------------------------------------------------
+// TextureBudget
+// -----------------------------------------------------------------------
+
+TextureBudget::TextureBudget(uint64_t max_bytes)
+    : max_bytes_(max_bytes), current_frame_(0) {}
+
+TextureBudget::~TextureBudget() {}
+
+void TextureBudget::set_max_bytes(uint64_t max_bytes) {
+  max_bytes_ = max_bytes;
+  Trim();
+}
+
+void TextureBudget::BeginFrame() { current_frame_++; }
+
+void TextureBudget::Upload(Client* client, uint64_t bytes) {
+  auto it = entries_.find(client);
+  if (it != entries_.end()) {
+    stats_.resident_bytes -= it->second->bytes;
+    lru_.erase(it->second);
+    entries_.erase(it);
+  } else {
+    stats_.uploads++;
+    if (evicted_.erase(client))
+      stats_.reuploads++;
+  }
+
+  lru_.push_front(Entry{client, bytes, current_frame_});
+  entries_[client] = lru_.begin();
+  stats_.resident_bytes += bytes;
+  stats_.peak_bytes = std::max(stats_.peak_bytes, stats_.resident_bytes);
+  stats_.resident_clients = entries_.size();
+
+  Trim();
+}
+
+void TextureBudget::Touch(Client* client) {
+  auto it = entries_.find(client);
+  if (it == entries_.end())
+    return;
+
+  it->second->last_frame = current_frame_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+}
+
+void TextureBudget::Remove(Client* client) {
+  evicted_.erase(client);
+
+  auto it = entries_.find(client);
+  if (it == entries_.end())
+    return;
+
+  stats_.resident_bytes -= it->second->bytes;
+  lru_.erase(it->second);
+  entries_.erase(it);
+  stats_.resident_clients = entries_.size();
+}
+
+bool TextureBudget::IsResident(Client* client) const {
+  return entries_.find(client) != entries_.end();
+}
+
+void TextureBudget::WriteReport(std::ostream& os) const {
+  os << "Texture budget: ";
+  if (max_bytes_)
+    os << max_bytes_ / kBytesPerMegabyte << " MB";
+  else
+    os << "unlimited";
+  os << std::endl;
+
+  os << "Resident: " << stats_.resident_bytes / kBytesPerMegabyte << " MB in "
+     << stats_.resident_clients << " surfaces" << std::endl;
+  os << "Peak: " << stats_.peak_bytes / kBytesPerMegabyte << " MB"
+     << std::endl;
+  os << "Uploads: " << stats_.uploads << " (" << stats_.reuploads
+     << " after eviction)" << std::endl;
+  os << "Evictions: " << stats_.evictions << " ("
+     << stats_.evicted_bytes / kBytesPerMegabyte << " MB)" << std::endl;
+}
+
+void TextureBudget::Trim() {
+  while (max_bytes_ && stats_.resident_bytes > max_bytes_ && !lru_.empty()) {
+    Entry victim = lru_.back();
+    if (victim.last_frame == current_frame_)
+      break;
+
+    lru_.pop_back();
+    entries_.erase(victim.client);
+    evicted_.insert(victim.client);
+    stats_.resident_bytes -= victim.bytes;
+    stats_.resident_clients = entries_.size();
+    stats_.evictions++;
+    stats_.evicted_bytes += victim.bytes;
+
+    victim.client->EvictTextures();
+  }
+}
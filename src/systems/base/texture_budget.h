@@ -0,0 +1,130 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#ifndef SRC_SYSTEMS_BASE_TEXTURE_BUDGET_H_
+#define SRC_SYSTEMS_BASE_TEXTURE_BUDGET_H_
+
+#include <cstdint>
+#include <iosfwd>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+
+// Tracks how much video memory is held by uploaded textures and keeps it under
+// a byte budget.
+//
+// Surfaces keep their textures for as long as they live, and surfaces are
+// kept alive by the image cache, preloaded G00 slots, HIK scripts and
+// objects. Each surface that uploads textures registers here with the number
+// of bytes it holds. When the total goes over the budget, the surfaces that
+// were least recently rendered are told to drop their textures, and they
+// upload them again the next time they're drawn. Surfaces drawn during the
+// current frame are never evicted, so a single frame that needs more than the
+// budget still draws correctly.
+class TextureBudget {
+ public:
+  // Something that holds textures on behalf of the budget.
+  class Client {
+   public:
+    virtual ~Client();
+
+    // Releases all video memory. The client must not call back into the
+    // TextureBudget from here; it has already been removed.
+    virtual void EvictTextures() = 0;
+  };
+
+  struct Stats {
+    Stats();
+
+    // Bytes held by registered clients right now, and the high-water mark.
+    uint64_t resident_bytes;
+    uint64_t peak_bytes;
+    int resident_clients;
+
+    // How many clients were evicted, and how many bytes that freed.
+    uint64_t evictions;
+    uint64_t evicted_bytes;
+
+    // Uploads by clients that weren't resident, and how many of those were
+    // clients that had been evicted earlier.
+    uint64_t uploads;
+    uint64_t reuploads;
+  };
+
+  // |max_bytes| of zero means unlimited.
+  explicit TextureBudget(uint64_t max_bytes);
+  ~TextureBudget();
+
+  uint64_t max_bytes() const { return max_bytes_; }
+  void set_max_bytes(uint64_t max_bytes);
+
+  const Stats& stats() const { return stats_; }
+
+  // Starts a new frame. Clients touched before this call become evictable.
+  void BeginFrame();
+
+  // Records that |client| now holds |bytes| of textures and is in use this
+  // frame, then evicts other clients if that put us over budget.
+  void Upload(Client* client, uint64_t bytes);
+
+  // Marks |client| as used this frame. Does nothing if it isn't resident.
+  void Touch(Client* client);
+
+  // Forgets |client|. Called when it frees its textures on its own.
+  void Remove(Client* client);
+
+  bool IsResident(Client* client) const;
+
+  // Writes a human readable summary of |stats_|.
+  void WriteReport(std::ostream& os) const;
+
+ private:
+  struct Entry {
+    Client* client;
+    uint64_t bytes;
+    uint64_t last_frame;
+  };
+  typedef std::list<Entry> EntryList;
+
+  // Evicts the least recently used clients until we fit in |max_bytes_| or
+  // only clients used this frame are left.
+  void Trim();
+
+  uint64_t max_bytes_;
+  uint64_t current_frame_;
+
+  // Most recently used at the front.
+  EntryList lru_;
+  std::unordered_map<Client*, EntryList::iterator> entries_;
+
+  // Clients that were evicted and haven't uploaded since.
+  std::unordered_set<Client*> evicted_;
+
+  Stats stats_;
+};
+
+#endif  // SRC_SYSTEMS_BASE_TEXTURE_BUDGET_H_
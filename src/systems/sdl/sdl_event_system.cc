@@ -29,6 +29,9 @@
 
 #include <SDL/SDL.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <functional>
 
 #include "machine/rlmachine.h"
@@ -39,6 +42,87 @@
 using std::bind;
 using std::placeholders::_1;
 
+namespace {
+
+// Converts the SDL events that carry player input to and from InputEvents
+// for recording and replay. Returns false for any other kind of event.
+bool ToInputEvent(const SDL_Event& event, InputEvent* input) {
+  switch (event.type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+      *input = InputEvent(event.type == SDL_KEYDOWN ? InputEvent::KEY_DOWN
+                                                    : InputEvent::KEY_UP,
+                          event.key.keysym.sym,
+                          Point(),
+                          event.key.keysym.mod);
+      return true;
+    case SDL_MOUSEMOTION:
+      *input = InputEvent(InputEvent::MOUSE_MOTION,
+                          0,
+                          Point(event.motion.x, event.motion.y),
+                          0);
+      return true;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+      *input = InputEvent(event.type == SDL_MOUSEBUTTONDOWN
+                              ? InputEvent::MOUSE_DOWN
+                              : InputEvent::MOUSE_UP,
+                          event.button.button,
+                          Point(event.button.x, event.button.y),
+                          0);
+      return true;
+    case SDL_ACTIVEEVENT:
+      *input = InputEvent(event.active.gain ? InputEvent::FOCUS_GAINED
+                                            : InputEvent::FOCUS_LOST,
+                          event.active.state,
+                          Point(),
+                          0);
+      return true;
+    default:
+      return false;
+  }
+}
+
+SDL_Event ToSDLEvent(const InputEvent& input) {
+  SDL_Event event;
+  memset(&event, 0, sizeof(event));
+  switch (input.type) {
+    case InputEvent::KEY_DOWN:
+    case InputEvent::KEY_UP:
+      event.type =
+          input.type == InputEvent::KEY_DOWN ? SDL_KEYDOWN : SDL_KEYUP;
+      event.key.state =
+          input.type == InputEvent::KEY_DOWN ? SDL_PRESSED : SDL_RELEASED;
+      event.key.keysym.sym = static_cast<SDLKey>(input.code);
+      event.key.keysym.mod = static_cast<SDLMod>(input.modifiers);
+      break;
+    case InputEvent::MOUSE_MOTION:
+      event.type = SDL_MOUSEMOTION;
+      event.motion.x = input.position.x();
+      event.motion.y = input.position.y();
+      break;
+    case InputEvent::MOUSE_DOWN:
+    case InputEvent::MOUSE_UP:
+      event.type = input.type == InputEvent::MOUSE_DOWN ? SDL_MOUSEBUTTONDOWN
+                                                        : SDL_MOUSEBUTTONUP;
+      event.button.state =
+          input.type == InputEvent::MOUSE_DOWN ? SDL_PRESSED : SDL_RELEASED;
+      event.button.button = input.code;
+      event.button.x = input.position.x();
+      event.button.y = input.position.y();
+      break;
+    case InputEvent::FOCUS_GAINED:
+    case InputEvent::FOCUS_LOST:
+      event.type = SDL_ACTIVEEVENT;
+      event.active.gain = input.type == InputEvent::FOCUS_GAINED;
+      event.active.state = input.code;
+      break;
+  }
+  return event;
+}
+
+}  // namespace
+
 SDLEventSystem::SDLEventSystem(SDLSystem& sys, Gameexe& gexe)
     : EventSystem(gexe),
       shift_pressed_(false),
@@ -49,53 +133,72 @@ SDLEventSystem::SDLEventSystem(SDLSystem& sys, Gameexe& gexe)
       button2_state_(0),
       last_get_currsor_time_(0),
       last_mouse_move_time_(0),
+      start_time_(std::chrono::steady_clock::now()),
       system_(sys),
       raw_handler_(NULL) {}
 
 void SDLEventSystem::ExecuteEventSystem(RLMachine& machine) {
   SDL_Event event;
   while (SDL_PollEvent(&event)) {
-    switch (event.type) {
-      case SDL_KEYDOWN: {
-        if (raw_handler_)
-          raw_handler_->pushInput(event);
-        else
-          HandleKeyDown(machine, event);
-        break;
-      }
-      case SDL_KEYUP: {
-        if (raw_handler_)
-          raw_handler_->pushInput(event);
-        else
-          HandleKeyUp(machine, event);
-        break;
-      }
-      case SDL_MOUSEMOTION: {
-        if (raw_handler_)
-          raw_handler_->pushInput(event);
-        HandleMouseMotion(machine, event);
-        break;
-      }
-      case SDL_MOUSEBUTTONDOWN:
-      case SDL_MOUSEBUTTONUP: {
-        if (raw_handler_)
-          raw_handler_->pushInput(event);
-        else
-          HandleMouseButtonEvent(machine, event);
-        break;
-      }
-      case SDL_QUIT:
-        machine.Halt();
-        break;
-      case SDL_ACTIVEEVENT:
-        if (raw_handler_)
-          raw_handler_->pushInput(event);
-        HandleActiveEvent(machine, event);
-        break;
-      case SDL_VIDEOEXPOSE: {
-        machine.system().graphics().ForceRefresh();
-        break;
-      }
+    // While replaying, live input is ignored except for quitting.
+    if (replaying_input() && event.type != SDL_QUIT &&
+        event.type != SDL_VIDEOEXPOSE)
+      continue;
+
+    InputEvent input;
+    if (recording_input() && ToInputEvent(event, &input))
+      RecordInput(input);
+
+    HandleEvent(machine, event);
+  }
+
+  for (const InputEvent& input : GetReplayedInput()) {
+    SDL_Event replayed = ToSDLEvent(input);
+    HandleEvent(machine, replayed);
+  }
+}
+
+void SDLEventSystem::HandleEvent(RLMachine& machine, SDL_Event& event) {
+  switch (event.type) {
+    case SDL_KEYDOWN: {
+      if (raw_handler_)
+        raw_handler_->pushInput(event);
+      else
+        HandleKeyDown(machine, event);
+      break;
+    }
+    case SDL_KEYUP: {
+      if (raw_handler_)
+        raw_handler_->pushInput(event);
+      else
+        HandleKeyUp(machine, event);
+      break;
+    }
+    case SDL_MOUSEMOTION: {
+      if (raw_handler_)
+        raw_handler_->pushInput(event);
+      HandleMouseMotion(machine, event);
+      break;
+    }
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP: {
+      if (raw_handler_)
+        raw_handler_->pushInput(event);
+      else
+        HandleMouseButtonEvent(machine, event);
+      break;
+    }
+    case SDL_QUIT:
+      machine.Halt();
+      break;
+    case SDL_ACTIVEEVENT:
+      if (raw_handler_)
+        raw_handler_->pushInput(event);
+      HandleActiveEvent(machine, event);
+      break;
+    case SDL_VIDEOEXPOSE: {
+      machine.system().graphics().ForceRefresh();
+      break;
     }
   }
 }
@@ -125,12 +228,48 @@ unsigned int SDLEventSystem::TimeOfLastMouseMove() {
   return last_mouse_move_time_;
 }
 
-unsigned int SDLEventSystem::GetTicks() const { return SDL_GetTicks(); }
+unsigned int SDLEventSystem::GetTicks() const {
+  return GetMicroseconds() / 1000;
+}
+
+uint64_t SDLEventSystem::GetMicroseconds() const {
+  // While recording or replaying, time only moves between frames, so the
+  // interpreter sees the same times in both runs.
+  if (recording_input() || replaying_input())
+    return frame_time_us();
+
+  return GetLiveMicroseconds();
+}
+
+uint64_t SDLEventSystem::GetLiveMicroseconds() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start_time_).count();
+}
 
 void SDLEventSystem::Wait(unsigned int milliseconds) const {
   SDL_Delay(milliseconds);
 }
 
+void SDLEventSystem::WaitForEvents(unsigned int ticks) {
+  // SDL 1.2 has no timed event wait, so sleep in short slices and check the
+  // queue between them. Pumping an empty queue is cheap compared to a pass
+  // through the game loop, and the slice bounds input latency.
+  const unsigned int kSliceMs = 2;
+
+  SDL_Event event;
+  while (true) {
+    SDL_PumpEvents();
+    if (SDL_PeepEvents(&event, 1, SDL_PEEKEVENT, SDL_ALLEVENTS) > 0)
+      return;
+
+    unsigned int now = GetLiveMicroseconds() / 1000;
+    if (now >= ticks)
+      return;
+
+    SDL_Delay(std::min(ticks - now, kSliceMs));
+  }
+}
+
 bool SDLEventSystem::ShiftPressed() const { return shift_pressed_; }
 
 void SDLEventSystem::InjectMouseMovement(RLMachine& machine, const Point& loc) {
@@ -221,6 +360,14 @@ void SDLEventSystem::HandleKeyUp(RLMachine& machine, SDL_Event& event) {
       machine.system().ShowSystemInfo(machine);
       break;
     }
+    case SDLK_F10: {
+      machine.system().DumpFrameTelemetry(machine);
+      break;
+    }
+    case SDLK_F11: {
+      machine.system().graphics().ToggleTelemetryOverlay();
+      break;
+    }
     case SDLK_F12: {
       machine.system().DumpRenderTree(machine);
       break;
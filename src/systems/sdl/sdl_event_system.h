@@ -30,6 +30,8 @@
 
 #include <SDL/SDL_events.h>
 
+#include <chrono>
+
 #include "systems/base/event_system.h"
 #include "systems/base/rect.h"
 
@@ -59,7 +61,10 @@ class SDLEventSystem : public EventSystem {
   // Implementation of EventSystem:
   virtual void ExecuteEventSystem(RLMachine& machine) override;
   virtual unsigned int GetTicks() const override;
+  virtual uint64_t GetMicroseconds() const override;
+  virtual uint64_t GetLiveMicroseconds() const override;
   virtual void Wait(unsigned int milliseconds) const override;
+  virtual void WaitForEvents(unsigned int ticks) override;
   virtual bool ShiftPressed() const override;
   virtual bool CtrlPressed() const override;
   virtual Point GetCursorPos() override;
@@ -78,6 +83,9 @@ class SDLEventSystem : public EventSystem {
   // than 10ms since the last GetCursorPos() call.
   void PreventCursorPosSpinning();
 
+  // Dispatches one live or replayed event to the handlers below.
+  void HandleEvent(RLMachine& machine, SDL_Event& event);
+
   // RealLive event system commands
   void HandleKeyDown(RLMachine& machine, SDL_Event& event);
   void HandleKeyUp(RLMachine& machine, SDL_Event& event);
@@ -100,6 +108,10 @@ class SDLEventSystem : public EventSystem {
   // The last time we received a mouse move notification.
   unsigned int last_mouse_move_time_;
 
+  // When this event system was created. GetLiveMicroseconds() counts from
+  // here.
+  std::chrono::steady_clock::time_point start_time_;
+
   // Our owning system.
   SDLSystem& system_;
 
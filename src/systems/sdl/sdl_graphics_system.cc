@@ -49,15 +49,18 @@
 #include "base/notification_source.h"
 #include "libreallive/gameexe.h"
 #include "machine/rlmachine.h"
+#include "systems/base/asset_pack.h"
 #include "systems/base/cgm_table.h"
 #include "systems/base/colour.h"
 #include "systems/base/event_system.h"
+#include "systems/base/frame_telemetry.h"
 #include "systems/base/graphics_object.h"
 #include "systems/base/mouse_cursor.h"
 #include "systems/base/renderable.h"
 #include "systems/base/system.h"
 #include "systems/base/system_error.h"
 #include "systems/base/text_system.h"
+#include "systems/base/texture_budget.h"
 #include "systems/base/tone_curve.h"
 #include "systems/sdl/sdl_colour_filter.h"
 #include "systems/sdl/sdl_event_system.h"
@@ -83,6 +86,8 @@ void SDLGraphicsSystem::SetCursor(int cursor) {
 }
 
 void SDLGraphicsSystem::BeginFrame() {
+  texture_budget()->BeginFrame();
+
   glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
   DebugShowGLErrors();
@@ -148,6 +153,8 @@ void SDLGraphicsSystem::EndFrame() {
   DrawCursor();
 
   // Swap the buffers
+  FrameTelemetry::ScopedPhase swap(system().telemetry(),
+                                   FrameTelemetry::PHASE_SWAP);
   glFlush();
   SDL_GL_SwapBuffers();
   ShowGLErrors();
@@ -185,9 +192,10 @@ void SDLGraphicsSystem::RedrawLastFrame() {
 
     DrawCursor();
 
-    glFlush();
-
     // Swap the buffers
+    FrameTelemetry::ScopedPhase swap(system().telemetry(),
+                                     FrameTelemetry::PHASE_SWAP);
+    glFlush();
     SDL_GL_SwapBuffers();
     ShowGLErrors();
   }
@@ -239,9 +247,10 @@ SDLGraphicsSystem::SDLGraphicsSystem(System& system, Gameexe& gameexe)
   SetupVideo();
 
   // Now we allocate the first two display contexts with equal size to
-  // the display
+  // the display. DC0 is drawn every frame, so only DC1 can wait for pixels
+  // until it's written to.
   display_contexts_[0]->allocate(screen_size(), true);
-  display_contexts_[1]->allocate(screen_size());
+  display_contexts_[1]->allocateLazily(screen_size());
 
   SetWindowTitle();
 
@@ -373,7 +382,8 @@ SDLGraphicsSystem::~SDLGraphicsSystem() {}
 void SDLGraphicsSystem::ExecuteGraphicsSystem(RLMachine& machine) {
   // For now, nothing, but later, we need to put all code each cycle
   // here.
-  if (is_responsible_for_update() && screen_needs_refresh()) {
+  if (is_responsible_for_update() &&
+      IsPresentDue(machine.system().event().frame_ticks())) {
     Refresh(NULL);
     OnScreenRefreshed();
     redraw_last_frame_ = false;
@@ -424,6 +434,7 @@ void SDLGraphicsSystem::Observe(NotificationType type,
                                 const NotificationSource& source,
                                 const NotificationDetails& details) {
   Shaders::Reset();
+  Texture::ResetPixelBuffers();
 }
 
 void SDLGraphicsSystem::SetWindowSubtitle(const std::string& cp932str,
@@ -455,15 +466,15 @@ void SDLGraphicsSystem::AllocateDC(int dc, Size size) {
   // DC 1 is a special case and must always be at least the size of
   // the screen.
   if (dc == 1) {
-    SDL_Surface* dc0 = *(display_contexts_[0]);
-    if (size.width() < dc0->w)
-      size.set_width(dc0->w);
-    if (size.height() < dc0->h)
-      size.set_height(dc0->h);
+    Size dc0 = display_contexts_[0]->GetSize();
+    if (size.width() < dc0.width())
+      size.set_width(dc0.width());
+    if (size.height() < dc0.height())
+      size.set_height(dc0.height());
   }
 
   // Allocate a new obj.
-  display_contexts_[dc]->allocate(size);
+  display_contexts_[dc]->allocateLazily(size);
 }
 
 void SDLGraphicsSystem::SetMinimumSizeForDC(int dc, Size size) {
@@ -476,7 +487,7 @@ void SDLGraphicsSystem::SetMinimumSizeForDC(int dc, Size size) {
       Size maxSize = current.SizeUnion(size);
 
       std::shared_ptr<SDLSurface> newdc(new SDLSurface(this));
-      newdc->allocate(maxSize);
+      newdc->allocateLazily(maxSize);
 
       display_contexts_[dc]->BlitToSurface(
           *newdc, display_contexts_[dc]->GetRect(),
@@ -498,6 +509,43 @@ void SDLGraphicsSystem::FreeDC(int dc) {
   }
 }
 
+void SDLGraphicsSystem::WriteMemoryReport(std::ostream& os) const {
+  GraphicsSystem::WriteMemoryReport(os);
+
+  const double kBytesPerKilobyte = 1024.0;
+  uint64_t total_pixels = 0, total_textures = 0;
+  os << std::endl;
+  for (int i = 0; i < 16; ++i) {
+    SDLSurface& dc = *display_contexts_[i];
+    os << "DC" << i << ": ";
+    if (!dc.allocated()) {
+      os << "unallocated" << std::endl;
+      continue;
+    }
+
+    Size size = dc.GetSize();
+    os << size.width() << "x" << size.height() << ", ";
+    if (dc.is_constant()) {
+      const RGBAColour& colour = dc.constant_colour();
+      os << "no pixels, reads as (" << colour.r() << ", " << colour.g()
+         << ", " << colour.b() << ", " << colour.a() << ")";
+    } else {
+      os << dc.GetPixelBytes() / kBytesPerKilobyte << " KB pixels";
+      if (dc.is_shared())
+        os << " (shared)";
+      else
+        total_pixels += dc.GetPixelBytes();
+    }
+    os << ", " << dc.GetTextureBytes() / kBytesPerKilobyte << " KB textures"
+       << std::endl;
+    total_textures += dc.GetTextureBytes();
+  }
+
+  os << "DC total: " << total_pixels / kBytesPerKilobyte
+     << " KB unshared pixels, " << total_textures / kBytesPerKilobyte
+     << " KB textures" << std::endl;
+}
+
 void SDLGraphicsSystem::VerifySurfaceExists(int dc, const std::string& caller) {
   if (dc >= 16) {
     std::ostringstream ss;
@@ -579,23 +627,34 @@ std::shared_ptr<const Surface> SDLGraphicsSystem::LoadSurfaceFromFile(
     throw rlvm::Exception(oss.str());
   }
 
-  // Glue code to allow my stuff to work with Jagarl's loader
-  FILE* file = fopen(filename.string().c_str(), "rb");
-  if (!file) {
-    std::ostringstream oss;
-    oss << "Could not open file: " << filename;
-    throw rlvm::Exception(oss.str());
-  }
+  // Glue code to allow my stuff to work with Jagarl's loader. Images in the
+  // asset pack are decoded straight out of the mapping.
+  std::unique_ptr<char[]> d;
+  const char* data;
+  size_t size;
+  AssetPack::Asset asset;
+  if (AssetPack::FindPath(filename, &asset)) {
+    data = asset.data;
+    size = asset.size;
+  } else {
+    FILE* file = fopen(filename.string().c_str(), "rb");
+    if (!file) {
+      std::ostringstream oss;
+      oss << "Could not open file: " << filename;
+      throw rlvm::Exception(oss.str());
+    }
 
-  fseek(file, 0, SEEK_END);
-  size_t size = ftell(file);
-  std::unique_ptr<char[]> d(new char[size + 1]);
-  fseek(file, 0, SEEK_SET);
-  fread(d.get(), size, 1, file);
-  fclose(file);
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    d.reset(new char[size + 1]);
+    fseek(file, 0, SEEK_SET);
+    fread(d.get(), size, 1, file);
+    fclose(file);
+    data = d.get();
+  }
 
   std::unique_ptr<GRPCONV> conv(
-      GRPCONV::AssignConverter(d.get(), size, "???"));
+      GRPCONV::AssignConverter(data, size, "???"));
   if (conv == 0) {
     throw SystemError("Failure in GRPCONV.");
   }
@@ -662,7 +721,7 @@ std::shared_ptr<const Surface> SDLGraphicsSystem::LoadSurfaceFromFile(
 }
 
 std::shared_ptr<Surface> SDLGraphicsSystem::GetHaikei() {
-  if (haikei_->rawSurface() == NULL) {
+  if (!haikei_->allocated()) {
     haikei_->allocate(screen_size(), true);
   }
 
@@ -673,7 +732,7 @@ std::shared_ptr<Surface> SDLGraphicsSystem::GetDC(int dc) {
   VerifySurfaceExists(dc, "SDLGraphicsSystem::get_dc");
 
   // If requesting a DC that doesn't exist, allocate it first.
-  if (display_contexts_[dc]->rawSurface() == NULL)
+  if (!display_contexts_[dc]->allocated())
     AllocateDC(dc, display_contexts_[0]->GetSize());
 
   return display_contexts_[dc];
@@ -88,6 +88,9 @@ class SDLGraphicsSystem : public GraphicsSystem, public NotificationObserver {
 
   virtual ColourFilter* BuildColourFiller() override;
 
+  // Adds the pixel and texture memory held by each DC.
+  virtual void WriteMemoryReport(std::ostream& os) const override;
+
   // -----------------------------------------------------------------------
 
   virtual void SetWindowSubtitle(const std::string& cp932str,
@@ -30,6 +30,7 @@
 #include <SDL/SDL_mixer.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <map>
@@ -38,8 +39,11 @@
 #include <utility>
 #include <vector>
 
+#include "systems/base/asset_pack.h"
+#include "systems/base/pcm_cache.h"
 #include "systems/base/system.h"
 #include "systems/sdl/sdl_audio_locker.h"
+#include "systems/sdl/sdl_sound_chunk.h"
 #include "utilities/exception.h"
 
 namespace fs = boost::filesystem;
@@ -62,7 +66,8 @@ SDLMusic::SDLMusic(const SoundSystem::DSTrack& track, WAVFILE* wav)
       track_(track),
       fadetime_total_(0),
       fade_in_ms_(0),
-      music_paused_(false) {
+      music_paused_(false),
+      mixer_(BgmGain()) {
   // Advance the audio stream to the starting point
   if (track.from > 0)
     wav->Seek(track.from);
@@ -104,6 +109,9 @@ void SDLMusic::FadeIn(bool loop, int fade_in_ms) {
 
   fade_count_ = 0;
   fade_in_ms_ = fade_in_ms;
+  // Start from silence only when fading in; otherwise the first buffer would
+  // swell up from wherever the gain was left.
+  mixer_.SetGain(fade_in_ms > 0 ? 0.0f : BgmGain());
   s_currently_playing = shared_from_this();
 }
 
@@ -125,11 +133,18 @@ void SDLMusic::Unpause() {
   music_paused_ = false;
 }
 
+// static
+float SDLMusic::BgmGain() {
+  return s_computed_bgm_vol / static_cast<float>(SDL_MIX_MAXVOLUME);
+}
+
 std::string SDLMusic::GetName() const {
   SDLAudioLocker locker;
   return track_.name;
 }
 
+int SDLMusic::TakePeakLevel() { return mixer_.TakePeakLevel(); }
+
 int SDLMusic::BgmStatus() const {
   SDLAudioLocker locker;
 
@@ -164,15 +179,23 @@ void SDLMusic::MixMusic(void* udata, Uint8* stream, int len) {
     }
   }
 
-  int cur_vol = s_computed_bgm_vol;
-  // Compute in fadetime results.
+  int frames = len / 4;
+  float gain = BgmGain();
+  int ramp_frames = frames;
+  // Compute in fadetime results. |gain| is the gain the mixer ramps to from
+  // where the last buffer ended, over |ramp_frames|. A fade that ends inside
+  // this buffer is ramped over just its remaining frames.
   if (music->fade_in_ms_) {
     int count_total = music->fade_in_ms_ * (WAVFILE::freq / 1000);
     if (music->fade_count_ > count_total) {
       music->fade_in_ms_ = 0;
     } else {
-      cur_vol = cur_vol * (music->fade_count_) / count_total;
-      music->fade_count_ += len / 4;
+      int remaining = count_total - music->fade_count_;
+      music->fade_count_ += frames;
+      if (remaining < frames)
+        ramp_frames = remaining;
+      else
+        gain = gain * music->fade_count_ / count_total;
     }
   } else if (music->fadetime_total_) {
     int count_total = music->fadetime_total_ * (WAVFILE::freq / 1000);
@@ -183,16 +206,15 @@ void SDLMusic::MixMusic(void* udata, Uint8* stream, int len) {
       return;
     }
 
-    cur_vol = cur_vol * (count_total - music->fade_count_) / count_total;
-    music->fade_count_ += len / 4;
+    int remaining = count_total - music->fade_count_;
+    music->fade_count_ += frames;
+    gain = gain * std::max(count_total - music->fade_count_, 0) / count_total;
+    if (remaining < frames)
+      ramp_frames = remaining;
   }
 
-  if (cur_vol != SDL_MIX_MAXVOLUME) {
-    char stream_dup[len];  // NOLINT
-    memcpy(stream_dup, stream, len);
-    memset(stream, 0, len);
-    SDL_MixAudio(stream, (Uint8*)stream_dup, len, cur_vol);
-  }
+  music->mixer_.RampTo(gain, ramp_frames);
+  SDLSoundChunk::ApplyMixerChannel(music->mixer_, stream, len);
 }
 
 template <typename TYPE>
@@ -200,14 +222,37 @@ WAVFILE* BuildMusicImplementation(FILE* file, int size) {
   return WAVFILE::MakeConverter(new TYPE(file, size));
 }
 
+// Opens |path| and builds a decoder for it with |builder|. Returns NULL if the
+// file can't be opened.
+static WAVFILE* OpenMusicFile(
+    const std::string& path,
+    const std::function<WAVFILE*(FILE*, int)>& builder) {
+  FILE* f = AssetPack::OpenStream(path);
+  if (f == 0)
+    return NULL;
+
+  fseek(f, 0, SEEK_END);
+  int size = ftell(f);
+  rewind(f);
+
+  return builder(f, size);
+}
+
 std::shared_ptr<SDLMusic> SDLMusic::CreateMusic(
     System& system,
-    const SoundSystem::DSTrack& track) {
-  typedef std::vector<
-    std::pair<std::string, std::function<WAVFILE*(FILE*, int)>>> FileTypes;
-  static FileTypes types = {{"wav", &BuildMusicImplementation<WAVFILE_Stream>},
-                            {"nwa", &BuildMusicImplementation<NWAFILE>},
-                            {"ogg", &BuildMusicImplementation<OggFILE>}};
+    const SoundSystem::DSTrack& track,
+    PCMCache* cache) {
+  typedef std::function<WAVFILE*(FILE*, int)> Builder;
+  struct FileType {
+    std::string extension;
+    Builder builder;
+    // Whether decoding is expensive enough to be worth caching the PCM.
+    bool cacheable;
+  };
+  static std::vector<FileType> types = {
+      {"wav", &BuildMusicImplementation<WAVFILE_Stream>, false},
+      {"nwa", &BuildMusicImplementation<NWAFILE>, true},
+      {"ogg", &BuildMusicImplementation<OggFILE>, true}};
 
   fs::path file_path = system.FindFile(track.file, SOUND_FILETYPES);
   if (file_path.empty()) {
@@ -217,22 +262,35 @@ std::shared_ptr<SDLMusic> SDLMusic::CreateMusic(
   }
 
   const std::string& raw_path = file_path.native();
-  for (FileTypes::const_iterator it = types.begin(); it != types.end(); ++it) {
-    if (boost::iends_with(raw_path, it->first)) {
-      FILE* f = fopen(raw_path.c_str(), "r");
-      if (f == 0) {
+  for (const FileType& type : types) {
+    if (boost::iends_with(raw_path, type.extension)) {
+      // The cache is keyed on the source file's modification time, which
+      // tracks inside a pack don't have.
+      AssetPack::Asset asset;
+      bool use_cache = type.cacheable && cache && cache->enabled() &&
+                       !AssetPack::FindPath(file_path, &asset);
+      if (use_cache) {
+        WAVFILE* cached = cache->Open(file_path);
+        if (cached)
+          return std::shared_ptr<SDLMusic>(new SDLMusic(track, cached));
+      }
+
+      WAVFILE* w = OpenMusicFile(raw_path, type.builder);
+      if (w == NULL) {
         std::ostringstream oss;
         oss << "Could not open \"" << file_path << "\" for reading.";
         throw std::runtime_error(oss.str());
       }
 
-      fseek(f, 0, SEEK_END);
-      int size = ftell(f);
-      rewind(f);
+      if (use_cache) {
+        Builder builder = type.builder;
+        cache->Populate(file_path,
+                        [raw_path, builder]() {
+                          return OpenMusicFile(raw_path, builder);
+                        });
+      }
 
-      WAVFILE* w = it->second(f, size);
-      if (w)
-        return std::shared_ptr<SDLMusic>(new SDLMusic(track, w));
+      return std::shared_ptr<SDLMusic>(new SDLMusic(track, w));
     }
   }
 
@@ -33,9 +33,12 @@
 #include <memory>
 #include <string>
 
+#include "systems/base/sound_mixer.h"
 #include "systems/base/sound_system.h"
 #include "xclannad/wavfile.h"
 
+class PCMCache;
+
 // Encapsulates access to SDLMussic.
 //
 // This system is the way it is for a good reason. The first shot of
@@ -71,15 +74,20 @@ class SDLMusic : public std::enable_shared_from_this<SDLMusic> {
   void Unpause();
   std::string GetName() const;
 
+  // Returns the peak output level since the last call, in [0, 32767].
+  int TakePeakLevel();
+
   // Returns the current playing status of the current track. Uses the
   // same return codes as SoundSystem::bgmStatus().
   int BgmStatus() const;
 
   // Creates a MusicImpl object from the incoming description of the
-  // music.
+  // music. NWA and Ogg tracks are streamed from |cache| when it has them, and
+  // are queued for decoding into it when it doesn't. |cache| may be NULL.
   static std::shared_ptr<SDLMusic> CreateMusic(
       System& system,
-      const SoundSystem::DSTrack& track);
+      const SoundSystem::DSTrack& track,
+      PCMCache* cache = NULL);
 
   // Returns the currently playing SDLMusic object. Returns NULL if no
   // music is currently playing.
@@ -108,6 +116,9 @@ class SDLMusic : public std::enable_shared_from_this<SDLMusic> {
   // the static method WavChunk::callback in music2/music.cc.
   static void MixMusic(void* udata, Uint8* stream, int len);
 
+  // The gain that s_computed_bgm_vol maps to.
+  static float BgmGain();
+
   // Strongly coupled because of access to SDLMusic::MixMusic.
   friend class SDLSoundSystem;
 
@@ -132,6 +143,11 @@ class SDLMusic : public std::enable_shared_from_this<SDLMusic> {
   // Whether the music is currently paused.
   bool music_paused_;
 
+  // Applies the volume and fades to the decoded stream. MixMusic() sets a new
+  // target gain for each buffer and the gain is ramped per sample, reaching
+  // the target early when a fade ends partway through the buffer.
+  MixerChannel mixer_;
+
   // The currently playing track.
   static std::shared_ptr<SDLMusic> s_currently_playing;
 
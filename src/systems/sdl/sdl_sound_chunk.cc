@@ -29,13 +29,30 @@
 
 #include <SDL/SDL_mixer.h>
 #include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <cstring>
 #include <string>
 
+#include "systems/base/asset_pack.h"
 #include "systems/base/sound_system.h"
 #include "systems/sdl/sdl_audio_locker.h"
 #include "xclannad/wavfile.h"
 
-SDLSoundChunk::PlayingTable SDLSoundChunk::s_playing_table;
+// How long a volume change on a playing channel is spread over.
+const int VOLUME_RAMP_MS = 5;
+
+// Size of the buffer each channel's samples are copied into for its gain
+// stage. A multiple of every frame size the audio device can be opened with.
+const int MIX_SCRATCH_BYTES = 4096;
+
+std::shared_ptr<SDLSoundChunk>
+    SDLSoundChunk::s_playing_table[NUM_TOTAL_CHANNELS];
+int SDLSoundChunk::s_position[NUM_TOTAL_CHANNELS];
+int SDLSoundChunk::s_loops[NUM_TOTAL_CHANNELS];
+MixerChannel SDLSoundChunk::s_mixer_channels[NUM_TOTAL_CHANNELS];
+float SDLSoundChunk::s_channel_gain[NUM_TOTAL_CHANNELS];
+bool SDLSoundChunk::s_fading_out[NUM_TOTAL_CHANNELS];
 
 SDLSoundChunk::SDLSoundChunk(const boost::filesystem::path& path)
     : sample_(LoadSample(path)) {}
@@ -54,7 +71,7 @@ Mix_Chunk* SDLSoundChunk::LoadSample(const boost::filesystem::path& path) {
     // Hack to load NWA sounds into a MixChunk. I was resisted doing this
     // because I assumed there was a better way, but this is essentially what
     // jagarl does in xclannad too :(
-    FILE* f = fopen(path.native().c_str(), "r");
+    FILE* f = AssetPack::OpenStream(path);
     if (!f)
       return NULL;
     int size = 0;
@@ -65,41 +82,106 @@ Mix_Chunk* SDLSoundChunk::LoadSample(const boost::filesystem::path& path) {
     delete[] data;
 
     return chunk;
-  } else {
-    return Mix_LoadWAV(path.native().c_str());
   }
+
+  AssetPack::Asset asset;
+  if (AssetPack::FindPath(path, &asset)) {
+    return Mix_LoadWAV_RW(
+        SDL_RWFromConstMem(asset.data, static_cast<int>(asset.size)), 1);
+  }
+
+  return Mix_LoadWAV(path.native().c_str());
 }
 
 void SDLSoundChunk::PlayChunkOn(int channel, int loops) {
-  {
-    SDLAudioLocker locker;
-    s_playing_table[channel] = shared_from_this();
-  }
+  SDLAudioLocker locker;
+  s_mixer_channels[channel].SetGain(s_channel_gain[channel]);
+  StartOn(channel, loops);
+}
+
+void SDLSoundChunk::FadeInChunkOn(int channel, int loops, int ms) {
+  SDLAudioLocker locker;
+  s_mixer_channels[channel].SetGain(0.0f);
+  s_mixer_channels[channel].RampTo(s_channel_gain[channel],
+                                   MillisecondsToFrames(ms));
+  StartOn(channel, loops);
+}
 
-  if (Mix_PlayChannel(channel, sample_, loops) == -1) {
+void SDLSoundChunk::StartOn(int channel, int loops) {
+  if (!sample_) {
     // TODO(erg): Throw something here.
+    FinishChannel(channel);
+    return;
   }
+
+  s_playing_table[channel] = shared_from_this();
+  s_position[channel] = 0;
+  s_loops[channel] = loops;
+  s_fading_out[channel] = false;
 }
 
-void SDLSoundChunk::FadeInChunkOn(int channel, int loops, int ms) {
-  {
-    SDLAudioLocker locker;
-    s_playing_table[channel] = shared_from_this();
+// static
+void SDLSoundChunk::MixChannels(void* udata, Uint8* stream, int len) {
+  // Inside an SDL_LockAudio() section set up by SDL_Mixer! Don't lock here!
+  for (int channel = 0; channel < NUM_TOTAL_CHANNELS; ++channel) {
+    int index = 0;
+    while (index < len && s_playing_table[channel]) {
+      int mixed = MixChannel(channel, stream + index,
+                             std::min(len - index, MIX_SCRATCH_BYTES));
+      index += mixed;
+    }
   }
+}
 
-  if (Mix_FadeInChannel(channel, sample_, loops, ms) == -1) {
-    // TODO(erg): Throw something here.
+// static
+int SDLSoundChunk::MixChannel(int channel, Uint8* stream, int len) {
+  // Copied out of the chunk so the gain stage doesn't modify the cached
+  // samples. Preallocated since this runs in the audio callback.
+  static Uint8 scratch[MIX_SCRATCH_BYTES];
+
+  Mix_Chunk* sample = s_playing_table[channel]->sample_;
+  int index = 0;
+  while (index < len) {
+    if (s_position[channel] >= static_cast<int>(sample->alen)) {
+      if (s_loops[channel] == 0 || sample->alen == 0) {
+        FinishChannel(channel);
+        break;
+      }
+
+      if (s_loops[channel] > 0)
+        --s_loops[channel];
+      s_position[channel] = 0;
+    }
+
+    int count = std::min(len - index,
+                         static_cast<int>(sample->alen) - s_position[channel]);
+    memcpy(scratch + index, sample->abuf + s_position[channel], count);
+    s_position[channel] += count;
+    index += count;
   }
+
+  ApplyMixerChannel(s_mixer_channels[channel], scratch, index);
+  SDL_MixAudio(stream, scratch, index, SDL_MIX_MAXVOLUME);
+
+  // A fade out is over once the gain stage has ramped down to silence.
+  if (s_fading_out[channel] && !s_mixer_channels[channel].IsRamping())
+    FinishChannel(channel);
+
+  return index;
 }
 
 // static
-void SDLSoundChunk::SoundChunkFinishedPlayback(int channel) {
-  // Don't need an SDLAudioLocker because we're in the audio callback right
-  // now.
-  //
+void SDLSoundChunk::FinishChannel(int channel) {
   // Decrease the refcount of the SDLSoundChunk that just finished
   // playing.
   s_playing_table[channel].reset();
+  s_fading_out[channel] = false;
+}
+
+// static
+bool SDLSoundChunk::IsPlaying(int channel) {
+  SDLAudioLocker locker;
+  return s_playing_table[channel].get() != 0;
 }
 
 // static
@@ -117,10 +199,68 @@ int SDLSoundChunk::FindNextFreeExtraChannel() {
 }
 
 // static
-void SDLSoundChunk::StopChannel(int channel) { Mix_HaltChannel(channel); }
+void SDLSoundChunk::StopChannel(int channel) {
+  SDLAudioLocker locker;
+  FinishChannel(channel);
+}
 
-void SDLSoundChunk::StopAllChannels() { Mix_HaltChannel(-1); }
+void SDLSoundChunk::StopAllChannels() {
+  SDLAudioLocker locker;
+  for (int i = 0; i < NUM_TOTAL_CHANNELS; ++i)
+    FinishChannel(i);
+}
 
+// static
 void SDLSoundChunk::FadeOut(const int channel, const int fadetime) {
-  Mix_FadeOutChannel(channel, fadetime);
+  SDLAudioLocker locker;
+  if (!s_playing_table[channel])
+    return;
+
+  if (fadetime <= 0) {
+    FinishChannel(channel);
+    return;
+  }
+
+  // Ramp the gain down; MixChannel() stops the channel once the ramp is done.
+  s_mixer_channels[channel].RampTo(0.0f, MillisecondsToFrames(fadetime));
+  s_fading_out[channel] = true;
+}
+
+// static
+void SDLSoundChunk::SetChannelGain(int channel, float gain) {
+  SDLAudioLocker locker;
+  s_channel_gain[channel] = gain;
+
+  // A volume change must not cancel a running fade out.
+  if (s_fading_out[channel])
+    return;
+
+  if (s_playing_table[channel]) {
+    s_mixer_channels[channel].RampTo(gain,
+                                     MillisecondsToFrames(VOLUME_RAMP_MS));
+  } else {
+    s_mixer_channels[channel].SetGain(gain);
+  }
+}
+
+// static
+int SDLSoundChunk::TakeChannelPeakLevel(int channel) {
+  return s_mixer_channels[channel].TakePeakLevel();
+}
+
+// static
+void SDLSoundChunk::ApplyMixerChannel(MixerChannel& mixer,
+                                      void* stream,
+                                      int len) {
+  // Mix_OpenAudio() is only ever asked for one of these two formats; anything
+  // else is passed through untouched.
+  if (WAVFILE::format == AUDIO_S16SYS)
+    mixer.Process(stream, len, MIXER_SAMPLE_S16, WAVFILE::channels);
+  else if (WAVFILE::format == AUDIO_S8)
+    mixer.Process(stream, len, MIXER_SAMPLE_S8, WAVFILE::channels);
+}
+
+// static
+int SDLSoundChunk::MillisecondsToFrames(int ms) {
+  return ms * (WAVFILE::freq / 1000);
 }
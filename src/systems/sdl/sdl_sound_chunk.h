@@ -32,9 +32,11 @@
 
 #include <SDL/SDL_mixer.h>
 
-#include <map>
 #include <memory>
 
+#include "systems/base/sound_mixer.h"
+#include "systems/base/sound_system.h"
+
 // -----------------------------------------------------------------------
 
 // Encapsulates a Mix_Chunk object. We do this so we can refcounting
@@ -49,19 +51,22 @@ class SDLSoundChunk : public std::enable_shared_from_this<SDLSoundChunk> {
 
   virtual ~SDLSoundChunk();
 
-  // Plays the chunk on the given channel. Wraps Mix_PlayChannel. Pass -1 to
-  // |loops| for infinite loops.
+  // Plays the chunk on the given channel, replacing whatever was playing
+  // there. The chunk plays |loops| + 1 times; pass -1 to |loops| for infinite
+  // loops.
   //
-  // This method should always be used instead of Mix_PlayChannel with a raw
-  // Mix_Chunk because we do additional bookkeeping to handle memory
-  // deallocation for when a chunk finishes.
+  // Chunks are mixed by MixChannels() rather than by SDL_mixer's channels,
+  // so this must be used instead of Mix_PlayChannel with a raw Mix_Chunk.
   void PlayChunkOn(int channel, int loops);
 
   // Fades a chunk in.
   void FadeInChunkOn(int channel, int loops, int ms);
 
-  // SDL_Mixer callback function passed in to Mix_ChannelFinished().
-  static void SoundChunkFinishedPlayback(int channel);
+  // SDL_mixer callback passed to Mix_SetPostMix(). Runs every playing
+  // channel through its MixerChannel and adds it to |stream|.
+  static void MixChannels(void* udata, Uint8* stream, int len);
+
+  static bool IsPlaying(int channel);
 
   static int FindNextFreeExtraChannel();
 
@@ -70,18 +75,57 @@ class SDLSoundChunk : public std::enable_shared_from_this<SDLSoundChunk> {
 
   static void FadeOut(const int channel, const int fadetime);
 
+  // Sets the volume of |channel| as a gain in [0, 1]. If something is playing
+  // on the channel, the change is ramped in over a few milliseconds instead
+  // of being applied in one step.
+  static void SetChannelGain(int channel, float gain);
+
+  // Returns the peak level on |channel| since the last call, in [0, 32767].
+  static int TakeChannelPeakLevel(int channel);
+
+  // Runs |mixer| over a buffer in the output format that the audio device was
+  // opened with. Must be called from inside the audio callback.
+  static void ApplyMixerChannel(MixerChannel& mixer, void* stream, int len);
+
+  // Converts a duration to a number of sample frames at the output rate.
+  static int MillisecondsToFrames(int ms);
+
  private:
+  // Starts this chunk on |channel|. Must be called under an SDLAudioLocker.
+  void StartOn(int channel, int loops);
+
+  // Mixes up to |len| bytes of |channel| into |stream|. Returns the number of
+  // bytes mixed, which is less than |len| only when the channel stops.
+  static int MixChannel(int channel, Uint8* stream, int len);
+
+  // Stops |channel| and releases its chunk. Must be called under an
+  // SDLAudioLocker or from inside the audio callback.
+  static void FinishChannel(int channel);
+
   // Used in the path constructor to actually create the Mix_Chunk, which
   // requires a hack for NWA support.
   Mix_Chunk* LoadSample(const boost::filesystem::path& path);
 
   // Static table which deliberately creates cycles. When a chunk
   // starts playing, it's associated with its channel ID in this table
-  // to make sure that SDLSoundChunk object isn't deallocated. The
-  // SDL_mixer callback, SoundChunkFinishedPlayback(), will reset the
-  // associate smart pointer.
-  typedef std::map<int, std::shared_ptr<SDLSoundChunk>> PlayingTable;
-  static PlayingTable s_playing_table;
+  // to make sure that SDLSoundChunk object isn't deallocated.
+  // FinishChannel() will reset the associate smart pointer. A channel is
+  // playing while its entry is set.
+  static std::shared_ptr<SDLSoundChunk> s_playing_table[NUM_TOTAL_CHANNELS];
+
+  // Read position in the playing chunk's samples, in bytes, and the number of
+  // times left to restart it (-1 for forever).
+  static int s_position[NUM_TOTAL_CHANNELS];
+  static int s_loops[NUM_TOTAL_CHANNELS];
+
+  // Gain stage and nominal volume for each channel. SDL_mixer's own channel
+  // volume is left at maximum; all volume and fade processing happens here.
+  static MixerChannel s_mixer_channels[NUM_TOTAL_CHANNELS];
+  static float s_channel_gain[NUM_TOTAL_CHANNELS];
+
+  // Whether a channel is in a FadeOut(). Volume changes are deferred until the
+  // next chunk starts, and the channel stops once its gain reaches zero.
+  static bool s_fading_out[NUM_TOTAL_CHANNELS];
 
   // Wrapped chunk
   Mix_Chunk* sample_;
@@ -93,8 +137,7 @@ class SDLSoundChunk : public std::enable_shared_from_this<SDLSoundChunk> {
 
 // -----------------------------------------------------------------------
 
-// Changes an incoming RealLive volume (0-256) to the range SDL_Mixer expects
-// (0-128).
-inline int realLiveVolumeToSDLMixerVolume(int in_vol) { return in_vol / 2; }
+// Changes an incoming RealLive volume (0-255) to a MixerChannel gain (0-1).
+inline float realLiveVolumeToGain(int in_vol) { return in_vol / 255.0f; }
 
 #endif  // SRC_SYSTEMS_SDL_SDL_SOUND_CHUNK_H_
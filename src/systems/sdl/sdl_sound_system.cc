@@ -31,9 +31,12 @@
 #include <SDL/SDL_mixer.h>
 #include <boost/algorithm/string/case_conv.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <algorithm>
 #include <sstream>
 #include <string>
 
+#include "libreallive/gameexe.h"
+#include "systems/base/event_system.h"
 #include "systems/base/system.h"
 #include "systems/base/system_error.h"
 #include "systems/base/voice_archive.h"
@@ -43,6 +46,9 @@
 
 namespace fs = boost::filesystem;
 
+// Default size limit of the decoded BGM cache, in megabytes.
+const int DEFAULT_PCM_CACHE_MB = 512;
+
 // -----------------------------------------------------------------------
 // RealLive Sound Qualities table
 // -----------------------------------------------------------------------
@@ -105,14 +111,14 @@ void SDLSoundSystem::WavPlayImpl(const std::string& wav_file,
 void SDLSoundSystem::SetChannelVolumeImpl(int channel) {
   int base = channel == KOE_CHANNEL ? GetKoeVolume_mod() : pcm_volume_mod();
   int adjusted = compute_channel_volume(GetChannelVolume(channel), base);
-  Mix_Volume(channel, realLiveVolumeToSDLMixerVolume(adjusted));
+  SDLSoundChunk::SetChannelGain(channel, realLiveVolumeToGain(adjusted));
 }
 
 std::shared_ptr<SDLMusic> SDLSoundSystem::LoadMusic(
     const std::string& bgm_name) {
   DSTable::const_iterator ds_it = ds_table().find(boost::to_lower_copy(bgm_name));
   if (ds_it != ds_table().end())
-    return SDLMusic::CreateMusic(system(), ds_it->second);
+    return SDLMusic::CreateMusic(system(), ds_it->second, pcm_cache_.get());
 
   CDTable::const_iterator cd_it = cd_table().find(boost::to_lower_copy(bgm_name));
   if (cd_it != cd_table().end()) {
@@ -159,15 +165,28 @@ SDLSoundSystem::SDLSoundSystem(System& system)
     WAVFILE::channels = channels;
   }
 
-  Mix_AllocateChannels(NUM_TOTAL_CHANNELS);
+  // Cache size is in megabytes; zero turns the cache off.
+  int pcm_cache_mb = system.gameexe()("__PCM_CACHE_SIZE")
+                         .ToInt(DEFAULT_PCM_CACHE_MB);
+  pcm_cache_.reset(new PCMCache(
+      system.GameSaveDirectory() / "pcm_cache",
+      static_cast<uint64_t>(std::max(pcm_cache_mb, 0)) * 1024 * 1024));
+
+  // Sound chunks are mixed by SDLSoundChunk after the music, with volume
+  // applied by each channel's MixerChannel. SDL_mixer's own channels are
+  // unused.
+  for (int i = 0; i < NUM_TOTAL_CHANNELS; ++i)
+    SetChannelVolumeImpl(i);
 
-  Mix_ChannelFinished(&SDLSoundChunk::SoundChunkFinishedPlayback);
+  Mix_SetPostMix(&SDLSoundChunk::MixChannels, NULL);
 
   SetMusicHook(NULL);
 }
 
 SDLSoundSystem::~SDLSoundSystem() {
   Mix_HookMusic(NULL, NULL);
+  Mix_SetPostMix(NULL, NULL);
+  SDLSoundChunk::StopAllChannels();
 
   Mix_CloseAudio();
   SDL_QuitSubSystem(SDL_INIT_AUDIO);
@@ -180,6 +199,10 @@ void SDLSoundSystem::ExecuteSoundSystem() {
     queued_music_->FadeIn(queued_music_loop_, queued_music_fadein_);
     queued_music_.reset();
   }
+
+  // Poll for the current track ending.
+  if (queued_music_)
+    system().event().ScheduleNextFrame();
 }
 
 void SDLSoundSystem::SetBgmEnabled(const int in) {
@@ -242,7 +265,7 @@ void SDLSoundSystem::WavPlay(const std::string& wav_file,
 
 bool SDLSoundSystem::WavPlaying(const int channel) {
   CheckChannel(channel, "SDLSoundSystem::wav_playing");
-  return Mix_Playing(channel);
+  return SDLSoundChunk::IsPlaying(channel);
 }
 
 void SDLSoundSystem::WavStop(const int channel) {
@@ -279,7 +302,7 @@ void SDLSoundSystem::PlaySe(const int se_num) {
     int channel = it->second.second;
 
     // Make sure there isn't anything playing on the current channel
-    Mix_HaltChannel(channel);
+    SDLSoundChunk::StopChannel(channel);
 
     if (file_name == "") {
       // Just stop a channel in case of an empty file name.
@@ -289,7 +312,7 @@ void SDLSoundSystem::PlaySe(const int se_num) {
     SDLSoundChunkPtr sample = GetSoundChunk(file_name, wav_cache_);
 
     // SE chunks have no volume other than the modifier.
-    Mix_Volume(channel, realLiveVolumeToSDLMixerVolume(se_volume_mod()));
+    SDLSoundChunk::SetChannelGain(channel, realLiveVolumeToGain(se_volume_mod()));
     sample->PlayChunkOn(channel, 0);
   }
 }
@@ -377,7 +400,20 @@ bool SDLSoundSystem::BgmLooping() const {
     return false;
 }
 
-bool SDLSoundSystem::KoePlaying() const { return Mix_Playing(KOE_CHANNEL); }
+int SDLSoundSystem::GetBgmPeakLevel() const {
+  std::shared_ptr<SDLMusic> currently_playing = SDLMusic::CurrnetlyPlaying();
+  if (currently_playing)
+    return currently_playing->TakePeakLevel();
+  else
+    return 0;
+}
+
+int SDLSoundSystem::GetChannelPeakLevel(const int channel) {
+  CheckChannel(channel, "SDLSoundSystem::GetChannelPeakLevel");
+  return SDLSoundChunk::TakeChannelPeakLevel(channel);
+}
+
+bool SDLSoundSystem::KoePlaying() const { return SDLSoundChunk::IsPlaying(KOE_CHANNEL); }
 
 void SDLSoundSystem::KoeStop() { SDLSoundChunk::StopChannel(KOE_CHANNEL); }
 
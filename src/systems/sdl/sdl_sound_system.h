@@ -34,6 +34,7 @@
 #include <memory>
 #include <string>
 
+#include "systems/base/pcm_cache.h"
 #include "systems/base/sound_system.h"
 #include "lru_cache.hpp"
 
@@ -88,6 +89,12 @@ class SDLSoundSystem : public SoundSystem {
 
   virtual void Reset() override;
 
+  // Peak meters. Return the highest absolute sample value (in [0, 32767])
+  // that was output on the music stream or on |channel| since the previous
+  // call.
+  int GetBgmPeakLevel() const;
+  int GetChannelPeakLevel(const int channel);
+
   // Wrapper around SDL_mixer's hook function. We do this because we need to
   // have our own default music mixing function which is set at startup.
   void SetMusicHook(void (*mix_func)(void* udata, Uint8* stream, int len));
@@ -127,6 +134,9 @@ class SDLSoundSystem : public SoundSystem {
   SoundChunkCache se_cache_;
   SoundChunkCache wav_cache_;
 
+  // Decoded BGM on disk, so looped and replayed tracks skip the decoder.
+  std::unique_ptr<PCMCache> pcm_cache_;
+
   // The music to play next as soon as the current track finishes.
   SDLMusicPtr queued_music_;
 
@@ -113,11 +113,12 @@ class ApplyColourTransformer : public ColourTransformer {
   RGBColour colour_;
 };
 
-// Applies a |transformer| to every pixel in |area| in the surface |surface|.
+// Applies a |transformer| to every pixel in |area| of |surface|, the pixels
+// of |our_surface|. Alpha is left alone.
 void TransformSurface(SDLSurface* our_surface,
+                      SDL_Surface* surface,
                       const Rect& area,
                       const ColourTransformer& transformer) {
-  SDL_Surface* surface = our_surface->rawSurface();
   SDL_Color colour;
   Uint32 col = 0;
 
@@ -195,6 +196,13 @@ SDL_Surface* buildNewSurface(const Size& size) {
   return tmp;
 }
 
+// Whether |format| is the one buildNewSurface() creates.
+static bool isNativeFormat(const SDL_PixelFormat* format) {
+  return format->BitsPerPixel == DefaultBpp && format->Rmask == DefaultRmask &&
+         format->Gmask == DefaultGmask && format->Bmask == DefaultBmask &&
+         format->Amask == DefaultAmask;
+}
+
 // -----------------------------------------------------------------------
 // SDLSurface::TextureRecord
 // -----------------------------------------------------------------------
@@ -256,9 +264,13 @@ void SDLSurface::TextureRecord::forceUnload() { texture.reset(); }
 
 SDLSurface::SDLSurface(SDLGraphicsSystem* system)
     : surface_(NULL),
+      is_lazy_(false),
+      is_constant_(false),
+      known_opaque_(false),
       texture_is_valid_(false),
       is_dc0_(false),
       graphics_system_(system),
+      texture_budget_(system ? system->texture_budget() : nullptr),
       is_mask_(false) {
   registerForNotification(system);
 }
@@ -267,9 +279,13 @@ SDLSurface::SDLSurface(SDLGraphicsSystem* system)
 
 SDLSurface::SDLSurface(SDLGraphicsSystem* system, SDL_Surface* surf)
     : surface_(surf),
+      is_lazy_(false),
+      is_constant_(false),
+      known_opaque_(false),
       texture_is_valid_(false),
       is_dc0_(false),
       graphics_system_(system),
+      texture_budget_(system ? system->texture_budget() : nullptr),
       is_mask_(false) {
   buildRegionTable(Size(surf->w, surf->h));
   registerForNotification(system);
@@ -282,10 +298,14 @@ SDLSurface::SDLSurface(SDLGraphicsSystem* system,
                        SDL_Surface* surf,
                        const std::vector<SDLSurface::GrpRect>& region_table)
     : surface_(surf),
+      is_lazy_(false),
+      is_constant_(false),
+      known_opaque_(false),
       region_table_(region_table),
       texture_is_valid_(false),
       is_dc0_(false),
       graphics_system_(system),
+      texture_budget_(system ? system->texture_budget() : nullptr),
       is_mask_(false) {
   registerForNotification(system);
 }
@@ -294,9 +314,13 @@ SDLSurface::SDLSurface(SDLGraphicsSystem* system,
 
 SDLSurface::SDLSurface(SDLGraphicsSystem* system, const Size& size)
     : surface_(NULL),
+      is_lazy_(false),
+      is_constant_(false),
+      known_opaque_(false),
       texture_is_valid_(false),
       is_dc0_(false),
       graphics_system_(system),
+      texture_budget_(system ? system->texture_budget() : nullptr),
       is_mask_(false) {
   allocate(size);
   buildRegionTable(size);
@@ -340,6 +364,9 @@ SDLSurface::~SDLSurface() { deallocate(); }
 // -----------------------------------------------------------------------
 
 Size SDLSurface::GetSize() const {
+  if (is_constant_)
+    return constant_size_;
+
   assert(surface_);
   return Size(surface_->w, surface_->h);
 }
@@ -351,6 +378,7 @@ void SDLSurface::Dump() {
   std::ostringstream ss;
   ss << "dump_" << count << ".bmp";
   count++;
+  ensureBacked();
   SDL_SaveBMP(surface_, ss.str().c_str());
 }
 
@@ -359,6 +387,9 @@ void SDLSurface::Dump() {
 void SDLSurface::allocate(const Size& size) {
   deallocate();
 
+  // An eagerly allocated surface keeps its pixels when filled.
+  is_lazy_ = false;
+
   surface_ = buildNewSurface(size);
 
   Fill(RGBAColour::Black());
@@ -373,12 +404,39 @@ void SDLSurface::allocate(const Size& size, bool is_dc0) {
 
 // -----------------------------------------------------------------------
 
+void SDLSurface::allocateLazily(const Size& size) {
+  deallocate();
+
+  is_lazy_ = true;
+  is_constant_ = true;
+  texture_is_valid_ = false;
+  constant_colour_ = RGBAColour::Black();
+  constant_size_ = size;
+  known_opaque_ = true;
+}
+
+// -----------------------------------------------------------------------
+
 void SDLSurface::deallocate() {
+  if (texture_budget_)
+    texture_budget_->Remove(this);
   textures_.clear();
   if (surface_) {
+    // Only frees the pixels once no other SDLSurface shares them.
     SDL_FreeSurface(surface_);
     surface_ = NULL;
   }
+  is_constant_ = false;
+}
+
+// -----------------------------------------------------------------------
+
+SDL_Surface* SDLSurface::rawSurface() {
+  prepareForWrite();
+
+  // We can't know what the caller does to the alpha channel.
+  known_opaque_ = false;
+  return surface_;
 }
 
 // TODO(erg): This function doesn't ignore alpha blending when use_src_alpha is
@@ -390,6 +448,33 @@ void SDLSurface::BlitToSurface(Surface& dest_surface,
                                bool use_src_alpha) const {
   SDLSurface& sdl_dest_surface = dynamic_cast<SDLSurface&>(dest_surface);
 
+  if (is_constant_ && src.size() == dst.size() &&
+      src.Intersection(GetRect()) == src && alpha == 255 &&
+      (!use_src_alpha ||
+       (constant_colour_.a() == 255 && sdl_dest_surface.known_opaque_))) {
+    // Every pixel we'd copy is the same colour.
+    sdl_dest_surface.Fill(constant_colour_, dst);
+    return;
+  }
+
+  if (canShareInto(sdl_dest_surface, src, dst, alpha, use_src_alpha)) {
+    // Copy on write: |sdl_dest_surface| takes a reference to our pixels, and
+    // whichever of us is written to next makes its own copy.
+    surface_->refcount++;
+    if (sdl_dest_surface.surface_)
+      SDL_FreeSurface(sdl_dest_surface.surface_);
+    sdl_dest_surface.surface_ = surface_;
+    sdl_dest_surface.is_constant_ = false;
+    sdl_dest_surface.known_opaque_ = known_opaque_;
+    sdl_dest_surface.markWrittenTo(dst);
+    return;
+  }
+
+  ensureBacked();
+  sdl_dest_surface.prepareForWrite();
+  if (!use_src_alpha)
+    sdl_dest_surface.known_opaque_ &= known_opaque_;
+
   SDL_Rect src_rect, dest_rect;
   RectToSDLRect(src, &src_rect);
   RectToSDLRect(dst, &dest_rect);
@@ -411,7 +496,7 @@ void SDLSurface::BlitToSurface(Surface& dest_surface,
         reportSDLError("SDL_SetAlpha", "SDLGraphicsSystem::blitSurfaceToDC()");
     }
 
-    if (SDL_BlitSurface(tmp, NULL, sdl_dest_surface.surface(), &dest_rect))
+    if (SDL_BlitSurface(tmp, NULL, sdl_dest_surface.surface_, &dest_rect))
       reportSDLError("SDL_BlitSurface", "SDLGraphicsSystem::blitSurfaceToDC()");
 
     SDL_FreeSurface(tmp);
@@ -426,7 +511,7 @@ void SDLSurface::BlitToSurface(Surface& dest_surface,
     }
 
     if (SDL_BlitSurface(
-            surface_, &src_rect, sdl_dest_surface.surface(), &dest_rect))
+            surface_, &src_rect, sdl_dest_surface.surface_, &dest_rect))
       reportSDLError("SDL_BlitSurface", "SDLGraphicsSystem::blitSurfaceToDC()");
   }
   sdl_dest_surface.markWrittenTo(dst);
@@ -441,6 +526,10 @@ void SDLSurface::blitFROMSurface(SDL_Surface* src_surface,
                                  const Rect& dst,
                                  int alpha,
                                  bool use_src_alpha) {
+  prepareForWrite();
+  if (!use_src_alpha)
+    known_opaque_ = false;
+
   SDL_Rect src_rect, dest_rect;
   RectToSDLRect(src, &src_rect);
   RectToSDLRect(dst, &dest_rect);
@@ -521,6 +610,8 @@ static void determineProperties(SDL_Surface* surface,
 
 void SDLSurface::uploadTextureIfNeeded() const {
   if (!texture_is_valid_) {
+    ensureBacked();
+
     if (textures_.size() == 0) {
       GLenum bytes_per_pixel;
       GLint byte_order, byte_type;
@@ -556,16 +647,27 @@ void SDLSurface::uploadTextureIfNeeded() const {
 
         x_offset += *it;
       }
+
+      if (texture_budget_) {
+        uint64_t bytes = 0;
+        for (const TextureRecord& record : textures_)
+          bytes += record.texture->GetVideoMemoryBytes();
+        texture_budget_->Upload(const_cast<SDLSurface*>(this), bytes);
+      }
     } else {
       // Reupload the textures without reallocating them.
-      for_each(textures_.begin(), textures_.end(), [&](TextureRecord& record) {
-        record.reupload(surface_, dirty_rectangle_);
-      });
+      for (TextureRecord& record : textures_) {
+        for (const Rect& dirty : dirty_region_.rects())
+          record.reupload(surface_, dirty);
+      }
     }
 
-    dirty_rectangle_ = Rect();
+    dirty_region_.Clear();
     texture_is_valid_ = true;
   }
+
+  if (texture_budget_)
+    texture_budget_->Touch(const_cast<SDLSurface*>(this));
 }
 
 // -----------------------------------------------------------------------
@@ -629,6 +731,15 @@ void SDLSurface::RenderToScreenAsObject(const GraphicsObject& rp,
 // -----------------------------------------------------------------------
 
 void SDLSurface::Fill(const RGBAColour& colour) {
+  if (is_lazy_) {
+    releaseAsConstant(colour);
+    markWrittenTo(GetRect());
+    return;
+  }
+
+  prepareForWrite();
+  known_opaque_ = colour.a() == 255;
+
   // Fill the entire surface with the incoming colour
   Uint32 sdl_colour = MapRGBA(surface_->format, colour);
 
@@ -642,6 +753,15 @@ void SDLSurface::Fill(const RGBAColour& colour) {
 // -----------------------------------------------------------------------
 
 void SDLSurface::Fill(const RGBAColour& colour, const Rect& area) {
+  if (area.Intersection(GetRect()) == GetRect()) {
+    Fill(colour);
+    return;
+  }
+
+  prepareForWrite();
+  if (colour.a() != 255)
+    known_opaque_ = false;
+
   // Fill the entire surface with the incoming colour
   Uint32 sdl_colour = MapRGBA(surface_->format, colour);
 
@@ -658,29 +778,33 @@ void SDLSurface::Fill(const RGBAColour& colour, const Rect& area) {
 // -----------------------------------------------------------------------
 
 void SDLSurface::Invert(const Rect& rect) {
+  prepareForWrite();
   InvertColourTransformer inverter;
-  TransformSurface(this, rect, inverter);
+  TransformSurface(this, surface_, rect, inverter);
 }
 
 // -----------------------------------------------------------------------
 
 void SDLSurface::Mono(const Rect& rect) {
+  prepareForWrite();
   MonoColourTransformer mono;
-  TransformSurface(this, rect, mono);
+  TransformSurface(this, surface_, rect, mono);
 }
 
 // -----------------------------------------------------------------------
 
 void SDLSurface::ToneCurve(const ToneCurveRGBMap effect, const Rect& area) {
+  prepareForWrite();
   ToneCurveColourTransformer tc(effect);
-  TransformSurface(this, area, tc);
+  TransformSurface(this, surface_, area, tc);
 }
 
 // -----------------------------------------------------------------------
 
 void SDLSurface::ApplyColour(const RGBColour& colour, const Rect& area) {
+  prepareForWrite();
   ApplyColourTransformer apply(colour);
-  TransformSurface(this, area, apply);
+  TransformSurface(this, surface_, area, apply);
 }
 
 // -----------------------------------------------------------------------
@@ -699,6 +823,8 @@ const SDLSurface::GrpRect& SDLSurface::GetPattern(int patt_no) const {
 // -----------------------------------------------------------------------
 
 Surface* SDLSurface::Clone() const {
+  ensureBacked();
+
   SDL_Surface* tmp_surface =
       SDL_CreateRGBSurface(surface_->flags,
                            surface_->w,
@@ -752,6 +878,13 @@ std::vector<int> SDLSurface::segmentPicture(int size_remainging) {
 // -----------------------------------------------------------------------
 
 void SDLSurface::GetDCPixel(const Point& pos, int& r, int& g, int& b) const {
+  if (is_constant_) {
+    r = constant_colour_.r();
+    g = constant_colour_.g();
+    b = constant_colour_.b();
+    return;
+  }
+
   SDL_Color colour;
   Uint32 col = 0;
 
@@ -783,6 +916,8 @@ std::shared_ptr<Surface> SDLSurface::ClipAsColorMask(const Rect& clip_rect,
                                                        int b) const {
   const char* function_name = "SDLGraphicsSystem::ClipAsColorMask()";
 
+  ensureBacked();
+
   // TODO(erg): This needs to be made exception safe and so does the rest
   // of this file.
   SDL_Surface* tmp_surface = SDL_CreateRGBSurface(
@@ -814,6 +949,95 @@ std::shared_ptr<Surface> SDLSurface::ClipAsColorMask(const Rect& clip_rect,
 
 // -----------------------------------------------------------------------
 
+bool SDLSurface::is_shared() const {
+  return surface_ && surface_->refcount > 1;
+}
+
+// -----------------------------------------------------------------------
+
+uint64_t SDLSurface::GetPixelBytes() const {
+  return surface_ ? static_cast<uint64_t>(surface_->pitch) * surface_->h : 0;
+}
+
+// -----------------------------------------------------------------------
+
+uint64_t SDLSurface::GetTextureBytes() const {
+  uint64_t bytes = 0;
+  for (const TextureRecord& record : textures_) {
+    if (record.texture)
+      bytes += record.texture->GetVideoMemoryBytes();
+  }
+  return bytes;
+}
+
+// -----------------------------------------------------------------------
+
+void SDLSurface::ensureBacked() const {
+  if (!is_constant_)
+    return;
+
+  surface_ = buildNewSurface(constant_size_);
+  if (SDL_FillRect(surface_, NULL, MapRGBA(surface_->format, constant_colour_)))
+    reportSDLError("SDL_FillRect", "SDLSurface::ensureBacked()");
+  is_constant_ = false;
+}
+
+// -----------------------------------------------------------------------
+
+void SDLSurface::prepareForWrite() {
+  ensureBacked();
+
+  if (surface_->refcount > 1) {
+    // Someone else still reads these pixels, so write to a copy.
+    SDL_Surface* copy = buildNewSurface(Size(surface_->w, surface_->h));
+    if (SDL_SetAlpha(surface_, 0, 0))
+      reportSDLError("SDL_SetAlpha", "SDLSurface::prepareForWrite()");
+    if (SDL_BlitSurface(surface_, NULL, copy, NULL))
+      reportSDLError("SDL_BlitSurface", "SDLSurface::prepareForWrite()");
+
+    SDL_FreeSurface(surface_);
+    surface_ = copy;
+  }
+}
+
+// -----------------------------------------------------------------------
+
+void SDLSurface::releaseAsConstant(const RGBAColour& colour) {
+  Size size = GetSize();
+  deallocate();
+
+  is_constant_ = true;
+  constant_colour_ = colour;
+  constant_size_ = size;
+  known_opaque_ = colour.a() == 255;
+}
+
+// -----------------------------------------------------------------------
+
+bool SDLSurface::canShareInto(const SDLSurface& dest,
+                              const Rect& src,
+                              const Rect& dst,
+                              int alpha,
+                              bool use_src_alpha) const {
+  if (!dest.is_lazy_ || &dest == this || !surface_ || alpha != 255)
+    return false;
+
+  // Only a whole surface copied unscaled onto a surface of the same size.
+  if (src != GetRect() || dst != dest.GetRect() ||
+      GetSize() != dest.GetSize())
+    return false;
+
+  // Color keyed surfaces skip pixels, and other formats would be converted.
+  if ((surface_->flags & SDL_SRCCOLORKEY) || !isNativeFormat(surface_->format))
+    return false;
+
+  // Without alpha blending, the blit copies every channel. With it, the
+  // result is a copy only when both sides are opaque.
+  return !use_src_alpha || (known_opaque_ && dest.known_opaque_);
+}
+
+// -----------------------------------------------------------------------
+
 void SDLSurface::markWrittenTo(const Rect& written_rect) {
   // If we are marked as dc0, alert the SDLGraphicsSystem.
   if (is_dc0_ && graphics_system_) {
@@ -821,7 +1045,7 @@ void SDLSurface::markWrittenTo(const Rect& written_rect) {
   }
 
   // Mark that the texture needs reuploading
-  dirty_rectangle_ = dirty_rectangle_.RectUnion(written_rect);
+  dirty_region_.Add(written_rect);
   texture_is_valid_ = false;
 }
 
@@ -836,8 +1060,15 @@ void SDLSurface::Observe(NotificationType type,
       it->forceUnload();
     }
 
-    dirty_rectangle_ = GetRect();
+    dirty_region_.Clear();
+    dirty_region_.Add(GetRect());
   }
 
   texture_is_valid_ = false;
 }
+
+void SDLSurface::EvictTextures() {
+  // The next upload rebuilds every TextureRecord from |surface_|.
+  textures_.clear();
+  texture_is_valid_ = false;
+}
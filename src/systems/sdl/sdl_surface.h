@@ -28,11 +28,16 @@
 #ifndef SRC_SYSTEMS_SDL_SDL_SURFACE_H_
 #define SRC_SYSTEMS_SDL_SDL_SURFACE_H_
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "base/notification_observer.h"
 #include "base/notification_registrar.h"
+#include "systems/base/colour.h"
+#include "systems/base/dirty_region.h"
 #include "systems/base/surface.h"
+#include "systems/base/texture_budget.h"
 #include "systems/base/tone_curve.h"
 
 struct SDL_Surface;
@@ -50,7 +55,9 @@ SDL_Surface* buildNewSurface(const Size& size);
 // Some SDLSurfaces will own their underlying SDL_Surface, for
 // example, anything returned from GetSurfaceNamedAndMarkViewed(), while others
 // don't own their surfaces (SDLSurfaces returned by GetDC()
-class SDLSurface : public Surface, public NotificationObserver {
+class SDLSurface : public Surface,
+                   public NotificationObserver,
+                   public TextureBudget::Client {
  public:
   explicit SDLSurface(SDLGraphicsSystem* system);
 
@@ -71,8 +78,9 @@ class SDLSurface : public Surface, public NotificationObserver {
 
   void registerForNotification(GraphicsSystem* system);
 
-  // Whether we have an underlying allocated surface.
-  bool allocated() { return surface_; }
+  // Whether we have an underlying allocated surface, or are a lazily
+  // allocated surface that doesn't need one yet.
+  bool allocated() { return surface_ || is_constant_; }
 
   virtual void SetIsMask(const bool is) override { is_mask_ = is; }
 
@@ -84,9 +92,18 @@ class SDLSurface : public Surface, public NotificationObserver {
   void allocate(const Size& size, bool is_dc0);
   void deallocate();
 
-  operator SDL_Surface*() { return surface_; }
+  // Allocates a black surface of |size| without any pixels. Reads see solid
+  // black until something writes to part of the surface, and filling the
+  // whole surface with one colour releases the pixels again. Copying one
+  // whole surface onto a lazy surface shares the pixels until either side is
+  // written to. Used for DCs, which scripts allocate far more often than they
+  // draw to.
+  void allocateLazily(const Size& size);
 
-  SDL_Surface* rawSurface() { return surface_; }
+  // Direct access to the pixels, which are allocated and made private to this
+  // surface first. Callers may write to them.
+  operator SDL_Surface*() { return rawSurface(); }
+  SDL_Surface* rawSurface();
 
   virtual void BlitToSurface(Surface& dest_surface,
                              const Rect& src,
@@ -135,7 +152,7 @@ class SDLSurface : public Surface, public NotificationObserver {
   virtual void Mono(const Rect& area) override;
   virtual void ApplyColour(const RGBColour& colour, const Rect& area) override;
 
-  SDL_Surface* surface() { return surface_; }
+  SDL_Surface* surface() { return rawSurface(); }
 
   virtual void GetDCPixel(const Point& pos, int& r, int& g, int& b) const override;
   virtual std::shared_ptr<Surface> ClipAsColorMask(const Rect& clip_rect,
@@ -151,11 +168,21 @@ class SDLSurface : public Surface, public NotificationObserver {
   // invalid and notifies SDLGraphicsSystem when appropriate.
   void markWrittenTo(const Rect& written_rect);
 
+  // Memory accounting, for SDLGraphicsSystem::WriteMemoryReport().
+  bool is_constant() const { return is_constant_; }
+  const RGBAColour& constant_colour() const { return constant_colour_; }
+  bool is_shared() const;
+  uint64_t GetPixelBytes() const;
+  uint64_t GetTextureBytes() const;
+
   // NotificationObserver:
   virtual void Observe(NotificationType type,
                        const NotificationSource& source,
                        const NotificationDetails& details);
 
+  // TextureBudget::Client:
+  virtual void EvictTextures() override;
+
  private:
   // Keeps track of a texture and the information about which region
   // of the current surface this Texture is. We keep track of this
@@ -193,10 +220,43 @@ class SDLSurface : public Surface, public NotificationObserver {
   // texture_.
   void uploadTextureIfNeeded() const;
 
+  // Gives a lazy surface real pixels, filled with |constant_colour_|.
+  void ensureBacked() const;
+
+  // Makes sure we have pixels that nobody else shares. Call before changing
+  // surface_.
+  void prepareForWrite();
+
+  // Frees our pixels and textures and reads as |colour| from now on.
+  void releaseAsConstant(const RGBAColour& colour);
+
+  // Whether BlitToSurface(dest, src, dst, alpha, use_src_alpha) would leave
+  // |dest| an exact copy of us, so it can share our pixels instead.
+  bool canShareInto(const SDLSurface& dest,
+                    const Rect& src,
+                    const Rect& dst,
+                    int alpha,
+                    bool use_src_alpha) const;
+
   static std::vector<int> segmentPicture(int size_remainging);
 
-  // The SDL_Surface that contains the software version of the bitmap.
-  SDL_Surface* surface_;
+  // The SDL_Surface that contains the software version of the bitmap. NULL
+  // while |is_constant_|. Its refcount is above one while it's shared with
+  // another SDLSurface.
+  mutable SDL_Surface* surface_;
+
+  // Whether allocateLazily() was used. Only lazy surfaces release their
+  // pixels when filled, or take shared pixels.
+  bool is_lazy_;
+
+  // While true, every pixel is |constant_colour_| and |surface_| is NULL.
+  mutable bool is_constant_;
+  RGBAColour constant_colour_;
+  Size constant_size_;
+
+  // Whether every pixel is known to have an alpha of 255. Alpha blending an
+  // opaque surface onto an opaque surface is then a plain copy.
+  bool known_opaque_;
 
   // The region table
   std::vector<GrpRect> region_table_;
@@ -209,9 +269,9 @@ class SDLSurface : public Surface, public NotificationObserver {
   // texture.
   mutable bool texture_is_valid_;
 
-  // When a chunk of the surface is invalidated, we only want to upload the
-  // smallest possible area, but for simplicity, we only keep one dirty area.
-  mutable Rect dirty_rectangle_;
+  // The parts of surface_ written since the last upload. Each TextureRecord
+  // reuploads only the rectangles that overlap it.
+  mutable DirtyRegion dirty_region_;
 
   // Whether this surface is DC0 and needs special treatment.
   bool is_dc0_;
@@ -221,6 +281,10 @@ class SDLSurface : public Surface, public NotificationObserver {
   // invalidate them all in the case of a screen change.
   SDLGraphicsSystem* graphics_system_;
 
+  // Where our uploaded textures are accounted for. Shared with the graphics
+  // system since some surfaces outlive it. NULL when there's no system.
+  std::shared_ptr<TextureBudget> texture_budget_;
+
   bool is_mask_;
 
   NotificationRegistrar registrar_;
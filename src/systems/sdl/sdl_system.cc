@@ -34,6 +34,7 @@
 #include "libreallive/defs.h"
 #include "libreallive/gameexe.h"
 #include "machine/rlmachine.h"
+#include "systems/base/frame_telemetry.h"
 #include "systems/base/graphics_object.h"
 #include "systems/base/graphics_object_data.h"
 #include "systems/base/platform.h"
@@ -41,10 +42,14 @@
 #include "systems/sdl/sdl_graphics_system.h"
 #include "systems/sdl/sdl_sound_system.h"
 #include "systems/sdl/sdl_text_system.h"
+#include "systems/sdl/texture.h"
 
 // -----------------------------------------------------------------------
 
 SDLSystem::SDLSystem(Gameexe& gameexe) : System(), gameexe_(gameexe) {
+  // Index the game's files while the rest of the system starts up.
+  BuildFileSystemCacheInBackground();
+
   // First, initialize SDL's video subsystem.
   if (SDL_Init(SDL_INIT_VIDEO) < 0) {
     std::ostringstream ss;
@@ -86,11 +91,22 @@ SDLSystem::~SDLSystem() {
 // -----------------------------------------------------------------------
 
 void SDLSystem::Run(RLMachine& machine) {
+  event_system_->BeginFrame();
+
+  FrameTelemetry& frame_telemetry = telemetry();
+  frame_telemetry.AddUploadBytes(Texture::TakeUploadedBytes());
+  frame_telemetry.BeginFrame(event_system_->frame_ticks());
+
   // Give the event handler a chance to run.
+  uint64_t lap = frame_telemetry.GetMicroseconds();
   event_system_->ExecuteEventSystem(machine);
+  lap = frame_telemetry.Lap(FrameTelemetry::PHASE_EVENTS, lap);
   text_system_->ExecuteTextSystem();
+  lap = frame_telemetry.Lap(FrameTelemetry::PHASE_TEXT, lap);
   sound_system_->ExecuteSoundSystem();
+  lap = frame_telemetry.Lap(FrameTelemetry::PHASE_SOUND, lap);
   graphics_system_->ExecuteGraphicsSystem(machine);
+  frame_telemetry.Lap(FrameTelemetry::PHASE_GRAPHICS, lap);
 
   if (platform())
     platform()->Run(machine);
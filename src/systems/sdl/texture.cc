@@ -56,6 +56,11 @@ unsigned int Texture::s_screen_height = 0;
 unsigned int Texture::s_upload_buffer_size = 0;
 std::unique_ptr<char[]> Texture::s_upload_buffer;
 
+uint64_t Texture::s_uploaded_bytes = 0;
+
+GLuint Texture::s_pixel_buffers[Texture::kPixelBufferCount] = {0};
+int Texture::s_next_pixel_buffer = 0;
+
 // -----------------------------------------------------------------------
 
 void Texture::SetScreenSize(const Size& s) {
@@ -65,6 +70,23 @@ void Texture::SetScreenSize(const Size& s) {
 
 int Texture::ScreenHeight() { return s_screen_height; }
 
+uint64_t Texture::TakeUploadedBytes() {
+  uint64_t bytes = s_uploaded_bytes;
+  s_uploaded_bytes = 0;
+  return bytes;
+}
+
+void Texture::ResetPixelBuffers() {
+  if (s_pixel_buffers[0]) {
+    glDeleteBuffersARB(kPixelBufferCount, s_pixel_buffers);
+    DebugShowGLErrors();
+
+    for (int i = 0; i < kPixelBufferCount; ++i)
+      s_pixel_buffers[i] = 0;
+  }
+  s_next_pixel_buffer = 0;
+}
+
 // -----------------------------------------------------------------------
 // Texture
 // -----------------------------------------------------------------------
@@ -84,6 +106,7 @@ Texture::Texture(SDL_Surface* surface,
       total_height_(surface->h),
       texture_width_(SafeSize(logical_width_)),
       texture_height_(SafeSize(logical_height_)),
+      bytes_per_texel_(bytes_per_pixel == GL_ALPHA ? 1 : 4),
       back_texture_id_(0),
       is_upside_down_(false) {
   glGenTextures(1, &texture_id_);
@@ -117,6 +140,8 @@ Texture::Texture(SDL_Surface* surface,
                     byte_type,
                     surface->pixels);
     DebugShowGLErrors();
+    s_uploaded_bytes +=
+        surface->format->BytesPerPixel * surface->w * surface->h;
 
     SDL_UnlockSurface(surface);
   } else {
@@ -153,6 +178,7 @@ Texture::Texture(SDL_Surface* surface,
     glTexSubImage2D(
         GL_TEXTURE_2D, 0, 0, 0, w, h, byte_order, byte_type, pixel_data);
     DebugShowGLErrors();
+    s_uploaded_bytes += surface->format->BytesPerPixel * w * h;
   }
 }
 
@@ -167,6 +193,7 @@ Texture::Texture(render_to_texture, int width, int height)
       total_height_(height),
       texture_width_(0),
       texture_height_(0),
+      bytes_per_texel_(4),
       texture_id_(0),
       back_texture_id_(0),
       is_upside_down_(true) {
@@ -247,28 +274,39 @@ void Texture::reupload(SDL_Surface* surface,
                     byte_type,
                     surface->pixels);
     DebugShowGLErrors();
+    s_uploaded_bytes +=
+        surface->format->BytesPerPixel * surface->w * surface->h;
 
     SDL_UnlockSurface(surface);
   } else {
-    // Cut out the current piece
-    char* pixel_data = uploadBuffer(surface->format->BytesPerPixel * w * h);
-    char* cur_dst_ptr = pixel_data;
-
-    SDL_LockSurface(surface);
-    {
-      char* cur_src_ptr = (char*)surface->pixels;
-      cur_src_ptr += surface->pitch * y;
-
-      int row_start = surface->format->BytesPerPixel * x;
-      int subrow_size = surface->format->BytesPerPixel * w;
-      for (int current_row = 0; current_row < h; ++current_row) {
-        memcpy(cur_dst_ptr, cur_src_ptr + row_start, subrow_size);
-        cur_dst_ptr += subrow_size;
-        cur_src_ptr += surface->pitch;
+    unsigned int size = surface->format->BytesPerPixel * w * h;
+    char* pixel_data = NULL;
+
+    GLuint pixel_buffer = nextPixelBuffer();
+    if (pixel_buffer) {
+      glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, pixel_buffer);
+      glBufferDataARB(
+          GL_PIXEL_UNPACK_BUFFER_ARB, size, NULL, GL_STREAM_DRAW_ARB);
+      char* mapped = static_cast<char*>(
+          glMapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB));
+      if (mapped) {
+        copyRows(surface, x, y, w, h, mapped);
+        glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB);
+      } else {
+        // The driver couldn't map the buffer; fall back to a plain upload.
+        glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        pixel_buffer = 0;
       }
+      DebugShowGLErrors();
+    }
+
+    if (!pixel_buffer) {
+      // Cut out the current piece
+      pixel_data = uploadBuffer(size);
+      copyRows(surface, x, y, w, h, pixel_data);
     }
-    SDL_UnlockSurface(surface);
 
+    // With a pixel buffer bound, |pixel_data| is an offset into it.
     glTexSubImage2D(GL_TEXTURE_2D,
                     0,
                     offset_x,
@@ -279,7 +317,53 @@ void Texture::reupload(SDL_Surface* surface,
                     byte_type,
                     pixel_data);
     DebugShowGLErrors();
+    s_uploaded_bytes += size;
+
+    if (pixel_buffer)
+      glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+  }
+}
+
+// -----------------------------------------------------------------------
+
+// static
+GLuint Texture::nextPixelBuffer() {
+  if (!GLEW_ARB_pixel_buffer_object)
+    return 0;
+
+  if (!s_pixel_buffers[0]) {
+    glGenBuffersARB(kPixelBufferCount, s_pixel_buffers);
+    DebugShowGLErrors();
+  }
+
+  GLuint buffer = s_pixel_buffers[s_next_pixel_buffer];
+  s_next_pixel_buffer = (s_next_pixel_buffer + 1) % kPixelBufferCount;
+  return buffer;
+}
+
+// -----------------------------------------------------------------------
+
+// static
+void Texture::copyRows(SDL_Surface* surface,
+                       int x,
+                       int y,
+                       int w,
+                       int h,
+                       char* dst) {
+  SDL_LockSurface(surface);
+  {
+    char* cur_src_ptr = (char*)surface->pixels;
+    cur_src_ptr += surface->pitch * y;
+
+    int row_start = surface->format->BytesPerPixel * x;
+    int subrow_size = surface->format->BytesPerPixel * w;
+    for (int current_row = 0; current_row < h; ++current_row) {
+      memcpy(dst, cur_src_ptr + row_start, subrow_size);
+      dst += subrow_size;
+      cur_src_ptr += surface->pitch;
+    }
   }
+  SDL_UnlockSurface(surface);
 }
 
 // -----------------------------------------------------------------------
@@ -30,6 +30,7 @@
 
 #include <SDL/SDL_opengl.h>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -50,6 +51,14 @@ class Texture {
 
   static int ScreenHeight();
 
+  // Returns the number of bytes of pixel data uploaded to all textures since
+  // the last call.
+  static uint64_t TakeUploadedBytes();
+
+  // Frees the pixel buffers used for streaming uploads. Called when the
+  // OpenGL context is recreated.
+  static void ResetPixelBuffers();
+
  public:
   Texture(SDL_Surface* surface,
           int x,
@@ -80,6 +89,11 @@ class Texture {
   int height() { return logical_height_; }
   GLuint textureId() { return texture_id_; }
 
+  // Video memory allocated for this texture, padding included.
+  unsigned int GetVideoMemoryBytes() const {
+    return texture_width_ * texture_height_ * bytes_per_texel_;
+  }
+
   void RenderToScreenAsObject(const GraphicsObject& go,
                               const SDLSurface& surface,
                               const Rect& srcRect,
@@ -103,6 +117,18 @@ class Texture {
   // large enough.
   static char* uploadBuffer(unsigned int size);
 
+  // Returns the next pixel unpack buffer in the ring, or 0 when pixel buffer
+  // objects aren't supported.
+  static GLuint nextPixelBuffer();
+
+  // Copies Rect(x, y, w, h) of |surface| into |dst| with no row padding.
+  static void copyRows(SDL_Surface* surface,
+                       int x,
+                       int y,
+                       int w,
+                       int h,
+                       char* dst);
+
   void render_to_screen_as_colour_mask_subtractive_glsl(const Rect& src,
                                                         const Rect& dst,
                                                         const RGBAColour& rgba);
@@ -135,6 +161,9 @@ class Texture {
   unsigned int texture_width_;
   unsigned int texture_height_;
 
+  // 1 for alpha only masks, 4 otherwise.
+  unsigned int bytes_per_texel_;
+
   GLuint texture_id_;
 
   GLuint back_texture_id_;
@@ -152,6 +181,18 @@ class Texture {
   // To prevent new-ing in a loop, save the dynamically allocated
   // buffer used to upload data into.
   static std::unique_ptr<char[]> s_upload_buffer;
+
+  // Bytes uploaded since the last TakeUploadedBytes().
+  static uint64_t s_uploaded_bytes;
+
+  // Partial uploads are copied into a pixel buffer object, and
+  // glTexSubImage2D() reads from it asynchronously instead of stalling until
+  // the driver has copied our memory. We cycle through a few buffers and
+  // orphan each one before writing to it, so we never wait for a transfer
+  // that is still in flight.
+  static const int kPixelBufferCount = 4;
+  static GLuint s_pixel_buffers[kPixelBufferCount];
+  static int s_next_pixel_buffer;
 };
 
 #endif  // SRC_SYSTEMS_SDL_TEXTURE_H_
@@ -0,0 +1,143 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+// rlvm-pack: packs a game's loose assets into an rlvm.pack file in the game
+// root. See AssetPack for the format.
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "libreallive/gameexe.h"
+#include "systems/base/asset_pack.h"
+#include "utilities/exception.h"
+#include "utilities/file.h"
+
+namespace fs = boost::filesystem;
+
+using boost::to_lower;
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+
+namespace {
+
+const std::vector<string> PACKED_FILETYPES = {"g00", "pdt", "anm", "gan",
+                                              "hik", "ogg", "nwa"};
+
+typedef std::vector<std::pair<string, fs::path>> FileList;
+
+void AddDirectory(const fs::path& directory, FileList* files) {
+  std::vector<fs::path> children;
+  std::copy(fs::directory_iterator(directory), fs::directory_iterator(),
+            std::back_inserter(children));
+  // Sorted so that which of two same named files wins is deterministic.
+  std::sort(children.begin(), children.end());
+
+  for (const fs::path& child : children) {
+    if (fs::is_directory(child)) {
+      AddDirectory(child, files);
+      continue;
+    }
+
+    string extension = child.extension().string();
+    if (extension.size() > 1 && extension[0] == '.')
+      extension = extension.substr(1);
+    to_lower(extension);
+    if (std::find(PACKED_FILETYPES.begin(), PACKED_FILETYPES.end(),
+                  extension) != PACKED_FILETYPES.end()) {
+      files->push_back(std::make_pair(child.filename().string(), child));
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argc > 3) {
+    cout << "Usage: " << argv[0] << " <game root> [output]" << endl
+         << "Packs the game's G00, PDT, ANM, GAN, HIK, OGG and NWA files "
+         << "into <game root>/rlvm.pack." << endl;
+    return 1;
+  }
+
+  fs::path gameroot(argv[1]);
+  fs::path output = argc == 3 ? fs::path(argv[2]) : gameroot / "rlvm.pack";
+
+  try {
+    fs::path gameexe_path = CorrectPathCase(gameroot / "Gameexe.ini");
+    if (gameexe_path.empty()) {
+      cerr << "Could not find Gameexe.ini in " << gameroot << endl;
+      return 1;
+    }
+    Gameexe gameexe(gameexe_path);
+
+    std::vector<string> folders;
+    GameexeFilteringIterator it = gameexe.filtering_begin("FOLDNAME");
+    GameexeFilteringIterator end = gameexe.filtering_end();
+    for (; it != end; ++it) {
+      string dir = it->ToString();
+      if (!dir.empty()) {
+        to_lower(dir);
+        folders.push_back(dir);
+      }
+    }
+
+    FileList files;
+    for (fs::directory_iterator dir(gameroot), dir_end; dir != dir_end;
+         ++dir) {
+      string lowername = dir->path().filename().string();
+      to_lower(lowername);
+      if (fs::is_directory(dir->status()) &&
+          std::find(folders.begin(), folders.end(), lowername) !=
+              folders.end()) {
+        AddDirectory(dir->path(), &files);
+      }
+    }
+
+    AssetPack::Write(output, files);
+    AssetPack pack(output);
+    cout << "Packed " << pack.size() << " files into " << output << "."
+         << endl
+         << "Loose files still take priority over the pack; remove them to "
+         << "read from the pack." << endl;
+  } catch (rlvm::Exception& e) {
+    cerr << e.what() << endl;
+    return 1;
+  } catch (std::exception& e) {
+    cerr << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
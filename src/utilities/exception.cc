@@ -29,6 +29,7 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "libreallive/bytecode.h"
 #include "libreallive/expression.h"
@@ -37,6 +38,20 @@ using std::ostringstream;
 
 namespace rlvm {
 
+namespace {
+
+// Exceptions can outlive the scenario the command came from, so copy the
+// parameters out.
+std::vector<std::string> CopyParameters(
+    const libreallive::CommandElement& command) {
+  std::vector<std::string> parameters;
+  for (auto const& param : command.GetUnparsedParameters())
+    parameters.push_back(param.str());
+  return parameters;
+}
+
+}  // namespace
+
 // -----------------------------------------------------------------------
 // Exception
 // -----------------------------------------------------------------------
@@ -81,7 +96,7 @@ UnimplementedOpcode::UnimplementedOpcode(
     const libreallive::CommandElement& command)
     : Exception(""),
       has_parameters_(true),
-      parameters_(command.GetUnparsedParameters()) {
+      parameters_(CopyParameters(command)) {
   std::ostringstream oss;
   oss << funName << " [opcode<" << command.modtype() << ":" << command.module()
       << ":" << command.opcode() << ", " << command.overload() << ">]";
@@ -94,7 +109,7 @@ UnimplementedOpcode::UnimplementedOpcode(
     const libreallive::CommandElement& command)
     : Exception(""),
       has_parameters_(true),
-      parameters_(command.GetUnparsedParameters()) {
+      parameters_(CopyParameters(command)) {
   ostringstream oss;
   oss << "opcode<" << command.modtype() << ":" << command.module() << ":"
       << command.opcode() << ", " << command.overload() << ">";
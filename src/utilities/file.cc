@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <fstream>
 #include <iterator>
 #include <sstream>
@@ -40,6 +41,7 @@
 #include <stdexcept>
 #include <string>
 
+#include "systems/base/asset_pack.h"
 #include "systems/base/system.h"
 #include "systems/base/system_error.h"
 #include "utilities/exception.h"
@@ -116,6 +118,14 @@ fs::path CorrectPathCase(fs::path Path) {
 bool LoadFileData(const boost::filesystem::path& path,
                   std::unique_ptr<char[]>& fileData,
                   int& fileSize) {
+  AssetPack::Asset asset;
+  if (AssetPack::FindPath(path, &asset)) {
+    fileSize = asset.size;
+    fileData.reset(new char[fileSize]);
+    memcpy(fileData.get(), asset.data, fileSize);
+    return false;
+  }
+
   fs::ifstream ifs(path, ifstream::in | ifstream::binary);
   if (!ifs) {
     ostringstream oss;
@@ -66,8 +66,7 @@ string cp932toUTF8(const string& line, int transformation) {
   if (line.empty())
     return line;
 
-  std::wstring ws = cp932toUnicode(line, transformation);
-  return UnicodeToUTF8(ws);
+  return Cp::instance(transformation).ConvertToUTF8(line);
 }
 
 bool IsOpeningQuoteMark(int codepoint) {
@@ -104,6 +103,44 @@ bool IsKinsoku(int codepoint) {
   return false;
 }
 
+LineBreakClass GetLineBreakClass(int codepoint) {
+  // MustLineBreak() checks for kinsoku first, so they win for characters like
+  // the apostrophe that are in both sets.
+  if (IsKinsoku(codepoint))
+    return LINE_BREAK_KINSOKU;
+  if (IsWrappingRomanCharacter(codepoint))
+    return LINE_BREAK_ROMAN;
+  return LINE_BREAK_NORMAL;
+}
+
+DisplayText::DisplayText(const std::string& utf8_text) : utf8(utf8_text) {
+  codepoints.reserve(utf8.size());
+  break_classes.reserve(utf8.size());
+  offsets.reserve(utf8.size() + 1);
+
+  string::const_iterator it = utf8.cbegin();
+  while (it != utf8.cend()) {
+    offsets.push_back(it - utf8.cbegin());
+    int codepoint = utf8::next(it, utf8.cend());
+    codepoints.push_back(codepoint);
+    break_classes.push_back(GetLineBreakClass(codepoint));
+  }
+  offsets.push_back(utf8.size());
+}
+
+std::string DisplayText::Character(size_t i) const {
+  return utf8.substr(offsets[i], offsets[i + 1] - offsets[i]);
+}
+
+std::string DisplayText::LineBreakLookahead(size_t i) const {
+  size_t end = i;
+  while (end < size() && break_classes[end] != LINE_BREAK_NORMAL)
+    ++end;
+  if (end < size())
+    ++end;
+  return utf8.substr(offsets[i], offsets[end] - offsets[i]);
+}
+
 int Codepoint(const string& c) {
   if (c == "") {
     return 0;
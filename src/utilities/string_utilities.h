@@ -31,6 +31,7 @@
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <vector>
 
 // Converts a CP932/Shift_JIS string into a wstring with Unicode
 // characters.
@@ -59,7 +60,8 @@ std::string TransformationName(int transformation);
 // Converts a UTF-16 string to a UTF-8 one.
 std::string UnicodeToUTF8(const std::wstring& widestring);
 
-// For convenience. Combines the two above functions.
+// Converts straight from the codepage to UTF-8, without going through the
+// wide string that cp932toUnicode() builds.
 std::string cp932toUTF8(const std::string& line, int transformation);
 
 // Returns true if codepoint is either of the Japanese quote marks or '('.
@@ -72,6 +74,43 @@ bool IsWrappingRomanCharacter(int codepoint);
 // Returns whether the unicode |codepoint| is a piece of breaking punctuation.
 bool IsKinsoku(int codepoint);
 
+// How a character takes part in choosing where a line of text breaks.
+enum LineBreakClass {
+  LINE_BREAK_NORMAL = 0,
+  // IsKinsoku(): punctuation that can't start a line.
+  LINE_BREAK_KINSOKU,
+  // IsWrappingRomanCharacter(): part of a word that wraps as a whole.
+  LINE_BREAK_ROMAN
+};
+
+LineBreakClass GetLineBreakClass(int codepoint);
+
+// UTF-8 text split into characters for display, so that TextoutLongOperation
+// doesn't have to decode it one character at a time as it is shown.
+struct DisplayText {
+  explicit DisplayText(const std::string& utf8_text);
+
+  // Returns the UTF-8 for character |i|.
+  std::string Character(size_t i) const;
+
+  // Returns the characters starting at |i| that TextWindow needs to look at
+  // to decide whether to break the line before the character preceding them:
+  // the run of kinsoku and roman characters, plus the first character after
+  // it.
+  std::string LineBreakLookahead(size_t i) const;
+
+  size_t size() const { return codepoints.size(); }
+
+  std::string utf8;
+
+  // One entry per character.
+  std::vector<int> codepoints;
+  std::vector<uint8_t> break_classes;
+
+  // The byte offset of each character in |utf8|, plus one for the end.
+  std::vector<size_t> offsets;
+};
+
 // Returns the unicode codpoint for the next UTF-8 character in |c|.
 int Codepoint(const std::string& c);
 
@@ -0,0 +1,146 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "systems/base/asset_pack.h"
+#include "utilities/exception.h"
+#include "utilities/file.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+class AssetPackTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    root_ = fs::temp_directory_path() /
+            fs::unique_path("rlvm-asset-pack-%%%%-%%%%");
+    fs::create_directories(root_);
+    pack_file_ = root_ / "rlvm.pack";
+  }
+
+  virtual void TearDown() { fs::remove_all(root_); }
+
+  fs::path MakeFile(const std::string& name, const std::string& contents) {
+    fs::path path = root_ / name;
+    fs::ofstream out(path, std::ios::binary);
+    out << contents;
+    return path;
+  }
+
+  void WritePack() {
+    std::vector<std::pair<std::string, fs::path>> files = {
+        {"BG001.G00", MakeFile("a", "first image")},
+        {"title.nwa", MakeFile("b", "music")},
+        {"title.ogg", MakeFile("c", "other music")},
+        {"bg001.g00", MakeFile("d", "duplicate")},
+        {"empty.pdt", MakeFile("e", "")}};
+    AssetPack::Write(pack_file_, files);
+  }
+
+  std::string ToString(const AssetPack::Asset& asset) {
+    return std::string(asset.data, asset.size);
+  }
+
+  fs::path root_;
+  fs::path pack_file_;
+};
+
+TEST_F(AssetPackTest, FindsPackedFiles) {
+  WritePack();
+  AssetPack pack(pack_file_);
+  EXPECT_EQ(4u, pack.size());
+
+  AssetPack::Asset asset;
+  ASSERT_TRUE(pack.Find("bg001.g00", &asset));
+  EXPECT_EQ("first image", ToString(asset));
+  ASSERT_TRUE(pack.Find("title.ogg", &asset));
+  EXPECT_EQ("other music", ToString(asset));
+  ASSERT_TRUE(pack.Find("empty.pdt", &asset));
+  EXPECT_EQ(0u, asset.size);
+  EXPECT_FALSE(pack.Find("BG001.g00", &asset));
+  EXPECT_FALSE(pack.Find("missing.g00", &asset));
+
+  // Data is aligned for zero-copy decoding.
+  ASSERT_TRUE(pack.Find("title.nwa", &asset));
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(asset.data) % 16);
+}
+
+TEST_F(AssetPackTest, FindFileUsesExtensionOrder) {
+  WritePack();
+  AssetPack pack(pack_file_);
+  EXPECT_EQ(pack_file_ / "title.nwa", pack.FindFile("title", {"nwa", "ogg"}));
+  EXPECT_EQ(pack_file_ / "title.ogg", pack.FindFile("title", {"ogg", "nwa"}));
+  EXPECT_EQ(fs::path(), pack.FindFile("title", {"wav"}));
+}
+
+TEST_F(AssetPackTest, PackPathsAreReadable) {
+  WritePack();
+  fs::path music;
+  {
+    AssetPack pack(pack_file_);
+    music = pack.FindFile("title", {"ogg"});
+
+    AssetPack::Asset asset;
+    ASSERT_TRUE(AssetPack::FindPath(music, &asset));
+    EXPECT_EQ("other music", ToString(asset));
+
+    FILE* f = AssetPack::OpenStream(music);
+    ASSERT_TRUE(f);
+    char buf[32] = {0};
+    EXPECT_EQ(11u, fread(buf, 1, sizeof(buf), f));
+    EXPECT_EQ("other music", std::string(buf));
+    fclose(f);
+
+    std::unique_ptr<char[]> data;
+    int size = 0;
+    EXPECT_FALSE(LoadFileData(music, data, size));
+    EXPECT_EQ("other music", std::string(data.get(), size));
+  }
+
+  // Once the pack is closed, its paths no longer resolve.
+  AssetPack::Asset asset;
+  EXPECT_FALSE(AssetPack::FindPath(music, &asset));
+}
+
+TEST_F(AssetPackTest, RejectsInvalidPacks) {
+  MakeFile("rlvm.pack", "not a pack at all, just some text");
+  EXPECT_THROW(AssetPack pack(pack_file_), rlvm::Exception);
+  EXPECT_THROW(AssetPack pack(root_ / "missing.pack"), rlvm::Exception);
+}
+
+}  // namespace
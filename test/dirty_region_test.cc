@@ -0,0 +1,72 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include "systems/base/dirty_region.h"
+
+TEST(DirtyRegionTest, GlyphsAlongALineMergeIntoOneRect) {
+  DirtyRegion region;
+  for (int i = 0; i < 20; ++i)
+    region.Add(Rect::REC(i * 12, 40, 12, 24));
+
+  ASSERT_EQ(1u, region.rects().size());
+  EXPECT_EQ(Rect::REC(0, 40, 240, 24), region.rects()[0]);
+}
+
+TEST(DirtyRegionTest, DistantWritesStaySeparate) {
+  DirtyRegion region;
+  region.Add(Rect::REC(0, 0, 10, 10));
+  region.Add(Rect::REC(600, 400, 10, 10));
+
+  EXPECT_EQ(2u, region.rects().size());
+  EXPECT_EQ(200, region.GetArea());
+
+  // Something inside an existing rect adds nothing.
+  region.Add(Rect::REC(2, 2, 4, 4));
+  EXPECT_EQ(2u, region.rects().size());
+  EXPECT_EQ(200, region.GetArea());
+
+  // Empty rects are ignored.
+  region.Add(Rect::REC(50, 50, 0, 10));
+  EXPECT_EQ(2u, region.rects().size());
+
+  region.Clear();
+  EXPECT_TRUE(region.empty());
+}
+
+TEST(DirtyRegionTest, MergesCheapestPairWhenFull) {
+  DirtyRegion region;
+  for (int i = 0; i < DirtyRegion::kMaxRects; ++i)
+    region.Add(Rect::REC(i * 100, i * 100, 10, 10));
+  EXPECT_EQ(DirtyRegion::kMaxRects, static_cast<int>(region.rects().size()));
+
+  // Close to the first rect, so those two are merged.
+  region.Add(Rect::REC(12, 0, 10, 10));
+  EXPECT_EQ(DirtyRegion::kMaxRects, static_cast<int>(region.rects().size()));
+  EXPECT_EQ(7 * 100 + 22 * 10, region.GetArea());
+}
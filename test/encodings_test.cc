@@ -0,0 +1,164 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "encodings/cp932.h"
+#include "encodings/cp936.h"
+#include "encodings/cp949.h"
+#include "encodings/western.h"
+#include "utilities/string_utilities.h"
+
+#include "test_utils.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+// What cp932toUTF8() used to do: build a wide string and then encode it.
+std::string ConvertThroughWideString(const Codepage& cp,
+                                     const std::string& in) {
+  return UnicodeToUTF8(cp.ConvertString(in));
+}
+
+// Every double byte character with a lead in [first_lead, last_lead] and a
+// trail in [first_trail, last_trail], with runs of ASCII of varying length
+// mixed in so the block copy is exercised at every alignment.
+std::string AllDoubleByteCharacters(int first_lead,
+                                    int last_lead,
+                                    int first_trail,
+                                    int last_trail) {
+  std::string out;
+  for (int lead = first_lead; lead <= last_lead; ++lead) {
+    for (int trail = first_trail; trail <= last_trail; ++trail) {
+      out += static_cast<char>(lead);
+      out += static_cast<char>(trail);
+    }
+    out.append(lead % 37, 'a' + lead % 26);
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST(EncodingsTest, Cp932MatchesWideStringPath) {
+  Cp932 cp;
+  std::string singles;
+  for (int c = 1; c < 0x100; ++c) {
+    if (!shiftjis_lead_byte(c))
+      singles += static_cast<char>(c);
+  }
+  EXPECT_EQ(ConvertThroughWideString(cp, singles), cp.ConvertToUTF8(singles));
+
+  std::string doubles = AllDoubleByteCharacters(0x81, 0x9f, 0x40, 0xfc) +
+                        AllDoubleByteCharacters(0xe0, 0xfc, 0x40, 0xfc);
+  EXPECT_EQ(ConvertThroughWideString(cp, doubles), cp.ConvertToUTF8(doubles));
+}
+
+TEST(EncodingsTest, Cp936MatchesWideStringPath) {
+  Cp936 cp;
+  std::string in = AllDoubleByteCharacters(0x81, 0xfe, 0x40, 0xfe);
+  EXPECT_EQ(ConvertThroughWideString(cp, in), cp.ConvertToUTF8(in));
+}
+
+TEST(EncodingsTest, Cp949MatchesWideStringPath) {
+  Cp949 cp;
+  std::string in = AllDoubleByteCharacters(0x81, 0xc8, 0x41, 0xfe);
+  EXPECT_EQ(ConvertThroughWideString(cp, in), cp.ConvertToUTF8(in));
+}
+
+TEST(EncodingsTest, Cp1252MatchesWideStringPath) {
+  Cp1252 cp;
+  std::string in;
+  for (int c = 1; c < 0x100; ++c)
+    in += static_cast<char>(c);
+  EXPECT_EQ(ConvertThroughWideString(cp, in), cp.ConvertToUTF8(in));
+}
+
+TEST(EncodingsTest, StopsAtNulAndTruncatedLeadByte) {
+  Cp932 cp;
+  EXPECT_EQ("ab", cp.ConvertToUTF8(std::string("ab\0cd", 5)));
+
+  // "a" (U+3042) followed by a lead byte with nothing after it.
+  EXPECT_EQ("\xe3\x81\x82", cp.ConvertToUTF8("\x82\xa0\x82"));
+  EXPECT_EQ("", cp.ConvertToUTF8(""));
+}
+
+// Compares the old and new conversions on the source of the test scenarios.
+TEST(EncodingsTest, DISABLED_TranscodeSpeed) {
+  const char* kDirectories[] = {"ExpressionTest_SEEN", "Module_Jmp_SEEN",
+                                "Module_Mem_SEEN", "Module_Str_SEEN",
+                                "Module_Sys_SEEN"};
+  std::vector<std::string> lines;
+  size_t bytes = 0;
+  for (const char* directory : kDirectories) {
+    fs::directory_iterator it(locateTestCase(directory)), end;
+    for (; it != end; ++it) {
+      if (it->path().extension() != ".ke")
+        continue;
+      fs::ifstream file(it->path());
+      std::string line;
+      while (std::getline(file, line)) {
+        bytes += line.size();
+        lines.push_back(line);
+      }
+    }
+  }
+
+  const int kIterations = 200;
+  Cp932 cp;
+  auto time = [&](const char* name,
+                  const std::function<std::string(const std::string&)>& f) {
+    size_t output = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+      for (const std::string& line : lines)
+        output += f(line).size();
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    printf("%-24s %8.1f MB/s (%zu lines, %zu bytes out)\n", name,
+           bytes * kIterations / elapsed.count() / 1e6, lines.size(),
+           output / kIterations);
+  };
+
+  time("wide string", [&](const std::string& line) {
+    return ConvertThroughWideString(cp, line);
+  });
+  time("direct", [&](const std::string& line) {
+    return cp.ConvertToUTF8(line);
+  });
+}
@@ -0,0 +1,174 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "systems/base/file_index.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+const std::vector<std::string> EXTENSIONS = {"g00", "pdt", "ogg", "nwa"};
+
+class FileIndexTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    root_ = fs::temp_directory_path() /
+            fs::unique_path("rlvm-file-index-%%%%-%%%%");
+    gamepath_ = root_ / "game";
+    index_file_ = root_ / "save" / "file_index";
+
+    Touch("G00/BG001.g00");
+    Touch("G00/bg002.PDT");
+    Touch("G00/readme.txt");
+    Touch("KOE/0001/z000100001.ogg");
+    Touch("KOE/0002/z000200001.ogg");
+    Touch("BGM/title.nwa");
+    Touch("BGM/title.ogg");
+    Touch("UNLISTED/hidden.g00");
+
+    // As if the game had been installed a while ago. Listings of directories
+    // changed within the last second are never reused.
+    for (fs::recursive_directory_iterator it(gamepath_), end; it != end; ++it) {
+      if (fs::is_directory(it->status()))
+        fs::last_write_time(it->path(), std::time(NULL) - 60);
+    }
+  }
+
+  virtual void TearDown() { fs::remove_all(root_); }
+
+  void Touch(const std::string& relative) {
+    fs::path path = gamepath_ / relative;
+    fs::create_directories(path.parent_path());
+    fs::ofstream out(path);
+  }
+
+  FileIndex* MakeIndex(const fs::path& index_file) {
+    return new FileIndex(gamepath_, {"g00", "koe", "bgm"}, EXTENSIONS,
+                         index_file);
+  }
+
+  fs::path root_;
+  fs::path gamepath_;
+  fs::path index_file_;
+};
+
+TEST_F(FileIndexTest, FindsFilesCaseInsensitively) {
+  std::unique_ptr<FileIndex> index(MakeIndex(fs::path()));
+  index->Build();
+
+  EXPECT_EQ(gamepath_ / "G00/BG001.g00", index->Find("bg001", {"g00"}));
+  EXPECT_EQ(gamepath_ / "G00/bg002.PDT", index->Find("bg002", {"g00", "pdt"}));
+  EXPECT_EQ(gamepath_ / "KOE/0002/z000200001.ogg",
+            index->Find("z000200001", {"ogg"}));
+  EXPECT_EQ(fs::path(), index->Find("bg001", {"pdt"}));
+  EXPECT_EQ(fs::path(), index->Find("readme", {"txt"}));
+  EXPECT_EQ(fs::path(), index->Find("hidden", {"g00"}));
+  EXPECT_EQ(6u, index->size());
+}
+
+TEST_F(FileIndexTest, ExtensionOrderIsPriority) {
+  std::unique_ptr<FileIndex> index(MakeIndex(fs::path()));
+  index->Build();
+
+  EXPECT_EQ(gamepath_ / "BGM/title.nwa", index->Find("title", {"nwa", "ogg"}));
+  EXPECT_EQ(gamepath_ / "BGM/title.ogg", index->Find("title", {"ogg", "nwa"}));
+}
+
+TEST_F(FileIndexTest, BackgroundBuild) {
+  std::unique_ptr<FileIndex> index(MakeIndex(fs::path()));
+  index->BuildInBackground();
+  EXPECT_EQ(gamepath_ / "BGM/title.ogg", index->Find("title", {"ogg"}));
+}
+
+TEST_F(FileIndexTest, ReusesPersistedDirectories) {
+  {
+    std::unique_ptr<FileIndex> index(MakeIndex(index_file_));
+    index->Build();
+    EXPECT_EQ(5, index->directories_scanned());
+  }
+  ASSERT_TRUE(fs::exists(index_file_));
+
+  std::unique_ptr<FileIndex> index(MakeIndex(index_file_));
+  index->Build();
+  EXPECT_EQ(0, index->directories_scanned());
+  EXPECT_EQ(6u, index->size());
+  EXPECT_EQ(gamepath_ / "KOE/0001/z000100001.ogg",
+            index->Find("z000100001", {"ogg"}));
+}
+
+TEST_F(FileIndexTest, RescansOnlyChangedDirectories) {
+  {
+    std::unique_ptr<FileIndex> index(MakeIndex(index_file_));
+    index->Build();
+  }
+
+  // Most likely in the same second as the first build, so the directory's
+  // mtime may not tell the two listings apart.
+  Touch("KOE/0001/z000100002.ogg");
+
+  std::unique_ptr<FileIndex> index(MakeIndex(index_file_));
+  index->Build();
+  EXPECT_EQ(1, index->directories_scanned());
+  EXPECT_EQ(gamepath_ / "KOE/0001/z000100002.ogg",
+            index->Find("z000100002", {"ogg"}));
+}
+
+TEST_F(FileIndexTest, RetriesAfterFailedBackgroundBuild) {
+  fs::path moved = root_ / "moved";
+  fs::rename(gamepath_, moved);
+
+  std::unique_ptr<FileIndex> index(MakeIndex(fs::path()));
+  index->BuildInBackground();
+  EXPECT_THROW(index->Find("title", {"ogg"}), fs::filesystem_error);
+
+  fs::rename(moved, gamepath_);
+  EXPECT_EQ(gamepath_ / "BGM/title.ogg", index->Find("title", {"ogg"}));
+}
+
+TEST_F(FileIndexTest, IgnoresIndexForOtherGame) {
+  {
+    std::unique_ptr<FileIndex> index(MakeIndex(index_file_));
+    index->Build();
+  }
+
+  FileIndex other(root_, {"game"}, EXTENSIONS, index_file_);
+  other.Build();
+  EXPECT_EQ(7, other.directories_scanned());
+  EXPECT_EQ(gamepath_ / "UNLISTED/hidden.g00", other.Find("hidden", {"g00"}));
+}
+
+}  // namespace
@@ -0,0 +1,130 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "systems/base/frame_telemetry.h"
+#include "systems/base/graphics_system.h"
+
+#include "test_utils.h"
+
+namespace {
+
+// A clock that advances by one millisecond every time it is read.
+FrameTelemetry::ClockSource SteppingClock(uint64_t* now) {
+  return [now]() { return *now += 1000; };
+}
+
+}  // namespace
+
+TEST(FrameTelemetryTest, RecordsPhasesPerFrame) {
+  uint64_t now = 0;
+  FrameTelemetry telemetry;
+  telemetry.SetClockSource(SteppingClock(&now));
+
+  telemetry.AddInstructions(5);
+  EXPECT_EQ(0, telemetry.size()) << "Nothing is recorded before a frame";
+
+  telemetry.BeginFrame(100);
+  uint64_t lap = telemetry.GetMicroseconds();
+  lap = telemetry.Lap(FrameTelemetry::PHASE_EVENTS, lap);
+  telemetry.Lap(FrameTelemetry::PHASE_SOUND, lap);
+  {
+    FrameTelemetry::ScopedPhase swap(telemetry, FrameTelemetry::PHASE_SWAP);
+  }
+  telemetry.AddInstructions(7);
+  telemetry.AddUploadBytes(4096);
+  EXPECT_EQ(0, telemetry.size()) << "The current frame isn't finished";
+
+  telemetry.BeginFrame(116);
+  ASSERT_EQ(1, telemetry.size());
+  const FrameTelemetry::Frame& frame = telemetry.GetFrame(0);
+  EXPECT_EQ(100u, frame.ticks);
+  EXPECT_EQ(6000u, frame.frame_us);
+  EXPECT_EQ(1000u, frame.phase_us[FrameTelemetry::PHASE_EVENTS]);
+  EXPECT_EQ(1000u, frame.phase_us[FrameTelemetry::PHASE_SOUND]);
+  EXPECT_EQ(1000u, frame.phase_us[FrameTelemetry::PHASE_SWAP]);
+  EXPECT_EQ(0u, frame.phase_us[FrameTelemetry::PHASE_TEXT]);
+  EXPECT_EQ(7, frame.instructions);
+  EXPECT_EQ(4096u, frame.upload_bytes);
+}
+
+TEST(FrameTelemetryTest, KeepsMostRecentFrames) {
+  FrameTelemetry telemetry(3);
+  for (unsigned int ticks = 0; ticks < 6; ++ticks)
+    telemetry.BeginFrame(ticks);
+
+  ASSERT_EQ(3, telemetry.size());
+  EXPECT_EQ(2u, telemetry.GetFrame(0).ticks);
+  EXPECT_EQ(4u, telemetry.GetFrame(2).ticks);
+}
+
+TEST(FrameTelemetryTest, ExportsCSVAndJSON) {
+  uint64_t now = 0;
+  FrameTelemetry telemetry;
+  telemetry.SetClockSource(SteppingClock(&now));
+  telemetry.BeginFrame(10);
+  telemetry.AddPhaseTime(FrameTelemetry::PHASE_DRAW_OBJECTS, 250);
+  telemetry.AddInstructions(3);
+  telemetry.BeginFrame(20);
+
+  std::ostringstream csv;
+  telemetry.WriteCSV(csv);
+  EXPECT_EQ(
+      "ticks,scene,frame_us,events_us,text_us,sound_us,graphics_us,interpreter_us,"
+      "draw_background_us,draw_objects_us,draw_text_us,swap_us,"
+      "instructions,upload_bytes\n"
+      "10,0,1000,0,0,0,0,0,0,250,0,0,3,0\n",
+      csv.str());
+
+  std::ostringstream json;
+  telemetry.WriteJSON(json);
+  EXPECT_NE(std::string::npos, json.str().find("\"ticks\": 10"));
+  EXPECT_NE(std::string::npos, json.str().find("\"draw_objects_us\": 250"));
+  EXPECT_NE(std::string::npos, json.str().find("\"instructions\": 3"));
+}
+
+class FrameTelemetrySystemTest : public FullSystemTest {};
+
+TEST_F(FrameTelemetrySystemTest, RefreshRecordsDrawPhases) {
+  uint64_t now = 0;
+  FrameTelemetry& telemetry = system.telemetry();
+  telemetry.SetClockSource(SteppingClock(&now));
+
+  telemetry.BeginFrame(0);
+  system.graphics().Refresh(NULL);
+  telemetry.BeginFrame(1);
+
+  const FrameTelemetry::Frame& frame = telemetry.GetFrame(0);
+  EXPECT_EQ(1000u, frame.phase_us[FrameTelemetry::PHASE_DRAW_BACKGROUND]);
+  EXPECT_EQ(1000u, frame.phase_us[FrameTelemetry::PHASE_DRAW_OBJECTS]);
+  EXPECT_EQ(1000u, frame.phase_us[FrameTelemetry::PHASE_DRAW_TEXT]);
+}
@@ -25,16 +25,28 @@
 //
 // -----------------------------------------------------------------------
 
+#include "libreallive/alldefs.h"
 #include "libreallive/gameexe.h"
 
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
 #include "gtest/gtest.h"
 
 #include "test_utils.h"
 
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <sstream>
 #include <string>
 #include <vector>
 
 using namespace std;
+namespace fs = boost::filesystem;
 
 TEST(GameexeUnit, ReadAllKeys) {
   Gameexe ini(locateTestCase("Gameexe_data/Gameexe.ini"));
@@ -136,3 +148,156 @@ TEST(GameexeUnit, DstrackRegression) {
   EXPECT_EQ("dcbgm000", dc.GetStringAt(3));
   EXPECT_EQ("dcbgm000", dc.GetStringAt(4));
 }
+
+// Value tokens that aren't plain numbers or strings.
+TEST(GameexeUnit, ValueTokenEdgeCases) {
+  Gameexe ini;
+  ini.parseLine("#NEGATIVE = -5, -2147483648\r");
+  ini.parseLine("#DASHES = 1 - 2 -- 3 --4");
+  ini.parseLine("#BROKEN = 99999999999, 2147483648");
+  ini.parseLine("  #SPACED.KEY   =  \"a b\" ,\"\"");
+
+  EXPECT_EQ(-5, ini("NEGATIVE").GetIntAt(0));
+  EXPECT_EQ(INT32_MIN, ini("NEGATIVE").GetIntAt(1));
+
+  std::vector<int> dashes = ini("DASHES").ToIntVector();
+  ASSERT_EQ(5u, dashes.size());
+  EXPECT_EQ(1, dashes[0]);
+  EXPECT_EQ(2, dashes[1]);
+  EXPECT_EQ(0, dashes[2]);
+  EXPECT_EQ(3, dashes[3]);
+  EXPECT_EQ(0, dashes[4]);
+
+  EXPECT_EQ(0, ini("BROKEN").GetIntAt(0));
+  EXPECT_EQ(0, ini("BROKEN").GetIntAt(1));
+
+  EXPECT_EQ("a b", ini("SPACED", "KEY").GetStringAt(0));
+  EXPECT_EQ("", ini("SPACED", "KEY").GetStringAt(1));
+}
+
+// Integer key parts and their setw(3) spelling name the same key.
+TEST(GameexeUnit, IntAndStringKeyPartsMatch) {
+  Gameexe ini(locateTestCase("Gameexe_data/Gameexe.ini"));
+  EXPECT_EQ(25, ini("WINDOW", 0, "MOJI_SIZE").ToInt());
+  EXPECT_EQ(25, ini("WINDOW", "000", "MOJI_SIZE").ToInt());
+  EXPECT_EQ(25, ini("WINDOW.000", "MOJI_SIZE").ToInt());
+  EXPECT_EQ(25, ini("WINDOW", 0)("MOJI_SIZE").ToInt());
+  EXPECT_EQ("WINDOW.000.MOJI_SIZE", ini("WINDOW", 0)("MOJI_SIZE").key());
+  EXPECT_FALSE(ini("WINDOW", "0", "MOJI_SIZE").Exists());
+  EXPECT_FALSE(ini("WINDOW", 1, "MOJI_SIZE").Exists());
+}
+
+TEST(GameexeUnit, AssignmentIsVisibleToLookups) {
+  Gameexe ini(locateTestCase("Gameexe_data/Gameexe.ini"));
+  ini("IMAGINE", "ONE") = 10;
+  EXPECT_EQ(10, ini("IMAGINE.ONE").ToInt());
+
+  GameexeInterpretObject fresh = ini("BRAND", "NEW", 7);
+  EXPECT_FALSE(fresh.Exists());
+  fresh = "value";
+  EXPECT_TRUE(fresh.Exists());
+  EXPECT_EQ("value", ini("BRAND.NEW.007").ToString());
+}
+
+TEST(GameexeUnit, KeyHandles) {
+  Gameexe ini(locateTestCase("Gameexe_data/Gameexe.ini"));
+  GameexeKeyHandle moji_size = ini.GetHandle("WINDOW", 0, "MOJI_SIZE");
+  EXPECT_TRUE(moji_size.Exists());
+  EXPECT_EQ(25, moji_size.ToInt());
+  EXPECT_EQ("WINDOW.000.MOJI_SIZE", moji_size.key());
+
+  GameexeKeyHandle caption = ini.GetHandle("CAPTION");
+  EXPECT_EQ("Canon: A firearm", caption.ToString());
+
+  // A handle to a missing key picks up later assignments.
+  GameexeKeyHandle missing = ini.GetHandle("SAVEPOINT_MESSAGE");
+  EXPECT_FALSE(missing.Exists());
+  EXPECT_EQ(-1, missing.ToInt(-1));
+  EXPECT_THROW(missing.ToInt(), libreallive::Error);
+  ini("SAVEPOINT_MESSAGE") = 0;
+  EXPECT_TRUE(missing.Exists());
+  EXPECT_EQ(0, missing.ToInt());
+
+  GameexeKeyHandle unresolved;
+  EXPECT_FALSE(unresolved.Exists());
+  EXPECT_EQ(3, unresolved.ToInt(3));
+}
+
+// Lookup microbenchmark. Run with --gtest_also_run_disabled_tests.
+TEST(GameexeUnit, DISABLED_LookupSpeed) {
+  Gameexe ini(locateTestCase("Gameexe_data/Gameexe.ini"));
+  const int kIterations = 1000000;
+
+  // What every lookup used to cost: format the key through an ostringstream,
+  // then find it in a multimap of strings.
+  std::multimap<std::string, std::vector<int>> old_data;
+  GameexeFilteringIterator it = ini.filtering_begin("");
+  GameexeFilteringIterator end = ini.filtering_end();
+  for (; it != end; ++it)
+    old_data.emplace(it->key(), std::vector<int>());
+
+  auto time = [&](const char* name, const std::function<int()>& lookup) {
+    int sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i)
+      sum += lookup();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    printf("%-28s %6.1f ns/lookup\n", name,
+           elapsed.count() * 1e9 / kIterations);
+    return sum;
+  };
+
+  time("ostringstream + multimap", [&] {
+    std::ostringstream ss;
+    ss << "WINDOW" << "." << std::setw(3) << std::setfill('0') << 0 << "."
+       << "MOJI_SIZE";
+    return static_cast<int>(old_data.count(ss.str()));
+  });
+  time("gexe(\"WINDOW\", 0, ...)", [&] {
+    return ini("WINDOW", 0, "MOJI_SIZE").ToInt();
+  });
+  GameexeKeyHandle handle = ini.GetHandle("WINDOW", 0, "MOJI_SIZE");
+  time("GameexeKeyHandle", [&] { return handle.ToInt(); });
+}
+
+// Time to parse the fixtures, and a generated file about the size of a large
+// game's Gameexe.ini.
+TEST(GameexeUnit, DISABLED_StartupSpeed) {
+  const int kIterations = 2000;
+  auto time = [&](const char* name, const fs::path& file, int iterations) {
+    size_t keys = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      Gameexe ini(file);
+      keys += ini.size();
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    printf("%-28s %9.1f us/parse (%zu keys)\n", name,
+           elapsed.count() * 1e6 / iterations, keys / iterations);
+  };
+
+  time("Gameexe.ini", locateTestCase("Gameexe_data/Gameexe.ini"), kIterations);
+  time("Gameexe_koeonoff.ini",
+       locateTestCase("Gameexe_data/Gameexe_koeonoff.ini"), kIterations);
+  time("Gameexe_tokenization.ini",
+       locateTestCase("Gameexe_data/Gameexe_tokenization.ini"), kIterations);
+
+  fs::path large = fs::temp_directory_path() / fs::unique_path();
+  {
+    fs::ofstream out(large);
+    for (int i = 0; i < 2000; ++i) {
+      out << "#OBJECT." << std::setw(3) << std::setfill('0') << i
+          << "=1,0,0,0,0,0,0,0,0,0,0,0\r\n";
+      out << "#SE." << std::setw(3) << std::setfill('0') << i << "=\"se"
+          << i << "\",0\r\n";
+      out << "#DSTRACK=00000000-99999999-00269364=\"BGM" << i << "\"=\"BGM"
+          << i << "\"\r\n";
+      out << "#WINDOW." << std::setw(3) << std::setfill('0') << (i % 64)
+          << ".MOJI_SIZE=" << i << "\r\n";
+    }
+  }
+  time("generated (8000 lines)", large, kIterations / 100);
+  fs::remove(large);
+}
@@ -48,9 +48,11 @@
 #include "modules/module_obj_management.h"
 #include "modules/module_str.h"
 #include "systems/base/colour_filter_object_data.h"
+#include "systems/base/event_system.h"
 #include "systems/base/graphics_object.h"
 #include "systems/base/graphics_object_of_file.h"
 #include "systems/base/object_mutator.h"
+#include "systems/base/object_tween_table.h"
 #include "systems/base/parent_graphics_object_data.h"
 #include "test_system/mock_colour_filter.h"
 #include "test_system/test_graphics_system.h"
@@ -326,12 +328,78 @@ TEST_F(GraphicsObjectTest, ObjectMutatorCopy) {
   rlmachine.Exe("objBgEveColLevel", 1, TestMachine::Arg(18, 128, 0, 0, 0));
 
   EXPECT_TRUE(system.graphics().GetObject(1, 18).IsMutatorRunningMatching(
-      -1, "objEveColLevel"));
+      -1, InternMutatorName("objEveColLevel")));
 
   system.graphics().ClearAndPromoteObjects();
 
   EXPECT_TRUE(system.graphics().GetObject(0, 18).IsMutatorRunningMatching(
-      -1, "objEveColLevel"));
+      -1, InternMutatorName("objEveColLevel")));
+}
+
+// objEve* commands are rows in the graphics system's tween table, advanced
+// once per ExecuteGraphicsSystem() and removed when ended.
+TEST_F(GraphicsObjectTest, TweenTableDrivesEveCommands) {
+  uint64_t now = 1000000;
+  system.event().SetFrameClockSource([&now]() { return now; });
+  system.event().BeginFrame();
+
+  GraphicsObject obj;
+  obj.SetObjectData(new ColourFilterObjectData(
+      system.graphics(), Rect(10, 10, Size(80, 70))));
+  system.graphics().SetObject(0, 4, obj);
+
+  rlmachine.AttachModule(new ObjFgModule);
+  rlmachine.Exe("objEveMove", 1, TestMachine::Arg(4, 100, 200, 1000, 0, 0));
+
+  GraphicsObject& moving = system.graphics().GetObject(0, 4);
+  int name_id = InternMutatorName("objEveMove");
+  EXPECT_TRUE(moving.IsMutatorRunningMatching(-1, name_id));
+  EXPECT_EQ(2u, system.graphics().tweens().size());
+
+  now += 500000;
+  system.event().BeginFrame();
+  system.graphics().ExecuteGraphicsSystem(rlmachine);
+  EXPECT_EQ(50, moving.x());
+  EXPECT_EQ(100, moving.y());
+
+  rlmachine.Exe("objEveMoveEnd", 0, TestMachine::Arg(4, 0));
+  EXPECT_EQ(100, moving.x());
+  EXPECT_EQ(200, moving.y());
+  EXPECT_FALSE(moving.IsMutatorRunningMatching(-1, name_id));
+  EXPECT_EQ(0u, system.graphics().tweens().size());
+}
+
+// The savepoint snapshot keeps the values objects had when it was taken, even
+// while their tweens keep running.
+TEST_F(GraphicsObjectTest, SavepointSnapshotKeepsTweenedValues) {
+  uint64_t now = 1000000;
+  system.event().SetFrameClockSource([&now]() { return now; });
+  system.event().BeginFrame();
+
+  GraphicsObject obj;
+  obj.SetObjectData(new ColourFilterObjectData(
+      system.graphics(), Rect(10, 10, Size(80, 70))));
+  system.graphics().SetObject(0, 4, obj);
+
+  rlmachine.AttachModule(new ObjFgModule);
+  rlmachine.Exe("objEveMove", 1, TestMachine::Arg(4, 100, 200, 1000, 0, 0));
+
+  now += 500000;
+  system.event().BeginFrame();
+  system.graphics().ExecuteGraphicsSystem(rlmachine);
+  rlmachine.MarkSavepoint();
+  EXPECT_EQ(2u, system.graphics().tweens().size());
+
+  now += 250000;
+  system.event().BeginFrame();
+  system.graphics().ExecuteGraphicsSystem(rlmachine);
+  EXPECT_EQ(75, system.graphics().GetObject(0, 4).x());
+
+  std::stringstream ss;
+  Serialization::saveGameTo(ss, rlmachine);
+  Serialization::loadGameFrom(ss, rlmachine);
+  EXPECT_EQ(50, system.graphics().GetObject(0, 4).x());
+  EXPECT_EQ(100, system.graphics().GetObject(0, 4).y());
 }
 
 class MutatorTest : public ObjectMutator {
@@ -356,6 +424,50 @@ class MutatorTest : public ObjectMutator {
   bool called_;
 };
 
+// An animation that never finishes, standing in for ANM and GAN data.
+class EndlessAnimation : public GraphicsObjectData {
+ public:
+  EndlessAnimation() { set_is_currently_playing(true); }
+
+  virtual int PixelWidth(const GraphicsObject& rp) override { return 0; }
+  virtual int PixelHeight(const GraphicsObject& rp) override { return 0; }
+  virtual GraphicsObjectData* Clone() const override {
+    return new EndlessAnimation;
+  }
+  virtual void Execute(RLMachine& machine) override {}
+  virtual bool IsAnimation() const override { return true; }
+
+ protected:
+  virtual std::shared_ptr<const Surface> CurrentSurface(
+      const GraphicsObject& rp) override {
+    return std::shared_ptr<const Surface>();
+  }
+  virtual void ObjectInfo(std::ostream& tree) override {}
+};
+
+// A playing animation asks for the next frame even when it is a child of a
+// parent object.
+TEST_F(GraphicsObjectTest, AnimatedChildSchedulesNextFrame) {
+  EventSystem& event = system.event();
+  GraphicsObject parent;
+  ParentGraphicsObjectData* parent_data = new ParentGraphicsObjectData(10);
+  parent.SetObjectData(parent_data);
+  system.graphics().SetObject(0, 3, parent);
+
+  event.BeginFrame();
+  system.graphics().ExecuteGraphicsSystem(rlmachine);
+  EXPECT_EQ(EventSystem::kNoWakeup, event.next_wakeup());
+
+  GraphicsObject& live_parent = system.graphics().GetObject(0, 3);
+  static_cast<ParentGraphicsObjectData&>(live_parent.GetObjectData())
+      .GetObject(5)
+      .SetObjectData(new EndlessAnimation);
+
+  event.BeginFrame();
+  system.graphics().ExecuteGraphicsSystem(rlmachine);
+  EXPECT_EQ(event.frame_ticks(), event.next_wakeup());
+}
+
 TEST_F(GraphicsObjectTest, RunMutatorsOnChildObjects) {
   GraphicsObject parent;
   ParentGraphicsObjectData* parent_data = new ParentGraphicsObjectData(10);
@@ -0,0 +1,110 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <utility>
+
+#include "systems/base/event_system.h"
+#include "systems/base/input_trace.h"
+#include "utilities/exception.h"
+
+#include "test_utils.h"
+
+TEST(InputTraceTest, SavesAndLoads) {
+  InputTrace trace(1234);
+  trace.BeginFrame(16000);
+  trace.AddInstructions(40);
+  trace.BeginFrame(32000);
+  trace.AddEvent(InputEvent(InputEvent::MOUSE_DOWN, 1, Point(10, 20), 0));
+  trace.AddEvent(InputEvent(InputEvent::KEY_DOWN, 13, Point(), 256));
+  trace.AddInstructions(1);
+
+  std::stringstream ss;
+  trace.Save(ss);
+  std::unique_ptr<InputTrace> loaded = InputTrace::Load(ss);
+
+  EXPECT_EQ(1234u, loaded->seed());
+  ASSERT_EQ(2, loaded->size());
+  EXPECT_EQ(16000u, loaded->GetFrame(0).time_us);
+  EXPECT_EQ(40, loaded->GetFrame(0).instructions);
+  EXPECT_TRUE(loaded->GetFrame(0).events.empty());
+  EXPECT_EQ(trace.GetFrame(1).events, loaded->GetFrame(1).events);
+}
+
+TEST(InputTraceTest, RejectsMalformedTraces) {
+  std::istringstream wrong_magic("not-a-trace 1 0\n");
+  EXPECT_THROW(InputTrace::Load(wrong_magic), rlvm::Exception);
+
+  std::istringstream event_before_frame(
+      "rlvm-input-trace 1 0\ne keydown 13 0 0 0\n");
+  EXPECT_THROW(InputTrace::Load(event_before_frame), rlvm::Exception);
+}
+
+class InputReplayTest : public FullSystemTest {};
+
+// Recording captures the frame clock, input and instruction counts, and
+// replaying hands the same back frame by frame.
+TEST_F(InputReplayTest, ReplaysRecordedFrames) {
+  EventSystem& event = system.event();
+  uint64_t now = 5000000;
+  event.SetFrameClockSource([&now]() { return now += 16000; });
+
+  event.StartRecordingInput(99);
+  event.BeginFrame();
+  event.RecordInstructions(12);
+  event.BeginFrame();
+  InputEvent click(InputEvent::MOUSE_DOWN, 1, Point(5, 6), 0);
+  event.RecordInput(click);
+  event.RecordInstructions(1);
+
+  std::stringstream ss;
+  event.input_trace()->Save(ss);
+
+  event.StartReplayingInput(InputTrace::Load(ss));
+  EXPECT_TRUE(event.replaying_input());
+  EXPECT_EQ(5016u, event.frame_ticks()) << "Starts at the recorded clock";
+
+  event.BeginFrame();
+  EXPECT_EQ(5016000u, event.frame_time_us());
+  EXPECT_EQ(12, event.GetReplayedInstructions());
+  EXPECT_TRUE(event.GetReplayedInput().empty());
+
+  event.BeginFrame();
+  EXPECT_EQ(5032000u, event.frame_time_us());
+  ASSERT_EQ(1u, event.GetReplayedInput().size());
+  EXPECT_EQ(click, event.GetReplayedInput()[0]);
+  EXPECT_FALSE(event.replay_finished());
+
+  event.BeginFrame();
+  EXPECT_TRUE(event.replay_finished());
+  EXPECT_GT(event.frame_time_us(), 5032000u) << "Time keeps moving";
+  EXPECT_TRUE(event.GetReplayedInput().empty());
+}
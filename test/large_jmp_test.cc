@@ -29,6 +29,7 @@
 
 #include "libreallive/archive.h"
 #include "libreallive/intmemref.h"
+#include "machine/parameter_preparser.h"
 #include "machine/rlmachine.h"
 #include "modules/module_jmp.h"
 #include "modules/module_msg.h"
@@ -711,6 +712,32 @@ TEST(LargeJmpTest, fibonacci) {
   }
 }
 
+// Runs fibonacci with every parameter in the scenario parsed ahead of time on
+// several threads.
+TEST(LargeJmpTest, fibonacciPreparsed) {
+  libreallive::Archive arc(locateTestCase("Module_Jmp_SEEN/fibonacci.TXT"));
+  TestSystem system;
+  RLMachine rlmachine(system, arc);
+  rlmachine.AttachModule(new JmpModule);
+  rlmachine.AttachModule(new StrModule);
+  ParameterPreparser preparser(rlmachine, arc, 3, false);
+
+  libreallive::Scenario* scenario = arc.GetScenario(1);
+  ASSERT_TRUE(scenario);
+  EXPECT_LT(0, scenario->preparsed_command_count());
+  for (auto const& element : *scenario) {
+    const CommandElement* command =
+        dynamic_cast<const CommandElement*>(element.get());
+    if (command && rlmachine.FindOperation(*command)) {
+      EXPECT_TRUE(command->AreParametersParsed());
+    }
+  }
+
+  rlmachine.SetIntValue(IntMemRef('D', 0), 9);
+  rlmachine.ExecuteUntilHalted();
+  EXPECT_EQ(recFib(9), rlmachine.GetIntValue(IntMemRef('E', 0)));
+}
+
 // -----------------------------------------------------------------------
 
 // Tests farcall_with()/rtl_with().
@@ -26,8 +26,11 @@
 
 #include "gtest/gtest.h"
 
+#include "long_operations/wait_long_operation.h"
 #include "machine/rlmachine.h"
 #include "modules/module_event_loop.h"
+#include "systems/base/event_system.h"
+#include "systems/base/frame_counter.h"
 
 #include "test_utils.h"
 
@@ -49,3 +52,44 @@ TEST_F(MediumEventLoopTest, TestSkipMode) {
   rlmachine.Exe("SkipMode", 0);
   EXPECT_EQ(0, rlmachine.store_register());
 }
+
+// Everything reads the time sampled at the start of the frame, and a
+// replacement clock drives animation deterministically.
+TEST_F(MediumEventLoopTest, FrameClockDrivesFrameCounters) {
+  EventSystem& event = system.event();
+  uint64_t now = 1000000;
+  event.SetFrameClockSource([&now]() { return now; });
+  event.BeginFrame();
+
+  SimpleFrameCounter counter(event, 0, 100, 1000);
+  now += 500000;
+  EXPECT_EQ(1000000u, event.frame_time_us());
+  EXPECT_EQ(0, counter.ReadFrame()) << "The frame hasn't advanced yet";
+
+  event.BeginFrame();
+  EXPECT_EQ(1500u, event.frame_ticks());
+  EXPECT_EQ(50, counter.ReadFrame());
+}
+
+// A timed wait lets the game loop sleep and asks to be woken when it expires.
+// Waits on arbitrary predicates have to be polled every frame.
+TEST_F(MediumEventLoopTest, TimedWaitSchedulesWakeup) {
+  EventSystem& event = system.event();
+  event.BeginFrame();
+  EXPECT_EQ(EventSystem::kNoWakeup, event.next_wakeup());
+
+  WaitLongOperation wait(rlmachine);
+  wait.WaitMilliseconds(5000);
+  EXPECT_TRUE(wait.CanSleep());
+  EXPECT_FALSE(wait(rlmachine));
+
+  unsigned int now = event.GetTicks();
+  EXPECT_GT(event.next_wakeup(), now);
+  EXPECT_LE(event.next_wakeup(), now + 5001);
+
+  event.BeginFrame();
+  EXPECT_EQ(EventSystem::kNoWakeup, event.next_wakeup());
+
+  wait.BreakOnEvent([]() { return false; });
+  EXPECT_FALSE(wait.CanSleep());
+}
@@ -29,6 +29,7 @@
 #include "machine/rlmachine.h"
 #include "modules/module_grp.h"
 #include "systems/base/colour.h"
+#include "systems/base/event_system.h"
 #include "test_system/mock_surface.h"
 
 #include "test_utils.h"
@@ -133,3 +134,47 @@ TEST_F(MediumGrpTest, TestFade_7) {
   rlmachine.Exe(
       "recFade", 7, TestMachine::Arg(10, 10, 20, 20, 128, 128, 128, 0));
 }
+
+// With a present rate, a dirty screen waits for the next present interval.
+TEST_F(MediumGrpTest, PresentRateSpacesRedraws) {
+  GraphicsSystem& graphics = system.graphics();
+  uint64_t now = 1000000;
+  system.event().SetFrameClockSource([&now]() { return now; });
+  system.event().BeginFrame();
+
+  graphics.ForceRefresh();
+  EXPECT_TRUE(graphics.IsPresentDue(1000)) << "Unpaced redraws are immediate";
+
+  graphics.SetPresentRate(50);
+  EXPECT_EQ(20u, graphics.present_interval());
+  graphics.OnScreenRefreshed();
+  EXPECT_FALSE(graphics.IsPresentDue(1030)) << "Nothing to draw";
+
+  graphics.ForceRefresh();
+  EXPECT_FALSE(graphics.IsPresentDue(1010));
+  EXPECT_TRUE(graphics.IsPresentDue(1020));
+
+  graphics.SetPresentRate(0);
+  EXPECT_TRUE(graphics.IsPresentDue(1001));
+}
+
+TEST_F(MediumGrpTest, SkipModeCapsPresentRate) {
+  GraphicsSystem& graphics = system.graphics();
+  uint64_t now = 1000000;
+  system.event().SetFrameClockSource([&now]() { return now; });
+  system.event().BeginFrame();
+
+  graphics.SetSkipPresentRate(20);
+  EXPECT_EQ(0u, graphics.GetPresentInterval()) << "Not skipping";
+
+  system.set_force_fast_forward();
+  EXPECT_EQ(50u, graphics.GetPresentInterval());
+  graphics.OnScreenRefreshed();
+  graphics.ForceRefresh();
+  EXPECT_FALSE(graphics.IsPresentDue(1020));
+  EXPECT_TRUE(graphics.IsPresentDue(1050));
+
+  // A slower normal rate still wins.
+  graphics.SetPresentRate(10);
+  EXPECT_EQ(100u, graphics.GetPresentInterval());
+}
@@ -0,0 +1,207 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "libreallive/archive.h"
+#include "libreallive/intmemref.h"
+#include "machine/memory.h"
+#include "machine/rlmachine.h"
+#include "test_system/test_system.h"
+#include "utilities/exception.h"
+#include "test_utils.h"
+
+using libreallive::IntMemRef;
+
+namespace {
+
+const char BANKS[] = {'A', 'B', 'E', 'F', 'G', 'Z'};
+const char* const ACCESS_TYPES[] = {"", "b", "2b", "4b", "8b"};
+const int ACCESS_SIZES[] = {2000, 64000, 32000, 16000, 8000};
+
+}  // namespace
+
+// Runs the same bulk operations through Memory's bulk accessors on one
+// machine and through GetIntValue()/SetIntValue() on another, then checks
+// that both machines end up with the same memory and savepoint records.
+class MemoryBulkTest : public ::testing::Test {
+ protected:
+  MemoryBulkTest()
+      : arc(locateTestCase("Module_Str_SEEN/strcpy_0.TXT")),
+        bulk(system, arc),
+        element(system, arc),
+        rng(42) {
+    for (char bank : BANKS) {
+      for (int i = 0; i < SIZE_OF_MEM_BANK; ++i) {
+        int value = RandomInt();
+        bulk.SetIntValue(IntMemRef(bank, i), value);
+        element.SetIntValue(IntMemRef(bank, i), value);
+      }
+    }
+    bulk.MarkSavepoint();
+    element.MarkSavepoint();
+  }
+
+  // A random number in [0, |n|).
+  int Random(int n) {
+    return std::uniform_int_distribution<int>(0, n - 1)(rng);
+  }
+
+  // A random number across the whole range of int.
+  int RandomInt() {
+    return std::uniform_int_distribution<int>(INT32_MIN, INT32_MAX)(rng);
+  }
+
+  // A random range that fits in |size| elements.
+  void RandomRange(int size, int* first, int* count) {
+    *count = 1 + Random(300);
+    *first = Random(size - *count + 1);
+  }
+
+  void ExpectSameMemory() {
+    for (char bank : BANKS) {
+      for (int i = 0; i < SIZE_OF_MEM_BANK; ++i) {
+        ASSERT_EQ(element.GetIntValue(IntMemRef(bank, i)),
+                  bulk.GetIntValue(IntMemRef(bank, i)))
+            << bank << "[" << i << "]";
+      }
+    }
+
+    const OriginalIntBank* element_original[] = {
+        &element.memory().local().original_intA,
+        &element.memory().local().original_intF};
+    const OriginalIntBank* bulk_original[] = {
+        &bulk.memory().local().original_intA,
+        &bulk.memory().local().original_intF};
+    for (int b = 0; b < 2; ++b) {
+      ASSERT_EQ(element_original[b]->dirty, bulk_original[b]->dirty);
+      for (int i = 0; i < SIZE_OF_MEM_BANK; ++i) {
+        if (element_original[b]->dirty[i]) {
+          ASSERT_EQ(element_original[b]->values[i],
+                    bulk_original[b]->values[i]);
+        }
+      }
+    }
+  }
+
+  TestSystem system;
+  libreallive::Archive arc;
+  RLMachine bulk;
+  RLMachine element;
+  std::mt19937 rng;
+};
+
+TEST_F(MemoryBulkTest, Fill) {
+  for (int round = 0; round < 200; ++round) {
+    char bank = BANKS[Random(6)];
+    int type = Random(5);
+    int first, count;
+    RandomRange(ACCESS_SIZES[type], &first, &count);
+    int value = RandomInt();
+
+    bulk.memory().FillIntValues(
+        IntMemRef(bank, ACCESS_TYPES[type], first), count, value);
+    for (int i = 0; i < count; ++i)
+      element.SetIntValue(IntMemRef(bank, ACCESS_TYPES[type], first + i),
+                          value);
+  }
+  ExpectSameMemory();
+}
+
+TEST_F(MemoryBulkTest, WriteAndRead) {
+  for (int round = 0; round < 200; ++round) {
+    char source_bank = BANKS[Random(6)];
+    char dest_bank = BANKS[Random(6)];
+    int source_type = Random(5);
+    int dest_type = Random(5);
+    int source, dest, count;
+    int size = std::min(ACCESS_SIZES[source_type], ACCESS_SIZES[dest_type]);
+    RandomRange(size, &source, &count);
+    dest = Random(size - count + 1);
+
+    std::vector<int> bulk_values(count);
+    bulk.memory().GetIntValues(
+        IntMemRef(source_bank, ACCESS_TYPES[source_type], source), count,
+        bulk_values.data());
+    std::vector<int> element_values(count);
+    for (int i = 0; i < count; ++i) {
+      element_values[i] = element.GetIntValue(
+          IntMemRef(source_bank, ACCESS_TYPES[source_type], source + i));
+    }
+    ASSERT_EQ(element_values, bulk_values);
+
+    bulk.memory().SetIntValues(
+        IntMemRef(dest_bank, ACCESS_TYPES[dest_type], dest), count,
+        bulk_values.data());
+    for (int i = 0; i < count; ++i) {
+      element.SetIntValue(
+          IntMemRef(dest_bank, ACCESS_TYPES[dest_type], dest + i),
+          element_values[i]);
+    }
+  }
+  ExpectSameMemory();
+}
+
+TEST_F(MemoryBulkTest, Sum) {
+  for (int round = 0; round < 200; ++round) {
+    char bank = BANKS[Random(6)];
+    int type = Random(5);
+    int first, count;
+    RandomRange(ACCESS_SIZES[type], &first, &count);
+
+    // Sums wrap around like any other 32-bit integer arithmetic.
+    int64_t expected = 0;
+    for (int i = 0; i < count; ++i) {
+      expected +=
+          element.GetIntValue(IntMemRef(bank, ACCESS_TYPES[type], first + i));
+    }
+    EXPECT_EQ(static_cast<int32_t>(static_cast<uint32_t>(expected)),
+              bulk.memory().SumIntValues(
+                  IntMemRef(bank, ACCESS_TYPES[type], first), count));
+  }
+}
+
+// Ranges that run off the end of a bank write up to the end and then throw,
+// exactly like the element-wise loop.
+TEST_F(MemoryBulkTest, RangePastEndOfBank) {
+  EXPECT_THROW(bulk.memory().FillIntValues(IntMemRef('A', "4b", 15990), 20, 7),
+               rlvm::Exception);
+  EXPECT_THROW(
+      {
+        for (int i = 0; i < 20; ++i)
+          element.SetIntValue(IntMemRef('A', "4b", 15990 + i), 7);
+      },
+      rlvm::Exception);
+  ExpectSameMemory();
+  EXPECT_EQ(7, bulk.GetIntValue(IntMemRef('A', "4b", 15999)));
+}
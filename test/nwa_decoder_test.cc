@@ -0,0 +1,200 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "xclannad/endian.hpp"
+#include "xclannad/wavfile.h"
+
+namespace {
+
+struct NWAFormat {
+  int channels;
+  int bps;
+  int complevel;
+  bool use_runlength;
+};
+
+std::vector<NWAFormat> AllFormats() {
+  std::vector<NWAFormat> formats;
+  for (int channels = 1; channels <= 2; ++channels) {
+    for (int bps = 8; bps <= 16; bps += 8) {
+      for (int complevel = 0; complevel <= 5; ++complevel) {
+        formats.push_back({channels, bps, complevel, false});
+        formats.push_back({channels, bps, complevel, true});
+      }
+    }
+  }
+  return formats;
+}
+
+// Every bit pattern is a valid NWA bitstream, so random data exercises all
+// the code paths. The buffer is zero padded because the reference decoder
+// reads a byte or two past the end of the block.
+std::vector<char> RandomBlock(std::mt19937& rng, int size) {
+  std::vector<char> block(size + 16, 0);
+  for (int i = 0; i < size; ++i)
+    block[i] = static_cast<char>(rng() & 0xff);
+  return block;
+}
+
+std::vector<char> Decode(const NWAFormat& f,
+                         const std::vector<char>& block,
+                         int datasize,
+                         int outdatasize,
+                         bool reference) {
+  std::vector<char> out(outdatasize, 0);
+  NWADecodeBlock(f.channels, f.bps, f.complevel, f.use_runlength,
+                 block.data(), out.data(), datasize, outdatasize, reference);
+  return out;
+}
+
+// Writes a complete NWA file with |blocks| blocks of random data to a
+// temporary file.
+FILE* WriteRandomNWAFile(std::mt19937& rng, int blocks, int* file_size) {
+  const int kBlockSize = 2048;  // samples per block
+  const int kRestSize = 1000;
+  const int kCompBlockSize = 1500;
+
+  int data_start = 0x2c + blocks * 4;
+  int compdatasize = data_start + blocks * kCompBlockSize;
+  int samplecount = (blocks - 1) * kBlockSize + kRestSize;
+
+  std::vector<char> file(compdatasize, 0);
+  char* h = file.data();
+  write_little_endian_short(h + 0x00, 2);
+  write_little_endian_short(h + 0x02, 16);
+  write_little_endian_int(h + 0x04, 44100);
+  write_little_endian_int(h + 0x08, 2);
+  write_little_endian_int(h + 0x0c, 0);
+  write_little_endian_int(h + 0x10, blocks);
+  write_little_endian_int(h + 0x14, samplecount * 2);
+  write_little_endian_int(h + 0x18, compdatasize);
+  write_little_endian_int(h + 0x1c, samplecount);
+  write_little_endian_int(h + 0x20, kBlockSize);
+  write_little_endian_int(h + 0x24, kRestSize);
+  write_little_endian_int(h + 0x28, 0x89);
+  for (int i = 0; i < blocks; ++i)
+    write_little_endian_int(h + 0x2c + i * 4, data_start + i * kCompBlockSize);
+  for (int i = data_start; i < compdatasize; ++i)
+    file[i] = static_cast<char>(rng() & 0xff);
+
+  FILE* f = tmpfile();
+  fwrite(file.data(), 1, file.size(), f);
+  rewind(f);
+  *file_size = compdatasize;
+  return f;
+}
+
+}  // namespace
+
+TEST(NWADecoderTest, MatchesReferenceDecoder) {
+  std::mt19937 rng(2813);
+  for (const NWAFormat& f : AllFormats()) {
+    for (int i = 0; i < 8; ++i) {
+      int datasize = 64 + (rng() % 4096);
+      std::vector<char> block = RandomBlock(rng, datasize);
+      int outdatasize = 4096 * (f.bps / 8);
+      EXPECT_EQ(Decode(f, block, datasize, outdatasize, true),
+                Decode(f, block, datasize, outdatasize, false))
+          << "channels=" << f.channels << " bps=" << f.bps
+          << " complevel=" << f.complevel << " rl=" << f.use_runlength;
+    }
+  }
+}
+
+// Short blocks run out of input before filling the output, which checks that
+// the new decoder stops at exactly the same sample as the old one.
+TEST(NWADecoderTest, StopsAtEndOfInputLikeReference) {
+  std::mt19937 rng(513);
+  for (const NWAFormat& f : AllFormats()) {
+    for (int datasize = 0; datasize < 40; ++datasize) {
+      std::vector<char> block = RandomBlock(rng, datasize);
+      int outdatasize = 1024 * (f.bps / 8);
+      EXPECT_EQ(Decode(f, block, datasize, outdatasize, true),
+                Decode(f, block, datasize, outdatasize, false))
+          << "channels=" << f.channels << " bps=" << f.bps
+          << " complevel=" << f.complevel << " datasize=" << datasize;
+    }
+  }
+}
+
+// NWAFILE::ReadAll() decodes all blocks at once (in parallel when there are
+// enough of them); it must produce the same PCM as streaming through
+// NWAFILE::Read().
+TEST(NWADecoderTest, ReadAllMatchesStreamingDecode) {
+  std::mt19937 rng(42);
+  int size;
+  FILE* f = WriteRandomNWAFile(rng, 37, &size);
+
+  int total_size;
+  char* all = NWAFILE::ReadAll(f, total_size);
+  ASSERT_TRUE(all);
+  std::vector<char> read_all(all, all + total_size);
+  delete[] all;
+
+  rewind(f);
+  NWAFILE stream(f, size);
+  std::vector<char> streamed(total_size + 4096);
+  int got = stream.Read(streamed.data(), 1, streamed.size());
+  streamed.resize(got);
+
+  EXPECT_EQ(read_all, streamed);
+}
+
+// Throughput benchmark. Run with --gtest_also_run_disabled_tests.
+TEST(NWADecoderTest, DISABLED_Throughput) {
+  std::mt19937 rng(1);
+  const int kBlockSamples = 1 << 16;
+  const int kIterations = 64;
+  NWAFormat f = {2, 16, 2, false};
+  std::vector<char> block = RandomBlock(rng, kBlockSamples * 2);
+  int outdatasize = kBlockSamples * 2;
+  std::vector<char> out(outdatasize);
+
+  for (bool reference : {true, false}) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+      NWADecodeBlock(f.channels, f.bps, f.complevel, f.use_runlength,
+                     block.data(), out.data(), block.size() - 16,
+                     outdatasize, reference);
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    double mb = static_cast<double>(outdatasize) * kIterations / (1 << 20);
+    printf("%s decoder: %.1f MB/s of PCM\n",
+           reference ? "reference" : "fast", mb / elapsed.count());
+  }
+
+  EXPECT_EQ(Decode(f, block, block.size() - 16, outdatasize, true),
+            Decode(f, block, block.size() - 16, outdatasize, false));
+}
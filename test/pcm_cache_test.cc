@@ -0,0 +1,196 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <SDL/SDL.h>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "systems/base/pcm_cache.h"
+#include "xclannad/wavfile.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+// Stands in for a decoder that is already in the output format: four byte
+// stereo frames counting up from zero.
+struct CountingWAVFILE : WAVFILE {
+  explicit CountingWAVFILE(int frames) : frames_(frames), position_(0) {
+    wavinfo.SamplingRate = WAVFILE::freq;
+    wavinfo.Channels = 2;
+    wavinfo.DataBits = 16;
+  }
+
+  int Read(char* buf, int blksize, int blklen) {
+    int count = std::min(blklen, frames_ - position_);
+    for (int i = 0; i < count; ++i) {
+      int32_t frame = position_ + i;
+      memcpy(buf + i * blksize, &frame, sizeof(frame));
+    }
+    position_ += count;
+    return count;
+  }
+
+  void Seek(int count) { position_ = count; }
+
+  int frames_;
+  int position_;
+};
+
+class PCMCacheTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    WAVFILE::freq = 44100;
+    WAVFILE::format = AUDIO_S16;
+    WAVFILE::channels = 2;
+
+    directory_ = fs::temp_directory_path() /
+                 fs::unique_path("rlvm-pcm-cache-%%%%-%%%%");
+    fs::create_directories(directory_);
+  }
+
+  virtual void TearDown() { fs::remove_all(directory_); }
+
+  fs::path MakeSource(const std::string& name, const std::string& contents) {
+    fs::path source = directory_ / name;
+    FILE* f = fopen(source.string().c_str(), "wb");
+    fwrite(contents.data(), 1, contents.size(), f);
+    fclose(f);
+    return source;
+  }
+
+  std::vector<int32_t> ReadAll(WAVFILE* file) {
+    std::vector<int32_t> frames;
+    int32_t buf[100];
+    int count;
+    while ((count = file->Read(reinterpret_cast<char*>(buf), 4, 100)) > 0)
+      frames.insert(frames.end(), buf, buf + count);
+    return frames;
+  }
+
+  fs::path directory_;
+};
+
+TEST_F(PCMCacheTest, PopulateThenOpen) {
+  fs::path source = MakeSource("track.nwa", "source");
+  PCMCache cache(directory_ / "cache", 1024 * 1024);
+  EXPECT_EQ(NULL, cache.Open(source));
+
+  cache.Populate(source, [] { return new CountingWAVFILE(1000); });
+  cache.WaitForPendingWrites();
+
+  std::unique_ptr<WAVFILE> cached(cache.Open(source));
+  ASSERT_TRUE(cached.get());
+  std::vector<int32_t> frames = ReadAll(cached.get());
+  ASSERT_EQ(1000u, frames.size());
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i, frames[i]);
+
+  // Loop points are in source frames.
+  cached->Seek(990);
+  EXPECT_EQ(10u, ReadAll(cached.get()).size());
+}
+
+TEST_F(PCMCacheTest, DisabledCacheDoesNothing) {
+  fs::path source = MakeSource("track.nwa", "source");
+  PCMCache cache(directory_ / "cache", 0);
+  EXPECT_FALSE(cache.enabled());
+
+  cache.Populate(source, [] { return new CountingWAVFILE(1000); });
+  cache.WaitForPendingWrites();
+  EXPECT_EQ(NULL, cache.Open(source));
+  EXPECT_EQ(0u, cache.GetTotalBytes());
+}
+
+TEST_F(PCMCacheTest, ModifiedSourceInvalidatesEntry) {
+  fs::path source = MakeSource("track.ogg", "source");
+  PCMCache cache(directory_ / "cache", 1024 * 1024);
+  cache.Populate(source, [] { return new CountingWAVFILE(1000); });
+  cache.WaitForPendingWrites();
+  ASSERT_GT(cache.GetTotalBytes(), 0u);
+
+  MakeSource("track.ogg", "a different source");
+  EXPECT_EQ(NULL, cache.Open(source));
+  EXPECT_EQ(0u, cache.GetTotalBytes());
+}
+
+TEST_F(PCMCacheTest, DifferentOutputFormatInvalidatesEntry) {
+  fs::path source = MakeSource("track.ogg", "source");
+  PCMCache cache(directory_ / "cache", 1024 * 1024);
+  cache.Populate(source, [] { return new CountingWAVFILE(1000); });
+  cache.WaitForPendingWrites();
+
+  WAVFILE::freq = 22050;
+  EXPECT_EQ(NULL, cache.Open(source));
+}
+
+TEST_F(PCMCacheTest, EvictsLeastRecentlyUsed) {
+  // Each entry holds 40000 bytes of PCM plus its header.
+  PCMCache cache(directory_ / "cache", 100000);
+  fs::path first = MakeSource("first.nwa", "1");
+  fs::path second = MakeSource("second.nwa", "2");
+  fs::path third = MakeSource("third.nwa", "3");
+
+  cache.Populate(first, [] { return new CountingWAVFILE(10000); });
+  cache.WaitForPendingWrites();
+  cache.Populate(second, [] { return new CountingWAVFILE(10000); });
+  cache.WaitForPendingWrites();
+
+  // Make |first| the most recently used by playing it.
+  fs::path cache_dir = directory_ / "cache";
+  for (fs::directory_iterator it(cache_dir), end; it != end; ++it)
+    fs::last_write_time(it->path(), 1000);
+  delete cache.Open(first);
+
+  cache.Populate(third, [] { return new CountingWAVFILE(10000); });
+  cache.WaitForPendingWrites();
+
+  EXPECT_LE(cache.GetTotalBytes(), 100000u);
+  std::unique_ptr<WAVFILE> a(cache.Open(first));
+  std::unique_ptr<WAVFILE> b(cache.Open(second));
+  std::unique_ptr<WAVFILE> c(cache.Open(third));
+  EXPECT_TRUE(a.get());
+  EXPECT_FALSE(b.get());
+  EXPECT_TRUE(c.get());
+}
+
+TEST_F(PCMCacheTest, OversizedTrackIsNotCached) {
+  fs::path source = MakeSource("track.nwa", "source");
+  PCMCache cache(directory_ / "cache", 1000);
+  cache.Populate(source, [] { return new CountingWAVFILE(10000); });
+  cache.WaitForPendingWrites();
+  EXPECT_EQ(NULL, cache.Open(source));
+  EXPECT_EQ(0u, cache.GetTotalBytes());
+}
+
+}  // namespace
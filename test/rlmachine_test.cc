@@ -126,6 +126,20 @@ TEST_F(RLMachineTest, StringMemory) {
   }
 }
 
+// String parameters may be passed as references into string memory, so
+// reading strK[] must not move it, and writing one strK[] value from another
+// must survive the bank growing.
+TEST_F(RLMachineTest, StrKReferencesStayValid) {
+  rlmachine.SetStringValue(STRK_LOCATION, 0, "first value in strK");
+  const string& first = rlmachine.GetStringValue(STRK_LOCATION, 0);
+  EXPECT_EQ("", rlmachine.GetStringValue(STRK_LOCATION, 1500));
+  EXPECT_EQ("first value in strK", first);
+
+  rlmachine.SetStringValue(STRK_LOCATION, 1999, first);
+  EXPECT_EQ("first value in strK",
+            rlmachine.GetStringValue(STRK_LOCATION, 1999));
+}
+
 // Test error-inducing, string memory access.
 TEST_F(RLMachineTest, StringMemoryErrors) {
   EXPECT_THROW({ rlmachine.SetStringValue(STRM_LOCATION, 2000, "Blah"); },
@@ -276,3 +290,38 @@ TEST_F(RLMachineTest, SerializationOfSavepointValues) {
     verifyStrMemoryCountingFrom(loadMachine, STRS_LOCATION, 0);
   }
 }
+
+// Only the value at the most recent savepoint is saved, no matter how many
+// times or through which bit width a location was written since.
+TEST_F(RLMachineTest, SerializationRevertsAllWritesSinceSavepoint) {
+  stringstream ss;
+  libreallive::Archive arc(locateTestCase("Module_Str_SEEN/strcpy_0.TXT"));
+  {
+    RLMachine saveMachine(system, arc);
+    saveMachine.SetIntValue(IntMemRef('A', 10), 1);
+    saveMachine.SetIntValue(IntMemRef('F', 1999), 2);
+    saveMachine.MarkSavepoint();
+
+    saveMachine.SetIntValue(IntMemRef('A', 10), 3);
+    saveMachine.SetIntValue(IntMemRef('A', 10), 4);
+    saveMachine.SetIntValue(IntMemRef('F', "8b", 4 * 1999), 5);
+    saveMachine.SetIntValue(IntMemRef('B', 0), 6);
+    saveMachine.MarkSavepoint();
+
+    saveMachine.SetIntValue(IntMemRef('A', 10), 7);
+    saveMachine.SetIntValue(IntMemRef('F', "8b", 4 * 1999 + 1), 8);
+    saveMachine.SetIntValue(IntMemRef('B', 0), 9);
+    EXPECT_EQ(7, saveMachine.GetIntValue(IntMemRef('A', 10)));
+
+    Serialization::saveGameTo(ss, saveMachine);
+  }
+
+  {
+    RLMachine loadMachine(system, arc);
+    Serialization::loadGameFrom(ss, loadMachine);
+    EXPECT_EQ(4, loadMachine.GetIntValue(IntMemRef('A', 10)));
+    EXPECT_EQ(5, loadMachine.GetIntValue(IntMemRef('F', "8b", 4 * 1999)));
+    EXPECT_EQ(0, loadMachine.GetIntValue(IntMemRef('F', "8b", 4 * 1999 + 1)));
+    EXPECT_EQ(6, loadMachine.GetIntValue(IntMemRef('B', 0)));
+  }
+}
@@ -49,6 +49,14 @@ using namespace libreallive;
 
 // -----------------------------------------------------------------------
 
+// Parameters are parsed in place out of the scenario; point into |strings|.
+vector<ByteSpan> ToSpans(const vector<string>& strings) {
+  vector<ByteSpan> spans;
+  for (string const& str : strings)
+    spans.emplace_back(str.data(), str.size());
+  return spans;
+}
+
 template <class T>
 void runDataTest(T& t, RLMachine& machine, const vector<string>& input) {
   ExpressionPiecesVector expression_pieces;
@@ -58,7 +66,7 @@ void runDataTest(T& t, RLMachine& machine, const vector<string>& input) {
             back_inserter(binary_strings),
             bind(&PrintableToParsableString, _1));
 
-  t.ParseParameters(binary_strings, expression_pieces);
+  t.ParseParameters(ToSpans(binary_strings), expression_pieces);
   t.Dispatch(machine, expression_pieces);
 }
 
@@ -152,7 +160,7 @@ TEST_F(RLOperationTest, TestStringConstant_T) {
 
   vector<string> unparsed = {"\"string one\"", "\"string two\""};
   ExpressionPiecesVector expression_pieces;
-  capturer.ParseParameters(unparsed, expression_pieces);
+  capturer.ParseParameters(ToSpans(unparsed), expression_pieces);
   capturer.Dispatch(rlmachine, expression_pieces);
 
   EXPECT_EQ("string one", one);
@@ -185,7 +193,7 @@ TEST_F(RLOperationTest, TestIntStringConstant_T) {
   vector<string> unparsed = {PrintableToParsableString("$ FF 01 00 00 00"),
                              "\"string two\""};
   ExpressionPiecesVector expression_pieces;
-  capturer.ParseParameters(unparsed, expression_pieces);
+  capturer.ParseParameters(ToSpans(unparsed), expression_pieces);
   capturer.Dispatch(rlmachine, expression_pieces);
 
   EXPECT_EQ(1, one);
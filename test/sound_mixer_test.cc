@@ -0,0 +1,135 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "systems/base/sound_mixer.h"
+
+namespace {
+
+// Reference implementation of ApplyGainRamp() that the SSE2 path must match.
+std::vector<int16_t> ReferenceRamp(std::vector<int16_t> samples, int channels,
+                                   float start, float end) {
+  int frames = samples.size() / channels;
+  float step = (end - start) / frames;
+  for (int f = 0; f < frames; ++f) {
+    float gain = start + step * static_cast<float>(f);
+    for (int c = 0; c < channels; ++c) {
+      long v = std::lrint(samples[f * channels + c] * gain);
+      v = std::max(-32768L, std::min(32767L, v));
+      samples[f * channels + c] = v;
+    }
+  }
+  return samples;
+}
+
+std::vector<int16_t> MakeSawtooth(int count) {
+  std::vector<int16_t> out(count);
+  for (int i = 0; i < count; ++i)
+    out[i] = static_cast<int16_t>((i * 1237) % 65536 - 32768);
+  return out;
+}
+
+}  // namespace
+
+TEST(SoundMixerTest, ConstantGainScalesSamples) {
+  std::vector<int16_t> samples = {1000, -1000, 2000, -2000};
+  ApplyGainRamp(samples.data(), 2, 2, 0.5f, 0.5f);
+  EXPECT_EQ(500, samples[0]);
+  EXPECT_EQ(-500, samples[1]);
+  EXPECT_EQ(1000, samples[2]);
+  EXPECT_EQ(-1000, samples[3]);
+}
+
+TEST(SoundMixerTest, GainSaturates) {
+  std::vector<int16_t> samples = {30000, -30000};
+  int peak = ApplyGainRamp(samples.data(), 1, 2, 2.0f, 2.0f);
+  EXPECT_EQ(32767, samples[0]);
+  EXPECT_EQ(-32768, samples[1]);
+  EXPECT_EQ(32768, peak);
+}
+
+TEST(SoundMixerTest, RampIsPerFrame) {
+  std::vector<int16_t> samples(8, 10000);
+  ApplyGainRamp(samples.data(), 4, 2, 0.0f, 1.0f);
+  EXPECT_EQ(0, samples[0]);
+  EXPECT_EQ(0, samples[1]);
+  EXPECT_EQ(2500, samples[2]);
+  EXPECT_EQ(2500, samples[3]);
+  EXPECT_EQ(5000, samples[4]);
+  EXPECT_EQ(7500, samples[6]);
+}
+
+TEST(SoundMixerTest, VectorPathMatchesReference) {
+  for (int channels : {1, 2, 3, 4}) {
+    std::vector<int16_t> samples = MakeSawtooth(channels * 1023);
+    std::vector<int16_t> expected =
+        ReferenceRamp(samples, channels, 1.3f, 0.2f);
+    ApplyGainRamp(samples.data(), 1023, channels, 1.3f, 0.2f);
+    EXPECT_EQ(expected, samples) << "channels: " << channels;
+  }
+}
+
+TEST(SoundMixerTest, PeakLevel) {
+  std::vector<int16_t> samples = MakeSawtooth(1001);
+  samples[997] = -31000;
+  EXPECT_EQ(32768, PeakLevel(samples.data(), 1000));
+  EXPECT_EQ(1, PeakLevel(std::vector<int16_t>{0, 1, -1}.data(), 3));
+}
+
+TEST(SoundMixerTest, ChannelRampsAcrossBuffers) {
+  MixerChannel channel(0.0f);
+  channel.RampTo(1.0f, 8);
+  EXPECT_TRUE(channel.IsRamping());
+
+  std::vector<int16_t> buffer(8, 8000);
+  channel.Process(buffer.data(), buffer.size() * 2, MIXER_SAMPLE_S16, 2);
+  EXPECT_EQ(0, buffer[0]);
+  EXPECT_EQ(3000, buffer[6]);
+  EXPECT_FLOAT_EQ(0.5f, channel.gain());
+
+  std::fill(buffer.begin(), buffer.end(), 8000);
+  channel.Process(buffer.data(), buffer.size() * 2, MIXER_SAMPLE_S16, 2);
+  EXPECT_EQ(4000, buffer[0]);
+  EXPECT_EQ(7000, buffer[6]);
+  EXPECT_FALSE(channel.IsRamping());
+  EXPECT_FLOAT_EQ(1.0f, channel.gain());
+
+  EXPECT_EQ(7000, channel.TakePeakLevel());
+  EXPECT_EQ(0, channel.TakePeakLevel());
+}
+
+TEST(SoundMixerTest, SilentChannelZeroesBuffer) {
+  MixerChannel channel(0.0f);
+  std::vector<int8_t> buffer(16, 100);
+  channel.Process(buffer.data(), buffer.size(), MIXER_SAMPLE_S8, 2);
+  EXPECT_EQ(std::vector<int8_t>(16, 0), buffer);
+}
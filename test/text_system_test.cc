@@ -167,6 +167,54 @@ TEST_F(TextSystemTest, BackLogFunctionality) {
 
 // -----------------------------------------------------------------------
 
+TEST_F(TextSystemTest, BacklogDropsOldestPages) {
+  TextSystem& text = rlmachine.system().text();
+  text.SetBacklogLimits(2, 1024 * 1024);
+
+  WriteString("Page one.", true);
+  SnapshotAndClear();
+  WriteString("Page two.", true);
+  SnapshotAndClear();
+  WriteString("Page three.", true);
+  SnapshotAndClear();
+  WriteString("Page four.", true);
+  EXPECT_EQ(2u, text.GetBacklogMemoryUsage().size());
+
+  text.BackPage();
+  EXPECT_EQ("Page three.", GetTextWindow(0).current_contents());
+  text.BackPage();
+  EXPECT_EQ("Page two.", GetTextWindow(0).current_contents());
+  text.BackPage();
+  EXPECT_EQ("Page two.", GetTextWindow(0).current_contents())
+      << "Page one should have been dropped.";
+}
+
+TEST_F(TextSystemTest, BacklogStaysUnderByteLimit) {
+  TextSystem& text = rlmachine.system().text();
+  WriteString("Page one.", true);
+  SnapshotAndClear();
+  std::vector<size_t> usage = text.GetBacklogMemoryUsage();
+  ASSERT_EQ(1u, usage.size());
+  EXPECT_EQ(usage[0], text.backlog_bytes());
+
+  // Leave room for about two pages.
+  text.SetBacklogLimits(100, usage[0] * 2 + usage[0] / 2);
+  for (int i = 0; i < 5; ++i) {
+    WriteString("Another page.", true);
+    SnapshotAndClear();
+  }
+
+  usage = text.GetBacklogMemoryUsage();
+  EXPECT_EQ(2u, usage.size());
+  size_t total = 0;
+  for (size_t bytes : usage)
+    total += bytes;
+  EXPECT_EQ(total, text.backlog_bytes());
+  EXPECT_LE(text.backlog_bytes(), usage[0] * 2 + usage[0] / 2);
+}
+
+// -----------------------------------------------------------------------
+
 // Tests that the TextPage::name construct repeats correctly.
 TEST_F(TextSystemTest, RepeatsTextPageName) {
   TestTextSystem& sys = GetTextSystem();
@@ -28,11 +28,13 @@
 #include "gmock/gmock.h"
 
 #include "libreallive/archive.h"
+#include "libreallive/bytecode.h"
 #include "libreallive/expression.h"
 #include "libreallive/intmemref.h"
 #include "machine/rlmachine.h"
 #include "test_system/mock_surface.h"
 #include "test_system/test_system.h"
+#include "test_system/test_text_system.h"
 #include "test_system/test_text_window.h"
 #include "utilities/string_utilities.h"
 
@@ -263,3 +265,85 @@ TEST_F(TextWindowTest, MultipleKinsokuCharacters) {
             "\xe3\x81\x82\xe3\x81\x82\xe3\x81\x82\xe3\x81\x82\xe3\x81\x82\x0a"
             "\xe3\x81\x82\xe3\x80\x82\xe3\x80\x8d");
 }
+
+// Same as MultipleKinsokuCharacters, but each character only sees the
+// lookahead that TextoutLongOperation passes for prepared text.
+TEST_F(TextWindowTest, MultipleKinsokuCharactersWithLineBreakLookahead) {
+  kanonLikeTextbox();
+
+  TestTextWindow window(system, 0);
+  window.SetName(kGirl, kOpenQuote);
+
+  std::string str = kOpenQuote;
+  for (int i = 0; i < 19; ++i)
+    str += kHiraganaA;
+  str += kPeriod;
+  str += kCloseQuote;
+
+  DisplayText text(str);
+  for (size_t i = 0; i < text.size(); ++i)
+    window.DisplayCharacter(text.Character(i), text.LineBreakLookahead(i + 1));
+
+  EXPECT_EQ(window.current_contents(),
+            "\xe5\xbd\xbc\xe5\xa5\xb3\xe3\x80\x8c\xe3\x81\x82\xe3\x81\x82\xe3"
+            "\x81\x82\xe3\x81\x82\xe3\x81\x82\xe3\x81\x82\xe3\x81\x82\xe3\x81"
+            "\x82\xe3\x81\x82\xe3\x81\x82\xe3\x81\x82\xe3\x81\x82\xe3\x81\x82"
+            "\xe3\x81\x82\xe3\x81\x82\xe3\x81\x82\xe3\x81\x82\xe3\x81\x82\x0a"
+            "\xe3\x81\x82\xe3\x80\x82\xe3\x80\x8d");
+}
+
+TEST(DisplayTextTest, SplitsCharactersAndLineBreakClasses) {
+  // "「あ」ab彼女"
+  DisplayText text(kOpenQuote + kHiraganaA + kCloseQuote + "ab" + kGirl);
+  ASSERT_EQ(7u, text.size());
+  EXPECT_EQ(kHiraganaA, text.Character(1));
+  EXPECT_EQ(0x300d, text.codepoints[2]);
+  EXPECT_EQ(LINE_BREAK_NORMAL, text.break_classes[1]);
+  EXPECT_EQ(LINE_BREAK_KINSOKU, text.break_classes[2]);
+  EXPECT_EQ(LINE_BREAK_ROMAN, text.break_classes[3]);
+
+  // The run of kinsoku and roman characters, then one more.
+  EXPECT_EQ(kCloseQuote + "ab\xe5\xbd\xbc", text.LineBreakLookahead(2));
+  EXPECT_EQ("\xe5\xa5\xb3", text.LineBreakLookahead(6));
+  EXPECT_EQ("", text.LineBreakLookahead(7));
+}
+
+TEST(DisplayTextTest, TextoutElementPreparesTextWithoutNames) {
+  // "あい"
+  const char plain[] = "\x82\xa0\x82\xa2";
+  libreallive::TextoutElement plain_element(plain, plain + 4);
+  plain_element.PrepareDisplayText(0);
+  ASSERT_TRUE(plain_element.display_text());
+  EXPECT_EQ("\xe3\x81\x82\xe3\x81\x84", plain_element.display_text()->utf8);
+
+  // "＊Ａ" is replaced with a name when it is displayed.
+  const char named[] = "\x81\x96\x82\x60\x82\xa0";
+  libreallive::TextoutElement named_element(named, named + 6);
+  named_element.PrepareDisplayText(0);
+  EXPECT_FALSE(named_element.display_text());
+}
+
+// While skipping, glyphs are laid out but only rasterized once the page is
+// about to be shown, and pages cleared before then are never rasterized.
+TEST_F(TextWindowTest, SkippingDefersGlyphRasterization) {
+  kanonLikeTextbox();
+  TestTextSystem& text = dynamic_cast<TestTextSystem&>(system.text());
+  TestTextWindow window(system, 0);
+  system.set_force_fast_forward();
+
+  PrintTextToFunction(
+      bind(&TextWindow::DisplayCharacter, std::ref(window), _1, _2),
+      kHiraganaA + kHiraganaA, "");
+  EXPECT_EQ(0u, text.glyphs().size());
+
+  window.ClearWin();
+  window.FlushPendingGlyphs();
+  EXPECT_EQ(0u, text.glyphs().size());
+
+  PrintTextToFunction(
+      bind(&TextWindow::DisplayCharacter, std::ref(window), _1, _2),
+      kHiraganaA + kPeriod, "");
+  window.FlushPendingGlyphs();
+  ASSERT_EQ(2u, text.glyphs().size());
+  EXPECT_EQ(kPeriod, std::get<0>(text.glyphs()[1]));
+}
@@ -0,0 +1,130 @@
+// -*- Mode: C++; tab-width:2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi:tw=80:et:ts=2:sts=2
+//
+// -----------------------------------------------------------------------
+//
+// This file is part of RLVM, a RealLive virtual machine clone.
+//
+// -----------------------------------------------------------------------
+//
+// Copyright (C) 2026 Elliot Glaysher
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+//
+// -----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+#include "systems/base/texture_budget.h"
+
+namespace {
+
+class FakeClient : public TextureBudget::Client {
+ public:
+  FakeClient() : evictions_(0) {}
+
+  virtual void EvictTextures() override { evictions_++; }
+
+  int evictions() const { return evictions_; }
+
+ private:
+  int evictions_;
+};
+
+}  // namespace
+
+TEST(TextureBudgetTest, EvictsLeastRecentlyRendered) {
+  TextureBudget budget(300);
+  FakeClient a, b, c, d;
+
+  budget.Upload(&a, 100);
+  budget.Upload(&b, 100);
+  budget.Upload(&c, 100);
+  budget.BeginFrame();
+
+  // Drawing |a| makes |b| the least recently used.
+  budget.Touch(&a);
+  budget.Upload(&d, 100);
+
+  EXPECT_EQ(0, a.evictions());
+  EXPECT_EQ(1, b.evictions());
+  EXPECT_EQ(0, c.evictions());
+  EXPECT_FALSE(budget.IsResident(&b));
+  EXPECT_TRUE(budget.IsResident(&a));
+  EXPECT_EQ(300u, budget.stats().resident_bytes);
+  EXPECT_EQ(400u, budget.stats().peak_bytes);
+  EXPECT_EQ(3, budget.stats().resident_clients);
+  EXPECT_EQ(1u, budget.stats().evictions);
+  EXPECT_EQ(100u, budget.stats().evicted_bytes);
+
+  // Drawing |b| again uploads it again and pushes out |c|.
+  budget.BeginFrame();
+  budget.Touch(&a);
+  budget.Touch(&d);
+  budget.Upload(&b, 100);
+  EXPECT_EQ(1, c.evictions());
+  EXPECT_EQ(5u, budget.stats().uploads);
+  EXPECT_EQ(1u, budget.stats().reuploads);
+}
+
+TEST(TextureBudgetTest, NeverEvictsTexturesUsedThisFrame) {
+  TextureBudget budget(150);
+  FakeClient a, b;
+
+  budget.Upload(&a, 100);
+  budget.Upload(&b, 100);
+
+  // Both are needed for the current frame, so we go over budget.
+  EXPECT_EQ(0, a.evictions());
+  EXPECT_EQ(200u, budget.stats().resident_bytes);
+
+  // On the next frame, |a| isn't drawn, so it goes when |b| reuploads.
+  budget.BeginFrame();
+  budget.Upload(&b, 100);
+  EXPECT_EQ(1, a.evictions());
+  EXPECT_EQ(100u, budget.stats().resident_bytes);
+}
+
+TEST(TextureBudgetTest, RemovedClientsAreForgotten) {
+  TextureBudget budget(0);
+  FakeClient a;
+
+  budget.Upload(&a, 100);
+  budget.Upload(&a, 50);
+  EXPECT_EQ(50u, budget.stats().resident_bytes);
+  EXPECT_EQ(1u, budget.stats().uploads);
+
+  budget.Remove(&a);
+  EXPECT_FALSE(budget.IsResident(&a));
+  EXPECT_EQ(0u, budget.stats().resident_bytes);
+  EXPECT_EQ(0, budget.stats().resident_clients);
+
+  // Touching an unknown client does nothing.
+  budget.Touch(&a);
+  EXPECT_FALSE(budget.IsResident(&a));
+
+  // Lowering the budget evicts immediately.
+  FakeClient b;
+  budget.Upload(&b, 100);
+  budget.BeginFrame();
+  budget.set_max_bytes(10);
+  EXPECT_EQ(1, b.evictions());
+
+  std::ostringstream report;
+  budget.WriteReport(report);
+  EXPECT_NE(std::string::npos, report.str().find("Evictions: 1"));
+}